@@ -314,6 +314,7 @@ void OpenRoad::readDef(const char* filename,
   if (continue_on_errors) {
     def_reader.continueOnErrors();
   }
+  def_reader.setThreadCount(threads_);
   dbBlock* block = nullptr;
   if (child) {
     auto parent = db_->getChip()->getBlock();
@@ -362,6 +363,7 @@ void OpenRoad::writeDef(const char* filename, const string& version)
     if (block) {
       odb::defout def_writer(logger_);
       def_writer.setVersion(stringToDefVersion(version));
+      def_writer.setThreadCount(threads_);
       def_writer.writeBlock(block, filename);
     }
   }
@@ -437,20 +439,15 @@ void OpenRoad::writeCdl(const char* outFilename,
   }
 }
 
-void OpenRoad::readDb(const char* filename)
+void OpenRoad::readDb(const char* filename, bool lazy)
 {
   if (db_->getChip() && db_->getChip()->getBlock()) {
     logger_->error(
         ORD, 47, "You can't load a new db file as the db is already populated");
   }
 
-  std::ifstream stream;
-  stream.exceptions(std::ifstream::failbit | std::ifstream::badbit
-                    | std::ios::eofbit);
-  stream.open(filename, std::ios::binary);
-
   try {
-    db_->read(stream);
+    db_->readMapped(filename, threads_, lazy);
   } catch (const std::ios_base::failure& f) {
     logger_->error(ORD, 54, "odb file {} is invalid: {}", filename, f.what());
   }
@@ -464,7 +461,7 @@ void OpenRoad::writeDb(const char* filename)
 {
   utl::StreamHandler stream_handler(filename, true);
 
-  db_->write(stream_handler.getStream());
+  db_->write(stream_handler.getStream(), threads_);
 }
 
 void OpenRoad::diffDbs(const char* filename1,
@@ -182,9 +182,10 @@ proc write_cdl { args } {
 }
 
 
-sta::define_cmd_args "read_db" {filename}
+sta::define_cmd_args "read_db" {[-lazy] filename}
 
 proc read_db { args } {
+  sta::parse_key_args "read_db" args keys {} flags {-lazy}
   sta::check_argc_eq1 "read_db" $args
   set filename [file nativename [lindex $args 0]]
   if { ![file exists $filename] } {
@@ -193,7 +194,7 @@ proc read_db { args } {
   if { ![file readable $filename] } {
     utl::error "ORD" 8 "$filename is not readable."
   }
-  ord::read_db_cmd $filename
+  ord::read_db_cmd $filename [info exists flags(-lazy)]
 }
 
 sta::define_cmd_args "write_db" {filename}
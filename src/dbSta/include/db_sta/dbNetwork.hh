@@ -36,6 +36,7 @@
 #pragma once
 
 #include <set>
+#include <vector>
 
 #include "odb/db.h"
 #include "sta/ConcreteNetwork.hh"
@@ -261,6 +262,14 @@ class dbNetwork : public ConcreteNetwork
   double dbuToMeters(int dist) const;
   int metersToDbu(double dist) const;
 
+  // Flat snapshot of the (non-supply) pins of each dbNet so pinIterator(net)
+  // walks an array instead of the db iterm list.  Nets edited after the
+  // snapshot is built are read from the db until it is rebuilt.
+  void setNetPinCache(bool enable);
+  bool netPinCache() const { return net_pin_cache_; }
+  // Used by dbStaCbk.
+  void replaceCellAfter(const Instance* inst);
+
   // hierarchy handler, set in openroad tested in network child traverserser
   void setHierarchy() { hierarchy_ = true; }
   bool hasHierarchy() const { return hierarchy_; }
@@ -312,7 +321,24 @@ class dbNetwork : public ConcreteNetwork
   static constexpr unsigned DBIDTAG_WIDTH = 0x4;
 
  private:
+  friend class DbNetPinIterator;
+
+  void buildNetPinCache();
+  void netPinCacheChanged(const Net* net);
+  // Pins of net in the snapshot; false if the net is not in it.
+  bool cachedNetPins(const dbNet* net,
+                     // Return values.
+                     Pin* const*& begin,
+                     Pin* const*& end) const;
+
   bool hierarchy_ = false;
+
+  bool net_pin_cache_ = false;
+  // CSR snapshot indexed by dbNet id.
+  std::vector<size_t> net_pin_offsets_;
+  std::vector<Pin*> net_pins_;
+  std::vector<bool> net_pin_stale_;
+  int net_pin_edits_ = 0;
 };
 
 }  // namespace sta
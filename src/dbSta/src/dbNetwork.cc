@@ -37,6 +37,8 @@
 
 #include "db_sta/dbNetwork.hh"
 
+#include <algorithm>
+
 #include "odb/db.h"
 #include "sta/Liberty.hh"
 #include "sta/PatternMatch.hh"
@@ -403,6 +405,8 @@ class DbNetPinIterator : public NetPinIterator
   dbSet<dbITerm>::iterator iitr_end_;
   dbSet<dbModITerm>::iterator mitr_;
   dbSet<dbModITerm>::iterator mitr_end_;
+  Pin* const* cache_itr_ = nullptr;
+  Pin* const* cache_end_ = nullptr;
   Pin* next_;
   const dbNetwork* network_;
 };
@@ -414,7 +418,7 @@ DbNetPinIterator::DbNetPinIterator(const Net* net, const dbNetwork* network)
   network_ = network;
   network->staToDb(net, dnet, modnet);
   next_ = nullptr;
-  if (dnet) {
+  if (dnet && !network->cachedNetPins(dnet, cache_itr_, cache_end_)) {
     iitr_ = dnet->getITerms().begin();
     iitr_end_ = dnet->getITerms().end();
   }
@@ -428,6 +432,10 @@ DbNetPinIterator::DbNetPinIterator(const Net* net, const dbNetwork* network)
 
 bool DbNetPinIterator::hasNext()
 {
+  if (cache_itr_ != cache_end_) {
+    next_ = *cache_itr_++;
+    return true;
+  }
   while (iitr_ != iitr_end_) {
     dbITerm* iterm = *iitr_;
     if (!iterm->getSigType().isSupply()) {
@@ -531,6 +539,10 @@ void dbNetwork::clear()
 {
   ConcreteNetwork::clear();
   db_ = nullptr;
+  net_pin_offsets_.clear();
+  net_pins_.clear();
+  net_pin_stale_.clear();
+  net_pin_edits_ = 0;
 }
 
 Instance* dbNetwork::topInstance() const
@@ -585,17 +597,18 @@ ObjectId dbNetwork::id(const Instance* instance) const
 
 const char* dbNetwork::name(const Instance* instance) const
 {
+  // The db owns the names so they do not need to be copied.
   if (instance == top_instance_) {
-    return tmpStringCopy(block_->getConstName());
+    return block_->getConstName();
   }
 
   dbInst* db_inst;
   dbModInst* mod_inst;
   staToDb(instance, db_inst, mod_inst);
   if (db_inst) {
-    return tmpStringCopy(db_inst->getConstName());
+    return db_inst->getConstName();
   }
-  return tmpStringCopy(mod_inst->getName());
+  return mod_inst->getName();
 }
 
 void dbNetwork::makeVerilogCell(Library* library, dbModInst* mod_inst)
@@ -1132,8 +1145,7 @@ const char* dbNetwork::name(const Net* net) const
   dbNet* dnet = nullptr;
   staToDb(net, dnet, modnet);
   if (dnet) {
-    const char* name = dnet->getConstName();
-    return tmpStringCopy(name);
+    return dnet->getConstName();
   }
   if (modnet) {
     std::string net_name = modnet->getName();
@@ -1451,6 +1463,117 @@ void dbNetwork::readDbNetlistAfter()
   makeTopCell();
   findConstantNets();
   checkLibertyCorners();
+  if (net_pin_cache_) {
+    buildNetPinCache();
+  }
+}
+
+////////////////////////////////////////////////////////////////
+
+void dbNetwork::setNetPinCache(bool enable)
+{
+  net_pin_cache_ = enable;
+  buildNetPinCache();
+}
+
+void dbNetwork::buildNetPinCache()
+{
+  net_pin_offsets_.clear();
+  net_pins_.clear();
+  net_pin_stale_.clear();
+  net_pin_edits_ = 0;
+  if (!net_pin_cache_ || block_ == nullptr) {
+    return;
+  }
+
+  dbSet<dbNet> nets = block_->getNets();
+  uint max_id = 0;
+  for (dbNet* net : nets) {
+    max_id = std::max(max_id, net->getId());
+  }
+  // Ids without a net may be reused by new nets so they start out stale.
+  net_pin_stale_.assign(max_id + 1, true);
+  net_pin_offsets_.assign(max_id + 2, 0);
+  for (dbNet* net : nets) {
+    size_t count = 0;
+    for (dbITerm* iterm : net->getITerms()) {
+      if (!iterm->getSigType().isSupply()) {
+        count++;
+      }
+    }
+    net_pin_offsets_[net->getId() + 1] = count;
+    net_pin_stale_[net->getId()] = false;
+  }
+  for (uint id = 0; id <= max_id; id++) {
+    net_pin_offsets_[id + 1] += net_pin_offsets_[id];
+  }
+
+  net_pins_.resize(net_pin_offsets_[max_id + 1]);
+  for (dbNet* net : nets) {
+    size_t pin_index = net_pin_offsets_[net->getId()];
+    for (dbITerm* iterm : net->getITerms()) {
+      if (!iterm->getSigType().isSupply()) {
+        net_pins_[pin_index++] = dbToSta(iterm);
+      }
+    }
+  }
+}
+
+// Called from the single threaded network edit callbacks, never while
+// the snapshot is being read by search threads.
+void dbNetwork::netPinCacheChanged(const Net* net)
+{
+  if (!net_pin_cache_ || net == nullptr) {
+    return;
+  }
+
+  dbNet* dnet;
+  dbModNet* modnet;
+  staToDb(net, dnet, modnet);
+  if (dnet == nullptr) {
+    return;
+  }
+
+  // Rebuild once enough nets have gone stale to amortize the cost.
+  if (net_pin_edits_ > static_cast<int>(net_pin_stale_.size() / 4)) {
+    buildNetPinCache();
+  }
+  const uint id = dnet->getId();
+  if (id >= net_pin_stale_.size()) {
+    // New nets are not in the snapshot.
+    net_pin_edits_++;
+  } else if (!net_pin_stale_[id]) {
+    net_pin_stale_[id] = true;
+    net_pin_edits_++;
+  }
+}
+
+bool dbNetwork::cachedNetPins(const dbNet* net,
+                              // Return values.
+                              Pin* const*& begin,
+                              Pin* const*& end) const
+{
+  const uint id = net->getId();
+  if (id >= net_pin_stale_.size() || net_pin_stale_[id]) {
+    return false;
+  }
+  begin = net_pins_.data() + net_pin_offsets_[id];
+  end = net_pins_.data() + net_pin_offsets_[id + 1];
+  return true;
+}
+
+void dbNetwork::replaceCellAfter(const Instance* inst)
+{
+  // The supply pins filtered from the snapshot depend on the master.
+  dbInst* db_inst = staToDb(inst);
+  if (db_inst == nullptr) {
+    return;
+  }
+  for (dbITerm* iterm : db_inst->getITerms()) {
+    if (iterm->getNet()) {
+      netPinCacheChanged(dbToSta(iterm->getNet()));
+    }
+  }
 }
 
 void dbNetwork::makeTopCell()
@@ -1643,6 +1766,14 @@ Pin* dbNetwork::connect(Instance* inst, Port* port, Net* net)
 // Incrementally update drivers.
 void dbNetwork::connectPinAfter(Pin* pin)
 {
+  dbITerm* iterm;
+  dbBTerm* bterm;
+  dbModITerm* moditerm;
+  dbModBTerm* modbterm;
+  staToDb(pin, iterm, bterm, moditerm, modbterm);
+  if (iterm && iterm->getNet()) {
+    netPinCacheChanged(dbToSta(iterm->getNet()));
+  }
   if (isDriver(pin)) {
     Net* net = this->net(pin);
     PinSet* drvrs = net_drvr_pin_map_.findKey(net);
@@ -1702,6 +1833,14 @@ void dbNetwork::disconnectPin(Pin* pin)
 
 void dbNetwork::disconnectPinBefore(const Pin* pin)
 {
+  dbITerm* iterm;
+  dbBTerm* bterm;
+  dbModITerm* moditerm;
+  dbModBTerm* modbterm;
+  staToDb(pin, iterm, bterm, moditerm, modbterm);
+  if (iterm && iterm->getNet()) {
+    netPinCacheChanged(dbToSta(iterm->getNet()));
+  }
   Net* net = this->net(pin);
   // Incrementally update drivers.
   if (net && isDriver(pin)) {
@@ -1769,6 +1908,7 @@ void dbNetwork::deleteNet(Net* net)
 
 void dbNetwork::deleteNetBefore(const Net* net)
 {
+  netPinCacheChanged(net);
   PinSet* drvrs = net_drvr_pin_map_.findKey(net);
   delete drvrs;
   net_drvr_pin_map_.erase(net);
@@ -767,7 +767,9 @@ void dbStaCbk::inDbInstSwapMasterBefore(dbInst* inst, dbMaster* master)
 
 void dbStaCbk::inDbInstSwapMasterAfter(dbInst* inst)
 {
-  sta_->replaceEquivCellAfter(network_->dbToSta(inst));
+  Instance* sta_inst = network_->dbToSta(inst);
+  network_->replaceCellAfter(sta_inst);
+  sta_->replaceEquivCellAfter(sta_inst);
 }
 
 void dbStaCbk::inDbNetDestroy(dbNet* db_net)
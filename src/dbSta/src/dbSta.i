@@ -149,6 +149,14 @@ db_network_defined()
   db_network->readDefAfter(block);
 }
 
+void
+set_net_pin_cache(bool enable)
+{
+  ord::OpenRoad *openroad = ord::getOpenRoad();
+  sta::dbNetwork *db_network = openroad->getDbNetwork();
+  db_network->setNetPinCache(enable);
+}
+
 void
 report_cell_usage_cmd()
 {
@@ -0,0 +1,22 @@
+# report_checks with the dbNetwork net pin cache enabled
+source "helpers.tcl"
+read_lef example1.lef
+read_def example1.def
+read_liberty example1_slow.lib
+sta::set_net_pin_cache 1
+
+create_clock -name clk -period 10 {clk1 clk2 clk3}
+set_input_delay -clock clk 0 {in1 in2}
+set_output_delay -clock clk 0 out
+report_checks
+
+foreach pin [get_pins -of_objects [get_nets u1z]] {
+  puts [get_full_name $pin]
+}
+
+# Edited nets are read from the db until the cache is rebuilt.
+disconnect_pin u1z u2/A2
+puts [llength [get_pins -of_objects [get_nets u1z]]]
+connect_pin u1z u2/A2
+puts [llength [get_pins -of_objects [get_nets u1z]]]
+report_checks
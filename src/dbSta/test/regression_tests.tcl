@@ -5,6 +5,7 @@ record_tests {
   constant1
   make_port
   network_edit1
+  net_pin_cache1
   sdc_names1
   sdc_names2
   sdc_get1
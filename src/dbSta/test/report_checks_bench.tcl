@@ -0,0 +1,31 @@
+# Microbenchmark for the dbNetwork queries on the timing hot path.
+# Times full timing updates followed by report_checks with and without the
+# net pin cache. Not part of the regression; run by hand from this directory:
+#   openroad -exit report_checks_bench.tcl
+source "helpers.tcl"
+read_liberty Nangate45/Nangate45_typ.lib
+read_lef Nangate45/Nangate45.lef
+read_verilog ../../../test/aes_nangate45.v
+link_design aes_cipher_top
+read_sdc ../../../test/aes_nangate45.sdc
+
+set iterations 20
+
+proc bench_report_checks { label } {
+  global iterations
+  set start [clock milliseconds]
+  for { set i 0 } { $i < $iterations } { incr i } {
+    find_timing -full_update
+    sta::redirect_file_begin /dev/null
+    report_checks -group_path_count 100
+    sta::redirect_file_end
+  }
+  set elapsed [expr [clock milliseconds] - $start]
+  puts [format "%-12s %8.1f ms/iteration" $label \
+          [expr double($elapsed) / $iterations]]
+}
+
+sta::set_net_pin_cache 0
+bench_report_checks "no cache"
+sta::set_net_pin_cache 1
+bench_report_checks "cache"
@@ -340,15 +340,16 @@ bool Opendp::checkInRows(const Cell& cell) const
              y_ll,
              y_ur);
 
+  const int grid_index = grid_info.second.getGridIndex();
   for (GridY y = y_ll; y < y_ur; y++) {
+    const dbSite* row_site = grid_->gridSite(grid_index, y);
     for (GridX x = x_ll; x < x_ur; x++) {
-      const Pixel* pixel
-          = grid_->gridPixel(grid_info.second.getGridIndex(), x, y);
+      const Pixel* pixel = grid_->gridPixel(grid_index, x, y);
       if (pixel == nullptr  // outside core
           || !pixel->is_valid) {
         return false;
       }
-      if (pixel->site != cell.getSite()) {
+      if (row_site != cell.getSite()) {
         return false;
       }
     }
@@ -388,7 +389,7 @@ const Cell* Opendp::checkOverlap(Cell& cell) const
         overlap_cell = pixel_cell;
       }
     } else {
-      pixel->cell = &cell;
+      grid_->setPixelCell(pixel, &cell);
     }
   });
   return overlap_cell;
@@ -39,6 +39,7 @@
 
 #include "Grid.h"
 
+#include <algorithm>
 #include <boost/polygon/polygon.hpp>
 #include <cmath>
 #include <limits>
@@ -325,35 +326,22 @@ void Grid::initGrid(dbDatabase* db,
   }
 
   // Make pixel grid
-  if (pixels_.empty()) {
-    resize(getInfoMap().size());
-    for (auto& [gmk, grid_info] : getInfoMap()) {
-      resize(grid_info.getGridIndex(), grid_info.getRowCount());
-    }
-  }
-
+  pixels_.resize(getInfoMap().size());
   for (auto& [gmk, grid_info] : getInfoMap()) {
-    const GridY layer_row_count = grid_info.getRowCount();
-    const GridX layer_row_site_count = grid_info.getSiteCount();
-    const int index = grid_info.getGridIndex();
-    resize(index, layer_row_count);
-    for (GridY j{0}; j < layer_row_count; j++) {
-      resize(index, j, layer_row_site_count);
-      const auto& grid_sites = grid_info.getSites();
-      dbSite* row_site = nullptr;
-      if (!grid_sites.empty()) {
-        row_site = grid_sites[j.v % grid_sites.size()].site;
-      }
-
-      for (GridX k{0}; k < layer_row_site_count; k++) {
-        Pixel& pixel = pixels_[index][j.v][k.v];
-        pixel.cell = nullptr;
-        pixel.group = nullptr;
-        pixel.util = 0.0;
-        pixel.is_valid = false;
-        pixel.is_hopeless = false;
-        pixel.site = nullptr;
-        pixel.site = row_site;
+    const int layer_row_count = grid_info.getRowCount().v;
+    const int layer_row_site_count = grid_info.getSiteCount().v;
+    PixelGrid& grid = pixels_[grid_info.getGridIndex()];
+    grid.site_count = layer_row_site_count;
+    grid.words_per_row = (layer_row_site_count + 63) / 64;
+    grid.pixels.assign(
+        static_cast<size_t>(layer_row_count) * layer_row_site_count, Pixel{});
+    grid.occupied.assign(
+        static_cast<size_t>(layer_row_count) * grid.words_per_row, 0);
+    grid.row_sites.assign(layer_row_count, nullptr);
+    const auto& grid_sites = grid_info.getSites();
+    if (!grid_sites.empty()) {
+      for (int j = 0; j < layer_row_count; j++) {
+        grid.row_sites[j] = grid_sites[j % grid_sites.size()].site;
       }
     }
   }
@@ -444,8 +432,7 @@ void Grid::initGrid(dbDatabase* db,
     for (const auto& rect : rects) {
       for (int y = gtl::yl(rect); y < gtl::yh(rect); y++) {
         for (int x = gtl::xl(rect); x < gtl::xh(rect); x++) {
-          Pixel& pixel = pixels_[h_index][y][x];
-          pixel.is_hopeless = true;
+          pixel(h_index, GridY{y}, GridX{x}).is_hopeless = true;
         }
       }
     }
@@ -460,11 +447,91 @@ Pixel* Grid::gridPixel(int grid_idx, GridX grid_x, GridY grid_y) const
   const GridInfo* grid_info = grid_info_vector_[grid_idx];
   if (grid_x >= 0 && grid_x < grid_info->getSiteCount() && grid_y >= 0
       && grid_y < grid_info->getRowCount()) {
-    return const_cast<Pixel*>(&pixels_[grid_idx][grid_y.v][grid_x.v]);
+    const PixelGrid& grid = pixels_[grid_idx];
+    return const_cast<Pixel*>(&grid.pixels[pixelIndex(grid, grid_x, grid_y)]);
   }
   return nullptr;
 }
 
+dbSite* Grid::gridSite(int grid_idx, GridY grid_y) const
+{
+  if (grid_idx < 0 || grid_idx >= pixels_.size()) {
+    return nullptr;
+  }
+  const PixelGrid& grid = pixels_[grid_idx];
+  if (grid_y < 0 || grid_y.v >= static_cast<int>(grid.row_sites.size())) {
+    return nullptr;
+  }
+  return grid.row_sites[grid_y.v];
+}
+
+void Grid::setPixelCell(int grid_idx, GridX grid_x, GridY grid_y, Cell* cell)
+{
+  PixelGrid& grid = pixels_[grid_idx];
+  grid.pixels[pixelIndex(grid, grid_x, grid_y)].cell = cell;
+  const size_t row_offset = static_cast<size_t>(grid_y.v) * grid.words_per_row;
+  uint64_t& word = grid.occupied[row_offset + grid_x.v / 64];
+  const uint64_t bit = uint64_t{1} << (grid_x.v % 64);
+  if (cell) {
+    word |= bit;
+  } else {
+    word &= ~bit;
+  }
+}
+
+void Grid::setPixelCell(Pixel* pixel, Cell* cell)
+{
+  for (int grid_idx = 0; grid_idx < pixels_.size(); grid_idx++) {
+    const PixelGrid& grid = pixels_[grid_idx];
+    const Pixel* begin = grid.pixels.data();
+    if (pixel >= begin && pixel < begin + grid.pixels.size()) {
+      const size_t index = pixel - begin;
+      setPixelCell(grid_idx,
+                   GridX{static_cast<int>(index % grid.site_count)},
+                   GridY{static_cast<int>(index / grid.site_count)},
+                   cell);
+      return;
+    }
+  }
+}
+
+bool Grid::isOccupied(int grid_idx,
+                      GridY grid_y,
+                      GridX x_begin,
+                      GridX x_end) const
+{
+  if (grid_idx < 0 || grid_idx >= pixels_.size()) {
+    return false;
+  }
+  const PixelGrid& grid = pixels_[grid_idx];
+  if (grid_y < 0 || grid_y.v >= static_cast<int>(grid.row_sites.size())) {
+    return false;
+  }
+  const int begin = std::max(x_begin.v, 0);
+  const int end = std::min(x_end.v, grid.site_count);
+  if (begin >= end) {
+    return false;
+  }
+  const uint64_t* row
+      = &grid.occupied[static_cast<size_t>(grid_y.v) * grid.words_per_row];
+  const int first_word = begin / 64;
+  const int last_word = (end - 1) / 64;
+  const uint64_t first_mask = ~uint64_t{0} << (begin % 64);
+  const uint64_t last_mask = ~uint64_t{0} >> (63 - (end - 1) % 64);
+  if (first_word == last_word) {
+    return (row[first_word] & first_mask & last_mask) != 0;
+  }
+  if (row[first_word] & first_mask) {
+    return true;
+  }
+  for (int w = first_word + 1; w < last_word; w++) {
+    if (row[w]) {
+      return true;
+    }
+  }
+  return (row[last_word] & last_mask) != 0;
+}
+
 void Grid::visitCellPixels(
     Cell& cell,
     bool padded,
@@ -658,8 +725,7 @@ void Grid::erasePixel(Cell* cell)
           if (nullptr == pixel) {
             continue;
           }
-          pixel->cell = nullptr;
-          pixel->util = 0;
+          setPixelCell(target_grid_info.getGridIndex(), x, y, nullptr);
         }
       }
     }
@@ -728,15 +794,14 @@ void Grid::paintPixel(Cell* cell, GridX grid_x, GridY grid_y)
   const int index_in_grid = gmk.grid_index;
   setGridPaddedLoc(cell, grid_x, grid_y);
   cell->is_placed_ = true;
-  for (GridX x{grid_x}; x < x_end; x++) {
-    for (GridY y{grid_y}; y < y_end; y++) {
+  for (GridY y{grid_y}; y < y_end; y++) {
+    for (GridX x{grid_x}; x < x_end; x++) {
       Pixel* pixel = gridPixel(index_in_grid, x, y);
       if (pixel->cell) {
         logger_->error(
             DPL, 13, "Cannot paint grid because it is already occupied.");
       } else {
-        pixel->cell = cell;
-        pixel->util = 1.0;
+        setPixelCell(index_in_grid, x, y, cell);
       }
     }
   }
@@ -792,8 +857,7 @@ void Grid::paintPixel(Cell* cell, GridX grid_x, GridY grid_y)
           }
         }
         if (pixel) {
-          pixel->cell = cell;
-          pixel->util = 1.0;
+          setPixelCell(layer.second.getGridIndex(), x, y, cell);
         }
       }
     }
@@ -39,6 +39,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <unordered_set>
 
 #include "Coordinates.h"
@@ -61,15 +62,15 @@ struct DbuPoint
   DbuY y;
 };
 
+// Kept small because there is one per site of every grid.  The site of a
+// pixel only depends on its row; see Grid::gridSite.
 struct Pixel
 {
-  Cell* cell = nullptr;
+  Cell* cell = nullptr;  // only assign through Grid::setPixelCell
   Group* group = nullptr;
-  double util = 0.0;
   dbOrientType orient_;
   bool is_valid = false;     // false for dummy cells
   bool is_hopeless = false;  // too far from sites for diamond search
-  dbSite* site = nullptr;    // site that this pixel is
 };
 
 // Return value for grid searches.
@@ -127,7 +128,8 @@ struct GridMapKey
 // The "Grid" is now an array of 2D grids. The new dimension is to support
 // multi-height cells. Each unique row height creates a new grid that is used in
 // legalization. The first index is the grid index (corresponding to row
-// height), second index is the row index, and third index is the site index.
+// height). Each 2D grid is stored row-major so the sites of a row are
+// contiguous.
 class Grid
 {
  public:
@@ -184,15 +186,24 @@ class Grid
                          bool start) const;
 
   Pixel* gridPixel(int grid_idx, GridX x, GridY y) const;
-  Pixel& pixel(int g, GridY y, GridX x) { return pixels_[g][y.v][x.v]; }
+  Pixel& pixel(int g, GridY y, GridX x)
+  {
+    return pixels_[g].pixels[pixelIndex(pixels_[g], x, y)];
+  }
   const Pixel& pixel(int g, GridY y, GridX x) const
   {
-    return pixels_[g][y.v][x.v];
+    return pixels_[g].pixels[pixelIndex(pixels_[g], x, y)];
   }
+  // Site of row y in grid grid_idx, nullptr outside the grid.
+  dbSite* gridSite(int grid_idx, GridY y) const;
+
+  // Set the cell occupying a pixel and keep the occupancy bitmap in sync.
+  void setPixelCell(int grid_idx, GridX x, GridY y, Cell* cell);
+  void setPixelCell(Pixel* pixel, Cell* cell);
+  // True if any pixel of row y in [x_begin, x_end) holds a cell.
+  // The range is clipped to the grid.
+  bool isOccupied(int grid_idx, GridY y, GridX x_begin, GridX x_end) const;
 
-  void resize(int size) { pixels_.resize(size); }
-  void resize(int g, GridY size) { pixels_[g].resize(size.v); }
-  void resize(int g, GridY y, GridX size) { pixels_[g][y.v].resize(size.v); }
   void clear() { pixels_.clear(); }
 
   GridInfo& infoMap(const GridMapKey& key) { return grid_info_map_.at(key); }
@@ -226,10 +237,26 @@ class Grid
   void visitDbRows(dbBlock* block,
                    const std::function<void(odb::dbRow*)>& func) const;
 
+  // One 2D grid. occupied has one bit per pixel, set iff the pixel has a
+  // cell, with words_per_row words for each row.
+  struct PixelGrid
+  {
+    int site_count = 0;
+    int words_per_row = 0;
+    std::vector<Pixel> pixels;
+    std::vector<dbSite*> row_sites;
+    std::vector<uint64_t> occupied;
+  };
+
+  static size_t pixelIndex(const PixelGrid& grid, GridX x, GridY y)
+  {
+    return static_cast<size_t>(y.v) * grid.site_count + x.v;
+  }
+
   Logger* logger_ = nullptr;
   dbBlock* block_ = nullptr;
   std::shared_ptr<Padding> padding_;
-  std::vector<std::vector<std::vector<Pixel>>> pixels_;
+  std::vector<PixelGrid> pixels_;
   std::vector<const GridInfo*> grid_info_vector_;
   map<GridMapKey, GridInfo> grid_info_map_;
   std::unordered_map<dbSite*, dbSite*> hybrid_parent_;  // child -> parent
@@ -302,8 +302,7 @@ void Opendp::setFixedGridCells()
 
 void Opendp::setGridCell(Cell& cell, Pixel* pixel)
 {
-  pixel->cell = &cell;
-  pixel->util = 1.0;
+  grid_->setPixelCell(pixel, &cell);
   if ((&cell)->isBlock()) {
     // Try the is_hopeless strategy to get off of a block
     pixel->is_hopeless = true;
@@ -373,8 +372,8 @@ void Opendp::groupInitPixels2()
         for (Group& group : groups_) {
           for (Rect& rect : group.region_boundaries) {
             if (!isInside(sub, rect) && checkOverlap(sub, rect)) {
-              pixel->util = 0.0;
-              pixel->cell = &Cell::dummy_cell;
+              grid_->setPixelCell(
+                  grid_info.getGridIndex(), x, y, &Cell::dummy_cell);
               pixel->is_valid = false;
             }
           }
@@ -399,15 +398,8 @@ bool Opendp::checkOverlap(const Rect& cell, const Rect& box)
 
 void Opendp::groupInitPixels()
 {
-  for (const auto& layer : grid_->getInfoMap()) {
-    const GridInfo& grid_info = layer.second;
-    for (GridX x{0}; x < grid_info.getSiteCount(); x++) {
-      for (GridY y{0}; y < grid_info.getRowCount(); y++) {
-        Pixel* pixel = grid_->gridPixel(grid_info.getGridIndex(), x, y);
-        pixel->util = 0.0;
-      }
-    }
-  }
+  // Region coverage of each pixel, only allocated for grids used by groups.
+  std::vector<std::vector<double>> grid_util(grid_->getInfoMap().size());
   for (Group& group : groups_) {
     if (group.cells_.empty()) {
       logger_->warn(DPL, 42, "No cells found in group {}. ", group.name);
@@ -418,6 +410,15 @@ void Opendp::groupInitPixels()
     const GridInfo& grid_info = grid_->getInfoMap().at(gmk);
     const int grid_index = grid_info.getGridIndex();
     const DbuX site_width = grid_->getSiteWidth();
+    const int site_count = grid_info.getSiteCount().v;
+    std::vector<double>& util = grid_util[grid_index];
+    if (util.empty()) {
+      util.resize(
+          static_cast<size_t>(grid_info.getRowCount().v) * site_count, 0.0);
+    }
+    auto utilAt = [&](const GridX x, const GridY y) -> double& {
+      return util[static_cast<size_t>(y.v) * site_count + x.v];
+    };
     for (const DbuRect rect : group.region_boundaries) {
       debugPrint(logger_,
                  DPL,
@@ -437,18 +438,15 @@ void Opendp::groupInitPixels()
         const GridX col_end{dbuToGridFloor(rect.xh, site_width)};
 
         for (GridX l{col_start}; l < col_end; l++) {
-          Pixel* pixel = grid_->gridPixel(grid_index, l, k);
-          pixel->util += 1.0;
+          utilAt(l, k) += 1.0;
         }
         if (rect.xl % site_width != 0) {
-          Pixel* pixel = grid_->gridPixel(grid_index, col_start, k);
-          pixel->util
+          utilAt(col_start, k)
               -= (rect.xl % site_width).v / static_cast<double>(site_width.v);
         }
         if (rect.xh % site_width != 0) {
-          Pixel* pixel = grid_->gridPixel(grid_index, col_end - 1, k);
-          pixel->util -= ((site_width - rect.xh) % site_width).v
-                         / static_cast<double>(site_width.v);
+          utilAt(col_end - 1, k) -= ((site_width - rect.xh) % site_width).v
+                                    / static_cast<double>(site_width.v);
         }
       }
     }
@@ -463,13 +461,13 @@ void Opendp::groupInitPixels()
         // Assign group to each pixel.
         for (GridX l{col_start}; l < col_end; l++) {
           Pixel* pixel = grid_->gridPixel(grid_index, l, k);
-          if (pixel->util == 1.0) {
+          double& pixel_util = utilAt(l, k);
+          if (pixel_util == 1.0) {
             pixel->group = &group;
             pixel->is_valid = true;
-            pixel->util = 1.0;
-          } else if (pixel->util > 0.0 && pixel->util < 1.0) {
-            pixel->cell = &Cell::dummy_cell;
-            pixel->util = 0.0;
+          } else if (pixel_util > 0.0 && pixel_util < 1.0) {
+            grid_->setPixelCell(grid_index, l, k, &Cell::dummy_cell);
+            pixel_util = 0.0;
             pixel->is_valid = false;
           }
         }
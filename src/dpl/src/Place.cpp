@@ -585,7 +585,8 @@ bool Opendp::mapMove(Cell* cell, const GridPt& grid_pt)
              cell->y_,
              pixel_pt.x,
              pixel_pt.y,
-             pixel_pt.pixel->site->getName());
+             grid_->gridSite(grid_->getGridMapKey(cell).grid_index, pixel_pt.y)
+                 ->getName());
   if (pixel_pt.pixel) {
     grid_->paintPixel(cell, pixel_pt.x, pixel_pt.y);
     if (debug_observer_) {
@@ -996,15 +997,20 @@ bool Opendp::checkPixels(const Cell* cell,
   const auto cell_site = cell->getSite();
   const int layer = row_info.second.getGridIndex();
   for (GridY y1 = y; y1 < y_end; y1++) {
+    // Word-level reject of occupied rows before looking at pixels.
+    if (grid_->isOccupied(layer, y1, x, x_end)) {
+      return false;
+    }
+    const dbSite* row_site = grid_->gridSite(layer, y1);
     for (GridX x1 = x; x1 < x_end; x1++) {
       const Pixel* pixel = grid_->gridPixel(layer, x1, y1);
-      if (pixel == nullptr || pixel->cell || !pixel->is_valid
+      if (pixel == nullptr || !pixel->is_valid
           || (cell->inGroup() && pixel->group != cell->group_)
           || (!cell->inGroup() && pixel->group)
-          || (pixel->site != nullptr && pixel->site != cell_site)) {
+          || (row_site != nullptr && row_site != cell_site)) {
         return false;
       }
-      if (pixel->site == nullptr) {
+      if (row_site == nullptr) {
         logger_->error(DPL, 1599, "Pixel site is null");
       }
     }
@@ -31,12 +31,14 @@
 #include <tcl.h>
 
 #include <boost/asio/thread_pool.hpp>
+#include <iosfwd>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <optional>
 #include <queue>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "odb/geom.h"
@@ -75,6 +77,7 @@ struct frDebugSettings;
 class FlexDR;
 struct FlexDRViaData;
 class frMarker;
+class frConstraint;
 
 struct ParamStruct
 {
@@ -99,6 +102,7 @@ struct ParamStruct
   int minAccessPoints = -1;
   bool saveGuideUpdates = false;
   std::string repairPDNLayerName;
+  std::string paCacheDir;
 };
 
 class TritonRoute
@@ -183,13 +187,34 @@ class TritonRoute
   void reportDRC(const std::string& file_name,
                  const std::list<std::unique_ptr<frMarker>>& markers,
                  odb::Rect drcBox = odb::Rect(0, 0, 0, 0));
-  void checkDRC(const char* filename, int x1, int y1, int x2, int y2);
+  void checkDRC(const char* filename,
+                int x1,
+                int y1,
+                int x2,
+                int y2,
+                bool incremental = false);
   bool initGuide();
   void prep();
   void processBTermsAboveTopLayer(bool has_routing = false);
   odb::dbDatabase* getDb() const { return db_; }
 
  private:
+  // Markers found by check_drc in one tile, kept for -incremental
+  struct DRCTileMarker
+  {
+    // report text, which holds the box, layer, type and sources of the
+    // marker
+    std::string report;
+    frConstraint* con;
+    // whether the marker may also be found by a neighboring tile
+    bool onSeam;
+  };
+  struct DRCTile
+  {
+    odb::Rect routeBox;
+    std::vector<DRCTileMarker> markers;
+  };
+
   std::unique_ptr<frDesign> design_;
   std::unique_ptr<frDebugSettings> debug_;
   std::unique_ptr<DesignCallBack> db_callback_;
@@ -209,14 +234,19 @@ class TritonRoute
   int results_sz_{0};
   unsigned int cloud_sz_{0};
   boost::asio::thread_pool dist_pool_{1};
+  std::vector<DRCTile> drc_tiles_;
+  odb::Rect drc_tiles_box_;
 
   void initDesign();
   void gr();
   void ta();
   void dr();
   void applyUpdates(const std::vector<std::vector<drUpdate>>& updates);
+  std::vector<odb::Rect> getDRCTiles(const odb::Rect& requiredDrcBox) const;
   void getDRCMarkers(std::list<std::unique_ptr<frMarker>>& markers,
                      const odb::Rect& requiredDrcBox);
+  void checkDRCTile(DRCTile& tile, const odb::Rect& requiredDrcBox);
+  void writeDRCMarker(std::ostream& os, const frMarker* marker) const;
   void stackVias(odb::dbBTerm* bterm,
                  int top_layer_idx,
                  int bterm_bottom_layer_idx,
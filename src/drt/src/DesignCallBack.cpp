@@ -39,8 +39,70 @@ static inline int defdist(odb::dbBlock* block, int x)
          / (double) block->getDbUnitsPerMicron();
 }
 
+// bound on the tracked regions; past it the whole block is rechecked
+static constexpr int kMaxDirtyRegions = 100000;
+
+void DesignCallBack::addDirtyRegion(odb::dbBlock* block, const odb::Rect& box)
+{
+  if (all_dirty_) {
+    return;
+  }
+  if ((int) dirty_regions_.size() >= kMaxDirtyRegions) {
+    all_dirty_ = true;
+    dirty_regions_.clear();
+    return;
+  }
+  dirty_regions_.emplace_back(defdist(block, box.xMin()),
+                              defdist(block, box.yMin()),
+                              defdist(block, box.xMax()),
+                              defdist(block, box.yMax()));
+}
+
+void DesignCallBack::addDirtyRegion(odb::dbWire* wire)
+{
+  const auto bbox = wire->getBBox();
+  if (bbox) {
+    addDirtyRegion(wire->getBlock(), *bbox);
+  }
+}
+
+void DesignCallBack::clearDirtyRegions()
+{
+  dirty_regions_.clear();
+  all_dirty_ = false;
+}
+
+void DesignCallBack::inDbInstCreate(odb::dbInst* db_inst)
+{
+  addDirtyRegion(db_inst->getBlock(), db_inst->getBBox()->getBox());
+}
+
+void DesignCallBack::inDbInstPlacementStatusBefore(
+    odb::dbInst* db_inst,
+    const odb::dbPlacementStatus& status)
+{
+  addDirtyRegion(db_inst->getBlock(), db_inst->getBBox()->getBox());
+}
+
+void DesignCallBack::inDbInstSwapMasterBefore(odb::dbInst* db_inst,
+                                              odb::dbMaster* master)
+{
+  addDirtyRegion(db_inst->getBlock(), db_inst->getBBox()->getBox());
+}
+
+void DesignCallBack::inDbInstSwapMasterAfter(odb::dbInst* db_inst)
+{
+  addDirtyRegion(db_inst->getBlock(), db_inst->getBBox()->getBox());
+}
+
+void DesignCallBack::inDbPreMoveInst(odb::dbInst* db_inst)
+{
+  addDirtyRegion(db_inst->getBlock(), db_inst->getBBox()->getBox());
+}
+
 void DesignCallBack::inDbPostMoveInst(odb::dbInst* db_inst)
 {
+  addDirtyRegion(db_inst->getBlock(), db_inst->getBBox()->getBox());
   auto design = router_->getDesign();
   if (design != nullptr && design->getTopBlock() != nullptr) {
     auto inst = design->getTopBlock()->getInst(db_inst->getName());
@@ -65,6 +127,7 @@ void DesignCallBack::inDbPostMoveInst(odb::dbInst* db_inst)
 
 void DesignCallBack::inDbInstDestroy(odb::dbInst* db_inst)
 {
+  addDirtyRegion(db_inst->getBlock(), db_inst->getBBox()->getBox());
   auto design = router_->getDesign();
   if (design != nullptr && design->getTopBlock() != nullptr) {
     auto inst = design->getTopBlock()->getInst(db_inst->getName());
@@ -78,4 +141,87 @@ void DesignCallBack::inDbInstDestroy(odb::dbInst* db_inst)
   }
 }
 
+void DesignCallBack::inDbITermPreDisconnect(odb::dbITerm* iterm)
+{
+  addDirtyRegion(iterm->getBlock(), iterm->getBBox());
+}
+
+void DesignCallBack::inDbITermPostConnect(odb::dbITerm* iterm)
+{
+  addDirtyRegion(iterm->getBlock(), iterm->getBBox());
+}
+
+void DesignCallBack::inDbBTermPreDisconnect(odb::dbBTerm* bterm)
+{
+  addDirtyRegion(bterm->getBlock(), bterm->getBBox());
+}
+
+void DesignCallBack::inDbBTermPostConnect(odb::dbBTerm* bterm)
+{
+  addDirtyRegion(bterm->getBlock(), bterm->getBBox());
+}
+
+void DesignCallBack::inDbObstructionCreate(odb::dbObstruction* obs)
+{
+  addDirtyRegion(obs->getBlock(), obs->getBBox()->getBox());
+}
+
+void DesignCallBack::inDbObstructionDestroy(odb::dbObstruction* obs)
+{
+  addDirtyRegion(obs->getBlock(), obs->getBBox()->getBox());
+}
+
+void DesignCallBack::inDbWireDestroy(odb::dbWire* wire)
+{
+  addDirtyRegion(wire);
+}
+
+void DesignCallBack::inDbWirePreModify(odb::dbWire* wire)
+{
+  addDirtyRegion(wire);
+}
+
+void DesignCallBack::inDbWirePostModify(odb::dbWire* wire)
+{
+  addDirtyRegion(wire);
+}
+
+void DesignCallBack::inDbWirePostAttach(odb::dbWire* wire)
+{
+  addDirtyRegion(wire);
+}
+
+void DesignCallBack::inDbWirePreDetach(odb::dbWire* wire)
+{
+  addDirtyRegion(wire);
+}
+
+void DesignCallBack::inDbWirePostAppend(odb::dbWire* src, odb::dbWire* dst)
+{
+  addDirtyRegion(dst);
+}
+
+void DesignCallBack::inDbSWireAddSBox(odb::dbSBox* box)
+{
+  addDirtyRegion(box->getSWire()->getBlock(), box->getBox());
+}
+
+void DesignCallBack::inDbSWireRemoveSBox(odb::dbSBox* box)
+{
+  addDirtyRegion(box->getSWire()->getBlock(), box->getBox());
+}
+
+void DesignCallBack::inDbSWirePreDestroySBoxes(odb::dbSWire* wire)
+{
+  for (odb::dbSBox* box : wire->getWires()) {
+    addDirtyRegion(wire->getBlock(), box->getBox());
+  }
+}
+
+void DesignCallBack::inDbBlockSetDieArea(odb::dbBlock* block)
+{
+  all_dirty_ = true;
+  dirty_regions_.clear();
+}
+
 }  // namespace drt
@@ -26,6 +26,8 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <vector>
+
 #include "odb/db.h"
 #include "odb/dbBlockCallBackObj.h"
 namespace drt {
@@ -36,10 +38,49 @@ class DesignCallBack : public odb::dbBlockCallBackObj
 {
  public:
   DesignCallBack(TritonRoute* router) : router_(router) {}
+  void inDbInstCreate(odb::dbInst* inst) override;
+  void inDbInstPlacementStatusBefore(
+      odb::dbInst* inst,
+      const odb::dbPlacementStatus& status) override;
+  void inDbInstSwapMasterBefore(odb::dbInst* inst,
+                                odb::dbMaster* master) override;
+  void inDbInstSwapMasterAfter(odb::dbInst* inst) override;
+  void inDbPreMoveInst(odb::dbInst* inst) override;
   void inDbPostMoveInst(odb::dbInst* inst) override;
   void inDbInstDestroy(odb::dbInst* inst) override;
+  void inDbITermPreDisconnect(odb::dbITerm* iterm) override;
+  void inDbITermPostConnect(odb::dbITerm* iterm) override;
+  void inDbBTermPreDisconnect(odb::dbBTerm* bterm) override;
+  void inDbBTermPostConnect(odb::dbBTerm* bterm) override;
+  void inDbObstructionCreate(odb::dbObstruction* obs) override;
+  void inDbObstructionDestroy(odb::dbObstruction* obs) override;
+  void inDbWireDestroy(odb::dbWire* wire) override;
+  void inDbWirePreModify(odb::dbWire* wire) override;
+  void inDbWirePostModify(odb::dbWire* wire) override;
+  void inDbWirePostAttach(odb::dbWire* wire) override;
+  void inDbWirePreDetach(odb::dbWire* wire) override;
+  void inDbWirePostAppend(odb::dbWire* src, odb::dbWire* dst) override;
+  void inDbSWireAddSBox(odb::dbSBox* box) override;
+  void inDbSWireRemoveSBox(odb::dbSBox* box) override;
+  void inDbSWirePreDestroySBoxes(odb::dbSWire* wire) override;
+  void inDbBlockSetDieArea(odb::dbBlock* block) override;
+
+  // Regions of the block modified since the last clearDirtyRegions, used by
+  // check_drc -incremental.  isAllDirty is set when the change is not
+  // localized or too many regions have accumulated.
+  const std::vector<odb::Rect>& getDirtyRegions() const
+  {
+    return dirty_regions_;
+  }
+  bool isAllDirty() const { return all_dirty_; }
+  void clearDirtyRegions();
 
  private:
+  void addDirtyRegion(odb::dbBlock* block, const odb::Rect& box);
+  void addDirtyRegion(odb::dbWire* wire);
+
   TritonRoute* router_;
+  std::vector<odb::Rect> dirty_regions_;
+  bool all_dirty_{true};
 };
 }  // namespace drt
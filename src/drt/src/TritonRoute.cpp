@@ -32,6 +32,8 @@
 #include <boost/bind/bind.hpp>
 #include <fstream>
 #include <iostream>
+#include <set>
+#include <sstream>
 
 #include "DesignCallBack.h"
 #include "db/tech/frTechObject.h"
@@ -57,6 +59,7 @@
 #include "sta/StaMain.hh"
 #include "stt/SteinerTreeBuilder.h"
 #include "ta/FlexTA.h"
+#include "utl/exception.h"
 
 namespace sta {
 // Tcl files encoded into strings.
@@ -957,6 +960,7 @@ int TritonRoute::main()
     FlexPA pa(getDesign(), logger_, dist_);
     pa.setDistributed(dist_ip_, dist_port_, shared_volume_, cloud_sz_);
     pa.setDebug(debug_.get(), db_);
+    pa.setDbTech(db_->getTech());
     pa_pool.join();
     pa.main();
     if (distributed_ || debug_->debugDR || debug_->debugDumpDR) {
@@ -1017,6 +1021,7 @@ void TritonRoute::pinAccess(const std::vector<odb::dbInst*>& target_insts)
   FlexPA pa(getDesign(), logger_, dist_);
   pa.setTargetInstances(target_insts);
   pa.setDebug(debug_.get(), db_);
+  pa.setDbTech(db_->getTech());
   if (distributed_) {
     pa.setDistributed(dist_ip_, dist_port_, shared_volume_, cloud_sz_);
     dist_pool_.join();
@@ -1026,11 +1031,9 @@ void TritonRoute::pinAccess(const std::vector<odb::dbInst*>& target_insts)
   writer.updateDb(db_, true);
 }
 
-void TritonRoute::getDRCMarkers(frList<std::unique_ptr<frMarker>>& markers,
-                                const Rect& requiredDrcBox)
+std::vector<Rect> TritonRoute::getDRCTiles(const Rect& requiredDrcBox) const
 {
-  MAX_THREADS = ord::OpenRoad::openRoad()->getThreadCount();
-  std::vector<std::vector<std::unique_ptr<FlexGCWorker>>> workersBatches(1);
+  std::vector<Rect> tiles;
   auto size = 7;
   auto offset = 0;
   auto gCellPatterns = design_->getTopBlock()->getGCellPatterns();
@@ -1040,37 +1043,55 @@ void TritonRoute::getDRCMarkers(frList<std::unique_ptr<frMarker>>& markers,
     for (int j = offset; j < (int) ygp.getCount(); j += size) {
       Rect routeBox1 = design_->getTopBlock()->getGCellBox(Point(i, j));
       const int max_i = std::min((int) xgp.getCount() - 1, i + size - 1);
-      const int max_j = std::min((int) ygp.getCount(), j + size - 1);
+      const int max_j = std::min((int) ygp.getCount() - 1, j + size - 1);
       Rect routeBox2 = design_->getTopBlock()->getGCellBox(Point(max_i, max_j));
       Rect routeBox(routeBox1.xMin(),
                     routeBox1.yMin(),
                     routeBox2.xMax(),
                     routeBox2.yMax());
-      Rect extBox;
       Rect drcBox;
       routeBox.bloat(DRCSAFEDIST, drcBox);
-      routeBox.bloat(MTSAFEDIST, extBox);
       if (!drcBox.intersects(requiredDrcBox)) {
         continue;
       }
-      auto gcWorker
-          = std::make_unique<FlexGCWorker>(design_->getTech(), logger_);
-      gcWorker->setDrcBox(drcBox);
-      gcWorker->setExtBox(extBox);
-      if (workersBatches.back().size() >= BATCHSIZE) {
-        workersBatches.emplace_back();
-      }
-      workersBatches.back().push_back(std::move(gcWorker));
+      tiles.push_back(routeBox);
     }
   }
+  return tiles;
+}
+
+void TritonRoute::getDRCMarkers(frList<std::unique_ptr<frMarker>>& markers,
+                                const Rect& requiredDrcBox)
+{
+  MAX_THREADS = ord::OpenRoad::openRoad()->getThreadCount();
+  std::vector<std::vector<std::unique_ptr<FlexGCWorker>>> workersBatches(1);
+  for (const Rect& routeBox : getDRCTiles(requiredDrcBox)) {
+    Rect extBox;
+    Rect drcBox;
+    routeBox.bloat(DRCSAFEDIST, drcBox);
+    routeBox.bloat(MTSAFEDIST, extBox);
+    auto gcWorker = std::make_unique<FlexGCWorker>(design_->getTech(), logger_);
+    gcWorker->setDrcBox(drcBox);
+    gcWorker->setExtBox(extBox);
+    if (workersBatches.back().size() >= BATCHSIZE) {
+      workersBatches.emplace_back();
+    }
+    workersBatches.back().push_back(std::move(gcWorker));
+  }
   std::map<MarkerId, frMarker*> mapMarkers;
   omp_set_num_threads(MAX_THREADS);
   for (auto& workers : workersBatches) {
+    utl::ThreadException exception;
 #pragma omp parallel for schedule(dynamic)
     for (int i = 0; i < workers.size(); i++) {  // NOLINT
-      workers[i]->init(design_.get());
-      workers[i]->main();
+      try {
+        workers[i]->init(design_.get());
+        workers[i]->main();
+      } catch (...) {
+        exception.capture();
+      }
     }
+    exception.rethrow();
     for (const auto& worker : workers) {
       for (auto& marker : worker->getMarkers()) {
         Rect bbox = marker->getBBox();
@@ -1092,7 +1113,44 @@ void TritonRoute::getDRCMarkers(frList<std::unique_ptr<frMarker>>& markers,
   }
 }
 
-void TritonRoute::checkDRC(const char* filename, int x1, int y1, int x2, int y2)
+void TritonRoute::checkDRCTile(DRCTile& tile, const Rect& requiredDrcBox)
+{
+  Rect extBox;
+  Rect drcBox;
+  tile.routeBox.bloat(DRCSAFEDIST, drcBox);
+  tile.routeBox.bloat(MTSAFEDIST, extBox);
+  FlexGCWorker worker(design_->getTech(), logger_);
+  worker.setDrcBox(drcBox);
+  worker.setExtBox(extBox);
+  worker.init(design_.get());
+  worker.main();
+
+  // Only markers within DRCSAFEDIST of the tile boundary can also be found
+  // by a neighboring tile.
+  const Rect interior(tile.routeBox.xMin() + DRCSAFEDIST + 1,
+                      tile.routeBox.yMin() + DRCSAFEDIST + 1,
+                      tile.routeBox.xMax() - DRCSAFEDIST - 1,
+                      tile.routeBox.yMax() - DRCSAFEDIST - 1);
+  // The worker's markers are already unique by MarkerId.
+  tile.markers.clear();
+  for (auto& marker : worker.getMarkers()) {
+    const Rect bbox = marker->getBBox();
+    if (!bbox.intersects(requiredDrcBox)) {
+      continue;
+    }
+    std::ostringstream report;
+    writeDRCMarker(report, marker.get());
+    tile.markers.push_back(
+        {report.str(), marker->getConstraint(), !interior.contains(bbox)});
+  }
+}
+
+void TritonRoute::checkDRC(const char* filename,
+                           int x1,
+                           int y1,
+                           int x2,
+                           int y2,
+                           bool incremental)
 {
   GC_IGNORE_PDN_LAYER_NUM = -1;
   REPAIR_PDN_LAYER_NUM = -1;
@@ -1109,9 +1167,120 @@ void TritonRoute::checkDRC(const char* filename, int x1, int y1, int x2, int y2)
   if (requiredDrcBox.area() == 0) {
     requiredDrcBox = design_->getTopBlock()->getBBox();
   }
-  frList<std::unique_ptr<frMarker>> markers;
-  getDRCMarkers(markers, requiredDrcBox);
-  reportDRC(filename, markers, requiredDrcBox);
+
+  std::vector<DRCTile> tiles;
+  for (const Rect& routeBox : getDRCTiles(requiredDrcBox)) {
+    tiles.push_back({routeBox, {}});
+  }
+
+  // A tile is rechecked if anything changed within its extBox since the
+  // previous check of the same region.
+  std::vector<bool> dirty(tiles.size(), true);
+  if (incremental) {
+    bool reusable = drc_tiles_box_ == requiredDrcBox
+                    && drc_tiles_.size() == tiles.size()
+                    && !db_callback_->isAllDirty();
+    for (int i = 0; reusable && i < (int) tiles.size(); i++) {
+      reusable = drc_tiles_[i].routeBox == tiles[i].routeBox;
+    }
+    if (reusable) {
+      std::vector<rq_box_value_t<int>> extBoxes;
+      extBoxes.reserve(tiles.size());
+      for (int i = 0; i < (int) tiles.size(); i++) {
+        Rect extBox;
+        tiles[i].routeBox.bloat(MTSAFEDIST, extBox);
+        extBoxes.emplace_back(extBox, i);
+        dirty[i] = false;
+      }
+      const RTree<int> tileTree(extBoxes);
+      std::vector<rq_box_value_t<int>> results;
+      for (const Rect& region : db_callback_->getDirtyRegions()) {
+        results.clear();
+        tileTree.query(bgi::intersects(region), back_inserter(results));
+        for (const auto& [extBox, i] : results) {
+          dirty[i] = true;
+        }
+      }
+      for (int i = 0; i < (int) tiles.size(); i++) {
+        if (!dirty[i]) {
+          tiles[i].markers = std::move(drc_tiles_[i].markers);
+        }
+      }
+    } else {
+      logger_->info(DRT,
+                    621,
+                    "No reusable check_drc results for this region, checking "
+                    "all tiles.");
+    }
+  }
+  drc_tiles_.clear();
+
+  std::ofstream drcRpt;
+  const bool writeReport = filename != nullptr && filename[0] != '\0';
+  if (!writeReport) {
+    if (VERBOSE > 0) {
+      logger_->warn(
+          DRT,
+          290,
+          "Warning: no DRC report specified, skipped writing DRC report");
+    }
+  } else {
+    drcRpt.open(filename);
+    if (!drcRpt.is_open()) {
+      logger_->error(DRT, 622, "Unable to open DRC report file {}.", filename);
+    }
+  }
+
+  // Check the tiles a batch at a time and stream each batch's markers to the
+  // report in tile order, so the output does not depend on the thread count.
+  MAX_THREADS = ord::OpenRoad::openRoad()->getThreadCount();
+  omp_set_num_threads(MAX_THREADS);
+  // Seam markers are deduplicated like MarkerId, with the report text
+  // standing in for the box, layer and sources.
+  std::set<std::pair<frConstraint*, std::string>> seamMarkers;
+  int numChecked = 0;
+  int numMarkers = 0;
+  for (int begin = 0; begin < (int) tiles.size(); begin += BATCHSIZE) {
+    const int end = std::min((int) tiles.size(), begin + BATCHSIZE);
+    utl::ThreadException exception;
+#pragma omp parallel for schedule(dynamic) reduction(+ : numChecked)
+    for (int i = begin; i < end; i++) {  // NOLINT
+      if (!dirty[i]) {
+        continue;
+      }
+      try {
+        checkDRCTile(tiles[i], requiredDrcBox);
+        numChecked++;
+      } catch (...) {
+        exception.capture();
+      }
+    }
+    exception.rethrow();
+    for (int i = begin; i < end; i++) {
+      for (const DRCTileMarker& marker : tiles[i].markers) {
+        if (marker.onSeam
+            && !seamMarkers.insert({marker.con, marker.report}).second) {
+          continue;
+        }
+        numMarkers++;
+        if (writeReport) {
+          drcRpt << marker.report;
+        }
+      }
+    }
+  }
+  drc_tiles_ = std::move(tiles);
+  drc_tiles_box_ = requiredDrcBox;
+  db_callback_->clearDirtyRegions();
+
+  if (incremental && VERBOSE > 0) {
+    logger_->info(DRT,
+                  623,
+                  "Checked {} of {} tiles, found {} violations.",
+                  numChecked,
+                  drc_tiles_.size(),
+                  numMarkers);
+  }
 }
 
 void TritonRoute::processBTermsAboveTopLayer(bool has_routing)
@@ -1330,6 +1499,7 @@ void TritonRoute::setParams(const ParamStruct& params)
   }
   SAVE_GUIDE_UPDATES = params.saveGuideUpdates;
   REPAIR_PDN_LAYER_NAME = params.repairPDNLayerName;
+  PA_CACHE_DIR = params.paCacheDir;
 }
 
 void TritonRoute::addWorkerResults(
@@ -1363,8 +1533,6 @@ void TritonRoute::reportDRC(const std::string& file_name,
                             const frList<std::unique_ptr<frMarker>>& markers,
                             Rect drcBox)
 {
-  double dbu = getDesign()->getTech()->getDBUPerUU();
-
   if (file_name == std::string("")) {
     if (VERBOSE > 0) {
       logger_->warn(
@@ -1382,77 +1550,84 @@ void TritonRoute::reportDRC(const std::string& file_name,
       if (drcBox != Rect() && !drcBox.intersects(bbox)) {
         continue;
       }
-      auto tech = getDesign()->getTech();
-      auto layer = tech->getLayer(marker->getLayerNum());
-      auto layerType = layer->getType();
-
-      auto con = marker->getConstraint();
-      drcRpt << "  violation type: ";
-      if (con) {
-        std::string violName;
-        if (con->typeId() == frConstraintTypeEnum::frcShortConstraint
-            && layerType == dbTechLayerType::CUT) {
-          violName = "Cut Short";
-        } else {
-          violName = con->getViolName();
+      writeDRCMarker(drcRpt, marker.get());
+    }
+  } else {
+    std::cout << "Error: Fail to open DRC report file\n";
+  }
+}
+
+void TritonRoute::writeDRCMarker(std::ostream& os, const frMarker* marker) const
+{
+  double dbu = getDesign()->getTech()->getDBUPerUU();
+  Rect bbox = marker->getBBox();
+  auto tech = getDesign()->getTech();
+  auto layer = tech->getLayer(marker->getLayerNum());
+  auto layerType = layer->getType();
+
+  auto con = marker->getConstraint();
+  os << "  violation type: ";
+  if (con) {
+    std::string violName;
+    if (con->typeId() == frConstraintTypeEnum::frcShortConstraint
+        && layerType == dbTechLayerType::CUT) {
+      violName = "Cut Short";
+    } else {
+      violName = con->getViolName();
+    }
+    os << violName;
+  } else {
+    os << "nullptr";
+  }
+  os << std::endl;
+  // get source(s) of violation
+  // format: type:name/identifier
+  os << "    srcs: ";
+  for (auto src : marker->getSrcs()) {
+    if (src) {
+      switch (src->typeId()) {
+        case frcNet:
+          os << "net:" << (static_cast<frNet*>(src))->getName() << " ";
+          break;
+        case frcInstTerm: {
+          frInstTerm* instTerm = (static_cast<frInstTerm*>(src));
+          os << "iterm:" << instTerm->getInst()->getName() << "/"
+             << instTerm->getTerm()->getName() << " ";
+          break;
         }
-        drcRpt << violName;
-      } else {
-        drcRpt << "nullptr";
-      }
-      drcRpt << std::endl;
-      // get source(s) of violation
-      // format: type:name/identifier
-      drcRpt << "    srcs: ";
-      for (auto src : marker->getSrcs()) {
-        if (src) {
-          switch (src->typeId()) {
-            case frcNet:
-              drcRpt << "net:" << (static_cast<frNet*>(src))->getName() << " ";
-              break;
-            case frcInstTerm: {
-              frInstTerm* instTerm = (static_cast<frInstTerm*>(src));
-              drcRpt << "iterm:" << instTerm->getInst()->getName() << "/"
-                     << instTerm->getTerm()->getName() << " ";
-              break;
-            }
-            case frcBTerm: {
-              frBTerm* bterm = (static_cast<frBTerm*>(src));
-              drcRpt << "bterm:" << bterm->getName() << " ";
-              break;
-            }
-            case frcInstBlockage: {
-              frInst* inst = (static_cast<frInstBlockage*>(src))->getInst();
-              drcRpt << "inst:" << inst->getName() << " ";
-              break;
-            }
-            case frcInst: {
-              frInst* inst = (static_cast<frInst*>(src));
-              drcRpt << "inst:" << inst->getName() << " ";
-              break;
-            }
-            case frcBlockage: {
-              drcRpt << "obstruction: ";
-              break;
-            }
-            default:
-              logger_->error(DRT,
-                             291,
-                             "Unexpected source type in marker: {}",
-                             src->typeId());
-          }
+        case frcBTerm: {
+          frBTerm* bterm = (static_cast<frBTerm*>(src));
+          os << "bterm:" << bterm->getName() << " ";
+          break;
+        }
+        case frcInstBlockage: {
+          frInst* inst = (static_cast<frInstBlockage*>(src))->getInst();
+          os << "inst:" << inst->getName() << " ";
+          break;
+        }
+        case frcInst: {
+          frInst* inst = (static_cast<frInst*>(src));
+          os << "inst:" << inst->getName() << " ";
+          break;
         }
+        case frcBlockage: {
+          os << "obstruction: ";
+          break;
+        }
+        default:
+          logger_->error(DRT,
+                         291,
+                         "Unexpected source type in marker: {}",
+                         src->typeId());
       }
-      drcRpt << "\n";
-
-      drcRpt << "    bbox = ( " << bbox.xMin() / dbu << ", "
-             << bbox.yMin() / dbu << " ) - ( " << bbox.xMax() / dbu << ", "
-             << bbox.yMax() / dbu << " ) on Layer ";
-      drcRpt << layer->getName() << "\n";
     }
-  } else {
-    std::cout << "Error: Fail to open DRC report file\n";
   }
+  os << "\n";
+
+  os << "    bbox = ( " << bbox.xMin() / dbu << ", " << bbox.yMin() / dbu
+     << " ) - ( " << bbox.xMax() / dbu << ", " << bbox.yMax() / dbu
+     << " ) on Layer ";
+  os << layer->getName() << "\n";
 }
 
 }  // namespace drt
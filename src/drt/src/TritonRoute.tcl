@@ -59,6 +59,7 @@ sta::define_cmd_args "detailed_route" {
     [-min_access_points count]
     [-save_guide_updates]
     [-repair_pdn_vias layer]
+    [-pin_access_cache_dir dir]
     [-single_step_dr]
 }
 
@@ -68,7 +69,8 @@ proc detailed_route { args } {
       -db_process_node -droute_end_iter -via_in_pin_bottom_layer \
       -via_in_pin_top_layer -or_seed -or_k -bottom_routing_layer \
       -top_routing_layer -verbose -remote_host -remote_port -shared_volume \
-      -cloud_size -min_access_points -repair_pdn_vias -drc_report_iter_step} \
+      -cloud_size -min_access_points -repair_pdn_vias -drc_report_iter_step \
+      -pin_access_cache_dir} \
     flags {-disable_via_gen -distributed -clean_patches -no_pin_access \
            -single_step_dr -save_guide_updates}
   sta::check_argc_eq0 "detailed_route" $args
@@ -86,6 +88,11 @@ proc detailed_route { args } {
   } else {
     set repair_pdn_vias ""
   }
+  if { [info exists keys(-pin_access_cache_dir)] } {
+    set pa_cache_dir $keys(-pin_access_cache_dir)
+  } else {
+    set pa_cache_dir ""
+  }
   if { [info exists keys(-output_maze)] } {
     set output_maze $keys(-output_maze)
   } else {
@@ -197,7 +204,7 @@ proc detailed_route { args } {
     $via_in_pin_bottom_layer $via_in_pin_top_layer \
     $or_seed $or_k $bottom_routing_layer $top_routing_layer $verbose \
     $clean_patches $no_pin_access $single_step_dr $min_access_points \
-    $save_guide_updates $repair_pdn_vias $drc_report_iter_step
+    $save_guide_updates $repair_pdn_vias $drc_report_iter_step $pa_cache_dir
 }
 
 proc detailed_route_num_drvs { args } {
@@ -292,6 +299,7 @@ sta::define_cmd_args "pin_access" {
     [-bottom_routing_layer layer]
     [-top_routing_layer layer]
     [-min_access_points count]
+    [-pin_access_cache_dir dir]
     [-verbose level]
     [-distributed]
     [-remote_host rhost]
@@ -302,7 +310,8 @@ sta::define_cmd_args "pin_access" {
 proc pin_access { args } {
   sta::parse_key_args "pin_access" args \
     keys {-db_process_node -bottom_routing_layer -top_routing_layer -verbose \
-          -min_access_points -remote_host -remote_port -shared_volume -cloud_size } \
+          -min_access_points -remote_host -remote_port -shared_volume -cloud_size \
+          -pin_access_cache_dir } \
     flags {-distributed}
   sta::check_argc_eq0 "detailed_route_debug" $args
   if {[info exists keys(-db_process_node)]} {
@@ -332,6 +341,11 @@ proc pin_access { args } {
   } else {
     set min_access_points -1
   }
+  if { [info exists keys(-pin_access_cache_dir)] } {
+    set pa_cache_dir $keys(-pin_access_cache_dir)
+  } else {
+    set pa_cache_dir ""
+  }
   if { [info exists flags(-distributed)] } {
     if { [info exists keys(-remote_host)] } {
       set rhost $keys(-remote_host)
@@ -356,7 +370,7 @@ proc pin_access { args } {
     drt::detailed_route_distributed $rhost $rport $vol $cloudsz
   }
   drt::pin_access_cmd $db_process_node $bottom_routing_layer \
-    $top_routing_layer $verbose $min_access_points
+    $top_routing_layer $verbose $min_access_points $pa_cache_dir
 }
 
 sta::define_cmd_args "detailed_route_run_worker" {
@@ -474,11 +488,12 @@ proc step_dr { args } {
 sta::define_cmd_args "check_drc" {
     [-box box]
     [-output_file filename]
+    [-incremental]
 };# checker off
 proc check_drc { args } {
   sta::parse_key_args "check_drc" args \
     keys { -box -output_file } \
-    flags {};# checker off
+    flags { -incremental };# checker off
   sta::check_argc_eq0 "check_drc" $args
   set box { 0 0 0 0 }
   if {[info exists keys(-box)]} {
@@ -493,7 +508,8 @@ proc check_drc { args } {
   } else {
     utl::error DRT 613 "-output_file is required for check_drc command"
   }
-  drt::check_drc_cmd $output_file $x1 $y1 $x2 $y2
+  set incremental [info exists flags(-incremental)]
+  drt::check_drc_cmd $output_file $x1 $y1 $x2 $y2 $incremental
 }
 
 }
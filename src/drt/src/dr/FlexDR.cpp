@@ -35,11 +35,14 @@
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/io/ios_state.hpp>
 #include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <fstream>
 #include <iomanip>
+#include <mutex>
 #include <numeric>
 #include <sstream>
+#include <unordered_map>
 
 #include "db/infra/frTime.h"
 #include "distributed/RoutingJobDescription.h"
@@ -200,7 +203,8 @@ void FlexDRWorker::writeUpdates(const std::string& file_name)
   file.close();
 }
 
-int FlexDRWorker::main(frDesign* design)
+int FlexDRWorker::main(frDesign* design,
+                       const std::function<void()>& initDone)
 {
   ProfileTask profile("DRW:main");
   using std::chrono::high_resolution_clock;
@@ -264,6 +268,9 @@ int FlexDRWorker::main(frDesign* design)
   if (!skipRouting_) {
     init(design);
   }
+  if (initDone) {
+    initDone();
+  }
   high_resolution_clock::time_point t1 = high_resolution_clock::now();
   if (!skipRouting_) {
     route_queue();
@@ -555,6 +562,207 @@ void FlexDR::getBatchInfo(int& batchStepX, int& batchStepY)
   batchStepY = 2;
 }
 
+// Runs the workers without checkerboard barriers.  The workers keep the
+// checkerboard order as their commit order and end() is called strictly in
+// that order.  A worker depends on every earlier worker whose extBox overlaps
+// its own and reads the design exactly when its last dependency has been
+// committed: the next commit waits until all such readers are initialized.
+// Each worker therefore sees the same design state regardless of thread
+// timing, while workers away from a slow clip keep the cores busy.
+void FlexDR::scheduleWorkers(
+    std::vector<std::vector<std::vector<std::unique_ptr<FlexDRWorker>>>>&
+        workers,
+    const std::vector<std::vector<FlexDRWorker*>>& workerGrid,
+    const std::function<void(int numMarkers)>& workerDone)
+{
+  ProfileTask profile("DR:schedule");
+  std::vector<std::unique_ptr<FlexDRWorker>> ordered;
+  for (auto& workerBatch : workers) {
+    for (auto& workersInBatch : workerBatch) {
+      for (auto& worker : workersInBatch) {
+        ordered.push_back(std::move(worker));
+      }
+    }
+  }
+  workers.clear();
+  const int numWorkers = ordered.size();
+  if (numWorkers == 0) {
+    return;
+  }
+  std::unordered_map<FlexDRWorker*, int> seqIdx;
+  for (int i = 0; i < numWorkers; i++) {
+    seqIdx[ordered[i].get()] = i;
+  }
+
+  // Workers sit on a regular grid, so the columns (rows) an extBox can reach
+  // are found from the first row (column) alone.
+  const int numCols = workerGrid.size();
+  const int numRows = workerGrid[0].size();
+  auto reach = [](int cnt,
+                  auto extLo,
+                  auto extHi,
+                  std::vector<int>& lo,
+                  std::vector<int>& hi) {
+    lo.resize(cnt);
+    hi.resize(cnt);
+    for (int i = 0; i < cnt; i++) {
+      lo[i] = i;
+      while (lo[i] > 0 && extHi(lo[i] - 1) >= extLo(i)) {
+        lo[i]--;
+      }
+      hi[i] = i;
+      while (hi[i] + 1 < cnt && extLo(hi[i] + 1) <= extHi(i)) {
+        hi[i]++;
+      }
+    }
+  };
+  std::vector<int> colLo, colHi, rowLo, rowHi;
+  reach(
+      numCols,
+      [&](int x) { return workerGrid[x][0]->getExtBox().xMin(); },
+      [&](int x) { return workerGrid[x][0]->getExtBox().xMax(); },
+      colLo,
+      colHi);
+  reach(
+      numRows,
+      [&](int y) { return workerGrid[0][y]->getExtBox().yMin(); },
+      [&](int y) { return workerGrid[0][y]->getExtBox().yMax(); },
+      rowLo,
+      rowHi);
+
+  // readIdx[i] is the commit index at which worker i reads the design.
+  std::vector<int> readIdx(numWorkers, 0);
+  for (int x = 0; x < numCols; x++) {
+    for (int y = 0; y < numRows; y++) {
+      FlexDRWorker* worker = workerGrid[x][y];
+      const int idx = seqIdx.at(worker);
+      for (int nx = colLo[x]; nx <= colHi[x]; nx++) {
+        for (int ny = rowLo[y]; ny <= rowHi[y]; ny++) {
+          FlexDRWorker* other = workerGrid[nx][ny];
+          const int otherIdx = seqIdx.at(other);
+          if (otherIdx < idx
+              && other->getExtBox().intersects(worker->getExtBox())) {
+            readIdx[idx] = std::max(readIdx[idx], otherIdx + 1);
+          }
+        }
+      }
+    }
+  }
+  std::vector<std::vector<int>> readers(numWorkers + 1);
+  for (int i = 0; i < numWorkers; i++) {
+    readers[readIdx[i]].push_back(i);
+  }
+
+  std::mutex mutex;
+  std::condition_variable cond;
+  std::deque<int> ready(readers[0].begin(), readers[0].end());
+  std::vector<int> pendingReads(numWorkers + 1);
+  for (int i = 0; i <= numWorkers; i++) {
+    pendingReads[i] = readers[i].size();
+  }
+  std::vector<char> routed(numWorkers, false);
+  int nextCommit = 0;
+  // Marker count as of the last commit; the design is only read for it by
+  // the committing thread.
+  int numMarkers = getDesign()->getTopBlock()->getNumMarkers();
+  bool committing = false;
+  bool aborted = false;
+
+  using clock = std::chrono::high_resolution_clock;
+  using seconds = std::chrono::duration<double>;
+  const auto start = clock::now();
+  double busyTime = 0;
+  int numThreads = 1;
+  ThreadException exception;
+#pragma omp parallel
+  {
+#pragma omp single
+    numThreads = omp_get_num_threads();
+    double threadBusyTime = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!aborted && nextCommit < numWorkers) {
+      if (!committing && routed[nextCommit]
+          && pendingReads[nextCommit] == 0) {
+        committing = true;
+        lock.unlock();
+        const auto t0 = clock::now();
+        bool failed = false;
+        try {
+          auto& worker = ordered[nextCommit];
+          if (worker->end(getDesign())) {
+            numWorkUnits_ += 1;
+          }
+          if (worker->isCongested()) {
+            increaseClipsize_ = true;
+          }
+          worker.reset();
+        } catch (...) {
+          exception.capture();
+          failed = true;
+        }
+        const int committedMarkers
+            = getDesign()->getTopBlock()->getNumMarkers();
+        threadBusyTime += seconds(clock::now() - t0).count();
+        lock.lock();
+        numMarkers = committedMarkers;
+        committing = false;
+        nextCommit++;
+        ready.insert(ready.end(),
+                     readers[nextCommit].begin(),
+                     readers[nextCommit].end());
+        aborted |= failed;
+        cond.notify_all();
+        continue;
+      }
+      if (!ready.empty()) {
+        const int idx = ready.front();
+        ready.pop_front();
+        lock.unlock();
+        const auto t0 = clock::now();
+        bool reading = true;
+        bool failed = false;
+        try {
+          ordered[idx]->main(getDesign(), [&]() {
+            std::lock_guard<std::mutex> guard(mutex);
+            pendingReads[readIdx[idx]]--;
+            reading = false;
+            cond.notify_all();
+          });
+        } catch (...) {
+          exception.capture();
+          failed = true;
+        }
+        threadBusyTime += seconds(clock::now() - t0).count();
+        lock.lock();
+        if (reading) {
+          pendingReads[readIdx[idx]]--;
+        }
+        routed[idx] = true;
+        workerDone(numMarkers);
+        aborted |= failed;
+        cond.notify_all();
+        continue;
+      }
+      cond.wait(lock);
+    }
+    busyTime += threadBusyTime;
+  }
+  exception.rethrow();
+
+  const double wallTime = seconds(clock::now() - start).count();
+  if (VERBOSE > 0) {
+    logger_->info(
+        DRT,
+        302,
+        "  Scheduled {} workers on {} threads in {:.2f}s, utilization "
+        "{:.1f}%.",
+        numWorkers,
+        numThreads,
+        wallTime,
+        wallTime > 0 ? 100.0 * busyTime / (wallTime * numThreads) : 0.0);
+  }
+}
+
 void FlexDR::searchRepair(const SearchRepairArgs& args)
 {
   const int iter = iter_++;
@@ -614,9 +822,11 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
 
   std::vector<std::vector<std::vector<std::unique_ptr<FlexDRWorker>>>> workers(
       batchStepX * batchStepY);
+  std::vector<std::vector<FlexDRWorker*>> workerGrid;
 
   int xIdx = 0, yIdx = 0;
   for (int i = offset; i < (int) xgp.getCount(); i += size) {
+    workerGrid.emplace_back();
     for (int j = offset; j < (int) ygp.getCount(); j += size) {
       auto worker
           = std::make_unique<FlexDRWorker>(&via_data_, design_, logger_);
@@ -667,6 +877,7 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
         workers[batchIdx].push_back(
             std::vector<std::unique_ptr<FlexDRWorker>>());
       }
+      workerGrid.back().push_back(worker.get());
       workers[batchIdx].back().push_back(std::move(worker));
 
       yIdx++;
@@ -675,10 +886,35 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
     xIdx++;
   }
 
+  // Reports progress as workers finish routing; callers serialize it and
+  // pass a marker count read while no worker is being committed.
+  auto workerDone = [&](int numMarkers) {
+    cnt++;
+    if (VERBOSE > 0) {
+      if (cnt * 1.0 / tot >= prev_perc / 100.0 + 0.1 && prev_perc < 90) {
+        if (prev_perc == 0 && t.isExceed(0)) {
+          isExceed = true;
+        }
+        prev_perc += 10;
+        if (isExceed) {
+          logger_->report("    Completing {}% with {} violations.",
+                          prev_perc,
+                          numMarkers);
+          logger_->report("    {}.", t);
+        }
+      }
+    }
+  };
+
   omp_set_num_threads(MAX_THREADS);
   int version = 0;
   increaseClipsize_ = false;
   numWorkUnits_ = 0;
+  if (!dist_on_ && !graphics_) {
+    // Workers start as soon as the workers they overlap have been written
+    // back rather than waiting for the whole checkerboard batch.
+    scheduleWorkers(workers, workerGrid, workerDone);
+  }
   // parallel execution
   for (auto& workerBatch : workers) {
     ProfileTask profile("DR:checkerboard");
@@ -711,25 +947,7 @@ void FlexDR::searchRepair(const SearchRepairArgs& args)
                 workersInBatch[i]->main(getDesign());
               }
 #pragma omp critical
-              {
-                cnt++;
-                if (VERBOSE > 0) {
-                  if (cnt * 1.0 / tot >= prev_perc / 100.0 + 0.1
-                      && prev_perc < 90) {
-                    if (prev_perc == 0 && t.isExceed(0)) {
-                      isExceed = true;
-                    }
-                    prev_perc += 10;
-                    if (isExceed) {
-                      logger_->report(
-                          "    Completing {}% with {} violations.",
-                          prev_perc,
-                          getDesign()->getTopBlock()->getNumMarkers());
-                      logger_->report("    {}.", t);
-                    }
-                  }
-                }
-              }
+              workerDone(getDesign()->getTopBlock()->getNumMarkers());
             } catch (...) {
               exception.capture();
             }
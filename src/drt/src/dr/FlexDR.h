@@ -33,6 +33,7 @@
 #include <boost/polygon/polygon.hpp>
 #include <boost/serialization/export.hpp>
 #include <deque>
+#include <functional>
 #include <memory>
 
 #include "db/drObj/drMarker.h"
@@ -163,6 +164,11 @@ class FlexDR
   void initFromTA();
   void initGCell2BoundaryPin();
   void getBatchInfo(int& batchStepX, int& batchStepY);
+  void scheduleWorkers(
+      std::vector<std::vector<std::vector<std::unique_ptr<FlexDRWorker>>>>&
+          workers,
+      const std::vector<std::vector<FlexDRWorker*>>& workerGrid,
+      const std::function<void(int numMarkers)>& workerDone);
 
   void init_halfViaEncArea();
 
@@ -387,7 +393,9 @@ class FlexDRWorker
   const FlexDRViaData* getViaData() const { return via_data_; }
   const FlexGridGraph& getGridGraph() const { return gridGraph_; }
   // others
-  int main(frDesign* design);
+  // initDone, when set, is called once the worker has read everything it
+  // needs from the design and only worker-local state is touched afterwards.
+  int main(frDesign* design, const std::function<void()>& initDone = nullptr);
   void distributedMain(frDesign* design);
   void writeUpdates(const std::string& file_name);
   void updateDesign(frDesign* design);
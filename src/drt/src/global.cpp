@@ -53,7 +53,6 @@ double OR_K = 0;
 std::string DBPROCESSNODE;
 int MAX_THREADS = 1;
 int BATCHSIZE = 1024;
-int BATCHSIZETA = 8;
 int MTSAFEDIST = 2000;
 int DRCSAFEDIST = 500;
 int VERBOSE = 1;
@@ -111,6 +110,7 @@ float SHAPEBLOATWIDTH = 3;
 int CONGCOST = 8;
 int HISTCOST = 32;
 std::string REPAIR_PDN_LAYER_NAME;
+std::string PA_CACHE_DIR;
 frLayerNum REPAIR_PDN_LAYER_NUM = -1;
 frLayerNum GC_IGNORE_PDN_LAYER_NUM = -1;
 
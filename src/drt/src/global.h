@@ -56,7 +56,6 @@ extern double OR_K;
 
 extern int MAX_THREADS;
 extern int BATCHSIZE;
-extern int BATCHSIZETA;
 extern int MTSAFEDIST;
 extern int DRCSAFEDIST;
 extern int VERBOSE;
@@ -116,6 +115,8 @@ extern int HISTCOST;
 extern int CONGCOST;
 
 extern std::string REPAIR_PDN_LAYER_NAME;
+// directory of the persistent pin access cache; empty disables it
+extern std::string PA_CACHE_DIR;
 extern frLayerNum REPAIR_PDN_LAYER_NUM;
 extern frLayerNum GC_IGNORE_PDN_LAYER_NUM;
 
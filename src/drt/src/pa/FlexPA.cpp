@@ -109,6 +109,7 @@ void FlexPA::applyPatternsFile(const char* file_path)
 void FlexPA::prep()
 {
   ProfileTask profile("PA:prep");
+  loadPACache();
   prepPoint();
   revertAccessPoints();
   if (isDistributed()) {
@@ -71,6 +71,9 @@ class FlexPA
 
   void setDebug(frDebugSettings* settings, odb::dbDatabase* db);
   void setTargetInstances(const frCollection<odb::dbInst*>& insts);
+  // The technology the design was read from, used to key the pin access
+  // cache
+  void setDbTech(odb::dbTech* tech) { db_tech_ = tech; }
   void setDistributed(const std::string& rhost,
                       uint16_t rport,
                       const std::string& shared_vol,
@@ -82,6 +85,7 @@ class FlexPA
   frDesign* design_;
   Logger* logger_;
   dst::Distributed* dist_;
+  odb::dbTech* db_tech_ = nullptr;
 
   std::unique_ptr<FlexPAGraphics> graphics_;
   std::string debugPinName_;
@@ -97,6 +101,10 @@ class FlexPA
   int macroCellPinNoApCnt_ = 0;
   std::vector<std::vector<std::unique_ptr<FlexPinAccessPattern>>>
       uniqueInstPatterns_;
+  // persistent cache: key per unique instance (empty if not cacheable) and
+  // whether its access points and patterns were loaded from the cache
+  std::vector<std::string> paCacheKeys_;
+  std::vector<bool> paCached_;
 
   UniqueInsts unique_insts_;
   using UniqueMTerm = std::pair<const UniqueInsts::InstSet*, frMTerm*>;
@@ -361,6 +369,15 @@ class FlexPA
                   const std::vector<FlexDPNode>& nodes,
                   const std::vector<frInst*>& insts);
   void revertAccessPoints();
+  // cache
+  bool isPACached(int uniqueIdx) const;
+  void loadPACache();
+  bool loadPACache_inst(frInst* inst, int uniqueIdx);
+  void savePACache();
+  bool savePACache_inst(frInst* inst, int uniqueIdx);
+  std::string getPACacheSignature() const;
+  std::string getPACacheKey(frInst* inst, const std::string& signature);
+  std::string getPACachePath(int uniqueIdx) const;
   void addAccessPatternObj(
       frInst* inst,
       FlexPinAccessPattern* accessPattern,
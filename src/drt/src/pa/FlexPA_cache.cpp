@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) 2024, The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the University nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE REGENTS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <sstream>
+
+#include "FlexPA.h"
+#include "distributed/frArchive.h"
+#include "frProfileTask.h"
+#include "serialization.h"
+
+namespace drt {
+
+// The on-disk cache stores, for each cacheable unique instance, the access
+// points of its pins (relative to the instance origin) and its access
+// patterns.  An entry is only reused if its key matches exactly; the key
+// covers everything that pin access generation depends on.  Bump the version
+// whenever the generation or the file layout changes.
+static constexpr int kPACacheVersion = 2;
+
+static bool isPACacheableMaster(frMaster* master)
+{
+  const dbMasterType masterType = master->getMasterType();
+  return masterType == dbMasterType::CORE
+         || masterType == dbMasterType::CORE_TIEHIGH
+         || masterType == dbMasterType::CORE_TIELOW
+         || masterType == dbMasterType::CORE_ANTENNACELL;
+}
+
+static void writeRect(std::ostream& os, const Rect& box)
+{
+  os << box.xMin() << ',' << box.yMin() << ',' << box.xMax() << ','
+     << box.yMax();
+}
+
+// Writes the layer and full geometry of a shape: all the points of a
+// polygon, and the box of anything else
+static void writeFig(std::ostream& os, const frFig* fig)
+{
+  os << static_cast<const frShape*>(fig)->getLayerNum() << ' ';
+  if (fig->typeId() == frcPolygon) {
+    for (const Point& pt : static_cast<const frPolygon*>(fig)->getPoints()) {
+      os << pt.x() << ',' << pt.y() << ' ';
+    }
+  } else {
+    writeRect(os, fig->getBBox());
+  }
+}
+
+bool FlexPA::isPACached(const int uniqueIdx) const
+{
+  return uniqueIdx < (int) paCached_.size() && paCached_[uniqueIdx];
+}
+
+std::string FlexPA::getPACacheSignature() const
+{
+  std::ostringstream ss;
+  ss << "version " << kPACacheVersion << '\n';
+
+  // All the rules that the access points are checked against (spacing
+  // tables, end of line, min step, cut spacing, ...) come from the db
+  // technology, so its full serialized form is part of the key.
+  if (db_tech_ != nullptr) {
+    std::ostringstream tech_stream;
+    db_tech_->write(tech_stream);
+    const std::string tech_bytes = tech_stream.str();
+    ss << "dbtech " << tech_bytes.size() << ' ' << std::hex
+       << std::hash<std::string>{}(tech_bytes) << std::dec << '\n';
+  }
+
+  const frTechObject* tech = getTech();
+  ss << "tech " << tech->getDBUPerUU() << ' ' << tech->getManufacturingGrid()
+     << '\n';
+  for (const auto& layer : tech->getLayers()) {
+    ss << "layer " << layer->getName() << ' ' << layer->getType().getString()
+       << ' ' << layer->getDir().getString() << ' ' << layer->getWidth() << ' '
+       << layer->getMinWidth() << ' ' << layer->getPitch();
+    if (layer->getType() == dbTechLayerType::ROUTING) {
+      ss << ' ' << layer->getWrongDirWidth();
+    }
+    ss << '\n';
+  }
+  // via defs are serialized by id so the id assignment must match too.
+  // They include the generated and design vias, which are not in the db
+  // technology.
+  for (const auto& viaDef : tech->getVias()) {
+    ss << "via " << viaDef->getName() << ' ' << viaDef->getNumCut() << ' '
+       << viaDef->getCutClassIdx() << ' ' << viaDef->getDefault() << ' '
+       << viaDef->isAddedByRouter() << '\n';
+    for (const auto* figs : {&viaDef->getLayer1Figs(),
+                             &viaDef->getCutFigs(),
+                             &viaDef->getLayer2Figs()}) {
+      for (const auto& fig : *figs) {
+        ss << "viafig ";
+        writeFig(ss, fig.get());
+        ss << '\n';
+      }
+    }
+  }
+
+  for (const auto& tp : getDesign()->getTopBlock()->getTrackPatterns()) {
+    ss << "tracks " << tp->getLayerNum() << ' ' << tp->isHorizontal() << ' '
+       << tp->getStartCoord() << ' ' << tp->getTrackSpacing() << '\n';
+  }
+
+  ss << "settings " << MINNUMACCESSPOINT_STDCELLPIN << ' '
+     << MINNUMACCESSPOINT_MACROCELLPIN << ' ' << BOTTOM_ROUTING_LAYER << ' '
+     << TOP_ROUTING_LAYER << ' ' << VIA_ACCESS_LAYERNUM << ' '
+     << VIAINPIN_BOTTOMLAYERNUM << ' ' << VIAINPIN_TOPLAYERNUM << ' '
+     << ENABLE_VIA_GEN << ' ' << USENONPREFTRACKS << '\n';
+  return ss.str();
+}
+
+std::string FlexPA::getPACacheKey(frInst* inst, const std::string& signature)
+{
+  frMaster* master = inst->getMaster();
+  const std::vector<frCoord>* offsets = unique_insts_.getTrackOffsets(inst);
+  if (!isPACacheableMaster(master) || offsets == nullptr) {
+    return "";
+  }
+
+  std::ostringstream ss;
+  ss << signature;
+  ss << "master " << master->getName() << ' '
+     << inst->getOrient().getString() << ' ';
+  writeRect(ss, master->getDieBox());
+  ss << '\n';
+  for (const auto& term : master->getTerms()) {
+    ss << "term " << term->getName() << '\n';
+    for (const auto& pin : term->getPins()) {
+      for (const auto& fig : pin->getFigs()) {
+        ss << "fig ";
+        writeFig(ss, fig.get());
+        ss << '\n';
+      }
+    }
+  }
+  for (const auto& blockage : master->getBlockages()) {
+    for (const auto& fig : blockage->getPin()->getFigs()) {
+      ss << "obs ";
+      writeFig(ss, fig.get());
+      ss << '\n';
+    }
+  }
+
+  ss << "offsets";
+  for (const frCoord offset : *offsets) {
+    ss << ' ' << offset;
+  }
+  ss << "\nskip ";
+  for (auto& instTerm : inst->getInstTerms()) {
+    ss << (isSkipInstTerm(instTerm.get()) ? '1' : '0');
+  }
+  ss << '\n';
+  return ss.str();
+}
+
+std::string FlexPA::getPACachePath(const int uniqueIdx) const
+{
+  const size_t hash = std::hash<std::string>{}(paCacheKeys_[uniqueIdx]);
+  return fmt::format("{}/{:016x}.pa", PA_CACHE_DIR, hash);
+}
+
+void FlexPA::loadPACache()
+{
+  const auto& unique = unique_insts_.getUnique();
+  uniqueInstPatterns_.clear();
+  uniqueInstPatterns_.resize(unique.size());
+  paCacheKeys_.assign(unique.size(), "");
+  paCached_.assign(unique.size(), false);
+  if (PA_CACHE_DIR.empty() || isDistributed()) {
+    return;
+  }
+
+  ProfileTask profile("PA:loadCache");
+  const std::string signature = getPACacheSignature();
+  int numCached = 0;
+  int numCacheable = 0;
+  for (int i = 0; i < (int) unique.size(); i++) {
+    paCacheKeys_[i] = getPACacheKey(unique[i], signature);
+    if (paCacheKeys_[i].empty()) {
+      continue;
+    }
+    numCacheable++;
+    if (loadPACache_inst(unique[i], i)) {
+      paCached_[i] = true;
+      numCached++;
+    }
+  }
+
+  if (VERBOSE > 0) {
+    logger_->info(DRT,
+                  618,
+                  "Loaded pin access for {} of {} unique instances from {}.",
+                  numCached,
+                  numCacheable,
+                  PA_CACHE_DIR);
+  }
+}
+
+bool FlexPA::loadPACache_inst(frInst* inst, const int uniqueIdx)
+{
+  std::ifstream file(getPACachePath(uniqueIdx), std::ios::binary);
+  if (!file) {
+    return false;
+  }
+
+  const int paIdx = unique_insts_.getPAIndex(inst);
+  std::vector<frMPin*> pins;
+  for (auto& instTerm : inst->getInstTerms()) {
+    for (auto& pin : instTerm->getTerm()->getPins()) {
+      pins.push_back(pin.get());
+    }
+  }
+
+  std::vector<std::vector<std::unique_ptr<frAccessPoint>>> aps(pins.size());
+  std::vector<std::unique_ptr<FlexPinAccessPattern>> patterns;
+  try {
+    frIArchive ar(file);
+    ar.setDesign(design_);
+    registerTypes(ar);
+    std::string key;
+    ar >> key;
+    int numPins = 0;
+    ar >> numPins;
+    // a hash collision or an entry from a different design
+    if (key != paCacheKeys_[uniqueIdx] || numPins != (int) pins.size()) {
+      return false;
+    }
+    for (auto& pinAPs : aps) {
+      int numAPs = 0;
+      ar >> numAPs;
+      while (numAPs--) {
+        auto ap = std::make_unique<frAccessPoint>();
+        ar >> *ap;
+        pinAPs.push_back(std::move(ap));
+      }
+    }
+
+    // access points are referenced by (pin ordinal, access point index)
+    auto getAP = [&aps](const int pinIdx, const int apIdx) -> frAccessPoint* {
+      if (pinIdx < 0 || pinIdx >= (int) aps.size() || apIdx < 0
+          || apIdx >= (int) aps[pinIdx].size()) {
+        return nullptr;
+      }
+      return aps[pinIdx][apIdx].get();
+    };
+    int numPatterns = 0;
+    ar >> numPatterns;
+    while (numPatterns--) {
+      auto pattern = std::make_unique<FlexPinAccessPattern>();
+      int numEntries = 0;
+      ar >> numEntries;
+      while (numEntries--) {
+        int pinIdx = 0;
+        int apIdx = 0;
+        ar >> pinIdx >> apIdx;
+        pattern->addAccessPoint(getAP(pinIdx, apIdx));
+      }
+      for (const bool isLeft : {true, false}) {
+        int pinIdx = 0;
+        int apIdx = 0;
+        ar >> pinIdx >> apIdx;
+        pattern->setBoundaryAP(isLeft, getAP(pinIdx, apIdx));
+      }
+      pattern->updateCost();
+      patterns.push_back(std::move(pattern));
+    }
+  } catch (const std::exception&) {
+    // truncated or stale entry; regenerate it
+    return false;
+  }
+
+  for (int i = 0; i < (int) pins.size(); i++) {
+    frPinAccess* pinAccess = pins[i]->getPinAccess(paIdx);
+    for (auto& ap : aps[i]) {
+      pinAccess->addAccessPoint(std::move(ap));
+    }
+  }
+  uniqueInstPatterns_[uniqueIdx] = std::move(patterns);
+  return true;
+}
+
+void FlexPA::savePACache()
+{
+  if (PA_CACHE_DIR.empty() || isDistributed()) {
+    return;
+  }
+
+  ProfileTask profile("PA:saveCache");
+  std::error_code ec;
+  std::filesystem::create_directories(PA_CACHE_DIR, ec);
+  if (ec) {
+    logger_->warn(DRT,
+                  619,
+                  "Unable to create the pin access cache directory {}: {}.",
+                  PA_CACHE_DIR,
+                  ec.message());
+    return;
+  }
+
+  const auto& unique = unique_insts_.getUnique();
+  for (int i = 0; i < (int) unique.size(); i++) {
+    if (paCacheKeys_[i].empty() || paCached_[i]) {
+      continue;
+    }
+    if (!savePACache_inst(unique[i], i)) {
+      logger_->warn(DRT,
+                    620,
+                    "Unable to write the pin access cache entry for {}.",
+                    unique[i]->getMaster()->getName());
+    }
+  }
+}
+
+bool FlexPA::savePACache_inst(frInst* inst, const int uniqueIdx)
+{
+  const int paIdx = unique_insts_.getPAIndex(inst);
+  std::vector<frMPin*> pins;
+  std::map<frAccessPoint*, std::pair<int, int>> ap2Idx;
+  for (auto& instTerm : inst->getInstTerms()) {
+    for (auto& pin : instTerm->getTerm()->getPins()) {
+      const int pinIdx = pins.size();
+      pins.push_back(pin.get());
+      const auto& aps = pin->getPinAccess(paIdx)->getAccessPoints();
+      for (int apIdx = 0; apIdx < (int) aps.size(); apIdx++) {
+        ap2Idx[aps[apIdx].get()] = {pinIdx, apIdx};
+      }
+    }
+  }
+  auto getIdx = [&ap2Idx](frAccessPoint* ap) {
+    auto it = ap2Idx.find(ap);
+    return it == ap2Idx.end() ? std::make_pair(-1, -1) : it->second;
+  };
+
+  // write to a temporary file and rename it into place so that concurrent
+  // runs sharing the directory never observe a partial entry
+  const std::string path = getPACachePath(uniqueIdx);
+  const std::string tmpPath = fmt::format("{}.{}.tmp", path, getpid());
+  {
+    std::ofstream file(tmpPath, std::ios::binary);
+    if (!file) {
+      return false;
+    }
+    frOArchive ar(file);
+    registerTypes(ar);
+    ar << paCacheKeys_[uniqueIdx];
+    const int numPins = pins.size();
+    ar << numPins;
+    for (frMPin* pin : pins) {
+      const auto& aps = pin->getPinAccess(paIdx)->getAccessPoints();
+      const int numAPs = aps.size();
+      ar << numAPs;
+      for (const auto& ap : aps) {
+        ar << *ap;
+      }
+    }
+    const auto& patterns = uniqueInstPatterns_[uniqueIdx];
+    const int numPatterns = patterns.size();
+    ar << numPatterns;
+    for (const auto& pattern : patterns) {
+      const int numEntries = pattern->getPattern().size();
+      ar << numEntries;
+      for (frAccessPoint* ap : pattern->getPattern()) {
+        const auto [pinIdx, apIdx] = getIdx(ap);
+        ar << pinIdx << apIdx;
+      }
+      for (const bool isLeft : {true, false}) {
+        const auto [pinIdx, apIdx] = getIdx(pattern->getBoundaryAP(isLeft));
+        ar << pinIdx << apIdx;
+      }
+    }
+    file.flush();
+    if (!file) {
+      std::filesystem::remove(tmpPath);
+      return false;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmpPath, path, ec);
+  if (ec) {
+    std::filesystem::remove(tmpPath, ec);
+    return false;
+  }
+  return true;
+}
+
+}  // namespace drt
@@ -1539,6 +1539,9 @@ void FlexPA::prepPoint()
   for (int i = 0; i < (int) unique.size(); i++) {  // NOLINT
     try {
       auto& inst = unique[i];
+      if (isPACached(i)) {
+        continue;
+      }
       // only do for core and block cells
       dbMasterType masterType = inst->getMaster()->getMasterType();
       if (masterType != dbMasterType::CORE
@@ -1755,6 +1758,9 @@ void FlexPA::prepPattern()
        currUniqueInstIdx++) {
     try {
       auto& inst = unique[currUniqueInstIdx];
+      if (isPACached(currUniqueInstIdx)) {
+        continue;
+      }
       // only do for core and block cells
       // TODO the above comment says "block cells" but that's not what the code
       // does?
@@ -1806,6 +1812,7 @@ void FlexPA::prepPattern()
   if (VERBOSE > 0) {
     logger_->info(DRT, 81, "  Complete {} unique inst patterns.", cnt);
   }
+  savePACache();
   if (isDistributed()) {
     dst::JobMessage msg(dst::JobMessage::PIN_ACCESS,
                         dst::JobMessage::BROADCAST),
@@ -1867,7 +1874,12 @@ void FlexPA::prepPattern()
 void FlexPA::revertAccessPoints()
 {
   const auto& unique = unique_insts_.getUnique();
-  for (auto& inst : unique) {
+  for (int i = 0; i < (int) unique.size(); i++) {
+    // cached access points are already relative to the origin
+    if (isPACached(i)) {
+      continue;
+    }
+    auto& inst = unique[i];
     const dbTransform xform = inst->getTransform();
     const Point offset(xform.getOffset());
     dbTransform revertXform;
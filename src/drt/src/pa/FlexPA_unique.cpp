@@ -180,6 +180,7 @@ void UniqueInsts::computeUnique(
       for (auto& [vec, insts] : offsetMap) {
         auto uniqueInst = *(insts.begin());
         unique_.push_back(uniqueInst);
+        unique2TrackOffsets_[uniqueInst] = &vec;
         for (auto i : insts) {
           inst2unique_[i] = uniqueInst;
           inst2Class_[i] = &insts;
@@ -291,6 +292,15 @@ std::set<frInst*, frBlockObjectComp>* UniqueInsts::getClass(frInst* inst) const
   return inst2Class_.at(inst);
 }
 
+const std::vector<frCoord>* UniqueInsts::getTrackOffsets(frInst* unique) const
+{
+  auto it = unique2TrackOffsets_.find(unique);
+  if (it == unique2TrackOffsets_.end()) {
+    return nullptr;
+  }
+  return it->second;
+}
+
 bool UniqueInsts::hasUnique(frInst* inst) const
 {
   return inst2unique_.find(inst) != inst2unique_.end();
@@ -60,6 +60,9 @@ class UniqueInsts
 
   // Gets the instances in the equivalence set of the given inst
   InstSet* getClass(frInst* inst) const;
+  // Gets the track offsets that define the unique instance's class or
+  // nullptr if it is not part of a class (eg NDR instances)
+  const std::vector<frCoord>* getTrackOffsets(frInst* unique) const;
 
   const std::vector<frInst*>& getUnique() const;
   frInst* getUnique(int idx) const;
@@ -103,6 +106,9 @@ class UniqueInsts
   std::map<frInst*, int, frBlockObjectComp> unique2paidx_;
   // Maps a unique instance to its index in unique_
   std::map<frInst*, int, frBlockObjectComp> unique2Idx_;
+  // Maps a unique instance to the track offsets of its class
+  std::map<frInst*, const std::vector<frCoord>*, frBlockObjectComp>
+      unique2TrackOffsets_;
   // master orient track-offset to instances
   std::map<frMaster*,
            std::map<dbOrientType, std::map<std::vector<frCoord>, InstSet>>,
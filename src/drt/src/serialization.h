@@ -771,7 +771,6 @@ void serializeGlobals(Archive& ar)
   (ar) & OR_K;
   (ar) & MAX_THREADS;
   (ar) & BATCHSIZE;
-  (ar) & BATCHSIZETA;
   (ar) & MTSAFEDIST;
   (ar) & DRCSAFEDIST;
   (ar) & VERBOSE;
@@ -31,7 +31,9 @@
 #include <omp.h>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <functional>
 #include <iostream>
 #include <sstream>
 
@@ -119,7 +121,7 @@ int FlexTA::initTA_helper(int iter,
   auto& ygp = gCellPatterns.at(1);
   int sol = 0;
   numPanels = 0;
-  std::vector<std::vector<std::unique_ptr<FlexTAWorker>>> workers;
+  std::vector<std::unique_ptr<FlexTAWorker>> workers;
   if (isH) {
     for (int i = offset; i < (int) ygp.getCount(); i += size) {
       auto uworker
@@ -137,10 +139,7 @@ int FlexTA::initTA_helper(int iter,
       worker.setExtBox(extBox);
       worker.setDir(dbTechLayerDir::HORIZONTAL);
       worker.setTAIter(iter);
-      if (workers.empty() || (int) workers.back().size() >= BATCHSIZETA) {
-        workers.emplace_back(std::vector<std::unique_ptr<FlexTAWorker>>());
-      }
-      workers.back().emplace_back(std::move(uworker));
+      workers.push_back(std::move(uworker));
     }
   } else {
     for (int i = offset; i < (int) xgp.getCount(); i += size) {
@@ -159,38 +158,99 @@ int FlexTA::initTA_helper(int iter,
       worker.setExtBox(extBox);
       worker.setDir(dbTechLayerDir::VERTICAL);
       worker.setTAIter(iter);
-      if (workers.empty() || (int) workers.back().size() >= BATCHSIZETA) {
-        workers.emplace_back(std::vector<std::unique_ptr<FlexTAWorker>>());
+      workers.push_back(std::move(uworker));
+    }
+  }
+
+  // Panels are assigned as if in batches of panel_batch_size: a panel sees
+  // the guides written back by the batches before its own but not those of
+  // its own batch.  Only panels whose extBoxes overlap can see each other,
+  // so each panel waits on just those rather than on a barrier per batch,
+  // and the result matches the batched order for any thread count.
+  //
+  // Each panel has two steps, assign (main_mt) and write back (end).  For
+  // overlapping panels j < i:
+  //  - in the same batch both are assigned before either is written back,
+  //    and they are written back in panel order;
+  //  - otherwise j is written back before i is assigned.
+  const int panel_batch_size = 8;
+  const int numWorkers = workers.size();
+  const int numSteps = 2 * numWorkers;
+  auto assignStep = [](int i) { return 2 * i; };
+  auto endStep = [](int i) { return 2 * i + 1; };
+  std::vector<std::vector<int>> successors(numSteps);
+  std::vector<std::atomic<int>> pending(numSteps);
+  for (int step = 0; step < numSteps; step++) {
+    pending[step] = 0;
+  }
+  auto addEdge = [&](int from, int to) {
+    successors[from].push_back(to);
+    pending[to]++;
+  };
+  for (int i = 0; i < numWorkers; i++) {
+    addEdge(assignStep(i), endStep(i));
+    // Panels are ordered along the track direction so the ones overlapping
+    // panel i come right before it.
+    for (int j = i - 1;
+         j >= 0
+         && workers[j]->getExtBox().intersects(workers[i]->getExtBox());
+         j--) {
+      if (j / panel_batch_size == i / panel_batch_size) {
+        addEdge(assignStep(j), endStep(i));
+        addEdge(assignStep(i), endStep(j));
+        addEdge(endStep(j), endStep(i));
+      } else {
+        addEdge(endStep(j), assignStep(i));
       }
-      workers.back().push_back(std::move(uworker));
     }
   }
 
-  omp_set_num_threads(std::min(8, MAX_THREADS));
-  // parallel execution
-  // multi thread
-  for (auto& workerBatch : workers) {
-    ProfileTask profile("TA:batch");
-    utl::ThreadException exception;
-#pragma omp parallel for schedule(dynamic)
-    for (int i = 0; i < (int) workerBatch.size(); i++) {
-      try {
-        workerBatch[i]->main_mt();
+  ProfileTask profile("TA:panels");
+  utl::ThreadException exception;
+  std::atomic<bool> aborted = false;
+  std::function<void(int)> run = [&](int step) {
+    if (aborted) {
+      return;
+    }
+    const int i = step / 2;
+    try {
+      if (step == assignStep(i)) {
+        workers[i]->main_mt();
+      } else {
+        if (save_updates_) {
 #pragma omp critical
-        {
-          sol += workerBatch[i]->getNumAssigned();
-          numPanels++;
+          workers[i]->end();
+        } else {
+          workers[i]->end();
         }
-      } catch (...) {
-        exception.capture();
+#pragma omp atomic
+        sol += workers[i]->getNumAssigned();
+#pragma omp atomic
+        numPanels++;
+        workers[i].reset();
+      }
+    } catch (...) {
+      exception.capture();
+      aborted = true;
+      return;
+    }
+    for (int succ : successors[step]) {
+      if (--pending[succ] == 0) {
+#pragma omp task
+        run(succ);
       }
     }
-    exception.rethrow();
-    for (auto& worker : workerBatch) {
-      worker->end();
+  };
+  omp_set_num_threads(MAX_THREADS);
+#pragma omp parallel
+#pragma omp single
+  for (int step = 0; step < numSteps; step++) {
+    if (pending[step] == 0) {
+#pragma omp task
+      run(step);
     }
-    workerBatch.clear();
   }
+  exception.rethrow();
   return sol;
 }
 
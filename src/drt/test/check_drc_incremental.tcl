@@ -0,0 +1,49 @@
+# check_drc -incremental after a wire edit matches a full check_drc,
+# including the tiles the wire was moved away from.
+source "helpers.tcl"
+
+read_lef Nangate45/Nangate45_tech.lef
+read_lef Nangate45/Nangate45_stdcell.lef
+read_def drc_test.def
+
+proc read_report { file_name } {
+  set stream [open $file_name r]
+  set report [read $stream]
+  close $stream
+  return $report
+}
+
+set before_file [make_result_file check_drc_incremental_before.drc]
+set incr_file [make_result_file check_drc_incremental.drc]
+set full_file [make_result_file check_drc_incremental_full.drc]
+
+drt::check_drc -output_file $before_file
+
+# Replace the routing of a net that has a short with a segment far from
+# its old shapes.
+set block [ord::get_db_block]
+set tech [ord::get_db_tech]
+set wire [[$block findNet _188_] getWire]
+set encoder [odb::dbWireEncoder]
+$encoder begin $wire
+$encoder newPath [$tech findLayer metal2] "ROUTED"
+$encoder addPoint 20000 20000
+$encoder addPoint 24000 20000
+$encoder end
+
+drt::check_drc -output_file $incr_file -incremental
+drt::check_drc -output_file $full_file
+
+set before [read_report $before_file]
+set incr [read_report $incr_file]
+set full [read_report $full_file]
+
+if { $incr ne $full } {
+  puts "fail: incremental report differs from the full report"
+} elseif { $incr eq $before } {
+  puts "fail: the wire edit did not change the report"
+} elseif { [string first "( 40.53, 44.1 )" $incr] != -1 } {
+  puts "fail: the short of the moved wire is still reported"
+} else {
+  puts "pass"
+}
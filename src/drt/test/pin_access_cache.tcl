@@ -0,0 +1,74 @@
+# pin_access with -pin_access_cache_dir gives the same access points from
+# a cold and a warm cache, and misses the cache after a rule changes.
+source "helpers.tcl"
+
+read_lef Nangate45/Nangate45_tech.lef
+read_lef Nangate45/Nangate45_stdcell.lef
+read_def gcd_nangate45_preroute.def
+
+set cache_dir [make_result_file pin_access_cache]
+file delete -force $cache_dir
+
+proc write_access_points { file_name } {
+  set stream [open $file_name w]
+  foreach inst [[ord::get_db_block] getInsts] {
+    foreach iterm [$inst getITerms] {
+      foreach ap [$iterm getPrefAccessPoints] {
+        set pt [$ap getPoint]
+        puts $stream "[$inst getName] [[$iterm getMTerm] getName]\
+          [$pt x] [$pt y] [[$ap getLayer] getName]"
+      }
+    }
+  }
+  close $stream
+}
+
+# Cache entries with their modification times
+proc cache_entries { cache_dir } {
+  set entries {}
+  foreach file [lsort [glob -nocomplain -directory $cache_dir *.pa]] {
+    lappend entries [file tail $file] [file mtime $file]
+  }
+  return $entries
+}
+
+set failed 0
+
+pin_access -pin_access_cache_dir $cache_dir
+set cold_file [make_result_file pin_access_cache_cold.txt]
+write_access_points $cold_file
+set cold_entries [cache_entries $cache_dir]
+if { [llength $cold_entries] == 0 } {
+  puts "fail - no cache entries written"
+  exit 1
+}
+
+# Make sure a rewritten entry would get a new mtime
+after 1100
+pin_access -pin_access_cache_dir $cache_dir
+set warm_file [make_result_file pin_access_cache_warm.txt]
+write_access_points $warm_file
+if { [diff_files $cold_file $warm_file] != 0 } {
+  set failed 1
+}
+if { [cache_entries $cache_dir] != $cold_entries } {
+  puts "Cache entries changed on a warm run."
+  set failed 1
+}
+
+# Any rule change makes new keys, so every entry is regenerated
+set metal1 [[ord::get_db_tech] findLayer metal1]
+$metal1 setMinStep [expr [$metal1 getMinStep] + 10]
+pin_access -pin_access_cache_dir $cache_dir
+set changed_entries [cache_entries $cache_dir]
+if { [llength $changed_entries] != 2 * [llength $cold_entries] } {
+  puts "Cache was not missed after a rule change."
+  set failed 1
+}
+
+if { $failed } {
+  puts "fail"
+  exit 1
+}
+puts "pass"
+exit
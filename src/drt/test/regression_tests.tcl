@@ -15,4 +15,6 @@ record_tests {
 }
 record_pass_fail_tests {
   gc_test
+  pin_access_cache
+  check_drc_incremental
 }
@@ -50,14 +50,18 @@ class Finale
  public:
   void init(odb::dbDatabase* db, Logger* logger);
 
-  void densityFill(const char* rules_filename, const odb::Rect& fill_area);
+  void densityFill(const char* rules_filename,
+                   const odb::Rect& fill_area,
+                   int tile_size = 0);
 
   void setDebug();
+  void setThreadCount(int threads);
 
  private:
   odb::dbDatabase* db_ = nullptr;
   Logger* logger_ = nullptr;
   bool debug_ = false;
+  int num_threads_ = 1;
 };
 
 }  // namespace fin
@@ -69,6 +69,23 @@ struct DensityFillLayerConfig
   DensityFillShapesConfig non_opc;
 };
 
+// A fill shape generated for a tile.  Fills are inserted into the db
+// only after all tiles of a layer are done.
+struct DensityFillShape
+{
+  Rectangle rect;
+  int mask;
+};
+
+// The fills generated for one tile of a layer
+struct DensityFillTile
+{
+  std::vector<DensityFillShape> non_opc;
+  std::vector<DensityFillShape> opc;
+  int num_non_opc_areas = 0;
+  int num_opc_areas = 0;
+};
+
 // Make a boost polygon representing a rectangle
 static Polygon90 makeRect(int x_lo, int y_lo, int x_hi, int y_hi)
 {
@@ -203,10 +220,10 @@ void DensityFill::loadConfig(const char* cfg_filename, dbTech* tech)
   readAndExpandLayers(tech, tree);
 }
 
-// Insert into polygon_set any part of given shape on the given layer (shape may
+// Insert into rects any part of given shape on the given layer (shape may
 // be a via)
 static void insertShape(const dbShape& shape,
-                        Polygon90Set& polygon_set,
+                        std::vector<Rectangle>& rects,
                         dbTechLayer* layer)
 {
   auto type = shape.getType();
@@ -232,34 +249,34 @@ static void insertShape(const dbShape& shape,
       dbShape::getViaBoxes(shape, boxes);
       for (auto& box : boxes) {
         if (box.getTechLayer() == layer) {
-          polygon_set.insert(
-              makeRect(box.xMin(), box.yMin(), box.xMax(), box.yMax()));
+          rects.emplace_back(box.xMin(), box.yMin(), box.xMax(), box.yMax());
         }
       }
       break;
     }
     case dbShape::SEGMENT:
       if (shape.getTechLayer() == layer) {
-        polygon_set.insert(
-            makeRect(shape.xMin(), shape.yMin(), shape.xMax(), shape.yMax()));
+        rects.emplace_back(
+            shape.xMin(), shape.yMin(), shape.xMax(), shape.yMax());
       }
       break;
     case dbShape::TECH_VIA_BOX:
     case dbShape::VIA_BOX:
       if (shape.getTechLayer() == layer) {
-        polygon_set.insert(
-            makeRect(shape.xMin(), shape.yMin(), shape.xMax(), shape.yMax()));
+        rects.emplace_back(
+            shape.xMin(), shape.yMin(), shape.xMax(), shape.yMax());
       }
       break;
   }
 }
 
-// Build a polygon set out of all the non-fill shape on the given layer
-// including wires, special wires, and instances' pins & OBS
-static Polygon90Set orNonFills(dbBlock* block, dbTechLayer* layer)
+// Collect all the non-fill shapes on the given layer including wires,
+// special wires, and instances' pins & OBS.  They are kept as rectangles
+// and only merged per tile to bound the memory of the polygon operations.
+static std::vector<Rectangle> getNonFills(dbBlock* block, dbTechLayer* layer)
 {
-  Polygon90Set non_fill;  // The result
-  dbShape shape;          // Shared temp
+  std::vector<Rectangle> non_fill;  // The result
+  dbShape shape;                    // Shared temp
 
   // Get shapes from regular wires
   dbWireShapeItr shapes;
@@ -287,8 +304,8 @@ static Polygon90Set orNonFills(dbBlock* block, dbTechLayer* layer)
             insertShape(via_shape, non_fill, layer);
           }
         } else if (sbox->getTechLayer() == layer) {
-          non_fill.insert(
-              makeRect(sbox->xMin(), sbox->yMin(), sbox->xMax(), sbox->yMax()));
+          non_fill.emplace_back(
+              sbox->xMin(), sbox->yMin(), sbox->xMax(), sbox->yMax());
         }
       }
     }
@@ -342,15 +359,15 @@ static void prune(Polygon90Set& fill_area,
 }
 
 // Fill a polygon (area) on the given layer using the given configuration.
-// Num_masks is used to color the generated fills.
+// Num_masks is used to color the generated fills, which are appended to
+// fill_shapes.
 // filled_area, if given, is an OR of the generated fills without bloating
 static void fillPolygon(const Polygon90& area,
                         dbTechLayer* layer,
-                        dbBlock* block,
                         const DensityFillShapesConfig& cfg,
                         int num_masks,
-                        bool needs_opc,
                         Graphics* graphics,
+                        std::vector<DensityFillShape>& fill_shapes,
                         Polygon90Set* filled_area = nullptr)
 {
   // Convert the area polygon to a polygon set as we will remove areas
@@ -415,7 +432,7 @@ static void fillPolygon(const Polygon90& area,
       Polygon90Set tmp_fills(fills);
       all_iter_fills += bloat(tmp_fills, space_x, space_x, space_y, space_y);
 
-      // Insert fills into the db
+      // Record the fills for the db
       std::vector<Rectangle> polygons;
       fills.get_rectangles(polygons);
       const int num_mask = std::max(num_masks, 1);
@@ -427,13 +444,9 @@ static void fillPolygon(const Polygon90& area,
         } else {
           mask = cnt++ % num_mask + 1;
         }
-        auto x_lo = xl(f);
-        auto y_lo = yl(f);
-        auto x_hi = xh(f);
-        auto y_hi = yh(f);
-        dbFill::create(block, needs_opc, mask, layer, x_lo, y_lo, x_hi, y_hi);
+        fill_shapes.push_back({f, mask});
         if (filled_area) {
-          *filled_area += makeRect(x_lo, y_lo, x_hi, y_hi);
+          *filled_area += makeRect(xl(f), yl(f), xh(f), yh(f));
         }
       }
     }
@@ -442,21 +455,19 @@ static void fillPolygon(const Polygon90& area,
   }
 }
 
-// Fill the given layer
-void DensityFill::fillLayer(dbBlock* block,
-                            dbTechLayer* layer,
-                            const odb::Rect& fill_bounds_rect)
+// Fill one tile of a layer.  fill_bounds is the part of the tile that
+// may hold fills and non_fill the non-fill shapes near the tile.
+static void fillTile(const Rectangle& fill_bounds_rect,
+                     const Polygon90Set& non_fill,
+                     dbTechLayer* layer,
+                     const DensityFillLayerConfig& cfg,
+                     Graphics* graphics,
+                     DensityFillTile& tile)
 {
-  logger_->info(FIN, 3, "Filling layer {}.", layer->getConstName());
-
-  Polygon90Set non_fill = orNonFills(block, layer);
-
-  auto fill_bounds = makeRect(fill_bounds_rect.xMin(),
-                              fill_bounds_rect.yMin(),
-                              fill_bounds_rect.xMax(),
-                              fill_bounds_rect.yMax());
-
-  const DensityFillLayerConfig& cfg = layers_[layer];
+  auto fill_bounds = makeRect(xl(fill_bounds_rect),
+                              yl(fill_bounds_rect),
+                              xh(fill_bounds_rect),
+                              yh(fill_bounds_rect));
 
   std::vector<Polygon90> polygons;
 
@@ -464,28 +475,26 @@ void DensityFill::fillLayer(dbBlock* block,
   Polygon90Set fill_area
       = fill_bounds - (non_fill + cfg.non_opc.space_to_non_fill);
 
-  if (graphics_) {
-    graphics_->status("Non-OPC Area");
-    graphics_->drawPolygon90Set(fill_area);
+  if (graphics) {
+    graphics->status("Non-OPC Area");
+    graphics->drawPolygon90Set(fill_area);
   }
 
-  prune(fill_area, layer, cfg.non_opc, graphics_.get());
+  prune(fill_area, layer, cfg.non_opc, graphics);
 
   fill_area.get(polygons);
-  logger_->info(FIN, 9, "Filling {} areas with non-OPC fill.", polygons.size());
+  tile.num_non_opc_areas = polygons.size();
 
   Polygon90Set non_opc_fill_area;
   for (auto& polygon : polygons) {
     fillPolygon(polygon,
                 layer,
-                block,
                 cfg.non_opc,
                 cfg.num_masks,
-                false,
-                graphics_.get(),
+                graphics,
+                tile.non_opc,
                 &non_opc_fill_area);
   }
-  logger_->info(FIN, 4, "Total fills: {}.", block->getFills().size());
 
   if (!cfg.has_opc) {
     return;
@@ -495,31 +504,222 @@ void DensityFill::fillLayer(dbBlock* block,
       = fill_bounds - (non_fill + cfg.opc.space_to_non_fill)
         - (non_opc_fill_area + cfg.non_opc.space_to_fill);
 
-  if (graphics_) {
-    graphics_->status("OPC Area");
-    graphics_->drawPolygon90Set(opc_fill_area);
+  if (graphics) {
+    graphics->status("OPC Area");
+    graphics->drawPolygon90Set(opc_fill_area);
   }
 
-  prune(opc_fill_area, layer, cfg.opc, graphics_.get());
+  prune(opc_fill_area, layer, cfg.opc, graphics);
 
   polygons.clear();
   opc_fill_area.get(polygons);
-  logger_->info(FIN, 5, "Filling {} areas with OPC fill.", polygons.size());
+  tile.num_opc_areas = polygons.size();
   for (auto& polygon : polygons) {
     fillPolygon(
-        polygon, layer, block, cfg.opc, cfg.num_masks, true, graphics_.get());
+        polygon, layer, cfg.opc, cfg.num_masks, graphics, tile.opc);
   }
 
-  logger_->info(FIN, 6, "Total fills: {}.", block->getFills().size());
+  if (graphics) {
+    graphics->status("OPC Area");
+    graphics->drawPolygon90Set(opc_fill_area);
+  }
+}
+
+// Half of the largest spacing between any two fills, rounded up
+static std::pair<int, int> getSeams(dbTechLayer* layer,
+                                    const DensityFillLayerConfig& cfg)
+{
+  auto [seam_x, seam_y] = getSpacing(layer, cfg.non_opc);
+  if (cfg.has_opc) {
+    auto [opc_x, opc_y] = getSpacing(layer, cfg.opc);
+    seam_x = std::max(seam_x, opc_x);
+    seam_y = std::max(seam_y, opc_y);
+  }
+  return {(seam_x + 1) / 2, (seam_y + 1) / 2};
+}
+
+// A tile must hold the largest fill shape between its seams
+void DensityFill::checkTileSize(dbTechLayer* layer, int tile_size)
+{
+  const DensityFillLayerConfig& cfg = layers_[layer];
+  const auto [seam_x, seam_y] = getSeams(layer, cfg);
+  int min_x = 0;
+  int min_y = 0;
+  for (const auto* shapes : {&cfg.non_opc, &cfg.opc}) {
+    if (shapes == &cfg.opc && !cfg.has_opc) {
+      continue;
+    }
+    for (const auto& [width, height] : shapes->shapes) {
+      min_x = std::max(min_x, width);
+      min_y = std::max(min_y, height);
+    }
+  }
+  const int min_tile_size = std::max(min_x + 2 * seam_x, min_y + 2 * seam_y);
+  if (tile_size < min_tile_size) {
+    logger_->error(FIN,
+                   11,
+                   "Tile size {} is below the minimum of {} for layer {}.",
+                   tile_size,
+                   min_tile_size,
+                   layer->getConstName());
+  }
+}
+
+// Fill the given layer
+//
+// The fill bounds are split into tiles of tile_size starting at their
+// lower left corner and the tiles are filled in parallel.  Each tile only
+// merges the non-fill shapes near it, which bounds the memory of the
+// polygon operations.  Fills stay half the fill spacing away from the
+// seams between tiles so fills of neighboring tiles never conflict.  The
+// fills are inserted into the db in tile order after all tiles are done
+// so the result does not depend on the thread count.
+void DensityFill::fillLayer(dbBlock* block,
+                            dbTechLayer* layer,
+                            const odb::Rect& fill_bounds_rect,
+                            int tile_size,
+                            int num_threads)
+{
+  logger_->info(FIN, 3, "Filling layer {}.", layer->getConstName());
+
+  const DensityFillLayerConfig& cfg = layers_[layer];
 
+  const auto [seam_x, seam_y] = getSeams(layer, cfg);
+
+  const int dx = fill_bounds_rect.dx();
+  const int dy = fill_bounds_rect.dy();
+  if (tile_size <= 0) {
+    tile_size = std::max({dx, dy, 1});
+  }
+  // Tiles are snapped to multiples of tile_size from the lower left and
+  // the last row and column absorb any remainder, so no tile is smaller
+  // than tile_size (unless the fill bounds are).
+  const int num_x = std::max(dx / tile_size, 1);
+  const int num_y = std::max(dy / tile_size, 1);
+  const size_t num_tiles = static_cast<size_t>(num_x) * num_y;
+
+  // Non-fill shapes only matter within their spacing of a tile
+  int halo = cfg.non_opc.space_to_non_fill;
+  if (cfg.has_opc) {
+    halo = std::max(halo, cfg.opc.space_to_non_fill);
+  }
+
+  std::vector<Rectangle> tile_bounds;
+  tile_bounds.reserve(num_tiles);
+  for (int iy = 0; iy < num_y; ++iy) {
+    for (int ix = 0; ix < num_x; ++ix) {
+      int x_lo = fill_bounds_rect.xMin() + ix * tile_size;
+      int y_lo = fill_bounds_rect.yMin() + iy * tile_size;
+      int x_hi = ix < num_x - 1 ? x_lo + tile_size : fill_bounds_rect.xMax();
+      int y_hi = iy < num_y - 1 ? y_lo + tile_size : fill_bounds_rect.yMax();
+      if (ix > 0) {
+        x_lo += seam_x;
+      }
+      if (ix < num_x - 1) {
+        x_hi -= seam_x;
+      }
+      if (iy > 0) {
+        y_lo += seam_y;
+      }
+      if (iy < num_y - 1) {
+        y_hi -= seam_y;
+      }
+      tile_bounds.emplace_back(x_lo, y_lo, x_hi, y_hi);
+    }
+  }
+
+  // Bin the non-fill shapes by the tiles they are near
+  const std::vector<Rectangle> non_fills = getNonFills(block, layer);
+  std::vector<std::vector<int>> tile_non_fills(num_tiles);
+  auto tileIndex = [tile_size](int coord, int origin, int num) {
+    return std::clamp((coord - origin) / tile_size, 0, num - 1);
+  };
+  const int num_non_fills = non_fills.size();
+  for (int i = 0; i < num_non_fills; ++i) {
+    const Rectangle& r = non_fills[i];
+    if (xh(r) + halo < fill_bounds_rect.xMin()
+        || xl(r) - halo > fill_bounds_rect.xMax()
+        || yh(r) + halo < fill_bounds_rect.yMin()
+        || yl(r) - halo > fill_bounds_rect.yMax()) {
+      continue;
+    }
+    const int ix_lo = tileIndex(xl(r) - halo, fill_bounds_rect.xMin(), num_x);
+    const int ix_hi = tileIndex(xh(r) + halo, fill_bounds_rect.xMin(), num_x);
+    const int iy_lo = tileIndex(yl(r) - halo, fill_bounds_rect.yMin(), num_y);
+    const int iy_hi = tileIndex(yh(r) + halo, fill_bounds_rect.yMin(), num_y);
+    for (int iy = iy_lo; iy <= iy_hi; ++iy) {
+      for (int ix = ix_lo; ix <= ix_hi; ++ix) {
+        tile_non_fills[static_cast<size_t>(iy) * num_x + ix].push_back(i);
+      }
+    }
+  }
+
+  // The debug graphics are not thread safe
   if (graphics_) {
-    graphics_->status("OPC Area");
-    graphics_->drawPolygon90Set(opc_fill_area);
+    num_threads = 1;
   }
+
+  std::vector<DensityFillTile> tiles(num_tiles);
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic, 1)
+  for (size_t i = 0; i < num_tiles; ++i) {
+    const Rectangle& bounds = tile_bounds[i];
+    if (xl(bounds) >= xh(bounds) || yl(bounds) >= yh(bounds)) {
+      continue;
+    }
+    Polygon90Set non_fill;
+    for (int idx : tile_non_fills[i]) {
+      non_fill.insert(non_fills[idx]);
+    }
+    fillTile(bounds, non_fill, layer, cfg, graphics_.get(), tiles[i]);
+    tile_non_fills[i].clear();
+    tile_non_fills[i].shrink_to_fit();
+  }
+
+  auto createFills = [&](const std::vector<DensityFillShape>& fills,
+                         bool needs_opc) {
+    for (const DensityFillShape& f : fills) {
+      dbFill::create(block,
+                     needs_opc,
+                     f.mask,
+                     layer,
+                     xl(f.rect),
+                     yl(f.rect),
+                     xh(f.rect),
+                     yh(f.rect));
+    }
+  };
+
+  int num_areas = 0;
+  for (const DensityFillTile& tile : tiles) {
+    num_areas += tile.num_non_opc_areas;
+  }
+  logger_->info(FIN, 9, "Filling {} areas with non-OPC fill.", num_areas);
+  for (const DensityFillTile& tile : tiles) {
+    createFills(tile.non_opc, false);
+  }
+  logger_->info(FIN, 4, "Total fills: {}.", block->getFills().size());
+
+  if (!cfg.has_opc) {
+    return;
+  }
+
+  num_areas = 0;
+  for (const DensityFillTile& tile : tiles) {
+    num_areas += tile.num_opc_areas;
+  }
+  logger_->info(FIN, 5, "Filling {} areas with OPC fill.", num_areas);
+  for (const DensityFillTile& tile : tiles) {
+    createFills(tile.opc, true);
+  }
+
+  logger_->info(FIN, 6, "Total fills: {}.", block->getFills().size());
 }
 
 // Fill the design according to the given cfg file
-void DensityFill::fill(const char* cfg_filename, const odb::Rect& fill_area)
+void DensityFill::fill(const char* cfg_filename,
+                       const odb::Rect& fill_area,
+                       int tile_size,
+                       int num_threads)
 {
   dbTech* tech = db_->getTech();
   loadConfig(cfg_filename, tech);
@@ -527,13 +727,23 @@ void DensityFill::fill(const char* cfg_filename, const odb::Rect& fill_area)
   dbChip* chip = db_->getChip();
   dbBlock* block = chip->getBlock();
 
+  // Check every layer before any is filled so a bad tile size does not
+  // leave the design partially filled.
+  if (tile_size > 0) {
+    for (dbTechLayer* layer : tech->getLayers()) {
+      if (layers_.find(layer) != layers_.end()) {
+        checkTileSize(layer, tile_size);
+      }
+    }
+  }
+
   for (dbTechLayer* layer : tech->getLayers()) {
     auto it = layers_.find(layer);
     if (it == layers_.end()) {
       logger_->warn(FIN, 10, "Skipping layer {}.", layer->getConstName());
       continue;
     }
-    fillLayer(block, layer, fill_area);
+    fillLayer(block, layer, fill_area, tile_size, num_threads);
   }
 }
 
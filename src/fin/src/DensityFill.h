@@ -60,15 +60,22 @@ class DensityFill
   DensityFill(const DensityFill&&) = delete;
   DensityFill& operator=(const DensityFill&&) = delete;
 
-  void fill(const char* cfg_filename, const odb::Rect& fill_area);
+  // tile_size of zero fills each layer as a single tile.
+  void fill(const char* cfg_filename,
+            const odb::Rect& fill_area,
+            int tile_size,
+            int num_threads);
 
  private:
   void loadConfig(const char* cfg_filename, odb::dbTech* tech);
   void readAndExpandLayers(odb::dbTech* tech,
                            boost::property_tree::ptree& tree);
+  void checkTileSize(odb::dbTechLayer* layer, int tile_size);
   void fillLayer(odb::dbBlock* block,
                  odb::dbTechLayer* layer,
-                 const odb::Rect& fill_bounds);
+                 const odb::Rect& fill_bounds,
+                 int tile_size,
+                 int num_threads);
 
   odb::dbDatabase* db_;
   std::map<odb::dbTechLayer*, DensityFillLayerConfig> layers_;
@@ -50,10 +50,17 @@ void Finale::setDebug()
   debug_ = true;
 }
 
-void Finale::densityFill(const char* rules_filename, const odb::Rect& fill_area)
+void Finale::setThreadCount(int threads)
+{
+  num_threads_ = threads;
+}
+
+void Finale::densityFill(const char* rules_filename,
+                         const odb::Rect& fill_area,
+                         int tile_size)
 {
   DensityFill filler(db_, logger_, debug_);
-  filler.fill(rules_filename, fill_area);
+  filler.fill(rules_filename, fill_area, tile_size, num_threads_);
 }
 
 }  // namespace fin
@@ -51,10 +51,12 @@ set_density_fill_debug_cmd()
 
 void
 density_fill_cmd(const char* rules_filename,
-                 const odb::Rect& fill_area)
+                 const odb::Rect& fill_area,
+                 int tile_size)
 {
   auto *finale = ord::OpenRoad::openRoad()->getFinale();
-  finale->densityFill(rules_filename, fill_area);
+  finale->setThreadCount(ord::OpenRoad::openRoad()->getThreadCount());
+  finale->densityFill(rules_filename, fill_area, tile_size);
 }
 
 %} // inline
@@ -0,0 +1,102 @@
+# density_fill with -tile_size gives the same fills with 1 and 4 threads
+# and no spacing violations between fills of neighboring tiles.
+source helpers.tcl
+set test_name gcd_fill_tiles
+
+read_lef sky130hd/sky130hd.tlef
+read_lef sky130hd/sky130_fd_sc_hd_merged.lef
+read_def gcd_prefill.def
+
+# The fill counts depend on the tile size
+suppress_message FIN 4
+suppress_message FIN 9
+
+set tile_size 40
+set block [ord::get_db_block]
+
+proc remove_fills { block } {
+  foreach fill [$block getFills] {
+    odb::dbFill_destroy $fill
+  }
+}
+
+# Count pairs of fills in different tiles that are closer than the
+# space_to_fill of their layer in fill.json.
+proc check_seams { block tile_size } {
+  set core [$block getCoreArea]
+  set x0 [$core xMin]
+  set y0 [$core yMin]
+  set tile [ord::microns_to_dbu $tile_size]
+  set num_x [expr max([$core dx] / $tile, 1)]
+  set num_y [expr max([$core dy] / $tile, 1)]
+  set spacing [dict create met1 0.3 met2 0.3 met3 0.3 met4 0.3 met5 1.6]
+
+  # Bin the fills that are within spacing of a tile edge by layer and tile
+  set border [dict create]
+  set rect [odb::Rect]
+  foreach fill [$block getFills] {
+    set layer [[$fill getTechLayer] getName]
+    set space [ord::microns_to_dbu [dict get $spacing $layer]]
+    $fill getRect $rect
+    set xl [$rect xMin]
+    set yl [$rect yMin]
+    set xh [$rect xMax]
+    set yh [$rect yMax]
+    set ix [expr min(max(($xl - $x0) / $tile, 0), $num_x - 1)]
+    set iy [expr min(max(($yl - $y0) / $tile, 0), $num_y - 1)]
+    set tx_lo [expr $x0 + $ix * $tile]
+    set ty_lo [expr $y0 + $iy * $tile]
+    set tx_hi [expr $tx_lo + $tile]
+    set ty_hi [expr $ty_lo + $tile]
+    if { $xl - $tx_lo < $space || $tx_hi - $xh < $space
+         || $yl - $ty_lo < $space || $ty_hi - $yh < $space } {
+      dict lappend border "$layer $ix $iy" [list $xl $yl $xh $yh]
+    }
+  }
+
+  set violations 0
+  dict for {key fills} $border {
+    lassign $key layer ix iy
+    set space [ord::microns_to_dbu [dict get $spacing $layer]]
+    foreach {dx dy} {1 -1 1 0 1 1 0 1} {
+      set other "$layer [expr $ix + $dx] [expr $iy + $dy]"
+      if { ![dict exists $border $other] } {
+        continue
+      }
+      foreach a $fills {
+        lassign $a axl ayl axh ayh
+        foreach b [dict get $border $other] {
+          lassign $b bxl byl bxh byh
+          set gap_x [expr max($axl - $bxh, $bxl - $axh)]
+          set gap_y [expr max($ayl - $byh, $byl - $ayh)]
+          if { $gap_x < $space && $gap_y < $space } {
+            incr violations
+          }
+        }
+      }
+    }
+  }
+  puts "Seam spacing violations: $violations"
+}
+
+set_thread_count 1
+density_fill -rules fill.json -tile_size $tile_size
+set def_file1 [make_result_file ${test_name}_1.def]
+write_def $def_file1
+check_seams $block $tile_size
+
+remove_fills $block
+set_thread_count 4
+density_fill -rules fill.json -tile_size $tile_size
+set def_file4 [make_result_file ${test_name}_4.def]
+write_def $def_file4
+check_seams $block $tile_size
+
+diff_files $def_file1 $def_file4
+
+# Tiles too small to hold a fill between their seams are rejected before
+# any layer is filled
+remove_fills $block
+catch { density_fill -rules fill.json -tile_size 1 } error
+puts $error
+puts "Fills: [llength [$block getFills]]"
@@ -1,5 +1,6 @@
 record_tests {
     gcd_fill
+    gcd_fill_tiles
     #fin_man_tcl_check
     #fin_readme_msgs_check
 }
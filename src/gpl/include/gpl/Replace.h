@@ -120,6 +120,7 @@ class Replace
   void setTimingDrivenMode(bool mode);
 
   void setSkipIoMode(bool mode);
+  void setParallelFftMode(bool mode);
 
   void setRoutabilityDrivenMode(bool mode);
   void setRoutabilityUseGrt(bool mode);
@@ -205,6 +206,7 @@ class Replace
   bool routabilityUseRudy_ = true;
   bool uniformTargetDensityMode_ = false;
   bool skipIoMode_ = false;
+  bool parallelFftMode_ = true;
 
   std::vector<int> timingNetWeightOverflows_;
 
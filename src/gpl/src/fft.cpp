@@ -33,6 +33,9 @@
 
 #include "fft.h"
 
+#include <omp.h>
+
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <cstdlib>
@@ -42,27 +45,34 @@
 
 namespace gpl {
 
-FFT::FFT(int binCntX, int binCntY, int binSizeX, int binSizeY)
+FFT::FFT(int binCntX,
+         int binCntY,
+         int binSizeX,
+         int binSizeY,
+         int numThreads)
     : binCntX_(binCntX),
       binCntY_(binCntY),
       binSizeX_(binSizeX),
-      binSizeY_(binSizeY)
+      binSizeY_(binSizeY),
+      numThreads_(std::max(numThreads, 1))
 {
-  binDensity_ = new float*[binCntX_];
-  electroPhi_ = new float*[binCntX_];
-  electroForceX_ = new float*[binCntX_];
-  electroForceY_ = new float*[binCntX_];
+  const size_t binCnt = static_cast<size_t>(binCntX_) * binCntY_;
+  binDensityStor_.resize(binCnt, 0);
+  electroPhiStor_.resize(binCnt, 0);
+  electroForceXStor_.resize(binCnt, 0);
+  electroForceYStor_.resize(binCnt, 0);
 
-  for (int i = 0; i < binCntX_; i++) {
-    binDensity_[i] = new float[binCntY_];
-    electroPhi_[i] = new float[binCntY_];
-    electroForceX_[i] = new float[binCntY_];
-    electroForceY_[i] = new float[binCntY_];
+  binDensity_.resize(binCntX_);
+  electroPhi_.resize(binCntX_);
+  electroForceX_.resize(binCntX_);
+  electroForceY_.resize(binCntX_);
 
-    for (int j = 0; j < binCntY_; j++) {
-      binDensity_[i][j] = electroPhi_[i][j] = electroForceX_[i][j]
-          = electroForceY_[i][j] = 0.0f;
-    }
+  for (int i = 0; i < binCntX_; i++) {
+    const size_t row = static_cast<size_t>(i) * binCntY_;
+    binDensity_[i] = &binDensityStor_[row];
+    electroPhi_[i] = &electroPhiStor_[row];
+    electroForceX_[i] = &electroForceXStor_[row];
+    electroForceY_[i] = &electroForceYStor_[row];
   }
 
   csTable_.resize(std::max(binCntX_, binCntY_) * 3 / 2, 0);
@@ -74,6 +84,16 @@ FFT::FFT(int binCntX, int binCntY, int binSizeX, int binSizeY)
 
   workArea_.resize(round(sqrt(std::max(binCntX_, binCntY_))) + 2, 0);
 
+  columnWork_.resize(static_cast<size_t>(numThreads_) * 4 * binCntX_, 0);
+
+  // Build the cos/sin tables up front, the same way the first ddct2d
+  // call would.  The 1D transforms then only read them, so they can run
+  // concurrently.
+  const int n = std::max(binCntX_, binCntY_);
+  const int nw = n >> 2;
+  makewt(nw, workArea_.data(), csTable_.data());
+  makect(n, workArea_.data(), csTable_.data() + nw);
+
   for (int i = 0; i < binCntX_; i++) {
     wx_[i]
         = REPLACE_FFT_PI * static_cast<float>(i) / static_cast<float>(binCntX_);
@@ -88,29 +108,6 @@ FFT::FFT(int binCntX, int binCntY, int binSizeX, int binSizeY)
   }
 }
 
-FFT::~FFT()
-{
-  using std::vector;
-  for (int i = 0; i < binCntX_; i++) {
-    delete[] binDensity_[i];
-    delete[] electroPhi_[i];
-    delete[] electroForceX_[i];
-    delete[] electroForceY_[i];
-  }
-  delete[] binDensity_;
-  delete[] electroPhi_;
-  delete[] electroForceX_;
-  delete[] electroForceY_;
-
-  csTable_.clear();
-  wx_.clear();
-  wxSquare_.clear();
-  wy_.clear();
-  wySquare_.clear();
-
-  workArea_.clear();
-}
-
 void FFT::updateDensity(int x, int y, float density)
 {
   binDensity_[x][y] = density;
@@ -126,15 +123,54 @@ float FFT::getElectroPhi(int x, int y) const
   return electroPhi_[x][y];
 }
 
+// Same steps as ddct2d/ddsct2d/ddcst2d: a 1D transform of every row,
+// then of every column, with columns gathered four at a time.  Each
+// row or column batch is independent, so they are spread across threads.
+void FFT::transform2d(bool rowSine, bool colSine, int isgn, float** a)
+{
+  int* ip = workArea_.data();
+  float* w = csTable_.data();
+  const int n1 = binCntX_;
+  const int n2 = binCntY_;
+
+#pragma omp parallel for num_threads(numThreads_)
+  for (int i = 0; i < n1; i++) {
+    if (rowSine) {
+      ddst(n2, isgn, a[i], ip, w);
+    } else {
+      ddct(n2, isgn, a[i], ip, w);
+    }
+  }
+
+  const int batch = std::min(n2, 4);
+  const int numBatches = n2 / batch;
+#pragma omp parallel for num_threads(numThreads_)
+  for (int b = 0; b < numBatches; b++) {
+    float* t = &columnWork_[static_cast<size_t>(omp_get_thread_num()) * 4 * n1];
+    const int j0 = b * batch;
+    for (int i = 0; i < n1; i++) {
+      for (int k = 0; k < batch; k++) {
+        t[k * n1 + i] = a[i][j0 + k];
+      }
+    }
+    for (int k = 0; k < batch; k++) {
+      if (colSine) {
+        ddst(n1, isgn, &t[k * n1], ip, w);
+      } else {
+        ddct(n1, isgn, &t[k * n1], ip, w);
+      }
+    }
+    for (int i = 0; i < n1; i++) {
+      for (int k = 0; k < batch; k++) {
+        a[i][j0 + k] = t[k * n1 + i];
+      }
+    }
+  }
+}
+
 void FFT::doFFT()
 {
-  ddct2d(binCntX_,
-         binCntY_,
-         -1,
-         binDensity_,
-         nullptr,
-         (int*) &workArea_[0],
-         (float*) &csTable_[0]);
+  transform2d(false, false, -1, binDensity_.data());
 
   for (int i = 0; i < binCntX_; i++) {
     binDensity_[i][0] *= 0.5;
@@ -144,12 +180,14 @@ void FFT::doFFT()
     binDensity_[0][i] *= 0.5;
   }
 
+#pragma omp parallel for num_threads(numThreads_)
   for (int i = 0; i < binCntX_; i++) {
     for (int j = 0; j < binCntY_; j++) {
       binDensity_[i][j] *= 4.0 / binCntX_ / binCntY_;
     }
   }
 
+#pragma omp parallel for num_threads(numThreads_)
   for (int i = 0; i < binCntX_; i++) {
     float wx = wx_[i];
     float wx2 = wxSquare_[i];
@@ -186,27 +224,9 @@ void FFT::doFFT()
     }
   }
   // Inverse DCT
-  ddct2d(binCntX_,
-         binCntY_,
-         1,
-         electroPhi_,
-         nullptr,
-         (int*) &workArea_[0],
-         (float*) &csTable_[0]);
-  ddsct2d(binCntX_,
-          binCntY_,
-          1,
-          electroForceX_,
-          nullptr,
-          (int*) &workArea_[0],
-          (float*) &csTable_[0]);
-  ddcst2d(binCntX_,
-          binCntY_,
-          1,
-          electroForceY_,
-          nullptr,
-          (int*) &workArea_[0],
-          (float*) &csTable_[0]);
+  transform2d(false, false, 1, electroPhi_.data());
+  transform2d(false, true, 1, electroForceX_.data());
+  transform2d(true, false, 1, electroForceY_.data());
 }
 
 }  // namespace gpl
@@ -40,8 +40,10 @@ namespace gpl {
 class FFT
 {
  public:
-  FFT(int binCntX, int binCntY, int binSizeX, int binSizeY);
-  ~FFT();
+  // numThreads > 1 splits the 2D transforms into row and column
+  // batches across OpenMP threads.  The result is the same for any
+  // number of threads.
+  FFT(int binCntX, int binCntY, int binSizeX, int binSizeY, int numThreads = 1);
 
   // input func
   void updateDensity(int x, int y, float density);
@@ -54,12 +56,22 @@ class FFT
   float getElectroPhi(int x, int y) const;
 
  private:
-  // 2D array; width: binCntX_, height: binCntY_;
-  // No hope to use Vector at this moment...
-  float** binDensity_ = nullptr;
-  float** electroPhi_ = nullptr;
-  float** electroForceX_ = nullptr;
-  float** electroForceY_ = nullptr;
+  // 2D DCT/DST of a: rows of length binCntY_ first, then columns of
+  // length binCntX_.  rowSine/colSine select ddst over ddct.
+  void transform2d(bool rowSine, bool colSine, int isgn, float** a);
+
+  // 2D arrays; width: binCntX_, height: binCntY_;
+  // each is stored contiguously, row i starting at i * binCntY_.
+  // The row pointers feed the Ooura routines.
+  std::vector<float> binDensityStor_;
+  std::vector<float> electroPhiStor_;
+  std::vector<float> electroForceXStor_;
+  std::vector<float> electroForceYStor_;
+
+  std::vector<float*> binDensity_;
+  std::vector<float*> electroPhi_;
+  std::vector<float*> electroForceX_;
+  std::vector<float*> electroForceY_;
 
   // cos/sin table (prev: w_2d)
   // length:  max(binCntX, binCntY) * 3 / 2
@@ -77,10 +89,14 @@ class FFT
   // length: round(sqrt( max(binCntX_, binCntY_) )) + 2
   std::vector<int> workArea_;
 
+  // column gather buffer, 4 * binCntX_ per thread
+  std::vector<float> columnWork_;
+
   int binCntX_ = 0;
   int binCntY_ = 0;
   int binSizeX_ = 0;
   int binSizeY_ = 0;
+  int numThreads_ = 1;
 };
 
 //
@@ -92,6 +108,8 @@ class FFT
 void cdft(int n, int isgn, float* a, int* ip, float* w);
 void ddct(int n, int isgn, float* a, int* ip, float* w);
 void ddst(int n, int isgn, float* a, int* ip, float* w);
+void makewt(int nw, int* ip, float* w);
+void makect(int nc, int* ip, float* c);
 
 /// 2D FFT ////////////////////////////////////////////////////////////////
 void cdft2d(int, int, int, float**, float*, int*, float*);
@@ -76,8 +76,6 @@ static float getSecondNorm(const std::vector<FloatPoint>& a);
 // Choose to use "float" only in the following functions
 static float getOverlapDensityArea(const Bin& bin, const GCell* cell);
 
-static float fastExp(float exp);
-
 ////////////////////////////////////////////////
 // GCell
 
@@ -294,6 +292,14 @@ void GNet::updateBox()
   }
 }
 
+void GNet::setBox(int lx, int ly, int ux, int uy)
+{
+  lx_ = lx;
+  ly_ = ly;
+  ux_ = ux;
+  uy_ = uy;
+}
+
 int64_t GNet::hpwl() const
 {
   if (ux_ < lx_) {  // dangling net
@@ -306,21 +312,6 @@ int64_t GNet::hpwl() const
   return (ux - lx) + (uy - ly);
 }
 
-void GNet::clearWaVars()
-{
-  waExpMinSumX_ = 0;
-  waXExpMinSumX_ = 0;
-
-  waExpMaxSumX_ = 0;
-  waXExpMaxSumX_ = 0;
-
-  waExpMinSumY_ = 0;
-  waYExpMinSumY_ = 0;
-
-  waExpMaxSumY_ = 0;
-  waYExpMaxSumY_ = 0;
-}
-
 void GNet::setDontCare()
 {
   isDontCare_ = true;
@@ -369,41 +360,6 @@ void GPin::setCenterLocation(int cx, int cy)
   cy_ = cy;
 }
 
-void GPin::clearWaVars()
-{
-  hasMaxExpSumX_ = false;
-  hasMaxExpSumY_ = false;
-  hasMinExpSumX_ = false;
-  hasMinExpSumY_ = false;
-
-  maxExpSumX_ = maxExpSumY_ = 0;
-  minExpSumX_ = minExpSumY_ = 0;
-}
-
-void GPin::setMaxExpSumX(float maxExpSumX)
-{
-  hasMaxExpSumX_ = true;
-  maxExpSumX_ = maxExpSumX;
-}
-
-void GPin::setMaxExpSumY(float maxExpSumY)
-{
-  hasMaxExpSumY_ = true;
-  maxExpSumY_ = maxExpSumY;
-}
-
-void GPin::setMinExpSumX(float minExpSumX)
-{
-  hasMinExpSumX_ = true;
-  minExpSumX_ = minExpSumX;
-}
-
-void GPin::setMinExpSumY(float minExpSumY)
-{
-  hasMinExpSumY_ = true;
-  minExpSumY_ = minExpSumY;
-}
-
 void GPin::updateLocation(const GCell* gCell)
 {
   cx_ = gCell->cx() + offsetCx_;
@@ -971,6 +927,59 @@ NesterovBaseCommon::NesterovBaseCommon(NesterovBaseVars nbVars,
       gNet.addGPin(pbToNb(pin));
     }
   }
+
+  initWaStore();
+}
+
+void NesterovBaseCommon::initWaStore()
+{
+  const int numNets = gNetStor_.size();
+
+  wa_.clear();
+  wa_.pinSlot.assign(gPinStor_.size(), -1);
+  wa_.slotPin.reserve(gPinStor_.size());
+  wa_.slotNet.reserve(gPinStor_.size());
+  wa_.netSlotBegin.reserve(numNets + 1);
+  wa_.netSlotBegin.push_back(0);
+  for (int net = 0; net < numNets; net++) {
+    for (const GPin* gPin : gNetStor_[net].gPins()) {
+      const int pin = gPin - gPinStor_.data();
+      wa_.pinSlot[pin] = wa_.slotPin.size();
+      wa_.slotPin.push_back(pin);
+      wa_.slotNet.push_back(net);
+    }
+    wa_.netSlotBegin.push_back(wa_.slotPin.size());
+  }
+
+  const size_t numSlots = wa_.slotPin.size();
+  wa_.slotCx.resize(numSlots);
+  wa_.slotCy.resize(numSlots);
+  wa_.slotMinExpX.resize(numSlots);
+  wa_.slotMaxExpX.resize(numSlots);
+  wa_.slotMinExpY.resize(numSlots);
+  wa_.slotMaxExpY.resize(numSlots);
+
+  wa_.netLx.resize(numNets);
+  wa_.netLy.resize(numNets);
+  wa_.netUx.resize(numNets);
+  wa_.netUy.resize(numNets);
+  wa_.netExpMinSumX.resize(numNets);
+  wa_.netXExpMinSumX.resize(numNets);
+  wa_.netExpMaxSumX.resize(numNets);
+  wa_.netXExpMaxSumX.resize(numNets);
+  wa_.netExpMinSumY.resize(numNets);
+  wa_.netYExpMinSumY.resize(numNets);
+  wa_.netExpMaxSumY.resize(numNets);
+  wa_.netYExpMaxSumY.resize(numNets);
+
+  debugPrint(log_,
+             GPL,
+             "wlUpdateWA",
+             1,
+             "WA store: {} nets, {} pins, {} kernel",
+             numNets,
+             numSlots,
+             waKernelName());
 }
 
 GCell* NesterovBaseCommon::pbToNb(Instance* inst) const
@@ -1023,95 +1032,129 @@ GNet* NesterovBaseCommon::dbToNb(odb::dbNet* net) const
 void NesterovBaseCommon::updateWireLengthForceWA(float wlCoeffX, float wlCoeffY)
 {
   assert(omp_get_thread_num() == 0);
-  // clear all WA variables.
+  const int numNets = gNetStor_.size();
+  const int numSlots = wa_.slotPin.size();
+
+  // gather the pin locations in net order and update the net boxes.
 #pragma omp parallel for num_threads(num_threads_)
-  for (auto gPin = gPinStor_.begin(); gPin < gPinStor_.end(); ++gPin) {
-    // old-style loop for old OpenMP
-    gPin->clearWaVars();
+  for (int net = 0; net < numNets; net++) {
+    int lx = INT_MAX, ly = INT_MAX;
+    int ux = INT_MIN, uy = INT_MIN;
+    for (int s = wa_.netSlotBegin[net]; s < wa_.netSlotBegin[net + 1]; s++) {
+      const GPin& gPin = gPinStor_[wa_.slotPin[s]];
+      const int cx = gPin.cx();
+      const int cy = gPin.cy();
+      wa_.slotCx[s] = cx;
+      wa_.slotCy[s] = cy;
+      lx = std::min(cx, lx);
+      ly = std::min(cy, ly);
+      ux = std::max(cx, ux);
+      uy = std::max(cy, uy);
+    }
+    wa_.netLx[net] = lx;
+    wa_.netLy[net] = ly;
+    wa_.netUx[net] = ux;
+    wa_.netUy[net] = uy;
+    gNetStor_[net].setBox(lx, ly, ux, uy);
   }
 
+  // The WA terms are shift invariant:
+  //
+  //   Sum(x_i * exp(x_i))    Sum(x_i * exp(x_i - C))
+  //   -----------------    = -----------------
+  //   Sum(exp(x_i))          Sum(exp(x_i - C))
+  //
+  // So we shift by the net box to keep the exponential from overflowing
+  const int chunkSize = 4096;
+  const int numChunks = (numSlots + chunkSize - 1) / chunkSize;
 #pragma omp parallel for num_threads(num_threads_)
-  for (auto gNet = gNetStor_.begin(); gNet < gNetStor_.end(); ++gNet) {
-    // old-style loop for old OpenMP
-
-    gNet->clearWaVars();
-    gNet->updateBox();
-
-    for (auto& gPin : gNet->gPins()) {
-      // The WA terms are shift invariant:
-      //
-      //   Sum(x_i * exp(x_i))    Sum(x_i * exp(x_i - C))
-      //   -----------------    = -----------------
-      //   Sum(exp(x_i))          Sum(exp(x_i - C))
-      //
-      // So we shift to keep the exponential from overflowing
-      float expMinX = (gNet->lx() - gPin->cx()) * wlCoeffX;
-      float expMaxX = (gPin->cx() - gNet->ux()) * wlCoeffX;
-      float expMinY = (gNet->ly() - gPin->cy()) * wlCoeffY;
-      float expMaxY = (gPin->cy() - gNet->uy()) * wlCoeffY;
-
-      // min x
-      if (expMinX > nbVars_.minWireLengthForceBar) {
-        gPin->setMinExpSumX(fastExp(expMinX));
-        gNet->addWaExpMinSumX(gPin->minExpSumX());
-        gNet->addWaXExpMinSumX(gPin->cx() * gPin->minExpSumX());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MinX updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->minExpSumX());
-        }
+  for (int chunk = 0; chunk < numChunks; chunk++) {
+    const int begin = chunk * chunkSize;
+    const int end = std::min(begin + chunkSize, numSlots);
+    computeWaExpTerms(wa_.slotCx.data(),
+                      wa_.slotNet.data(),
+                      wa_.netLx.data(),
+                      wa_.netUx.data(),
+                      wlCoeffX,
+                      nbVars_.minWireLengthForceBar,
+                      begin,
+                      end,
+                      wa_.slotMinExpX.data(),
+                      wa_.slotMaxExpX.data());
+    computeWaExpTerms(wa_.slotCy.data(),
+                      wa_.slotNet.data(),
+                      wa_.netLy.data(),
+                      wa_.netUy.data(),
+                      wlCoeffY,
+                      nbVars_.minWireLengthForceBar,
+                      begin,
+                      end,
+                      wa_.slotMinExpY.data(),
+                      wa_.slotMaxExpY.data());
+  }
+
+  // per net sums, accumulated in pin order so the result doesn't depend
+  // on the kernel or the thread count.
+#pragma omp parallel for num_threads(num_threads_)
+  for (int net = 0; net < numNets; net++) {
+    float expMinSumX = 0, xExpMinSumX = 0;
+    float expMaxSumX = 0, xExpMaxSumX = 0;
+    float expMinSumY = 0, yExpMinSumY = 0;
+    float expMaxSumY = 0, yExpMaxSumY = 0;
+    for (int s = wa_.netSlotBegin[net]; s < wa_.netSlotBegin[net + 1]; s++) {
+      expMinSumX += wa_.slotMinExpX[s];
+      xExpMinSumX += wa_.slotCx[s] * wa_.slotMinExpX[s];
+      expMaxSumX += wa_.slotMaxExpX[s];
+      xExpMaxSumX += wa_.slotCx[s] * wa_.slotMaxExpX[s];
+      expMinSumY += wa_.slotMinExpY[s];
+      yExpMinSumY += wa_.slotCy[s] * wa_.slotMinExpY[s];
+      expMaxSumY += wa_.slotMaxExpY[s];
+      yExpMaxSumY += wa_.slotCy[s] * wa_.slotMaxExpY[s];
+    }
+    wa_.netExpMinSumX[net] = expMinSumX;
+    wa_.netXExpMinSumX[net] = xExpMinSumX;
+    wa_.netExpMaxSumX[net] = expMaxSumX;
+    wa_.netXExpMaxSumX[net] = xExpMaxSumX;
+    wa_.netExpMinSumY[net] = expMinSumY;
+    wa_.netYExpMinSumY[net] = yExpMinSumY;
+    wa_.netExpMaxSumY[net] = expMaxSumY;
+    wa_.netYExpMaxSumY[net] = yExpMaxSumY;
+  }
+
+  if (log_->debugCheck(GPL, "wlUpdateWA", 1)) {
+    for (int s = 0; s < numSlots; s++) {
+      const GCell* gCell = gPinStor_[wa_.slotPin[s]].gCell();
+      if (!gCell || !gCell->isInstance()) {
+        continue;
       }
-
-      // max x
-      if (expMaxX > nbVars_.minWireLengthForceBar) {
-        gPin->setMaxExpSumX(fastExp(expMaxX));
-        gNet->addWaExpMaxSumX(gPin->maxExpSumX());
-        gNet->addWaXExpMaxSumX(gPin->cx() * gPin->maxExpSumX());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MaxX updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->maxExpSumX());
-        }
+      const char* name = gCell->instance()->dbInst()->getConstName();
+      if (wa_.slotMinExpX[s] > 0) {
+        log_->debug(GPL,
+                    "wlUpdateWA",
+                    "MinX updated: {} {:g}",
+                    name,
+                    wa_.slotMinExpX[s]);
       }
-
-      // min y
-      if (expMinY > nbVars_.minWireLengthForceBar) {
-        gPin->setMinExpSumY(fastExp(expMinY));
-        gNet->addWaExpMinSumY(gPin->minExpSumY());
-        gNet->addWaYExpMinSumY(gPin->cy() * gPin->minExpSumY());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MinY updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->minExpSumY());
-        }
+      if (wa_.slotMaxExpX[s] > 0) {
+        log_->debug(GPL,
+                    "wlUpdateWA",
+                    "MaxX updated: {} {:g}",
+                    name,
+                    wa_.slotMaxExpX[s]);
       }
-
-      // max y
-      if (expMaxY > nbVars_.minWireLengthForceBar) {
-        gPin->setMaxExpSumY(fastExp(expMaxY));
-        gNet->addWaExpMaxSumY(gPin->maxExpSumY());
-        gNet->addWaYExpMaxSumY(gPin->cy() * gPin->maxExpSumY());
-        if (gPin->gCell() && gPin->gCell()->isInstance()) {
-          debugPrint(log_,
-                     GPL,
-                     "wlUpdateWA",
-                     1,
-                     "MaxY updated: {} {:g}",
-                     gPin->gCell()->instance()->dbInst()->getConstName(),
-                     gPin->maxExpSumY());
-        }
+      if (wa_.slotMinExpY[s] > 0) {
+        log_->debug(GPL,
+                    "wlUpdateWA",
+                    "MinY updated: {} {:g}",
+                    name,
+                    wa_.slotMinExpY[s]);
+      }
+      if (wa_.slotMaxExpY[s] > 0) {
+        log_->debug(GPL,
+                    "wlUpdateWA",
+                    "MaxY updated: {} {:g}",
+                    name,
+                    wa_.slotMaxExpY[s]);
       }
     }
   }
@@ -1170,49 +1213,55 @@ FloatPoint NesterovBaseCommon::getWireLengthGradientPinWA(const GPin* gPin,
   float gradientMinX = 0, gradientMinY = 0;
   float gradientMaxX = 0, gradientMaxY = 0;
 
+  const int slot = wa_.pinSlot[gPin - gPinStor_.data()];
+  if (slot < 0) {
+    return FloatPoint();
+  }
+  const int net = wa_.slotNet[slot];
+
   // min x
-  if (gPin->hasMinExpSumX()) {
+  const float minExpSumX = wa_.slotMinExpX[slot];
+  if (minExpSumX > 0) {
     // from Net.
-    float waExpMinSumX = gPin->gNet()->waExpMinSumX();
-    float waXExpMinSumX = gPin->gNet()->waXExpMinSumX();
+    float waExpMinSumX = wa_.netExpMinSumX[net];
+    float waXExpMinSumX = wa_.netXExpMinSumX[net];
 
-    gradientMinX
-        = (waExpMinSumX * (gPin->minExpSumX() * (1.0 - wlCoeffX * gPin->cx()))
-           + wlCoeffX * gPin->minExpSumX() * waXExpMinSumX)
-          / (waExpMinSumX * waExpMinSumX);
+    gradientMinX = (waExpMinSumX * (minExpSumX * (1.0 - wlCoeffX * gPin->cx()))
+                    + wlCoeffX * minExpSumX * waXExpMinSumX)
+                   / (waExpMinSumX * waExpMinSumX);
   }
 
   // max x
-  if (gPin->hasMaxExpSumX()) {
-    float waExpMaxSumX = gPin->gNet()->waExpMaxSumX();
-    float waXExpMaxSumX = gPin->gNet()->waXExpMaxSumX();
+  const float maxExpSumX = wa_.slotMaxExpX[slot];
+  if (maxExpSumX > 0) {
+    float waExpMaxSumX = wa_.netExpMaxSumX[net];
+    float waXExpMaxSumX = wa_.netXExpMaxSumX[net];
 
-    gradientMaxX
-        = (waExpMaxSumX * (gPin->maxExpSumX() * (1.0 + wlCoeffX * gPin->cx()))
-           - wlCoeffX * gPin->maxExpSumX() * waXExpMaxSumX)
-          / (waExpMaxSumX * waExpMaxSumX);
+    gradientMaxX = (waExpMaxSumX * (maxExpSumX * (1.0 + wlCoeffX * gPin->cx()))
+                    - wlCoeffX * maxExpSumX * waXExpMaxSumX)
+                   / (waExpMaxSumX * waExpMaxSumX);
   }
 
   // min y
-  if (gPin->hasMinExpSumY()) {
-    float waExpMinSumY = gPin->gNet()->waExpMinSumY();
-    float waYExpMinSumY = gPin->gNet()->waYExpMinSumY();
+  const float minExpSumY = wa_.slotMinExpY[slot];
+  if (minExpSumY > 0) {
+    float waExpMinSumY = wa_.netExpMinSumY[net];
+    float waYExpMinSumY = wa_.netYExpMinSumY[net];
 
-    gradientMinY
-        = (waExpMinSumY * (gPin->minExpSumY() * (1.0 - wlCoeffY * gPin->cy()))
-           + wlCoeffY * gPin->minExpSumY() * waYExpMinSumY)
-          / (waExpMinSumY * waExpMinSumY);
+    gradientMinY = (waExpMinSumY * (minExpSumY * (1.0 - wlCoeffY * gPin->cy()))
+                    + wlCoeffY * minExpSumY * waYExpMinSumY)
+                   / (waExpMinSumY * waExpMinSumY);
   }
 
   // max y
-  if (gPin->hasMaxExpSumY()) {
-    float waExpMaxSumY = gPin->gNet()->waExpMaxSumY();
-    float waYExpMaxSumY = gPin->gNet()->waYExpMaxSumY();
+  const float maxExpSumY = wa_.slotMaxExpY[slot];
+  if (maxExpSumY > 0) {
+    float waExpMaxSumY = wa_.netExpMaxSumY[net];
+    float waYExpMaxSumY = wa_.netYExpMaxSumY[net];
 
-    gradientMaxY
-        = (waExpMaxSumY * (gPin->maxExpSumY() * (1.0 + wlCoeffY * gPin->cy()))
-           - wlCoeffY * gPin->maxExpSumY() * waYExpMaxSumY)
-          / (waExpMaxSumY * waExpMaxSumY);
+    gradientMaxY = (waExpMaxSumY * (maxExpSumY * (1.0 + wlCoeffY * gPin->cy()))
+                    - wlCoeffY * maxExpSumY * waYExpMaxSumY)
+                   / (waExpMaxSumY * waExpMaxSumY);
   }
 
   debugPrint(log_,
@@ -1340,8 +1389,12 @@ NesterovBase::NesterovBase(NesterovBaseVars nbVars,
   bg_.initBins();
 
   // initialize fft structrue based on bins
-  std::unique_ptr<FFT> fft(
-      new FFT(bg_.binCntX(), bg_.binCntY(), bg_.binSizeX(), bg_.binSizeY()));
+  const int fftThreads = nbVars_.parallelFft ? nbc_->getNumThreads() : 1;
+  std::unique_ptr<FFT> fft(new FFT(bg_.binCntX(),
+                                   bg_.binCntY(),
+                                   bg_.binSizeX(),
+                                   bg_.binSizeY(),
+                                   fftThreads));
 
   fft_ = std::move(fft);
 
@@ -2479,22 +2532,6 @@ static float calculateBiVariateNormalCDF(biNormalParameters i)
 }
 //
 // https://codingforspeed.com/using-faster-exponential-approximation/
-static float fastExp(float exp)
-{
-  exp = 1.0f + exp / 1024.0f;
-  exp *= exp;
-  exp *= exp;
-  exp *= exp;
-  exp *= exp;
-  exp *= exp;
-  exp *= exp;
-  exp *= exp;
-  exp *= exp;
-  exp *= exp;
-  exp *= exp;
-  return exp;
-}
-
 static float getDistance(const std::vector<FloatPoint>& a,
                          const std::vector<FloatPoint>& b)
 {
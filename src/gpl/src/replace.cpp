@@ -119,6 +119,7 @@ void Replace::reset()
   routabilityUseRudy_ = true;
   uniformTargetDensityMode_ = false;
   skipIoMode_ = false;
+  parallelFftMode_ = true;
 
   padLeft_ = padRight_ = 0;
 
@@ -306,6 +307,7 @@ bool Replace::initNesterovPlace(int threads)
     }
 
     nbVars.useUniformTargetDensity = uniformTargetDensityMode_;
+    nbVars.parallelFft = parallelFftMode_;
 
     nbc_ = std::make_shared<NesterovBaseCommon>(nbVars, pbc_, log_, threads);
 
@@ -489,6 +491,11 @@ void Replace::setSkipIoMode(bool mode)
   skipIoMode_ = mode;
 }
 
+void Replace::setParallelFftMode(bool mode)
+{
+  parallelFftMode_ = mode;
+}
+
 void Replace::setForceCPU(bool force_cpu)
 {
   forceCPU_ = force_cpu;
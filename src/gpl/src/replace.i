@@ -256,6 +256,13 @@ set_skip_io_mode_cmd(bool mode)
   replace->setSkipIoMode(mode);
 }
 
+void
+set_parallel_fft_mode_cmd(bool mode)
+{
+  Replace* replace = getReplace();
+  replace->setParallelFftMode(mode);
+}
+
 float
 get_global_placement_uniform_density_cmd() 
 {
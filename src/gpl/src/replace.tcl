@@ -41,6 +41,7 @@ sta::define_cmd_args "global_placement" {\
     [-incremental]\
     [-force_cpu]\
     [-skip_io]\
+    [-disable_parallel_fft]\
     [-bin_grid_count grid_count]\
     [-density target_density]\
     [-init_density_penalty init_density_penalty]\
@@ -92,6 +93,7 @@ proc global_placement { args } {
       -disable_timing_driven \
       -disable_routability_driven \
       -skip_io \
+      -disable_parallel_fft \
       -incremental\
       -force_cpu}
 
@@ -113,6 +115,8 @@ proc global_placement { args } {
     gpl::set_initial_place_max_iter_cmd 0
   }
 
+  gpl::set_parallel_fft_mode_cmd [expr ![info exists flags(-disable_parallel_fft)]]
+
   set timing_driven [info exists flags(-timing_driven)]
   gpl::set_timing_driven_mode $timing_driven
   if { $timing_driven } {
@@ -0,0 +1,299 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+
+#include "waKernel.h"
+
+#include <algorithm>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define GPL_WA_X86 1
+#include <immintrin.h>
+#endif
+
+namespace gpl {
+
+void WaStore::clear()
+{
+  netSlotBegin.clear();
+  pinSlot.clear();
+  slotPin.clear();
+  slotNet.clear();
+  slotCx.clear();
+  slotCy.clear();
+  slotMinExpX.clear();
+  slotMaxExpX.clear();
+  slotMinExpY.clear();
+  slotMaxExpY.clear();
+  netLx.clear();
+  netLy.clear();
+  netUx.clear();
+  netUy.clear();
+  netExpMinSumX.clear();
+  netXExpMinSumX.clear();
+  netExpMaxSumX.clear();
+  netXExpMaxSumX.clear();
+  netExpMinSumY.clear();
+  netYExpMinSumY.clear();
+  netExpMaxSumY.clear();
+  netYExpMaxSumY.clear();
+}
+
+static void waExpTermsScalar(const int* pinC,
+                             const int* slotNet,
+                             const int* netLo,
+                             const int* netHi,
+                             const float wlCoeff,
+                             const float forceBar,
+                             const int begin,
+                             const int end,
+                             float* minExp,
+                             float* maxExp)
+{
+  for (int s = begin; s < end; s++) {
+    const int net = slotNet[s];
+    const float expMin = (netLo[net] - pinC[s]) * wlCoeff;
+    const float expMax = (pinC[s] - netHi[net]) * wlCoeff;
+    minExp[s] = (expMin > forceBar) ? fastExp(expMin) : 0.0f;
+    maxExp[s] = (expMax > forceBar) ? fastExp(expMax) : 0.0f;
+  }
+}
+
+#ifdef GPL_WA_X86
+
+// The vector kernels repeat fastExp lane-wise.  Only exact operations
+// (int subtract, int->float convert, multiply by a power of two) feed
+// the squaring chain, so the results match the scalar kernel bit for
+// bit.  Tails are run through the vector body too rather than a scalar
+// loop, so the compiler never gets to contract scalar code into FMAs.
+
+__attribute__((target("avx2"))) static inline __m256 fastExpAvx2(__m256 x)
+{
+  x = _mm256_add_ps(_mm256_set1_ps(1.0f),
+                    _mm256_mul_ps(x, _mm256_set1_ps(1.0f / 1024.0f)));
+  for (int i = 0; i < 10; i++) {
+    x = _mm256_mul_ps(x, x);
+  }
+  return x;
+}
+
+__attribute__((target("avx2"))) static inline void waExpTermsAvx2Block(
+    const __m256i c,
+    const __m256i net,
+    const int* netLo,
+    const int* netHi,
+    const __m256 coeff,
+    const __m256 bar,
+    __m256* minExp,
+    __m256* maxExp)
+{
+  const __m256i lo = _mm256_i32gather_epi32(netLo, net, 4);
+  const __m256i hi = _mm256_i32gather_epi32(netHi, net, 4);
+  const __m256 expMin
+      = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_sub_epi32(lo, c)), coeff);
+  const __m256 expMax
+      = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_sub_epi32(c, hi)), coeff);
+  *minExp = _mm256_and_ps(_mm256_cmp_ps(expMin, bar, _CMP_GT_OQ),
+                          fastExpAvx2(expMin));
+  *maxExp = _mm256_and_ps(_mm256_cmp_ps(expMax, bar, _CMP_GT_OQ),
+                          fastExpAvx2(expMax));
+}
+
+__attribute__((target("avx2"))) static void waExpTermsAvx2(
+    const int* pinC,
+    const int* slotNet,
+    const int* netLo,
+    const int* netHi,
+    const float wlCoeff,
+    const float forceBar,
+    const int begin,
+    const int end,
+    float* minExp,
+    float* maxExp)
+{
+  const __m256 coeff = _mm256_set1_ps(wlCoeff);
+  const __m256 bar = _mm256_set1_ps(forceBar);
+  __m256 vMin, vMax;
+
+  int s = begin;
+  for (; s + 8 <= end; s += 8) {
+    const __m256i c = _mm256_loadu_si256((const __m256i*) (pinC + s));
+    const __m256i net = _mm256_loadu_si256((const __m256i*) (slotNet + s));
+    waExpTermsAvx2Block(c, net, netLo, netHi, coeff, bar, &vMin, &vMax);
+    _mm256_storeu_ps(minExp + s, vMin);
+    _mm256_storeu_ps(maxExp + s, vMax);
+  }
+
+  if (s < end) {
+    alignas(32) int cBuf[8] = {0};
+    alignas(32) int netBuf[8] = {0};
+    alignas(32) float minBuf[8];
+    alignas(32) float maxBuf[8];
+    const int rest = end - s;
+    std::copy(pinC + s, pinC + end, cBuf);
+    // Padding lanes reuse the last net so the gathers stay in bounds.
+    std::copy(slotNet + s, slotNet + end, netBuf);
+    std::fill(netBuf + rest, netBuf + 8, slotNet[end - 1]);
+    waExpTermsAvx2Block(_mm256_load_si256((const __m256i*) cBuf),
+                        _mm256_load_si256((const __m256i*) netBuf),
+                        netLo,
+                        netHi,
+                        coeff,
+                        bar,
+                        &vMin,
+                        &vMax);
+    _mm256_store_ps(minBuf, vMin);
+    _mm256_store_ps(maxBuf, vMax);
+    std::copy(minBuf, minBuf + rest, minExp + s);
+    std::copy(maxBuf, maxBuf + rest, maxExp + s);
+  }
+}
+
+__attribute__((target("avx512f"))) static inline __m512 fastExpAvx512(
+    __m512 x)
+{
+  x = _mm512_add_ps(_mm512_set1_ps(1.0f),
+                    _mm512_mul_ps(x, _mm512_set1_ps(1.0f / 1024.0f)));
+  for (int i = 0; i < 10; i++) {
+    x = _mm512_mul_ps(x, x);
+  }
+  return x;
+}
+
+__attribute__((target("avx512f"))) static void waExpTermsAvx512(
+    const int* pinC,
+    const int* slotNet,
+    const int* netLo,
+    const int* netHi,
+    const float wlCoeff,
+    const float forceBar,
+    const int begin,
+    const int end,
+    float* minExp,
+    float* maxExp)
+{
+  const __m512 coeff = _mm512_set1_ps(wlCoeff);
+  const __m512 bar = _mm512_set1_ps(forceBar);
+
+  for (int s = begin; s < end; s += 16) {
+    const int rest = std::min(16, end - s);
+    const __mmask16 lanes = (__mmask16) ((1u << rest) - 1);
+    const __m512i c = _mm512_maskz_loadu_epi32(lanes, pinC + s);
+    const __m512i net = _mm512_maskz_loadu_epi32(lanes, slotNet + s);
+    const __m512i lo = _mm512_mask_i32gather_epi32(
+        _mm512_setzero_si512(), lanes, net, netLo, 4);
+    const __m512i hi = _mm512_mask_i32gather_epi32(
+        _mm512_setzero_si512(), lanes, net, netHi, 4);
+    const __m512 expMin = _mm512_mul_ps(
+        _mm512_maskz_cvtepi32_ps(lanes, _mm512_sub_epi32(lo, c)), coeff);
+    const __m512 expMax = _mm512_mul_ps(
+        _mm512_maskz_cvtepi32_ps(lanes, _mm512_sub_epi32(c, hi)), coeff);
+    const __mmask16 minMask
+        = _mm512_mask_cmp_ps_mask(lanes, expMin, bar, _CMP_GT_OQ);
+    const __mmask16 maxMask
+        = _mm512_mask_cmp_ps_mask(lanes, expMax, bar, _CMP_GT_OQ);
+    _mm512_mask_storeu_ps(
+        minExp + s, lanes, _mm512_maskz_mov_ps(minMask, fastExpAvx512(expMin)));
+    _mm512_mask_storeu_ps(
+        maxExp + s, lanes, _mm512_maskz_mov_ps(maxMask, fastExpAvx512(expMax)));
+  }
+}
+
+#endif
+
+static WaExpKernelChoice selectWaExpKernel()
+{
+#ifdef GPL_WA_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return {waExpTermsAvx512, "avx512"};
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return {waExpTermsAvx2, "avx2"};
+  }
+#endif
+  return {waExpTermsScalar, "scalar"};
+}
+
+static const WaExpKernelChoice& waExpKernel()
+{
+  static const WaExpKernelChoice choice = selectWaExpKernel();
+  return choice;
+}
+
+void computeWaExpTerms(const int* pinC,
+                       const int* slotNet,
+                       const int* netLo,
+                       const int* netHi,
+                       const float wlCoeff,
+                       const float forceBar,
+                       const int begin,
+                       const int end,
+                       float* minExp,
+                       float* maxExp)
+{
+  if (begin >= end) {
+    return;
+  }
+  waExpKernel().kernel(pinC,
+                       slotNet,
+                       netLo,
+                       netHi,
+                       wlCoeff,
+                       forceBar,
+                       begin,
+                       end,
+                       minExp,
+                       maxExp);
+}
+
+const char* waKernelName()
+{
+  return waExpKernel().name;
+}
+
+std::vector<WaExpKernelChoice> waSupportedKernels()
+{
+  std::vector<WaExpKernelChoice> kernels = {{waExpTermsScalar, "scalar"}};
+#ifdef GPL_WA_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    kernels.push_back({waExpTermsAvx2, "avx2"});
+  }
+  if (__builtin_cpu_supports("avx512f")) {
+    kernels.push_back({waExpTermsAvx512, "avx512"});
+  }
+#endif
+  return kernels;
+}
+
+}  // namespace gpl
@@ -0,0 +1,154 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <vector>
+
+namespace gpl {
+
+// Structure-of-arrays copy of the pin and net data used by the
+// weighted-average (WA) wirelength model.
+//
+// Pins are stored net by net in "slots", so the pins of a net are
+// contiguous and the kernels below stream through plain int/float
+// arrays instead of chasing GNet/GPin pointers.
+//
+// A zero exp term marks a pin that is not part of the WA model
+// (its exponent is below minWireLengthForceBar).
+struct WaStore
+{
+  void clear();
+
+  // per net, size is nets + 1
+  std::vector<int> netSlotBegin;
+
+  // per pin in gPinStor_ order, -1 if the pin is on no net
+  std::vector<int> pinSlot;
+
+  // per slot
+  std::vector<int> slotPin;
+  std::vector<int> slotNet;
+  std::vector<int> slotCx;
+  std::vector<int> slotCy;
+  std::vector<float> slotMinExpX;
+  std::vector<float> slotMaxExpX;
+  std::vector<float> slotMinExpY;
+  std::vector<float> slotMaxExpY;
+
+  // per net
+  std::vector<int> netLx;
+  std::vector<int> netLy;
+  std::vector<int> netUx;
+  std::vector<int> netUy;
+
+  // Weighted average WL model sums, per net.
+  // Please check the equation (4) in the ePlace-MS paper.
+  //
+  // gamma: modeling accuracy.
+  //
+  // netExpMinSumX : sigma {exp(x_i/gamma)}
+  // netXExpMinSumX: sigma {x_i*exp(x_i/gamma)}
+  // netExpMaxSumX : sigma {exp(-x_i/gamma)}
+  // netXExpMaxSumX: sigma {x_i*exp(-x_i/gamma)}
+  //
+  // and likewise for Y.
+  std::vector<float> netExpMinSumX;
+  std::vector<float> netXExpMinSumX;
+  std::vector<float> netExpMaxSumX;
+  std::vector<float> netXExpMaxSumX;
+  std::vector<float> netExpMinSumY;
+  std::vector<float> netYExpMinSumY;
+  std::vector<float> netExpMaxSumY;
+  std::vector<float> netYExpMaxSumY;
+};
+
+// Fills minExp/maxExp for the slots [begin, end) of one axis:
+//
+//   minExp[s] = fastExp((netLo[slotNet[s]] - pinC[s]) * wlCoeff)
+//   maxExp[s] = fastExp((pinC[s] - netHi[slotNet[s]]) * wlCoeff)
+//
+// or zero when the exponent is not above forceBar.  Uses AVX-512 or
+// AVX2 when the CPU supports it and a scalar loop otherwise; all paths
+// give bit-identical results.
+void computeWaExpTerms(const int* pinC,
+                       const int* slotNet,
+                       const int* netLo,
+                       const int* netHi,
+                       float wlCoeff,
+                       float forceBar,
+                       int begin,
+                       int end,
+                       float* minExp,
+                       float* maxExp);
+
+// Name of the kernel selected by computeWaExpTerms, for reporting.
+const char* waKernelName();
+
+using WaExpKernel = void (*)(const int*,
+                             const int*,
+                             const int*,
+                             const int*,
+                             float,
+                             float,
+                             int,
+                             int,
+                             float*,
+                             float*);
+
+struct WaExpKernelChoice
+{
+  WaExpKernel kernel;
+  const char* name;
+};
+
+// Every kernel this CPU can run, scalar first, so tests can compare them.
+std::vector<WaExpKernelChoice> waSupportedKernels();
+
+// Approximates exp(x) by (1 + x/1024)^1024.
+inline float fastExp(float exp)
+{
+  exp = 1.0f + exp / 1024.0f;
+  exp *= exp;
+  exp *= exp;
+  exp *= exp;
+  exp *= exp;
+  exp *= exp;
+  exp *= exp;
+  exp *= exp;
+  exp *= exp;
+  exp *= exp;
+  exp *= exp;
+  return exp;
+}
+
+}  // namespace gpl
@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "src/gpl/src/waKernel.h"
+
+namespace {
+
+using gpl::WaExpKernelChoice;
+
+// Slots of random nets with pins inside and around their net bounds.
+struct WaInput
+{
+  std::vector<int> pinC;
+  std::vector<int> slotNet;
+  std::vector<int> netLo;
+  std::vector<int> netHi;
+};
+
+WaInput makeInput(const int slots, std::mt19937& rng)
+{
+  WaInput input;
+  const int nets = std::max(slots / 3, 1);
+  std::uniform_int_distribution<int> lo(-100000, 100000);
+  std::uniform_int_distribution<int> span(0, 50000);
+  for (int n = 0; n < nets; n++) {
+    input.netLo.push_back(lo(rng));
+    input.netHi.push_back(input.netLo.back() + span(rng));
+  }
+  std::uniform_int_distribution<int> net(0, nets - 1);
+  std::uniform_int_distribution<int> margin(-1000, 1000);
+  for (int s = 0; s < slots; s++) {
+    const int n = net(rng);
+    std::uniform_int_distribution<int> c(input.netLo[n], input.netHi[n]);
+    input.slotNet.push_back(n);
+    input.pinC.push_back(c(rng) + margin(rng));
+  }
+  return input;
+}
+
+std::vector<float> run(const WaExpKernelChoice& kernel,
+                       const WaInput& input,
+                       const int begin,
+                       const int end)
+{
+  // Slots outside [begin, end) must be left alone.
+  const float untouched = -1.0f;
+  std::vector<float> minExp(input.pinC.size(), untouched);
+  std::vector<float> maxExp(input.pinC.size(), untouched);
+  kernel.kernel(input.pinC.data(),
+                input.slotNet.data(),
+                input.netLo.data(),
+                input.netHi.data(),
+                0.01f,
+                -300.0f,
+                begin,
+                end,
+                minExp.data(),
+                maxExp.data());
+  minExp.insert(minExp.end(), maxExp.begin(), maxExp.end());
+  return minExp;
+}
+
+bool bitEqual(const std::vector<float>& a, const std::vector<float>& b)
+{
+  return a.size() == b.size()
+         && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+}  // namespace
+
+// Every vector kernel matches the scalar kernel bit for bit, for full
+// vectors and for every tail length of an AVX2 (8) and AVX-512 (16) body.
+TEST(WaKernel, KernelsMatchScalar)
+{
+  const std::vector<WaExpKernelChoice> kernels = gpl::waSupportedKernels();
+  ASSERT_STREQ(kernels.front().name, "scalar");
+
+  std::mt19937 rng(1);
+  for (int body = 0; body <= 48; body += 16) {
+    for (int tail = 0; tail < 16; tail++) {
+      for (int begin : {0, 1, 5}) {
+        const int end = begin + body + tail;
+        if (end == begin) {
+          continue;
+        }
+        const WaInput input = makeInput(end + 3, rng);
+        const std::vector<float> expected
+            = run(kernels.front(), input, begin, end);
+        for (const WaExpKernelChoice& kernel : kernels) {
+          EXPECT_TRUE(bitEqual(run(kernel, input, begin, end), expected))
+              << kernel.name << " slots [" << begin << ", " << end << ")";
+        }
+      }
+    }
+  }
+}
+
+// The scalar kernel applies fastExp above forceBar and zero below it.
+TEST(WaKernel, ScalarMatchesFastExp)
+{
+  std::mt19937 rng(2);
+  const WaInput input = makeInput(100, rng);
+  const std::vector<float> exps
+      = run(gpl::waSupportedKernels().front(), input, 0, 100);
+  for (int s = 0; s < 100; s++) {
+    const int net = input.slotNet[s];
+    const float expMin = (input.netLo[net] - input.pinC[s]) * 0.01f;
+    const float expMax = (input.pinC[s] - input.netHi[net]) * 0.01f;
+    const float minExp = expMin > -300.0f ? gpl::fastExp(expMin) : 0.0f;
+    const float maxExp = expMax > -300.0f ? gpl::fastExp(expMax) : 0.0f;
+    EXPECT_EQ(std::memcmp(&exps[s], &minExp, sizeof(float)), 0) << s;
+    EXPECT_EQ(std::memcmp(&exps[100 + s], &maxExp, sizeof(float)), 0) << s;
+  }
+}
@@ -173,6 +173,7 @@ class GlobalRouter : public ant::GlobalRouteSource
                            int layer,
                            float reduction_percentage);
   void setVerbose(const bool v);
+  void setNumThreads(int num_threads);
   void setOverflowIterations(int iterations);
   void setCongestionReportIterStep(int congestion_report_iter_step);
   void setCongestionReportFile(const char* file_name);
@@ -214,6 +215,9 @@ class GlobalRouter : public ant::GlobalRouteSource
   // See class IncrementalGRoute.
   void addDirtyNet(odb::dbNet* net);
   std::set<odb::dbNet*> getDirtyNets() { return dirty_nets_; }
+  // Total 2D overflow of the global routes. Dirty nets are rerouted first
+  // so the overflow matches the current placement.
+  int getOverflow();
   // check_antennas
   bool haveRoutes() override;
   bool haveDetailedRoutes();
@@ -463,6 +467,7 @@ class GlobalRouter : public ant::GlobalRouteSource
   std::vector<RegionAdjustment> region_adjustments_;
 
   bool verbose_;
+  int num_threads_;
   int min_layer_for_clock_;
   int max_layer_for_clock_;
 
@@ -525,6 +530,10 @@ class GRouteDbCbk : public odb::dbBlockCallBackObj
 
 // Class to save global router state and monitor db updates with callbacks
 // to make incremental routing updates.
+// Nets touched by instance moves, master swaps and (dis)connections are
+// collected in a dirty set. Updating the routes rips up only the dirty nets
+// whose pins changed grid position and reroutes them on the current
+// capacity grid, so the cost is proportional to the edit, not the design.
 class IncrementalGRoute
 {
  public:
@@ -532,6 +541,11 @@ class IncrementalGRoute
   IncrementalGRoute(GlobalRouter* groute, odb::dbBlock* block);
   // Update global routes for dirty nets.
   std::vector<Net*> updateRoutes(bool save_guides = false);
+  // Update global routes for dirty nets and estimate the parasitics of
+  // db_net from its (possibly rerouted) global route.
+  void estimateRC(odb::dbNet* db_net);
+  // Update global routes for dirty nets and return the total 2D overflow.
+  int overflow();
   // Disables db callbacks.
   ~IncrementalGRoute();
 
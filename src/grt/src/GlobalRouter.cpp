@@ -99,6 +99,7 @@ GlobalRouter::GlobalRouter()
       macro_extension_(0),
       initialized_(false),
       verbose_(false),
+      num_threads_(1),
       min_layer_for_clock_(-1),
       max_layer_for_clock_(-2),
       seed_(0),
@@ -1583,6 +1584,11 @@ void GlobalRouter::setVerbose(const bool v)
   verbose_ = v;
 }
 
+void GlobalRouter::setNumThreads(int num_threads)
+{
+  num_threads_ = num_threads;
+}
+
 void GlobalRouter::setOverflowIterations(int iterations)
 {
   overflow_iterations_ = iterations;
@@ -1704,6 +1710,7 @@ void GlobalRouter::ensureLayerForGuideDimension(int max_routing_layer)
 void GlobalRouter::configFastRoute()
 {
   fastroute_->setVerbose(verbose_);
+  fastroute_->setNumThreads(num_threads_);
   fastroute_->setOverflowIterations(overflow_iterations_);
   fastroute_->setCongestionReportIterStep(congestion_report_iter_step_);
 
@@ -4159,6 +4166,17 @@ std::vector<Net*> IncrementalGRoute::updateRoutes(bool save_guides)
   return groute_->updateDirtyRoutes(save_guides);
 }
 
+void IncrementalGRoute::estimateRC(odb::dbNet* db_net)
+{
+  groute_->updateDirtyRoutes();
+  groute_->estimateRC(db_net);
+}
+
+int IncrementalGRoute::overflow()
+{
+  return groute_->getOverflow();
+}
+
 IncrementalGRoute::~IncrementalGRoute()
 {
   db_cbk_.removeOwner();
@@ -4179,6 +4197,16 @@ void GlobalRouter::addDirtyNet(odb::dbNet* net)
   dirty_nets_.insert(net);
 }
 
+int GlobalRouter::getOverflow()
+{
+  if (!initialized_) {
+    logger_->error(
+        GRT, 255, "Run global_route before querying the routing overflow.");
+  }
+  updateDirtyRoutes();
+  return fastroute_->totalOverflow();
+}
+
 std::vector<Net*> GlobalRouter::updateDirtyRoutes(bool save_guides)
 {
   std::vector<Net*> dirty_nets;
@@ -194,6 +194,8 @@ set_perturbation_amount(int perturbation)
 void
 global_route(bool start_incremental, bool end_incremental)
 {
+  const int num_threads = ord::OpenRoad::openRoad()->getThreadCount();
+  getGlobalRouter()->setNumThreads(num_threads);
   getGlobalRouter()->globalRoute(true, start_incremental, end_incremental);
 }
 
@@ -209,6 +211,12 @@ route_layer_lengths(odb::dbNet* db_net)
   return getGlobalRouter()->routeLayerLengths(db_net);
 }
 
+int
+global_route_overflow()
+{
+  return getGlobalRouter()->getOverflow();
+}
+
 void
 repair_antennas(odb::dbMTerm* diode_mterm, int iterations, float ratio_margin)
 {
@@ -40,12 +40,14 @@
 #include <boost/icl/interval.hpp>
 #include <boost/icl/interval_set.hpp>
 #include <boost/multi_array.hpp>
+#include <memory>
 #include <set>
 #include <unordered_map>
 #include <vector>
 
 #include "AbstractMakeWireParasitics.h"
 #include "DataType.h"
+#include "MazeHeap.h"
 #include "grt/GRoute.h"
 #include "odb/geom.h"
 #include "stt/SteinerTreeBuilder.h"
@@ -93,6 +95,46 @@ struct DebugSetting
 
 using stt::Tree;
 
+// Scratch state of the 2D maze router.  Each thread routing nets in
+// parallel owns one, so they only touch shared state through the edge
+// usages of the nets being routed.
+//
+// Each search of a tree edge starts a new generation.  A cell holds valid
+// search state only if it was reached in the current generation, so the
+// arrays are never cleared between searches and only the cells reached by
+// a search are touched.
+struct MazeScratch
+{
+  void resize(int x_range, int y_range);
+
+  // Starts the search of a tree edge, forgetting all reached cells
+  void newSearch();
+  bool reached(int cell) const { return stamp[cell] == generation; }
+  // Sets the distance from the source subtree of a cell reached for the
+  // first time
+  void reach(int x, int y, float dist);
+
+  int x_range = 0;
+  uint32_t generation = 0;
+  std::vector<uint32_t> stamp;
+  multi_array<float, 2> d1;
+  multi_array<short, 2> parent_x1;
+  multi_array<short, 2> parent_y1;
+  multi_array<short, 2> parent_x3;
+  multi_array<short, 2> parent_y3;
+  multi_array<bool, 2> hv;
+  multi_array<bool, 2> hyper_v;
+  multi_array<bool, 2> hyper_h;
+  multi_array<int, 2> corr_edge;
+  std::vector<bool> pop_heap2;
+  MazeHeap src_heap;
+  std::vector<int> dest_cells;
+  std::vector<OrderNetEdge> net_eo;
+  // Edges whose usage changed, merged into h/v_used_ggrid_ by the caller
+  std::vector<std::pair<int, int>> h_used_ggrid;
+  std::vector<std::pair<int, int>> v_used_ggrid;
+};
+
 class FastRouteCore
 {
  public:
@@ -184,6 +226,7 @@ class FastRouteCore
   void incrementEdge3DUsage(int x1, int y1, int x2, int y2, int layer);
   void setMaxNetDegree(int);
   void setVerbose(bool v);
+  void setNumThreads(int num_threads) { num_threads_ = num_threads; }
   void setCriticalNetsPercentage(float u);
   float getCriticalNetsPercentage() { return critical_nets_percentage_; };
   void setMakeWireParasiticsBuilder(AbstractMakeWireParasitics* builder);
@@ -251,6 +294,34 @@ class FastRouteCore
                      const int slope,
                      const int L,
                      float& slack_th);
+  bool mazeRouteMSMDNet(const int netID,
+                        const int iter,
+                        const int expand,
+                        const float cost_height,
+                        const int ripup_threshold,
+                        const int maze_edge_threshold,
+                        const int cost_type,
+                        const float logis_cof,
+                        const int via,
+                        const int slope,
+                        const int L,
+                        const float slack_th,
+                        const odb::Rect& bounds,
+                        MazeScratch& scratch,
+                        int& enlarge);
+  void mazeRouteMSMDParallel(const std::vector<int>& order,
+                             const int iter,
+                             const int expand,
+                             const float cost_height,
+                             const int ripup_threshold,
+                             const int maze_edge_threshold,
+                             const int cost_type,
+                             const float logis_cof,
+                             const int via,
+                             const int slope,
+                             const int L,
+                             const float slack_th);
+  void mergeUsedGGrids(MazeScratch& scratch);
   void convertToMazeroute();
   void updateCongestionHistory(const int upType, bool stopDEC, int& max_adj);
   int getOverflow2D(int* maxOverflow);
@@ -287,10 +358,7 @@ class FastRouteCore
   void convertToMazerouteNet(const int netID);
   void setupHeap(const int netID,
                  const int edgeID,
-                 std::vector<float*>& src_heap,
-                 std::vector<float*>& dest_heap,
-                 multi_array<float, 2>& d1,
-                 multi_array<float, 2>& d2,
+                 MazeScratch& scratch,
                  const int regionX1,
                  const int regionX2,
                  const int regionY1,
@@ -492,13 +560,17 @@ class FastRouteCore
   void assignEdge(int netID, int edgeID, bool processDIR);
   void recoverEdge(int netID, int edgeID);
   void layerAssignmentV4();
+  void layerAssignmentNet(int netID);
   void netpinOrderInc();
+  odb::Rect netRouteBounds(int netID, int expand) const;
+  std::vector<std::vector<int>> disjointNetBatches(
+      const std::vector<odb::Rect>& bounds) const;
   void checkRoute3D();
   void StNetOrder();
   float CalculatePartialSlack();
   bool checkRoute2DTree(int netID);
   void removeLoops();
-  void netedgeOrderDec(int netID);
+  void netedgeOrderDec(int netID, std::vector<OrderNetEdge>& net_eo);
   void printTree2D(int netID);
   void printEdge2D(int netID, int edgeID);
   void printEdge3D(int netID, int edgeID);
@@ -564,6 +636,7 @@ class FastRouteCore
   float h_capacity_lb_;
   bool regular_x_;
   bool regular_y_;
+  int num_threads_;
 
   std::vector<short> v_capacity_3D_;
   std::vector<short> h_capacity_3D_;
@@ -586,7 +659,6 @@ class FastRouteCore
 
   std::vector<FrNet*> nets_;
   std::unordered_map<odb::dbNet*, int> db_net_id_map_;  // db net -> net id
-  std::vector<OrderNetEdge> net_eo_;
   std::vector<std::vector<int>>
       gxs_;  // the copy of xs for nets, used for second FLUTE
   std::vector<std::vector<int>>
@@ -601,15 +673,8 @@ class FastRouteCore
   multi_array<Edge, 2> h_edges_;       // The way it is indexed is (Y, X)
   multi_array<Edge3D, 3> h_edges_3D_;  // The way it is indexed is (Layer, Y, X)
   multi_array<Edge3D, 3> v_edges_3D_;  // The way it is indexed is (Layer, Y, X)
-  multi_array<int, 2> corr_edge_;
-  multi_array<short, 2> parent_x1_;
-  multi_array<short, 2> parent_y1_;
-  multi_array<short, 2> parent_x3_;
-  multi_array<short, 2> parent_y3_;
-  multi_array<bool, 2> hv_;
-  multi_array<bool, 2> hyper_v_;
-  multi_array<bool, 2> hyper_h_;
   multi_array<bool, 2> in_region_;
+  std::vector<std::unique_ptr<MazeScratch>> maze_scratch_;
 
   std::vector<StTree> sttrees_;  // the Steiner trees
   std::vector<StTree> sttrees_bk_;
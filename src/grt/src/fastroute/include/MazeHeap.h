@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <vector>
+
+namespace grt {
+
+// Binary min-heap of the grid cells reached by the maze router, keyed by
+// their distance in an array owned by the caller.  The position of each
+// cell in the heap is tracked, so decreasing the key of a cell doesn't
+// search the heap.  Ties are broken as in a plain binary heap, so cells are
+// popped in the same order as with the pointer heap it replaces.  A cell
+// may be pushed more than once, like the source grids of the maze router,
+// as long as its key is never decreased afterwards.
+class MazeHeap
+{
+ public:
+  // dist[cell] is the key of cell, for cells in [0, num_cells)
+  void init(int num_cells, const float* dist)
+  {
+    heap_.clear();
+    pos_.assign(num_cells, -1);
+    dist_ = dist;
+  }
+
+  // Only touches the cells left in the heap
+  void clear()
+  {
+    for (const int cell : heap_) {
+      pos_[cell] = -1;
+    }
+    heap_.clear();
+  }
+
+  bool empty() const { return heap_.empty(); }
+  int size() const { return heap_.size(); }
+  bool contains(int cell) const { return pos_[cell] >= 0; }
+  int top() const { return heap_[0]; }
+
+  void push(const int cell)
+  {
+    heap_.push_back(cell);
+    siftUp(heap_.size() - 1);
+  }
+
+  // Restores the heap order after the key of cell decreased.  A cell
+  // already popped is pushed again.
+  void decrease(const int cell)
+  {
+    if (pos_[cell] < 0) {
+      push(cell);
+    } else {
+      siftUp(pos_[cell]);
+    }
+  }
+
+  void pop()
+  {
+    pos_[heap_[0]] = -1;
+    const int last = heap_.back();
+    heap_.pop_back();
+    if (!heap_.empty()) {
+      heap_[0] = last;
+      siftDown(0);
+    }
+  }
+
+ private:
+  void siftUp(int i)
+  {
+    const int cell = heap_[i];
+    const float key = dist_[cell];
+    while (i > 0) {
+      const int parent = (i - 1) / 2;
+      if (!(dist_[heap_[parent]] > key)) {
+        break;
+      }
+      heap_[i] = heap_[parent];
+      pos_[heap_[i]] = i;
+      i = parent;
+    }
+    heap_[i] = cell;
+    pos_[cell] = i;
+  }
+
+  void siftDown(int i)
+  {
+    const int size = heap_.size();
+    const int cell = heap_[i];
+    const float key = dist_[cell];
+    while (true) {
+      const int l = 2 * i + 1;
+      const int r = 2 * i + 2;
+      int smallest = i;
+      if (l < size && dist_[heap_[l]] < key) {
+        smallest = l;
+        if (r < size && dist_[heap_[r]] < dist_[heap_[l]]) {
+          smallest = r;
+        }
+      } else if (r < size && dist_[heap_[r]] < key) {
+        smallest = r;
+      }
+      if (smallest == i) {
+        break;
+      }
+      heap_[i] = heap_[smallest];
+      pos_[heap_[i]] = i;
+      i = smallest;
+    }
+    heap_[i] = cell;
+    pos_[cell] = i;
+  }
+
+  std::vector<int> heap_;
+  // Index of each cell in heap_, -1 if not in the heap
+  std::vector<int> pos_;
+  const float* dist_ = nullptr;
+};
+
+}  // namespace grt
@@ -30,29 +30,59 @@
 // POSSIBILITY OF SUCH DAMAGE.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <omp.h>
+
 #include <algorithm>
+#include <memory>
 
 #include "DataType.h"
 #include "FastRoute.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 namespace grt {
 
 using utl::GRT;
 
-static int parent_index(int i)
+void MazeScratch::resize(const int x_range, const int y_range)
 {
-  return (i - 1) / 2;
+  if (d1.shape()[0] == y_range && d1.shape()[1] == x_range) {
+    return;
+  }
+  this->x_range = x_range;
+  generation = 0;
+  stamp.assign(y_range * x_range, 0);
+  d1.resize(boost::extents[y_range][x_range]);
+  parent_x1.resize(boost::extents[y_range][x_range]);
+  parent_y1.resize(boost::extents[y_range][x_range]);
+  parent_x3.resize(boost::extents[y_range][x_range]);
+  parent_y3.resize(boost::extents[y_range][x_range]);
+  hv.resize(boost::extents[y_range][x_range]);
+  hyper_v.resize(boost::extents[y_range][x_range]);
+  hyper_h.resize(boost::extents[y_range][x_range]);
+  corr_edge.resize(boost::extents[y_range][x_range]);
+  pop_heap2.assign(y_range * x_range, false);
+  src_heap.init(y_range * x_range, d1.data());
 }
 
-static int left_index(int i)
+void MazeScratch::newSearch()
 {
-  return 2 * i + 1;
+  src_heap.clear();
+  dest_cells.clear();
+  generation++;
+  if (generation == 0) {
+    // The stamps wrapped around, cells of old searches would look reached
+    std::fill(stamp.begin(), stamp.end(), 0);
+    generation = 1;
+  }
 }
 
-static int right_index(int i)
+void MazeScratch::reach(const int x, const int y, const float dist)
 {
-  return 2 * i + 2;
+  stamp[y * x_range + x] = generation;
+  d1[y][x] = dist;
+  hyper_h[y][x] = false;
+  hyper_v[y][x] = false;
 }
 
 void FastRouteCore::fixEmbeddedTrees()
@@ -519,57 +549,6 @@ void FastRouteCore::convertToMazeroute()
   check2DEdgesUsage();
 }
 
-// non recursive version of heapify
-static void heapify(std::vector<float*>& array)
-{
-  bool stop = false;
-  const int heapSize = array.size();
-  int i = 0;
-
-  float* tmp = array[i];
-  do {
-    const int l = left_index(i);
-    const int r = right_index(i);
-
-    int smallest;
-    if (l < heapSize && *(array[l]) < *tmp) {
-      smallest = l;
-      if (r < heapSize && *(array[r]) < *(array[l]))
-        smallest = r;
-    } else {
-      smallest = i;
-      if (r < heapSize && *(array[r]) < *tmp)
-        smallest = r;
-    }
-    if (smallest != i) {
-      array[i] = array[smallest];
-      i = smallest;
-    } else {
-      array[i] = tmp;
-      stop = true;
-    }
-  } while (!stop);
-}
-
-static void updateHeap(std::vector<float*>& array, int i)
-{
-  float* tmpi = array[i];
-  while (i > 0 && *(array[parent_index(i)]) > *tmpi) {
-    const int parent = parent_index(i);
-    array[i] = array[parent];
-    i = parent;
-  }
-  array[i] = tmpi;
-}
-
-// remove the entry with minimum distance from Priority queue
-static void removeMin(std::vector<float*>& array)
-{
-  array[0] = array.back();
-  heapify(array);
-  array.pop_back();
-}
-
 /*
  * num_iteration : the total number of iterations for maze route to run
  * round : the number of maze route stages runned
@@ -721,28 +700,33 @@ void FastRouteCore::updateCongestionHistory(const int upType,
 }
 
 // ripup a tree edge according to its ripup type and Z-route it
-// put all the nodes in the subtree t1 and t2 into src_heap and dest_heap
-// netID     - the ID for the net
-// edgeID    - the ID for the tree edge to route
-// d1        - the distance of any grid from the source subtree t1
-// d2        - the distance of any grid from the destination subtree t2
-// src_heap  - the heap storing the addresses for d1
-// dest_heap - the heap storing the addresses for d2
+// put all the nodes in the subtree t1 and t2 into src_heap and dest_cells
+// netID      - the ID for the net
+// edgeID     - the ID for the tree edge to route
+// d1         - the distance of any grid from the source subtree t1
+// src_heap   - the heap of the grids reached from t1, keyed by d1
+// dest_cells - the grids of the destination subtree t2
 void FastRouteCore::setupHeap(const int netID,
                               const int edgeID,
-                              std::vector<float*>& src_heap,
-                              std::vector<float*>& dest_heap,
-                              multi_array<float, 2>& d1,
-                              multi_array<float, 2>& d2,
+                              MazeScratch& scratch,
                               const int regionX1,
                               const int regionX2,
                               const int regionY1,
                               const int regionY2)
 {
-  for (int i = regionY1; i <= regionY2; i++) {
-    for (int j = regionX1; j <= regionX2; j++)
-      in_region_[i][j] = true;
-  }
+  MazeHeap& src_heap = scratch.src_heap;
+  std::vector<int>& dest_cells = scratch.dest_cells;
+  multi_array<int, 2>& corr_edge = scratch.corr_edge;
+
+  auto in_region = [=](const int x, const int y) {
+    return x >= regionX1 && x <= regionX2 && y >= regionY1 && y <= regionY2;
+  };
+  // A grid on more than one edge of the subtree is pushed once per edge,
+  // as the heap order of the equal keys decides the routes
+  auto add_source = [&](const int x, const int y) {
+    scratch.reach(x, y, 0);
+    src_heap.push(y * x_range_ + x);
+  };
 
   const auto& treeedges = sttrees_[netID].edges;
   const auto& treenodes = sttrees_[netID].nodes;
@@ -755,15 +739,10 @@ void FastRouteCore::setupHeap(const int netID,
   const int x2 = treenodes[n2].x;
   const int y2 = treenodes[n2].y;
 
-  src_heap.clear();
-  dest_heap.clear();
-
   if (num_terminals == 2)  // 2-pin net
   {
-    d1[y1][x1] = 0;
-    src_heap.push_back(&d1[y1][x1]);
-    d2[y2][x2] = 0;
-    dest_heap.push_back(&d2[y2][x2]);
+    add_source(x1, y1);
+    dest_cells.push_back(y2 * x_range_ + x2);
   } else {  // net with more than 2 pins
     const int numNodes = sttrees_[netID].num_nodes();
 
@@ -776,8 +755,7 @@ void FastRouteCore::setupHeap(const int netID,
     int queuetail = 0;
 
     // add n1 into src_heap
-    d1[y1][x1] = 0;
-    src_heap.push_back(&d1[y1][x1]);
+    add_source(x1, y1);
     visited[n1] = true;
 
     // add n1 into the queue
@@ -808,12 +786,11 @@ void FastRouteCore::setupHeap(const int netID,
         if (treeedges[edge].route.routelen > 0) {  // not a degraded edge
           // put nbr into src_heap if in enlarged region
           const TreeNode& nbr_node = treenodes[nbr];
-          if (in_region_[nbr_node.y][nbr_node.x]) {
+          if (in_region(nbr_node.x, nbr_node.y)) {
             const int nbrX = nbr_node.x;
             const int nbrY = nbr_node.y;
-            d1[nbrY][nbrX] = 0;
-            src_heap.push_back(&d1[nbrY][nbrX]);
-            corr_edge_[nbrY][nbrX] = edge;
+            add_source(nbrX, nbrY);
+            corr_edge[nbrY][nbrX] = edge;
           }
           const Route* route = &(treeedges[edge].route);
           if (route->type != RouteType::MazeRoute) {
@@ -825,10 +802,9 @@ void FastRouteCore::setupHeap(const int netID,
             const int x_grid = route->gridsX[j];
             const int y_grid = route->gridsY[j];
 
-            if (in_region_[y_grid][x_grid]) {
-              d1[y_grid][x_grid] = 0;
-              src_heap.push_back(&d1[y_grid][x_grid]);
-              corr_edge_[y_grid][x_grid] = edge;
+            if (in_region(x_grid, y_grid)) {
+              add_source(x_grid, y_grid);
+              corr_edge[y_grid][x_grid] = edge;
             }
           }
         }  // if not a degraded edge (len>0)
@@ -846,8 +822,7 @@ void FastRouteCore::setupHeap(const int netID,
     queuetail = 0;
 
     // add n2 into dest_heap
-    d2[y2][x2] = 0;
-    dest_heap.push_back(&d2[y2][x2]);
+    dest_cells.push_back(y2 * x_range_ + x2);
     visited[n2] = true;
 
     // add n2 into the queue
@@ -878,12 +853,11 @@ void FastRouteCore::setupHeap(const int netID,
         if (treeedges[edge].route.routelen > 0) {  // not a degraded edge
           // put nbr into dest_heap
           const TreeNode& nbr_node = treenodes[nbr];
-          if (in_region_[nbr_node.y][nbr_node.x]) {
+          if (in_region(nbr_node.x, nbr_node.y)) {
             const int nbrX = nbr_node.x;
             const int nbrY = nbr_node.y;
-            d2[nbrY][nbrX] = 0;
-            dest_heap.push_back(&d2[nbrY][nbrX]);
-            corr_edge_[nbrY][nbrX] = edge;
+            dest_cells.push_back(nbrY * x_range_ + nbrX);
+            corr_edge[nbrY][nbrX] = edge;
           }
 
           const Route* route = &(treeedges[edge].route);
@@ -895,10 +869,9 @@ void FastRouteCore::setupHeap(const int netID,
           for (int j = 1; j < route->routelen; j++) {
             const int x_grid = route->gridsX[j];
             const int y_grid = route->gridsY[j];
-            if (in_region_[y_grid][x_grid]) {
-              d2[y_grid][x_grid] = 0;
-              dest_heap.push_back(&d2[y_grid][x_grid]);
-              corr_edge_[y_grid][x_grid] = edge;
+            if (in_region(x_grid, y_grid)) {
+              dest_cells.push_back(y_grid * x_range_ + x_grid);
+              corr_edge[y_grid][x_grid] = edge;
             }
           }
         }  // if the edge is not degraded (len>0)
@@ -909,11 +882,6 @@ void FastRouteCore::setupHeap(const int netID,
       }  // loop i (3 neigbors for cur node)
     }    // while queue is not empty
   }      // net with more than two pins
-
-  for (int i = regionY1; i <= regionY2; i++) {
-    for (int j = regionX1; j <= regionX2; j++)
-      in_region_[i][j] = false;
-  }
 }
 
 int FastRouteCore::copyGrids(const std::vector<TreeNode>& treenodes,
@@ -1317,8 +1285,6 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
                                   float& slack_th)
 {
   // maze routing for multi-source, multi-destination
-  int tmpX, tmpY;
-
   const int max_usage_multiplier = 40;
 
   // allocate memory for distance and parent and pop_heap
@@ -1334,11 +1300,6 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
         = getCost(i, logis_cof, cost_height, slope, v_capacity_, cost_type);
   }
 
-  for (int i = 0; i < y_grid_; i++) {
-    for (int j = 0; j < x_grid_; j++)
-      in_region_[i][j] = false;
-  }
-
   if (ordering) {
     if (critical_nets_percentage_) {
       slack_th = CalculatePartialSlack();
@@ -1346,787 +1307,932 @@ void FastRouteCore::mazeRouteMSMD(const int iter,
     StNetOrder();
   }
 
-  std::vector<float*> src_heap;
-  std::vector<float*> dest_heap;
-  src_heap.reserve(y_grid_ * x_grid_);
-  dest_heap.reserve(y_grid_ * x_grid_);
-
-  multi_array<float, 2> d1(boost::extents[y_range_][x_range_]);
-  multi_array<float, 2> d2(boost::extents[y_range_][x_range_]);
-
-  std::vector<bool> pop_heap2(y_grid_ * x_range_, false);
+  const int num_scratch = std::max(num_threads_, 1);
+  maze_scratch_.resize(num_scratch);
+  for (std::unique_ptr<MazeScratch>& scratch : maze_scratch_) {
+    if (scratch == nullptr) {
+      scratch = std::make_unique<MazeScratch>();
+    }
+    scratch->resize(x_range_, y_range_);
+  }
 
+  std::vector<int> order(net_ids_.size());
   for (int nidRPC = 0; nidRPC < net_ids_.size(); nidRPC++) {
-    const int netID
+    order[nidRPC]
         = ordering ? tree_order_cong_[nidRPC].treeIndex : net_ids_[nidRPC];
+  }
 
-    const int num_terminals = sttrees_[netID].num_terminals;
+  if (num_threads_ > 1) {
+    mazeRouteMSMDParallel(order,
+                          iter,
+                          expand,
+                          cost_height,
+                          ripup_threshold,
+                          maze_edge_threshold,
+                          cost_type,
+                          logis_cof,
+                          via,
+                          slope,
+                          L,
+                          slack_th);
+  } else {
+    MazeScratch& scratch = *maze_scratch_[0];
+    const odb::Rect grid(0, 0, x_grid_ - 1, y_grid_ - 1);
+    for (const int netID : order) {
+      while (!mazeRouteMSMDNet(netID,
+                               iter,
+                               expand,
+                               cost_height,
+                               ripup_threshold,
+                               maze_edge_threshold,
+                               cost_type,
+                               logis_cof,
+                               via,
+                               slope,
+                               L,
+                               slack_th,
+                               grid,
+                               scratch,
+                               enlarge_)) {
+        reInitTree(netID);
+      }
+      mergeUsedGGrids(scratch);
+    }
+  }
 
-    const int origENG = expand;
+  h_cost_table_.clear();
+  v_cost_table_.clear();
+}
 
-    netedgeOrderDec(netID);
+// Rip-up and maze route the edges of a net.  Routing regions are clipped to
+// bounds.  Returns false if the tree of the net could not be updated, in
+// which case it must be reinitialized and routed again.
+bool FastRouteCore::mazeRouteMSMDNet(const int netID,
+                                     const int iter,
+                                     const int expand,
+                                     const float cost_height,
+                                     const int ripup_threshold,
+                                     const int maze_edge_threshold,
+                                     const int cost_type,
+                                     const float logis_cof,
+                                     const int via,
+                                     const int slope,
+                                     const int L,
+                                     const float slack_th,
+                                     const odb::Rect& bounds,
+                                     MazeScratch& scratch,
+                                     int& enlarge)
+{
+  MazeHeap& src_heap = scratch.src_heap;
+  const std::vector<int>& dest_cells = scratch.dest_cells;
+  multi_array<float, 2>& d1 = scratch.d1;
+  multi_array<short, 2>& parent_x1 = scratch.parent_x1;
+  multi_array<short, 2>& parent_y1 = scratch.parent_y1;
+  multi_array<short, 2>& parent_x3 = scratch.parent_x3;
+  multi_array<short, 2>& parent_y3 = scratch.parent_y3;
+  multi_array<bool, 2>& hv = scratch.hv;
+  multi_array<bool, 2>& hyper_v = scratch.hyper_v;
+  multi_array<bool, 2>& hyper_h = scratch.hyper_h;
+  multi_array<int, 2>& corr_edge = scratch.corr_edge;
+  std::vector<bool>& pop_heap2 = scratch.pop_heap2;
+  std::vector<OrderNetEdge>& net_eo = scratch.net_eo;
 
-    auto& treeedges = sttrees_[netID].edges;
-    auto& treenodes = sttrees_[netID].nodes;
-    // loop for all the tree edges
-    const int num_edges = sttrees_[netID].num_edges();
-    for (int edgeREC = 0; edgeREC < num_edges; edgeREC++) {
-      const int edgeID = net_eo_[edgeREC].edgeID;
-      TreeEdge* treeedge = &(treeedges[edgeID]);
-
-      int n1 = treeedge->n1;
-      int n2 = treeedge->n2;
-      const int n1x = treenodes[n1].x;
-      const int n1y = treenodes[n1].y;
-      const int n2x = treenodes[n2].x;
-      const int n2y = treenodes[n2].y;
-      treeedge->len = abs(n2x - n1x) + abs(n2y - n1y);
-
-      if (treeedge->len
-          <= maze_edge_threshold)  // only route the non-degraded edges (len>0)
-      {
-        continue;
-      }
+  int tmpX, tmpY;
 
-      const bool enter = newRipupCheck(treeedge,
-                                       n1x,
-                                       n1y,
-                                       n2x,
-                                       n2y,
-                                       ripup_threshold,
-                                       slack_th,
-                                       netID,
-                                       edgeID);
-
-      if (!enter) {
-        continue;
-      }
+  auto dist = [&](const int x, const int y) -> float {
+    return scratch.reached(y * x_range_ + x) ? d1[y][x] : BIG_INT;
+  };
 
-      // ripup the routing for the edge
-      const int ymin = std::min(n1y, n2y);
-      const int ymax = std::max(n1y, n2y);
+  const int num_terminals = sttrees_[netID].num_terminals;
 
-      const int xmin = std::min(n1x, n2x);
-      const int xmax = std::max(n1x, n2x);
+  const int origENG = expand;
 
-      enlarge_ = std::min(origENG, (iter / 6 + 3) * treeedge->route.routelen);
+  netedgeOrderDec(netID, net_eo);
 
-      int decrease = 0;
+  auto& treeedges = sttrees_[netID].edges;
+  auto& treenodes = sttrees_[netID].nodes;
+  // loop for all the tree edges
+  const int num_edges = sttrees_[netID].num_edges();
+  for (int edgeREC = 0; edgeREC < num_edges; edgeREC++) {
+    const int edgeID = net_eo[edgeREC].edgeID;
+    TreeEdge* treeedge = &(treeedges[edgeID]);
+
+    int n1 = treeedge->n1;
+    int n2 = treeedge->n2;
+    const int n1x = treenodes[n1].x;
+    const int n1y = treenodes[n1].y;
+    const int n2x = treenodes[n2].x;
+    const int n2y = treenodes[n2].y;
+    treeedge->len = abs(n2x - n1x) + abs(n2y - n1y);
+
+    if (treeedge->len
+        <= maze_edge_threshold)  // only route the non-degraded edges (len>0)
+    {
+      continue;
+    }
 
-      if (nets_[netID]->isCritical()) {
-        decrease = std::min((iter / 7) * 5, enlarge_ / 2);
-      }
-      const int regionX1 = std::max(xmin - enlarge_ + decrease, 0);
-      const int regionX2 = std::min(xmax + enlarge_ - decrease, x_grid_ - 1);
-      const int regionY1 = std::max(ymin - enlarge_ + decrease, 0);
-      const int regionY2 = std::min(ymax + enlarge_ - decrease, y_grid_ - 1);
-
-      // initialize d1[][] and d2[][] as BIG_INT
-      for (int i = regionY1; i <= regionY2; i++) {
-        for (int j = regionX1; j <= regionX2; j++) {
-          d1[i][j] = BIG_INT;
-          d2[i][j] = BIG_INT;
-          hyper_h_[i][j] = false;
-          hyper_v_[i][j] = false;
-        }
-      }
+    const bool enter = newRipupCheck(treeedge,
+                                     n1x,
+                                     n1y,
+                                     n2x,
+                                     n2y,
+                                     ripup_threshold,
+                                     slack_th,
+                                     netID,
+                                     edgeID);
 
-      // setup src_heap, dest_heap and initialize d1[][] and d2[][] for all the
-      // grids on the two subtrees
-      setupHeap(netID,
-                edgeID,
-                src_heap,
-                dest_heap,
-                d1,
-                d2,
-                regionX1,
-                regionX2,
-                regionY1,
-                regionY2);
-
-      // while loop to find shortest path
-      int ind1 = (src_heap[0] - &d1[0][0]);
-      for (int i = 0; i < dest_heap.size(); i++)
-        pop_heap2[(dest_heap[i] - &d2[0][0])] = true;
-
-      // stop when the grid position been popped out from both src_heap and
-      // dest_heap
-      while (pop_heap2[ind1] == false) {
-        // relax all the adjacent grids within the enlarged region for
-        // source subtree
-        const int curX = ind1 % x_range_;
-        const int curY = ind1 / x_range_;
-        int preX, preY;
-        if (d1[curY][curX] != 0) {
-          if (hv_[curY][curX]) {
-            preX = parent_x1_[curY][curX];
-            preY = parent_y1_[curY][curX];
-          } else {
-            preX = parent_x3_[curY][curX];
-            preY = parent_y3_[curY][curX];
-          }
+    if (!enter) {
+      continue;
+    }
+
+    // ripup the routing for the edge
+    const int ymin = std::min(n1y, n2y);
+    const int ymax = std::max(n1y, n2y);
+
+    const int xmin = std::min(n1x, n2x);
+    const int xmax = std::max(n1x, n2x);
+
+    enlarge = std::min(origENG, (iter / 6 + 3) * treeedge->route.routelen);
+
+    int decrease = 0;
+
+    if (nets_[netID]->isCritical()) {
+      decrease = std::min((iter / 7) * 5, enlarge / 2);
+    }
+    const int regionX1 = std::max(xmin - enlarge + decrease, bounds.xMin());
+    const int regionX2 = std::min(xmax + enlarge - decrease, bounds.xMax());
+    const int regionY1 = std::max(ymin - enlarge + decrease, bounds.yMin());
+    const int regionY2 = std::min(ymax + enlarge - decrease, bounds.yMax());
+
+    // grids not reached by this search have d1[][] = BIG_INT
+    scratch.newSearch();
+
+    // setup src_heap and dest_cells and initialize d1[][] for all the grids
+    // on the two subtrees
+    setupHeap(netID,
+              edgeID,
+              scratch,
+              regionX1,
+              regionX2,
+              regionY1,
+              regionY2);
+
+    // while loop to find shortest path
+    int ind1 = src_heap.top();
+    for (const int cell : dest_cells) {
+      pop_heap2[cell] = true;
+    }
+
+    // stop when the grid position been popped out from both src_heap and
+    // dest_heap
+    while (pop_heap2[ind1] == false) {
+      // relax all the adjacent grids within the enlarged region for
+      // source subtree
+      const int curX = ind1 % x_range_;
+      const int curY = ind1 / x_range_;
+      int preX, preY;
+      if (d1[curY][curX] != 0) {
+        if (hv[curY][curX]) {
+          preX = parent_x1[curY][curX];
+          preY = parent_y1[curY][curX];
         } else {
-          preX = curX;
-          preY = curY;
+          preX = parent_x3[curY][curX];
+          preY = parent_y3[curY][curX];
         }
+      } else {
+        preX = curX;
+        preY = curY;
+      }
+
+      src_heap.pop();
 
-        removeMin(src_heap);
-
-        // left
-        if (curX > regionX1) {
-          float tmp, cost1, cost2;
-          const int pos1 = h_edges_[curY][curX - 1].usage_red()
-                           + L * h_edges_[curY][(curX - 1)].last_usage;
-
-          if (pos1 < h_cost_table_.size())
-            cost1 = h_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
-
-          if ((preY == curY) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curX < regionX2 - 1) {
-              const int pos2 = h_edges_[curY][curX].usage_red()
-                               + L * h_edges_[curY][curX].last_usage;
-
-              if (pos2 < h_cost_table_.size())
-                cost2 = h_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                h_capacity_,
-                                cost_type);
-
-              const int tmp_cost = d1[curY][curX + 1] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_h_[curY][curX] = true;
-              }
+      // left
+      if (curX > regionX1) {
+        float tmp, cost1, cost2;
+        const int pos1 = h_edges_[curY][curX - 1].usage_red()
+                         + L * h_edges_[curY][(curX - 1)].last_usage;
+
+        if (pos1 < h_cost_table_.size())
+          cost1 = h_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
+
+        if ((preY == curY) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curX < regionX2 - 1) {
+            const int pos2 = h_edges_[curY][curX].usage_red()
+                             + L * h_edges_[curY][curX].last_usage;
+
+            if (pos2 < h_cost_table_.size())
+              cost2 = h_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              h_capacity_,
+                              cost_type);
+
+            const int tmp_cost = dist(curX + 1, curY) + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_h[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpX = curX - 1;  // the left neighbor
-
-          if (d1[curY][tmpX]
-              >= BIG_INT)  // left neighbor not been put into src_heap
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            src_heap.push_back(&d1[curY][tmpX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[curY][tmpX] > tmp)  // left neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            float* dtmp = &d1[curY][tmpX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
+        }
+        tmpX = curX - 1;  // the left neighbor
+
+        // left neighbor not been put into src_heap
+        if (!scratch.reached(curY * x_range_ + tmpX)) {
+          scratch.reach(tmpX, curY, tmp);
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          src_heap.push(curY * x_range_ + tmpX);
+        } else if (d1[curY][tmpX] > tmp)  // left neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          src_heap.decrease(curY * x_range_ + tmpX);
         }
-        // right
-        if (curX < regionX2) {
-          float tmp, cost1, cost2;
-          const int pos1 = h_edges_[curY][curX].usage_red()
-                           + L * h_edges_[curY][curX].last_usage;
-
-          if (pos1 < h_cost_table_.size())
-            cost1 = h_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
-
-          if ((preY == curY) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curX > regionX1 + 1) {
-              const int pos2 = h_edges_[curY][curX - 1].usage_red()
-                               + L * h_edges_[curY][curX - 1].last_usage;
-
-              if (pos2 < h_cost_table_.size())
-                cost2 = h_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                h_capacity_,
-                                cost_type);
-              const int tmp_cost = d1[curY][curX - 1] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_h_[curY][curX] = true;
-              }
+      }
+      // right
+      if (curX < regionX2) {
+        float tmp, cost1, cost2;
+        const int pos1 = h_edges_[curY][curX].usage_red()
+                         + L * h_edges_[curY][curX].last_usage;
+
+        if (pos1 < h_cost_table_.size())
+          cost1 = h_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, h_capacity_, cost_type);
+
+        if ((preY == curY) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curX > regionX1 + 1) {
+            const int pos2 = h_edges_[curY][curX - 1].usage_red()
+                             + L * h_edges_[curY][curX - 1].last_usage;
+
+            if (pos2 < h_cost_table_.size())
+              cost2 = h_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              h_capacity_,
+                              cost_type);
+            const int tmp_cost = dist(curX - 1, curY) + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_h[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpX = curX + 1;  // the right neighbor
-
-          if (d1[curY][tmpX]
-              >= BIG_INT)  // right neighbor not been put into src_heap
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            src_heap.push_back(&d1[curY][tmpX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[curY][tmpX] > tmp)  // right neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[curY][tmpX] = tmp;
-            parent_x3_[curY][tmpX] = curX;
-            parent_y3_[curY][tmpX] = curY;
-            hv_[curY][tmpX] = false;
-            float* dtmp = &d1[curY][tmpX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
+        }
+        tmpX = curX + 1;  // the right neighbor
+
+        // right neighbor not been put into src_heap
+        if (!scratch.reached(curY * x_range_ + tmpX)) {
+          scratch.reach(tmpX, curY, tmp);
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          src_heap.push(curY * x_range_ + tmpX);
+        } else if (d1[curY][tmpX] > tmp)  // right neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[curY][tmpX] = tmp;
+          parent_x3[curY][tmpX] = curX;
+          parent_y3[curY][tmpX] = curY;
+          hv[curY][tmpX] = false;
+          src_heap.decrease(curY * x_range_ + tmpX);
         }
-        // bottom
-        if (curY > regionY1) {
-          float tmp, cost1, cost2;
-          const int pos1 = v_edges_[curY - 1][curX].usage_red()
-                           + L * v_edges_[curY - 1][curX].last_usage;
-
-          if (pos1 < v_cost_table_.size())
-            cost1 = v_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
-
-          if ((preX == curX) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curY < regionY2 - 1) {
-              const int pos2 = v_edges_[curY][curX].usage_red()
-                               + L * v_edges_[curY][curX].last_usage;
-
-              if (pos2 < v_cost_table_.size())
-                cost2 = v_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                v_capacity_,
-                                cost_type);
-              const int tmp_cost = d1[curY + 1][curX] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_v_[curY][curX] = true;
-              }
+      }
+      // bottom
+      if (curY > regionY1) {
+        float tmp, cost1, cost2;
+        const int pos1 = v_edges_[curY - 1][curX].usage_red()
+                         + L * v_edges_[curY - 1][curX].last_usage;
+
+        if (pos1 < v_cost_table_.size())
+          cost1 = v_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
+
+        if ((preX == curX) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curY < regionY2 - 1) {
+            const int pos2 = v_edges_[curY][curX].usage_red()
+                             + L * v_edges_[curY][curX].last_usage;
+
+            if (pos2 < v_cost_table_.size())
+              cost2 = v_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              v_capacity_,
+                              cost_type);
+            const int tmp_cost = dist(curX, curY + 1) + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_v[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpY = curY - 1;  // the bottom neighbor
-          if (d1[tmpY][curX]
-              >= BIG_INT)  // bottom neighbor not been put into src_heap
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            src_heap.push_back(&d1[tmpY][curX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[tmpY][curX] > tmp)  // bottom neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            float* dtmp = &d1[tmpY][curX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
         }
-        // top
-        if (curY < regionY2) {
-          float tmp, cost1, cost2;
-          const int pos1 = v_edges_[curY][curX].usage_red()
-                           + L * v_edges_[curY][curX].last_usage;
-
-          if (pos1 < v_cost_table_.size())
-            cost1 = v_cost_table_.at(pos1);
-          else
-            cost1 = getCost(
-                pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
-
-          if ((preX == curX) || (d1[curY][curX] == 0)) {
-            tmp = d1[curY][curX] + cost1;
-          } else {
-            if (curY > regionY1 + 1) {
-              const int pos2 = v_edges_[curY - 1][curX].usage_red()
-                               + L * v_edges_[curY - 1][curX].last_usage;
-
-              if (pos2 < v_cost_table_.size())
-                cost2 = v_cost_table_.at(pos2);
-              else
-                cost2 = getCost(pos2,
-                                logis_cof,
-                                cost_height,
-                                slope,
-                                v_capacity_,
-                                cost_type);
-
-              const int tmp_cost = d1[curY - 1][curX] + cost2;
-
-              if (tmp_cost < d1[curY][curX] + via) {
-                hyper_v_[curY][curX] = true;
-              }
+        tmpY = curY - 1;  // the bottom neighbor
+        // bottom neighbor not been put into src_heap
+        if (!scratch.reached(tmpY * x_range_ + curX)) {
+          scratch.reach(curX, tmpY, tmp);
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          src_heap.push(tmpY * x_range_ + curX);
+        } else if (d1[tmpY][curX] > tmp)  // bottom neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          src_heap.decrease(tmpY * x_range_ + curX);
+        }
+      }
+      // top
+      if (curY < regionY2) {
+        float tmp, cost1, cost2;
+        const int pos1 = v_edges_[curY][curX].usage_red()
+                         + L * v_edges_[curY][curX].last_usage;
+
+        if (pos1 < v_cost_table_.size())
+          cost1 = v_cost_table_.at(pos1);
+        else
+          cost1 = getCost(
+              pos1, logis_cof, cost_height, slope, v_capacity_, cost_type);
+
+        if ((preX == curX) || (d1[curY][curX] == 0)) {
+          tmp = d1[curY][curX] + cost1;
+        } else {
+          if (curY > regionY1 + 1) {
+            const int pos2 = v_edges_[curY - 1][curX].usage_red()
+                             + L * v_edges_[curY - 1][curX].last_usage;
+
+            if (pos2 < v_cost_table_.size())
+              cost2 = v_cost_table_.at(pos2);
+            else
+              cost2 = getCost(pos2,
+                              logis_cof,
+                              cost_height,
+                              slope,
+                              v_capacity_,
+                              cost_type);
+
+            const int tmp_cost = dist(curX, curY - 1) + cost2;
+
+            if (tmp_cost < d1[curY][curX] + via) {
+              hyper_v[curY][curX] = true;
             }
-            tmp = d1[curY][curX] + via + cost1;
-          }
-          tmpY = curY + 1;  // the top neighbor
-          if (d1[tmpY][curX]
-              >= BIG_INT)  // top neighbor not been put into src_heap
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            src_heap.push_back(&d1[tmpY][curX]);
-            updateHeap(src_heap, src_heap.size() - 1);
-          } else if (d1[tmpY][curX] > tmp)  // top neighbor been put into
-                                            // src_heap but needs update
-          {
-            d1[tmpY][curX] = tmp;
-            parent_x1_[tmpY][curX] = curX;
-            parent_y1_[tmpY][curX] = curY;
-            hv_[tmpY][curX] = true;
-            float* dtmp = &d1[tmpY][curX];
-            int ind = 0;
-            while (src_heap[ind] != dtmp)
-              ind++;
-            updateHeap(src_heap, ind);
           }
+          tmp = d1[curY][curX] + via + cost1;
         }
+        tmpY = curY + 1;  // the top neighbor
+        // top neighbor not been put into src_heap
+        if (!scratch.reached(tmpY * x_range_ + curX)) {
+          scratch.reach(curX, tmpY, tmp);
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          src_heap.push(tmpY * x_range_ + curX);
+        } else if (d1[tmpY][curX] > tmp)  // top neighbor been put into
+                                          // src_heap but needs update
+        {
+          d1[tmpY][curX] = tmp;
+          parent_x1[tmpY][curX] = curX;
+          parent_y1[tmpY][curX] = curY;
+          hv[tmpY][curX] = true;
+          src_heap.decrease(tmpY * x_range_ + curX);
+        }
+      }
 
-        // update ind1 for next loop
-        ind1 = (src_heap[0] - &d1[0][0]);
+      // update ind1 for next loop
+      ind1 = src_heap.top();
 
-      }  // while loop
+    }  // while loop
 
-      for (int i = 0; i < dest_heap.size(); i++)
-        pop_heap2[(dest_heap[i] - &d2[0][0])] = false;
+    for (const int cell : dest_cells) {
+      pop_heap2[cell] = false;
+    }
 
-      const int crossX = ind1 % x_range_;
-      const int crossY = ind1 / x_range_;
+    const int crossX = ind1 % x_range_;
+    const int crossY = ind1 / x_range_;
 
-      int cnt = 0;
-      int curX = crossX;
-      int curY = crossY;
-      std::vector<int> tmp_gridsX, tmp_gridsY;
-      while (d1[curY][curX] != 0)  // loop until reach subtree1
-      {
-        bool hypered = false;
-        if (cnt != 0) {
-          if (curX != tmpX && hyper_h_[curY][curX]) {
-            curX = 2 * curX - tmpX;
-            hypered = true;
-          }
+    int cnt = 0;
+    int curX = crossX;
+    int curY = crossY;
+    std::vector<int> tmp_gridsX, tmp_gridsY;
+    while (d1[curY][curX] != 0)  // loop until reach subtree1
+    {
+      bool hypered = false;
+      if (cnt != 0) {
+        if (curX != tmpX && hyper_h[curY][curX]) {
+          curX = 2 * curX - tmpX;
+          hypered = true;
+        }
 
-          if (curY != tmpY && hyper_v_[curY][curX]) {
-            curY = 2 * curY - tmpY;
-            hypered = true;
-          }
+        if (curY != tmpY && hyper_v[curY][curX]) {
+          curY = 2 * curY - tmpY;
+          hypered = true;
         }
-        tmpX = curX;
-        tmpY = curY;
-        if (!hypered) {
-          if (hv_[tmpY][tmpX]) {
-            curY = parent_y1_[tmpY][tmpX];
-          } else {
-            curX = parent_x3_[tmpY][tmpX];
-          }
+      }
+      tmpX = curX;
+      tmpY = curY;
+      if (!hypered) {
+        if (hv[tmpY][tmpX]) {
+          curY = parent_y1[tmpY][tmpX];
+        } else {
+          curX = parent_x3[tmpY][tmpX];
         }
-        tmp_gridsX.push_back(curX);
-        tmp_gridsY.push_back(curY);
-        cnt++;
       }
-      // reverse the grids on the path
-      std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
-      std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
-
-      // add the connection point (crossX, crossY)
-      gridsX.push_back(crossX);
-      gridsY.push_back(crossY);
+      tmp_gridsX.push_back(curX);
+      tmp_gridsY.push_back(curY);
       cnt++;
+    }
+    // reverse the grids on the path
+    std::vector<int> gridsX(tmp_gridsX.rbegin(), tmp_gridsX.rend());
+    std::vector<int> gridsY(tmp_gridsY.rbegin(), tmp_gridsY.rend());
+
+    // add the connection point (crossX, crossY)
+    gridsX.push_back(crossX);
+    gridsY.push_back(crossY);
+    cnt++;
 
-      curX = crossX;
-      curY = crossY;
-      const int cnt_n1n2 = cnt;
-
-      // change the tree structure according to the new routing for the tree
-      // edge find E1 and E2, and the endpoints of the edges they are on
-      const int E1x = gridsX[0];
-      const int E1y = gridsY[0];
-      const int E2x = gridsX.back();
-      const int E2y = gridsY.back();
-
-      const int edge_n1n2 = edgeID;
-      // (1) consider subtree1
-      if (n1 < num_terminals && (E1x != n1x || E1y != n1y)) {
-        // split neighbor edge and return id new node
-        n1 = splitEdge(treeedges, treenodes, n2, n1, edgeID);
+    curX = crossX;
+    curY = crossY;
+    const int cnt_n1n2 = cnt;
+
+    // change the tree structure according to the new routing for the tree
+    // edge find E1 and E2, and the endpoints of the edges they are on
+    const int E1x = gridsX[0];
+    const int E1y = gridsY[0];
+    const int E2x = gridsX.back();
+    const int E2y = gridsY.back();
+
+    const int edge_n1n2 = edgeID;
+    // (1) consider subtree1
+    if (n1 < num_terminals && (E1x != n1x || E1y != n1y)) {
+      // split neighbor edge and return id new node
+      n1 = splitEdge(treeedges, treenodes, n2, n1, edgeID);
+    }
+    if (n1 >= num_terminals && (E1x != n1x || E1y != n1y))
+    // n1 is not a pin and E1!=n1, then make change to subtree1,
+    // otherwise, no change to subtree1
+    {
+      // find the endpoints of the edge E1 is on
+      const int endpt1 = treeedges[corr_edge[E1y][E1x]].n1;
+      const int endpt2 = treeedges[corr_edge[E1y][E1x]].n2;
+
+      // find A1, A2 and edge_n1A1, edge_n1A2
+      int A1, A2;
+      int edge_n1A1, edge_n1A2;
+      if (treenodes[n1].nbr[0] == n2) {
+        A1 = treenodes[n1].nbr[1];
+        A2 = treenodes[n1].nbr[2];
+        edge_n1A1 = treenodes[n1].edge[1];
+        edge_n1A2 = treenodes[n1].edge[2];
+      } else if (treenodes[n1].nbr[1] == n2) {
+        A1 = treenodes[n1].nbr[0];
+        A2 = treenodes[n1].nbr[2];
+        edge_n1A1 = treenodes[n1].edge[0];
+        edge_n1A2 = treenodes[n1].edge[2];
+      } else {
+        A1 = treenodes[n1].nbr[0];
+        A2 = treenodes[n1].nbr[1];
+        edge_n1A1 = treenodes[n1].edge[0];
+        edge_n1A2 = treenodes[n1].edge[1];
       }
-      if (n1 >= num_terminals && (E1x != n1x || E1y != n1y))
-      // n1 is not a pin and E1!=n1, then make change to subtree1,
-      // otherwise, no change to subtree1
+
+      if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
       {
-        // find the endpoints of the edge E1 is on
-        const int endpt1 = treeedges[corr_edge_[E1y][E1x]].n1;
-        const int endpt2 = treeedges[corr_edge_[E1y][E1x]].n2;
-
-        // find A1, A2 and edge_n1A1, edge_n1A2
-        int A1, A2;
-        int edge_n1A1, edge_n1A2;
-        if (treenodes[n1].nbr[0] == n2) {
-          A1 = treenodes[n1].nbr[1];
-          A2 = treenodes[n1].nbr[2];
-          edge_n1A1 = treenodes[n1].edge[1];
-          edge_n1A2 = treenodes[n1].edge[2];
-        } else if (treenodes[n1].nbr[1] == n2) {
-          A1 = treenodes[n1].nbr[0];
-          A2 = treenodes[n1].nbr[2];
-          edge_n1A1 = treenodes[n1].edge[0];
-          edge_n1A2 = treenodes[n1].edge[2];
-        } else {
-          A1 = treenodes[n1].nbr[0];
-          A2 = treenodes[n1].nbr[1];
-          edge_n1A1 = treenodes[n1].edge[0];
-          edge_n1A2 = treenodes[n1].edge[1];
+        // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
+        // (n1, A1)
+        if (endpt1 == A2 || endpt2 == A2) {
+          std::swap(A1, A2);
+          std::swap(edge_n1A1, edge_n1A2);
         }
 
-        if (endpt1 == n1 || endpt2 == n1)  // E1 is on (n1, A1) or (n1, A2)
-        {
-          // if E1 is on (n1, A2), switch A1 and A2 so that E1 is always on
-          // (n1, A1)
-          if (endpt1 == A2 || endpt2 == A2) {
-            std::swap(A1, A2);
-            std::swap(edge_n1A1, edge_n1A2);
-          }
-
-          // update route for edge (n1, A1), (n1, A2)
-          bool route_ok = updateRouteType1(netID,
-                                           treenodes,
-                                           n1,
-                                           A1,
-                                           A2,
-                                           E1x,
-                                           E1y,
-                                           treeedges,
-                                           edge_n1A1,
-                                           edge_n1A2);
-          if (!route_ok) {
-            if (verbose_)
-              logger_->error(GRT,
-                             150,
-                             "Net {} has errors during updateRouteType1.",
-                             nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        // update route for edge (n1, A1), (n1, A2)
+        bool route_ok = updateRouteType1(netID,
+                                         treenodes,
+                                         n1,
+                                         A1,
+                                         A2,
+                                         E1x,
+                                         E1y,
+                                         treeedges,
+                                         edge_n1A1,
+                                         edge_n1A2);
+        if (!route_ok) {
+          if (verbose_)
+            logger_->error(GRT,
+                           150,
+                           "Net {} has errors during updateRouteType1.",
+                           nets_[netID]->getName());
+          return false;
+        }
+        // update position for n1
+        treenodes[n1].x = E1x;
+        treenodes[n1].y = E1y;
+      }     // if E1 is on (n1, A1) or (n1, A2)
+      else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+      {
+        const int C1 = endpt1;
+        const int C2 = endpt2;
+        const int edge_C1C2 = corr_edge[E1y][E1x];
+
+        // update route for edge (n1, C1), (n1, C2) and (A1, A2)
+        bool route_ok = updateRouteType2(netID,
+                                         treenodes,
+                                         n1,
+                                         A1,
+                                         A2,
+                                         C1,
+                                         C2,
+                                         E1x,
+                                         E1y,
+                                         treeedges,
+                                         edge_n1A1,
+                                         edge_n1A2,
+                                         edge_C1C2);
+        if (!route_ok) {
+          if (verbose_)
+            logger_->warn(GRT,
+                          151,
+                          "Net {} has errors during updateRouteType2.",
+                          nets_[netID]->getName());
+          return false;
+        }
+        // update position for n1
+        treenodes[n1].x = E1x;
+        treenodes[n1].y = E1y;
+        // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
+        // C2)->(A1, A2)
+        const int edge_n1C1 = edge_n1A1;
+        treeedges[edge_n1C1].n1 = C1;
+        treeedges[edge_n1C1].n2 = n1;
+        const int edge_n1C2 = edge_n1A2;
+        treeedges[edge_n1C2].n1 = n1;
+        treeedges[edge_n1C2].n2 = C2;
+        const int edge_A1A2 = edge_C1C2;
+        treeedges[edge_A1A2].n1 = A1;
+        treeedges[edge_A1A2].n2 = A2;
+        // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
+        // n1's nbr (n2, A1, A2)->(n2, C1, C2)
+        treenodes[n1].nbr[0] = n2;
+        treenodes[n1].edge[0] = edge_n1n2;
+        treenodes[n1].nbr[1] = C1;
+        treenodes[n1].edge[1] = edge_n1C1;
+        treenodes[n1].nbr[2] = C2;
+        treenodes[n1].edge[2] = edge_n1C2;
+        // A1's nbr n1->A2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[A1].nbr[i] == n1) {
+            treenodes[A1].nbr[i] = A2;
+            treenodes[A1].edge[i] = edge_A1A2;
             break;
           }
-          // update position for n1
-          treenodes[n1].x = E1x;
-          treenodes[n1].y = E1y;
-        }     // if E1 is on (n1, A1) or (n1, A2)
-        else  // E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-        {
-          const int C1 = endpt1;
-          const int C2 = endpt2;
-          const int edge_C1C2 = corr_edge_[E1y][E1x];
-
-          // update route for edge (n1, C1), (n1, C2) and (A1, A2)
-          bool route_ok = updateRouteType2(netID,
-                                           treenodes,
-                                           n1,
-                                           A1,
-                                           A2,
-                                           C1,
-                                           C2,
-                                           E1x,
-                                           E1y,
-                                           treeedges,
-                                           edge_n1A1,
-                                           edge_n1A2,
-                                           edge_C1C2);
-          if (!route_ok) {
-            if (verbose_)
-              logger_->warn(GRT,
-                            151,
-                            "Net {} has errors during updateRouteType2.",
-                            nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        }
+        // A2's nbr n1->A1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[A2].nbr[i] == n1) {
+            treenodes[A2].nbr[i] = A1;
+            treenodes[A2].edge[i] = edge_A1A2;
             break;
           }
-          // update position for n1
-          treenodes[n1].x = E1x;
-          treenodes[n1].y = E1y;
-          // update 3 edges (n1, A1)->(C1, n1), (n1, A2)->(n1, C2), (C1,
-          // C2)->(A1, A2)
-          const int edge_n1C1 = edge_n1A1;
-          treeedges[edge_n1C1].n1 = C1;
-          treeedges[edge_n1C1].n2 = n1;
-          const int edge_n1C2 = edge_n1A2;
-          treeedges[edge_n1C2].n1 = n1;
-          treeedges[edge_n1C2].n2 = C2;
-          const int edge_A1A2 = edge_C1C2;
-          treeedges[edge_A1A2].n1 = A1;
-          treeedges[edge_A1A2].n2 = A2;
-          // update nbr and edge for 5 nodes n1, A1, A2, C1, C2
-          // n1's nbr (n2, A1, A2)->(n2, C1, C2)
-          treenodes[n1].nbr[0] = n2;
-          treenodes[n1].edge[0] = edge_n1n2;
-          treenodes[n1].nbr[1] = C1;
-          treenodes[n1].edge[1] = edge_n1C1;
-          treenodes[n1].nbr[2] = C2;
-          treenodes[n1].edge[2] = edge_n1C2;
-          // A1's nbr n1->A2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[A1].nbr[i] == n1) {
-              treenodes[A1].nbr[i] = A2;
-              treenodes[A1].edge[i] = edge_A1A2;
-              break;
-            }
-          }
-          // A2's nbr n1->A1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[A2].nbr[i] == n1) {
-              treenodes[A2].nbr[i] = A1;
-              treenodes[A2].edge[i] = edge_A1A2;
-              break;
-            }
-          }
-          // C1's nbr C2->n1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[C1].nbr[i] == C2) {
-              treenodes[C1].nbr[i] = n1;
-              treenodes[C1].edge[i] = edge_n1C1;
-              break;
-            }
+        }
+        // C1's nbr C2->n1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[C1].nbr[i] == C2) {
+            treenodes[C1].nbr[i] = n1;
+            treenodes[C1].edge[i] = edge_n1C1;
+            break;
           }
-          // C2's nbr C1->n1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[C2].nbr[i] == C1) {
-              treenodes[C2].nbr[i] = n1;
-              treenodes[C2].edge[i] = edge_n1C2;
-              break;
-            }
+        }
+        // C2's nbr C1->n1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[C2].nbr[i] == C1) {
+            treenodes[C2].nbr[i] = n1;
+            treenodes[C2].edge[i] = edge_n1C2;
+            break;
           }
+        }
 
-        }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
-      }    // n1 is not a pin and E1!=n1
+      }  // else E1 is not on (n1, A1) or (n1, A2), but on (C1, C2)
+    }    // n1 is not a pin and E1!=n1
 
-      // (2) consider subtree2
-      if (n2 < num_terminals && (E2x != n2x || E2y != n2y)) {
-        // split neighbor edge and return id new node
-        n2 = splitEdge(treeedges, treenodes, n1, n2, edgeID);
+    // (2) consider subtree2
+    if (n2 < num_terminals && (E2x != n2x || E2y != n2y)) {
+      // split neighbor edge and return id new node
+      n2 = splitEdge(treeedges, treenodes, n1, n2, edgeID);
+    }
+    if (n2 >= num_terminals && (E2x != n2x || E2y != n2y))
+    // n2 is not a pin and E2!=n2, then make change to subtree2,
+    // otherwise, no change to subtree2
+    {
+      // find the endpoints of the edge E1 is on
+      const int endpt1 = treeedges[corr_edge[E2y][E2x]].n1;
+      const int endpt2 = treeedges[corr_edge[E2y][E2x]].n2;
+
+      // find B1, B2
+      int B1, B2;
+      int edge_n2B1, edge_n2B2;
+      if (treenodes[n2].nbr[0] == n1) {
+        B1 = treenodes[n2].nbr[1];
+        B2 = treenodes[n2].nbr[2];
+        edge_n2B1 = treenodes[n2].edge[1];
+        edge_n2B2 = treenodes[n2].edge[2];
+      } else if (treenodes[n2].nbr[1] == n1) {
+        B1 = treenodes[n2].nbr[0];
+        B2 = treenodes[n2].nbr[2];
+        edge_n2B1 = treenodes[n2].edge[0];
+        edge_n2B2 = treenodes[n2].edge[2];
+      } else {
+        B1 = treenodes[n2].nbr[0];
+        B2 = treenodes[n2].nbr[1];
+        edge_n2B1 = treenodes[n2].edge[0];
+        edge_n2B2 = treenodes[n2].edge[1];
       }
-      if (n2 >= num_terminals && (E2x != n2x || E2y != n2y))
-      // n2 is not a pin and E2!=n2, then make change to subtree2,
-      // otherwise, no change to subtree2
+
+      if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
       {
-        // find the endpoints of the edge E1 is on
-        const int endpt1 = treeedges[corr_edge_[E2y][E2x]].n1;
-        const int endpt2 = treeedges[corr_edge_[E2y][E2x]].n2;
-
-        // find B1, B2
-        int B1, B2;
-        int edge_n2B1, edge_n2B2;
-        if (treenodes[n2].nbr[0] == n1) {
-          B1 = treenodes[n2].nbr[1];
-          B2 = treenodes[n2].nbr[2];
-          edge_n2B1 = treenodes[n2].edge[1];
-          edge_n2B2 = treenodes[n2].edge[2];
-        } else if (treenodes[n2].nbr[1] == n1) {
-          B1 = treenodes[n2].nbr[0];
-          B2 = treenodes[n2].nbr[2];
-          edge_n2B1 = treenodes[n2].edge[0];
-          edge_n2B2 = treenodes[n2].edge[2];
-        } else {
-          B1 = treenodes[n2].nbr[0];
-          B2 = treenodes[n2].nbr[1];
-          edge_n2B1 = treenodes[n2].edge[0];
-          edge_n2B2 = treenodes[n2].edge[1];
+        // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
+        // (n2, B1)
+        if (endpt1 == B2 || endpt2 == B2) {
+          std::swap(B1, B2);
+          std::swap(edge_n2B1, edge_n2B2);
         }
 
-        if (endpt1 == n2 || endpt2 == n2)  // E2 is on (n2, B1) or (n2, B2)
-        {
-          // if E2 is on (n2, B2), switch B1 and B2 so that E2 is always on
-          // (n2, B1)
-          if (endpt1 == B2 || endpt2 == B2) {
-            std::swap(B1, B2);
-            std::swap(edge_n2B1, edge_n2B2);
-          }
+        // update route for edge (n2, B1), (n2, B2)
+        bool route_ok = updateRouteType1(netID,
+                                         treenodes,
+                                         n2,
+                                         B1,
+                                         B2,
+                                         E2x,
+                                         E2y,
+                                         treeedges,
+                                         edge_n2B1,
+                                         edge_n2B2);
+        if (!route_ok) {
+          if (verbose_)
+            logger_->warn(GRT,
+                          152,
+                          "Net {} has errors during updateRouteType1.",
+                          nets_[netID]->getName());
+          return false;
+        }
 
-          // update route for edge (n2, B1), (n2, B2)
-          bool route_ok = updateRouteType1(netID,
-                                           treenodes,
-                                           n2,
-                                           B1,
-                                           B2,
-                                           E2x,
-                                           E2y,
-                                           treeedges,
-                                           edge_n2B1,
-                                           edge_n2B2);
-          if (!route_ok) {
-            if (verbose_)
-              logger_->warn(GRT,
-                            152,
-                            "Net {} has errors during updateRouteType1.",
-                            nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        // update position for n2
+        treenodes[n2].x = E2x;
+        treenodes[n2].y = E2y;
+      }     // if E2 is on (n2, B1) or (n2, B2)
+      else  // E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
+      {
+        const int D1 = endpt1;
+        const int D2 = endpt2;
+        const int edge_D1D2 = corr_edge[E2y][E2x];
+
+        // update route for edge (n2, D1), (n2, D2) and (B1, B2)
+        bool route_ok = updateRouteType2(netID,
+                                         treenodes,
+                                         n2,
+                                         B1,
+                                         B2,
+                                         D1,
+                                         D2,
+                                         E2x,
+                                         E2y,
+                                         treeedges,
+                                         edge_n2B1,
+                                         edge_n2B2,
+                                         edge_D1D2);
+        if (!route_ok) {
+          if (verbose_)
+            logger_->warn(GRT,
+                          153,
+                          "Net {} has errors during updateRouteType2.",
+                          nets_[netID]->getName());
+          return false;
+        }
+        // update position for n2
+        treenodes[n2].x = E2x;
+        treenodes[n2].y = E2y;
+        // update 3 edges (n2, B1)->(D1, n2), (n2, B2)->(n2, D2), (D1,
+        // D2)->(B1, B2)
+        const int edge_n2D1 = edge_n2B1;
+        treeedges[edge_n2D1].n1 = D1;
+        treeedges[edge_n2D1].n2 = n2;
+        const int edge_n2D2 = edge_n2B2;
+        treeedges[edge_n2D2].n1 = n2;
+        treeedges[edge_n2D2].n2 = D2;
+        const int edge_B1B2 = edge_D1D2;
+        treeedges[edge_B1B2].n1 = B1;
+        treeedges[edge_B1B2].n2 = B2;
+        // update nbr and edge for 5 nodes n2, B1, B2, D1, D2
+        // n1's nbr (n1, B1, B2)->(n1, D1, D2)
+        treenodes[n2].nbr[0] = n1;
+        treenodes[n2].edge[0] = edge_n1n2;
+        treenodes[n2].nbr[1] = D1;
+        treenodes[n2].edge[1] = edge_n2D1;
+        treenodes[n2].nbr[2] = D2;
+        treenodes[n2].edge[2] = edge_n2D2;
+        // B1's nbr n2->B2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[B1].nbr[i] == n2) {
+            treenodes[B1].nbr[i] = B2;
+            treenodes[B1].edge[i] = edge_B1B2;
             break;
           }
-
-          // update position for n2
-          treenodes[n2].x = E2x;
-          treenodes[n2].y = E2y;
-        }     // if E2 is on (n2, B1) or (n2, B2)
-        else  // E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
-        {
-          const int D1 = endpt1;
-          const int D2 = endpt2;
-          const int edge_D1D2 = corr_edge_[E2y][E2x];
-
-          // update route for edge (n2, D1), (n2, D2) and (B1, B2)
-          bool route_ok = updateRouteType2(netID,
-                                           treenodes,
-                                           n2,
-                                           B1,
-                                           B2,
-                                           D1,
-                                           D2,
-                                           E2x,
-                                           E2y,
-                                           treeedges,
-                                           edge_n2B1,
-                                           edge_n2B2,
-                                           edge_D1D2);
-          if (!route_ok) {
-            if (verbose_)
-              logger_->warn(GRT,
-                            153,
-                            "Net {} has errors during updateRouteType2.",
-                            nets_[netID]->getName());
-            reInitTree(netID);
-            nidRPC--;
+        }
+        // B2's nbr n2->B1
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[B2].nbr[i] == n2) {
+            treenodes[B2].nbr[i] = B1;
+            treenodes[B2].edge[i] = edge_B1B2;
             break;
           }
-          // update position for n2
-          treenodes[n2].x = E2x;
-          treenodes[n2].y = E2y;
-          // update 3 edges (n2, B1)->(D1, n2), (n2, B2)->(n2, D2), (D1,
-          // D2)->(B1, B2)
-          const int edge_n2D1 = edge_n2B1;
-          treeedges[edge_n2D1].n1 = D1;
-          treeedges[edge_n2D1].n2 = n2;
-          const int edge_n2D2 = edge_n2B2;
-          treeedges[edge_n2D2].n1 = n2;
-          treeedges[edge_n2D2].n2 = D2;
-          const int edge_B1B2 = edge_D1D2;
-          treeedges[edge_B1B2].n1 = B1;
-          treeedges[edge_B1B2].n2 = B2;
-          // update nbr and edge for 5 nodes n2, B1, B2, D1, D2
-          // n1's nbr (n1, B1, B2)->(n1, D1, D2)
-          treenodes[n2].nbr[0] = n1;
-          treenodes[n2].edge[0] = edge_n1n2;
-          treenodes[n2].nbr[1] = D1;
-          treenodes[n2].edge[1] = edge_n2D1;
-          treenodes[n2].nbr[2] = D2;
-          treenodes[n2].edge[2] = edge_n2D2;
-          // B1's nbr n2->B2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[B1].nbr[i] == n2) {
-              treenodes[B1].nbr[i] = B2;
-              treenodes[B1].edge[i] = edge_B1B2;
-              break;
-            }
-          }
-          // B2's nbr n2->B1
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[B2].nbr[i] == n2) {
-              treenodes[B2].nbr[i] = B1;
-              treenodes[B2].edge[i] = edge_B1B2;
-              break;
-            }
-          }
-          // D1's nbr D2->n2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[D1].nbr[i] == D2) {
-              treenodes[D1].nbr[i] = n2;
-              treenodes[D1].edge[i] = edge_n2D1;
-              break;
-            }
+        }
+        // D1's nbr D2->n2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[D1].nbr[i] == D2) {
+            treenodes[D1].nbr[i] = n2;
+            treenodes[D1].edge[i] = edge_n2D1;
+            break;
           }
-          // D2's nbr D1->n2
-          for (int i = 0; i < 3; i++) {
-            if (treenodes[D2].nbr[i] == D1) {
-              treenodes[D2].nbr[i] = n2;
-              treenodes[D2].edge[i] = edge_n2D2;
-              break;
-            }
+        }
+        // D2's nbr D1->n2
+        for (int i = 0; i < 3; i++) {
+          if (treenodes[D2].nbr[i] == D1) {
+            treenodes[D2].nbr[i] = n2;
+            treenodes[D2].edge[i] = edge_n2D2;
+            break;
           }
-        }  // else E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
-      }    // n2 is not a pin and E2!=n2
+        }
+      }  // else E2 is not on (n2, B1) or (n2, B2), but on (D1, D2)
+    }    // n2 is not a pin and E2!=n2
 
-      // update route for edge (n1, n2) and edge usage
-      if (treeedges[edge_n1n2].route.type == RouteType::MazeRoute) {
-        treeedges[edge_n1n2].route.gridsX.clear();
-        treeedges[edge_n1n2].route.gridsY.clear();
-      }
-      treeedges[edge_n1n2].route.gridsX.resize(cnt_n1n2, 0);
-      treeedges[edge_n1n2].route.gridsY.resize(cnt_n1n2, 0);
-      treeedges[edge_n1n2].route.type = RouteType::MazeRoute;
-      treeedges[edge_n1n2].route.routelen = cnt_n1n2 - 1;
-      treeedges[edge_n1n2].len = abs(E1x - E2x) + abs(E1y - E2y);
-
-      for (int i = 0; i < cnt_n1n2; i++) {
-        treeedges[edge_n1n2].route.gridsX[i] = gridsX[i];
-        treeedges[edge_n1n2].route.gridsY[i] = gridsY[i];
+    // update route for edge (n1, n2) and edge usage
+    if (treeedges[edge_n1n2].route.type == RouteType::MazeRoute) {
+      treeedges[edge_n1n2].route.gridsX.clear();
+      treeedges[edge_n1n2].route.gridsY.clear();
+    }
+    treeedges[edge_n1n2].route.gridsX.resize(cnt_n1n2, 0);
+    treeedges[edge_n1n2].route.gridsY.resize(cnt_n1n2, 0);
+    treeedges[edge_n1n2].route.type = RouteType::MazeRoute;
+    treeedges[edge_n1n2].route.routelen = cnt_n1n2 - 1;
+    treeedges[edge_n1n2].len = abs(E1x - E2x) + abs(E1y - E2y);
+
+    for (int i = 0; i < cnt_n1n2; i++) {
+      treeedges[edge_n1n2].route.gridsX[i] = gridsX[i];
+      treeedges[edge_n1n2].route.gridsY[i] = gridsY[i];
+    }
+
+    int edgeCost = nets_[netID]->getEdgeCost();
+
+    // update edge usage
+    for (int i = 0; i < cnt_n1n2 - 1; i++) {
+      if (gridsX[i] == gridsX[i + 1])  // a vertical edge
+      {
+        const int min_y = std::min(gridsY[i], gridsY[i + 1]);
+        v_edges_[min_y][gridsX[i]].usage += edgeCost;
+        scratch.v_used_ggrid.emplace_back(min_y, gridsX[i]);
+      } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
+      {
+        const int min_x = std::min(gridsX[i], gridsX[i + 1]);
+        h_edges_[gridsY[i]][min_x].usage += edgeCost;
+        scratch.h_used_ggrid.emplace_back(gridsY[i], min_x);
       }
+    }
+  }  // loop edgeID
 
-      int edgeCost = nets_[netID]->getEdgeCost();
+  return true;
+}
 
-      // update edge usage
-      for (int i = 0; i < cnt_n1n2 - 1; i++) {
-        if (gridsX[i] == gridsX[i + 1])  // a vertical edge
-        {
-          const int min_y = std::min(gridsY[i], gridsY[i + 1]);
-          v_edges_[min_y][gridsX[i]].usage += edgeCost;
-          v_used_ggrid_.insert(std::make_pair(min_y, gridsX[i]));
-        } else  /// if(gridsY[i]==gridsY[i+1])// a horizontal edge
-        {
-          const int min_x = std::min(gridsX[i], gridsX[i + 1]);
-          h_edges_[gridsY[i]][min_x].usage += edgeCost;
-          h_used_ggrid_.insert(std::make_pair(gridsY[i], min_x));
-        }
+// Nets are routed in batches whose bounds don't overlap.  A net only reads
+// and writes edge usages inside its bounds, so the nets of a batch are
+// routed concurrently.
+void FastRouteCore::mazeRouteMSMDParallel(const std::vector<int>& order,
+                                          const int iter,
+                                          const int expand,
+                                          const float cost_height,
+                                          const int ripup_threshold,
+                                          const int maze_edge_threshold,
+                                          const int cost_type,
+                                          const float logis_cof,
+                                          const int via,
+                                          const int slope,
+                                          const int L,
+                                          const float slack_th)
+{
+  const int num_nets = order.size();
+  std::vector<odb::Rect> bounds(num_nets);
+  for (int i = 0; i < num_nets; i++) {
+    bounds[i] = netRouteBounds(order[i], expand);
+  }
+
+  // enlarge_ is left as set by the last net routed, in sequential order
+  std::vector<int> enlarge(num_nets, -1);
+
+  std::vector<char> failed;
+  for (const std::vector<int>& batch : disjointNetBatches(bounds)) {
+    failed.assign(batch.size(), false);
+    utl::ThreadException exception;
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic, 1)
+    for (int i = 0; i < batch.size(); i++) {
+      try {
+        const int idx = batch[i];
+        MazeScratch& scratch = *maze_scratch_[omp_get_thread_num()];
+        failed[i] = !mazeRouteMSMDNet(order[idx],
+                                      iter,
+                                      expand,
+                                      cost_height,
+                                      ripup_threshold,
+                                      maze_edge_threshold,
+                                      cost_type,
+                                      logis_cof,
+                                      via,
+                                      slope,
+                                      L,
+                                      slack_th,
+                                      bounds[idx],
+                                      scratch,
+                                      enlarge[idx]);
+      } catch (...) {
+        exception.capture();
       }
-    }  // loop edgeID
-  }    // loop netID
+    }
+    exception.rethrow();
 
-  h_cost_table_.clear();
-  v_cost_table_.clear();
+    // Nets whose tree could not be updated are rerouted from scratch.  The
+    // new tree is inside the pins bounding box, so the bounds still hold.
+    MazeScratch& scratch = *maze_scratch_[0];
+    for (int i = 0; i < batch.size(); i++) {
+      if (!failed[i]) {
+        continue;
+      }
+      const int idx = batch[i];
+      do {
+        reInitTree(order[idx]);
+      } while (!mazeRouteMSMDNet(order[idx],
+                                 iter,
+                                 expand,
+                                 cost_height,
+                                 ripup_threshold,
+                                 maze_edge_threshold,
+                                 cost_type,
+                                 logis_cof,
+                                 via,
+                                 slope,
+                                 L,
+                                 slack_th,
+                                 bounds[idx],
+                                 scratch,
+                                 enlarge[idx]));
+    }
+
+    for (std::unique_ptr<MazeScratch>& scratch : maze_scratch_) {
+      mergeUsedGGrids(*scratch);
+    }
+  }
+
+  for (int idx = num_nets - 1; idx >= 0; idx--) {
+    if (enlarge[idx] >= 0) {
+      enlarge_ = enlarge[idx];
+      break;
+    }
+  }
+}
+
+void FastRouteCore::mergeUsedGGrids(MazeScratch& scratch)
+{
+  h_used_ggrid_.insert(scratch.h_used_ggrid.begin(),
+                       scratch.h_used_ggrid.end());
+  v_used_ggrid_.insert(scratch.v_used_ggrid.begin(),
+                       scratch.v_used_ggrid.end());
+  scratch.h_used_ggrid.clear();
+  scratch.v_used_ggrid.clear();
 }
 
 void FastRouteCore::findCongestedEdgesNets(
@@ -32,12 +32,14 @@
 
 #include <algorithm>
 #include <fstream>
+#include <numeric>
 #include <queue>
 
 #include "DataType.h"
 #include "FastRoute.h"
 #include "odb/db.h"
 #include "utl/Logger.h"
+#include "utl/exception.h"
 
 namespace grt {
 
@@ -143,6 +145,100 @@ static bool comparePVPV(const OrderNetPin& a, const OrderNetPin& b)
   return a.npv < b.npv;
 }
 
+// Bounding box of the tree nodes and routes of a net, enlarged by expand.
+odb::Rect FastRouteCore::netRouteBounds(const int netID, const int expand) const
+{
+  const StTree& sttree = sttrees_[netID];
+  int x_min = x_grid_ - 1;
+  int y_min = y_grid_ - 1;
+  int x_max = 0;
+  int y_max = 0;
+  for (int i = 0; i < sttree.num_nodes(); i++) {
+    x_min = std::min<int>(x_min, sttree.nodes[i].x);
+    y_min = std::min<int>(y_min, sttree.nodes[i].y);
+    x_max = std::max<int>(x_max, sttree.nodes[i].x);
+    y_max = std::max<int>(y_max, sttree.nodes[i].y);
+  }
+  for (const TreeEdge& edge : sttree.edges) {
+    if (edge.route.type != RouteType::MazeRoute) {
+      continue;
+    }
+    for (int i = 0; i <= edge.route.routelen; i++) {
+      x_min = std::min<int>(x_min, edge.route.gridsX[i]);
+      y_min = std::min<int>(y_min, edge.route.gridsY[i]);
+      x_max = std::max<int>(x_max, edge.route.gridsX[i]);
+      y_max = std::max<int>(y_max, edge.route.gridsY[i]);
+    }
+  }
+
+  return odb::Rect(std::max(x_min - expand, 0),
+                   std::max(y_min - expand, 0),
+                   std::min(x_max + expand, x_grid_ - 1),
+                   std::min(y_max + expand, y_grid_ - 1));
+}
+
+// Splits nets, given by their bounds in processing order, into batches of
+// nets whose bounds don't overlap.  A net joins a batch only if it doesn't
+// overlap any earlier net still waiting for a batch, so overlapping nets
+// stay in their order.  Processing the batches one after the other, with
+// the nets of a batch in parallel, gives the same result as processing the
+// nets sequentially.
+std::vector<std::vector<int>> FastRouteCore::disjointNetBatches(
+    const std::vector<odb::Rect>& bounds) const
+{
+  // Overlaps are checked conservatively on a coarse grid of bins
+  const int max_bins = 64;
+  const int bin_size
+      = std::max((std::max(x_grid_, y_grid_) + max_bins - 1) / max_bins, 1);
+  const int x_bins = (x_grid_ + bin_size - 1) / bin_size;
+  const int y_bins = (y_grid_ + bin_size - 1) / bin_size;
+  std::vector<int> bin_batch(x_bins * y_bins, -1);
+
+  // Limit the number of waiting nets considered for each batch
+  const int max_scan = 64 * std::max(num_threads_, 1);
+
+  std::vector<std::vector<int>> batches;
+  std::vector<int> waiting(bounds.size());
+  std::iota(waiting.begin(), waiting.end(), 0);
+  std::vector<int> next_waiting;
+  while (!waiting.empty()) {
+    const int batch_id = batches.size();
+    std::vector<int>& batch = batches.emplace_back();
+    next_waiting.clear();
+    int scanned = 0;
+    int marked = 0;
+    for (const int idx : waiting) {
+      if (scanned == max_scan || marked == bin_batch.size()) {
+        next_waiting.push_back(idx);
+        continue;
+      }
+      scanned++;
+      const odb::Rect& rect = bounds[idx];
+      bool overlaps = false;
+      for (int y = rect.yMin() / bin_size; y <= rect.yMax() / bin_size; y++) {
+        for (int x = rect.xMin() / bin_size; x <= rect.xMax() / bin_size;
+             x++) {
+          int& bin = bin_batch[y * x_bins + x];
+          if (bin == batch_id) {
+            overlaps = true;
+          } else {
+            bin = batch_id;
+            marked++;
+          }
+        }
+      }
+      if (overlaps) {
+        next_waiting.push_back(idx);
+      } else {
+        batch.push_back(idx);
+      }
+    }
+    waiting.swap(next_waiting);
+  }
+
+  return batches;
+}
+
 void FastRouteCore::netpinOrderInc()
 {
   tree_order_pv_.clear();
@@ -832,12 +928,7 @@ void FastRouteCore::assignEdge(int netID, int edgeID, bool processDIR)
 
 void FastRouteCore::layerAssignmentV4()
 {
-  int i, k, edgeID, nodeID, routeLen;
-  int n1, n2, connectionCNT;
-
-  int n1a, n2a;
-  std::queue<int> edgeQueue;
-
+  int edgeID, routeLen;
   TreeEdge* treeedge;
 
   for (const int& netID : net_ids_) {
@@ -853,119 +944,153 @@ void FastRouteCore::layerAssignmentV4()
   }
   netpinOrderInc();
 
-  for (i = 0; i < tree_order_pv_.size(); i++) {
-    int netID = tree_order_pv_[i].treeIndex;
-
-    auto& treeedges = sttrees_[netID].edges;
-    auto& treenodes = sttrees_[netID].nodes;
-    const int num_terminals = sttrees_[netID].num_terminals;
+  if (num_threads_ <= 1) {
+    for (const OrderNetPin& order : tree_order_pv_) {
+      layerAssignmentNet(order.treeIndex);
+    }
+    return;
+  }
 
-    for (nodeID = 0; nodeID < num_terminals; nodeID++) {
-      for (k = 0; k < treenodes[nodeID].conCNT; k++) {
-        edgeID = treenodes[nodeID].eID[k];
-        if (!treeedges[edgeID].assigned) {
-          edgeQueue.push(edgeID);
-          treeedges[edgeID].assigned = true;
-        }
+  // A net only changes the usage of the 3D edges on its routes, so nets
+  // with disjoint bounds are assigned concurrently.
+  std::vector<odb::Rect> bounds;
+  bounds.reserve(tree_order_pv_.size());
+  for (const OrderNetPin& order : tree_order_pv_) {
+    bounds.push_back(netRouteBounds(order.treeIndex, 0));
+  }
+  for (const std::vector<int>& batch : disjointNetBatches(bounds)) {
+    utl::ThreadException exception;
+#pragma omp parallel for num_threads(num_threads_) schedule(dynamic, 1)
+    for (int i = 0; i < batch.size(); i++) {
+      try {
+        layerAssignmentNet(tree_order_pv_[batch[i]].treeIndex);
+      } catch (...) {
+        exception.capture();
       }
     }
+    exception.rethrow();
+  }
+}
 
-    while (!edgeQueue.empty()) {
-      edgeID = edgeQueue.front();
-      edgeQueue.pop();
-      treeedge = &(treeedges[edgeID]);
-      if (treenodes[treeedge->n1a].assigned) {
-        assignEdge(netID, edgeID, 1);
-        treeedge->assigned = true;
-        if (!treenodes[treeedge->n2a].assigned) {
-          for (k = 0; k < treenodes[treeedge->n2a].conCNT; k++) {
-            edgeID = treenodes[treeedge->n2a].eID[k];
-            if (!treeedges[edgeID].assigned) {
-              edgeQueue.push(edgeID);
-              treeedges[edgeID].assigned = true;
-            }
+void FastRouteCore::layerAssignmentNet(const int netID)
+{
+  int k, edgeID, nodeID, routeLen;
+  int n1, n2, connectionCNT;
+
+  int n1a, n2a;
+  std::queue<int> edgeQueue;
+
+  TreeEdge* treeedge;
+
+  auto& treeedges = sttrees_[netID].edges;
+  auto& treenodes = sttrees_[netID].nodes;
+  const int num_terminals = sttrees_[netID].num_terminals;
+
+  for (nodeID = 0; nodeID < num_terminals; nodeID++) {
+    for (k = 0; k < treenodes[nodeID].conCNT; k++) {
+      edgeID = treenodes[nodeID].eID[k];
+      if (!treeedges[edgeID].assigned) {
+        edgeQueue.push(edgeID);
+        treeedges[edgeID].assigned = true;
+      }
+    }
+  }
+
+  while (!edgeQueue.empty()) {
+    edgeID = edgeQueue.front();
+    edgeQueue.pop();
+    treeedge = &(treeedges[edgeID]);
+    if (treenodes[treeedge->n1a].assigned) {
+      assignEdge(netID, edgeID, 1);
+      treeedge->assigned = true;
+      if (!treenodes[treeedge->n2a].assigned) {
+        for (k = 0; k < treenodes[treeedge->n2a].conCNT; k++) {
+          edgeID = treenodes[treeedge->n2a].eID[k];
+          if (!treeedges[edgeID].assigned) {
+            edgeQueue.push(edgeID);
+            treeedges[edgeID].assigned = true;
           }
-          treenodes[treeedge->n2a].assigned = true;
         }
-      } else {
-        assignEdge(netID, edgeID, 0);
-        treeedge->assigned = true;
-        if (!treenodes[treeedge->n1a].assigned) {
-          for (k = 0; k < treenodes[treeedge->n1a].conCNT; k++) {
-            edgeID = treenodes[treeedge->n1a].eID[k];
-            if (!treeedges[edgeID].assigned) {
-              edgeQueue.push(edgeID);
-              treeedges[edgeID].assigned = true;
-            }
+        treenodes[treeedge->n2a].assigned = true;
+      }
+    } else {
+      assignEdge(netID, edgeID, 0);
+      treeedge->assigned = true;
+      if (!treenodes[treeedge->n1a].assigned) {
+        for (k = 0; k < treenodes[treeedge->n1a].conCNT; k++) {
+          edgeID = treenodes[treeedge->n1a].eID[k];
+          if (!treeedges[edgeID].assigned) {
+            edgeQueue.push(edgeID);
+            treeedges[edgeID].assigned = true;
           }
-          treenodes[treeedge->n1a].assigned = true;
         }
+        treenodes[treeedge->n1a].assigned = true;
       }
     }
+  }
 
-    for (nodeID = 0; nodeID < sttrees_[netID].num_nodes(); nodeID++) {
-      treenodes[nodeID].topL = -1;
-      treenodes[nodeID].botL = num_layers_;
-      treenodes[nodeID].conCNT = 0;
-      treenodes[nodeID].hID = BIG_INT;
-      treenodes[nodeID].lID = BIG_INT;
-      treenodes[nodeID].status = 0;
-      treenodes[nodeID].assigned = false;
+  for (nodeID = 0; nodeID < sttrees_[netID].num_nodes(); nodeID++) {
+    treenodes[nodeID].topL = -1;
+    treenodes[nodeID].botL = num_layers_;
+    treenodes[nodeID].conCNT = 0;
+    treenodes[nodeID].hID = BIG_INT;
+    treenodes[nodeID].lID = BIG_INT;
+    treenodes[nodeID].status = 0;
+    treenodes[nodeID].assigned = false;
 
-      if (nodeID < num_terminals) {
-        treenodes[nodeID].botL = nets_[netID]->getPinL()[nodeID];
-        treenodes[nodeID].topL = nets_[netID]->getPinL()[nodeID];
-        treenodes[nodeID].assigned = true;
-        treenodes[nodeID].status = 1;
-      }
+    if (nodeID < num_terminals) {
+      treenodes[nodeID].botL = nets_[netID]->getPinL()[nodeID];
+      treenodes[nodeID].topL = nets_[netID]->getPinL()[nodeID];
+      treenodes[nodeID].assigned = true;
+      treenodes[nodeID].status = 1;
     }
+  }
 
-    for (edgeID = 0; edgeID < sttrees_[netID].num_edges(); edgeID++) {
-      treeedge = &(treeedges[edgeID]);
+  for (edgeID = 0; edgeID < sttrees_[netID].num_edges(); edgeID++) {
+    treeedge = &(treeedges[edgeID]);
 
-      if (treeedge->len > 0) {
-        routeLen = treeedge->route.routelen;
+    if (treeedge->len > 0) {
+      routeLen = treeedge->route.routelen;
 
-        n1 = treeedge->n1;
-        n2 = treeedge->n2;
-        const std::vector<short>& gridsL = treeedge->route.gridsL;
+      n1 = treeedge->n1;
+      n2 = treeedge->n2;
+      const std::vector<short>& gridsL = treeedge->route.gridsL;
 
-        n1a = treenodes[n1].stackAlias;
-        n2a = treenodes[n2].stackAlias;
-        connectionCNT = treenodes[n1a].conCNT;
-        treenodes[n1a].heights[connectionCNT] = gridsL[0];
-        treenodes[n1a].eID[connectionCNT] = edgeID;
-        treenodes[n1a].conCNT++;
+      n1a = treenodes[n1].stackAlias;
+      n2a = treenodes[n2].stackAlias;
+      connectionCNT = treenodes[n1a].conCNT;
+      treenodes[n1a].heights[connectionCNT] = gridsL[0];
+      treenodes[n1a].eID[connectionCNT] = edgeID;
+      treenodes[n1a].conCNT++;
 
-        if (gridsL[0] > treenodes[n1a].topL) {
-          treenodes[n1a].hID = edgeID;
-          treenodes[n1a].topL = gridsL[0];
-        }
-        if (gridsL[0] < treenodes[n1a].botL) {
-          treenodes[n1a].lID = edgeID;
-          treenodes[n1a].botL = gridsL[0];
-        }
+      if (gridsL[0] > treenodes[n1a].topL) {
+        treenodes[n1a].hID = edgeID;
+        treenodes[n1a].topL = gridsL[0];
+      }
+      if (gridsL[0] < treenodes[n1a].botL) {
+        treenodes[n1a].lID = edgeID;
+        treenodes[n1a].botL = gridsL[0];
+      }
 
-        treenodes[n1a].assigned = true;
+      treenodes[n1a].assigned = true;
 
-        connectionCNT = treenodes[n2a].conCNT;
-        treenodes[n2a].heights[connectionCNT] = gridsL[routeLen];
-        treenodes[n2a].eID[connectionCNT] = edgeID;
-        treenodes[n2a].conCNT++;
-        if (gridsL[routeLen] > treenodes[n2a].topL) {
-          treenodes[n2a].hID = edgeID;
-          treenodes[n2a].topL = gridsL[routeLen];
-        }
-        if (gridsL[routeLen] < treenodes[n2a].botL) {
-          treenodes[n2a].lID = edgeID;
-          treenodes[n2a].botL = gridsL[routeLen];
-        }
+      connectionCNT = treenodes[n2a].conCNT;
+      treenodes[n2a].heights[connectionCNT] = gridsL[routeLen];
+      treenodes[n2a].eID[connectionCNT] = edgeID;
+      treenodes[n2a].conCNT++;
+      if (gridsL[routeLen] > treenodes[n2a].topL) {
+        treenodes[n2a].hID = edgeID;
+        treenodes[n2a].topL = gridsL[routeLen];
+      }
+      if (gridsL[routeLen] < treenodes[n2a].botL) {
+        treenodes[n2a].lID = edgeID;
+        treenodes[n2a].botL = gridsL[routeLen];
+      }
 
-        treenodes[n2a].assigned = true;
+      treenodes[n2a].assigned = true;
 
-      }  // edge len > 0
-    }    // eunmerating edges
-  }
+    }  // edge len > 0
+  }    // eunmerating edges
 }
 
 void FastRouteCore::layerAssignment()
@@ -1669,20 +1794,21 @@ static bool compareEdgeLen(const OrderNetEdge a, const OrderNetEdge b)
   return a.length > b.length;
 }
 
-void FastRouteCore::netedgeOrderDec(int netID)
+void FastRouteCore::netedgeOrderDec(int netID,
+                                    std::vector<OrderNetEdge>& net_eo)
 {
   const int numTreeedges = sttrees_[netID].num_edges();
 
-  net_eo_.clear();
+  net_eo.clear();
 
   for (int j = 0; j < numTreeedges; j++) {
     OrderNetEdge orderNet;
     orderNet.length = sttrees_[netID].edges[j].route.routelen;
     orderNet.edgeID = j;
-    net_eo_.push_back(orderNet);
+    net_eo.push_back(orderNet);
   }
 
-  std::stable_sort(net_eo_.begin(), net_eo_.end(), compareEdgeLen);
+  std::stable_sort(net_eo.begin(), net_eo.end(), compareEdgeLen);
 }
 
 void FastRouteCore::printEdge2D(int netID, int edgeID)
@@ -0,0 +1,100 @@
+# incremental global routing after instance moves reroutes only the nets of
+# the moved instances and matches a full global_route. The layer capacities
+# are reduced so the design routes with overflow.
+source "helpers.tcl"
+read_lef "Nangate45/Nangate45.lef"
+read_def "gcd.def"
+
+set_global_routing_layer_adjustment metal2 0.9
+set_global_routing_layer_adjustment metal3 0.9
+set_global_routing_layer_adjustment metal4-metal10 1
+
+set_routing_layers -signal metal2-metal10
+
+# Route length of each routed signal net
+proc net_lengths { block } {
+  set lengths [dict create]
+  foreach net [$block getNets] {
+    if { [$net getSigType] == "POWER" || [$net getSigType] == "GROUND" } {
+      continue
+    }
+    if { [llength [$net getITerms]] + [llength [$net getBTerms]] < 2 } {
+      continue
+    }
+    set length 0
+    foreach layer_length [grt::route_layer_lengths $net] {
+      set length [expr $length + $layer_length]
+    }
+    dict set lengths [$net getName] $length
+  }
+  return $lengths
+}
+
+proc total_length { lengths } {
+  set total 0
+  dict for {name length} $lengths {
+    set total [expr $total + $length]
+  }
+  return $total
+}
+
+set block [ord::get_db_block]
+
+global_route -allow_congestion
+set before [net_lengths $block]
+
+global_route -allow_congestion -start_incremental
+
+set moved_nets [dict create]
+foreach {inst_name dx dy} {_445_ -30000 0 _448_ 30000 14000} {
+  set inst [$block findInst $inst_name]
+  lassign [$inst getLocation] x y
+  $inst setLocation [expr $x + $dx] [expr $y + $dy]
+  foreach iterm [$inst getITerms] {
+    set net [$iterm getNet]
+    if { $net != "NULL" } {
+      dict set moved_nets [$net getName] 1
+    }
+  }
+}
+
+# The overflow query routes the pending dirty nets first, so it matches the
+# overflow after the session ends.
+set incr_overflow [grt::global_route_overflow]
+global_route -allow_congestion -end_incremental
+set end_overflow [grt::global_route_overflow]
+set incr [net_lengths $block]
+
+global_route -allow_congestion
+set full [net_lengths $block]
+
+set kept_changed 0
+set moved_changed 0
+dict for {name length} $before {
+  if { [dict exists $moved_nets $name] } {
+    if { [dict get $incr $name] != $length } {
+      incr moved_changed
+    }
+  } elseif { [dict get $incr $name] != $length } {
+    incr kept_changed
+  }
+}
+
+set incr_total [total_length $incr]
+set full_total [total_length $full]
+set length_diff [expr abs($incr_total - $full_total) / double($full_total)]
+
+if { $kept_changed != 0 } {
+  puts "fail: $kept_changed nets of unmoved instances were rerouted"
+} elseif { $moved_changed == 0 } {
+  puts "fail: no net of the moved instances was rerouted"
+} elseif { $incr_overflow == 0 } {
+  puts "fail: no overflow with reduced layer capacities"
+} elseif { $incr_overflow != $end_overflow } {
+  puts "fail: overflow $incr_overflow before and $end_overflow after the end\
+    of the incremental session"
+} elseif { $length_diff > 0.05 } {
+  puts "fail: incremental wire length $incr_total, full wire length $full_total"
+} else {
+  puts "pass"
+}
@@ -0,0 +1,26 @@
+# global_route assigns layers to the nets in parallel and gives the same
+# guides with 1 and 4 threads.
+source "helpers.tcl"
+read_lef "Nangate45/Nangate45.lef"
+read_def "gcd.def"
+
+proc read_file { filename } {
+  set stream [open $filename r]
+  set data [read $stream]
+  close $stream
+  return $data
+}
+
+foreach threads { 1 4 } {
+  set_thread_count $threads
+  global_route
+  set guide_file($threads) \
+    [make_result_file layer_assignment_threads_$threads.guide]
+  write_guides $guide_file($threads)
+}
+
+if { [read_file $guide_file(1)] eq [read_file $guide_file(4)] } {
+  puts "pass"
+} else {
+  puts "fail: guides differ between 1 and 4 threads"
+}
@@ -0,0 +1,259 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Precision Innovations Inc.
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Benchmark of the FastRoute maze router.
+//
+// Nets are routed by FastRouteCore::run on a synthetic grid with uniform
+// edge capacities, tight enough that most of the time is spent in the maze
+// routing rounds.  The run time, total overflow and wire length of the
+// routes are reported.  To compare two revisions of the maze router, build
+// the benchmark at each one and run it with the same arguments: the same
+// wire length and overflow means the routes are unchanged.
+//
+// Nets are read from files written by
+//   global_route_debug -net <name> -saveSttInput <file>
+// (several nets may be concatenated in a file).  Without files, random nets
+// are generated.
+//
+// usage: grt_maze_bench [-tile_size dbu] [-grid n] [-capacity n]
+//                       [-nets n] [-threads n] [files...]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "FastRoute.h"
+#include "grt/GRoute.h"
+#include "odb/db.h"
+#include "stt/SteinerTreeBuilder.h"
+#include "utl/Logger.h"
+
+namespace {
+
+constexpr int kNumLayers = 4;
+
+using BenchNet = std::vector<std::pair<int, int>>;
+
+std::vector<BenchNet> readNets(const std::vector<std::string>& files,
+                               const int tile_size)
+{
+  std::vector<BenchNet> nets;
+  for (const std::string& file : files) {
+    std::ifstream in(file);
+    if (!in) {
+      fprintf(stderr, "cannot open %s\n", file.c_str());
+      exit(1);
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+      std::istringstream fields(line);
+      std::string name;
+      fields >> name;
+      if (name == "Net") {
+        nets.emplace_back();
+        continue;
+      }
+      int x, y;
+      if (nets.empty() || !(fields >> x >> y)) {
+        continue;
+      }
+      nets.back().emplace_back(x / tile_size, y / tile_size);
+    }
+  }
+  return nets;
+}
+
+std::vector<BenchNet> randomNets(const int count,
+                                 const int grid,
+                                 std::mt19937& rand)
+{
+  std::uniform_int_distribution<int> degree(2, 12);
+  std::uniform_int_distribution<int> span(4, std::min(grid, 60));
+  std::vector<BenchNet> nets(count);
+  for (BenchNet& net : nets) {
+    const int width = span(rand);
+    const int height = span(rand);
+    const int x0 = rand() % (grid - width + 1);
+    const int y0 = rand() % (grid - height + 1);
+    const int pins = degree(rand);
+    for (int i = 0; i < pins; i++) {
+      net.emplace_back(x0 + rand() % width, y0 + rand() % height);
+    }
+  }
+  return nets;
+}
+
+// Sets up core for a grid x grid gcells design with the given nets, as
+// GlobalRouter::initFastRoute does for a real design.
+void initCore(grt::FastRouteCore& core,
+              odb::dbBlock* block,
+              const std::vector<BenchNet>& nets,
+              const int grid,
+              const int capacity,
+              const int num_threads)
+{
+  const int tile_size = 1;
+  core.setVerbose(false);
+  core.setNumThreads(num_threads);
+  core.setOverflowIterations(50);
+  core.setCriticalNetsPercentage(0);
+  core.setLowerLeft(0, 0);
+  core.setTileSize(tile_size);
+  core.setGridsAndLayers(grid, grid, kNumLayers);
+  core.setGridMax(grid * tile_size, grid * tile_size);
+  for (int l = 1; l <= kNumLayers; l++) {
+    // Layer 1 is horizontal, as on most technologies
+    const bool horizontal = l % 2 == 1;
+    core.addLayerDirection(l - 1,
+                           horizontal ? odb::dbTechLayerDir::HORIZONTAL
+                                      : odb::dbTechLayerDir::VERTICAL);
+    core.addHCapacity(horizontal ? capacity : 0, l);
+    core.addVCapacity(horizontal ? 0 : capacity, l);
+  }
+
+  int max_degree = 0;
+  for (int i = 0; i < nets.size(); i++) {
+    const std::string name = "net" + std::to_string(i);
+    odb::dbNet* db_net = odb::dbNet::create(block, name.c_str());
+    grt::FrNet* net
+        = core.addNet(db_net,
+                      false,
+                      0,
+                      1,
+                      0,
+                      kNumLayers - 1,
+                      0,
+                      new std::vector<int>(kNumLayers, 1));
+    for (const auto& [x, y] : nets[i]) {
+      net->addPin(x, y, 0);
+    }
+    max_degree = std::max(max_degree, static_cast<int>(nets[i].size()));
+  }
+  core.setMaxNetDegree(max_degree);
+
+  core.initEdges();
+  core.setNumAdjustments(0);
+  core.initAuxVar();
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  int tile_size = 1;
+  int grid = 200;
+  int capacity = 6;
+  int num_nets = 4000;
+  int num_threads = 1;
+  std::vector<std::string> files;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-tile_size") == 0 && i + 1 < argc) {
+      tile_size = std::max(atoi(argv[++i]), 1);
+    } else if (strcmp(argv[i], "-grid") == 0 && i + 1 < argc) {
+      grid = std::max(atoi(argv[++i]), 4);
+    } else if (strcmp(argv[i], "-capacity") == 0 && i + 1 < argc) {
+      capacity = std::max(atoi(argv[++i]), 1);
+    } else if (strcmp(argv[i], "-nets") == 0 && i + 1 < argc) {
+      num_nets = std::max(atoi(argv[++i]), 1);
+    } else if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc) {
+      num_threads = std::max(atoi(argv[++i]), 1);
+    } else {
+      files.emplace_back(argv[i]);
+    }
+  }
+
+  std::mt19937 rand(1);
+  std::vector<BenchNet> nets = files.empty()
+                                   ? randomNets(num_nets, grid, rand)
+                                   : readNets(files, tile_size);
+  // Keep saved nets on the grid, and drop nets FastRoute doesn't route
+  for (BenchNet& net : nets) {
+    for (auto& [x, y] : net) {
+      x = std::clamp(x, 0, grid - 1);
+      y = std::clamp(y, 0, grid - 1);
+    }
+    std::sort(net.begin(), net.end());
+    net.erase(std::unique(net.begin(), net.end()), net.end());
+  }
+  nets.erase(
+      std::remove_if(nets.begin(),
+                     nets.end(),
+                     [](const BenchNet& net) { return net.size() < 2; }),
+      nets.end());
+
+  utl::Logger logger;
+  odb::dbDatabase* db = odb::dbDatabase::create();
+  odb::dbTech::create(db, "bench");
+  odb::dbBlock* block
+      = odb::dbBlock::create(odb::dbChip::create(db), "bench");
+  stt::SteinerTreeBuilder stt_builder;
+  stt_builder.init(db, &logger);
+
+  double time;
+  int overflow;
+  long long wire_length = 0;
+  {
+    grt::FastRouteCore core(db, &logger, &stt_builder);
+    initCore(core, block, nets, grid, capacity, num_threads);
+
+    const auto start = std::chrono::steady_clock::now();
+    grt::NetRouteMap routes = core.run();
+    const auto end = std::chrono::steady_clock::now();
+    time = std::chrono::duration<double>(end - start).count();
+    overflow = core.totalOverflow();
+
+    for (auto& [db_net, route] : routes) {
+      for (grt::GSegment& segment : route) {
+        wire_length += segment.length();
+      }
+    }
+  }
+  odb::dbDatabase::destroy(db);
+
+  printf("nets %zu grid %d capacity %d threads %d\n",
+         nets.size(),
+         grid,
+         capacity,
+         num_threads);
+  printf("run %8.3f s  overflow %d  wire length %lld\n",
+         time,
+         overflow,
+         wire_length);
+  return 0;
+}
@@ -0,0 +1,221 @@
+// Checks that MazeHeap pops the grids of a maze search in the same order as
+// the pointer heap it replaced, so the routes of the maze router do not
+// change.
+
+#include <random>
+#include <vector>
+
+#include "MazeHeap.h"
+#include "gtest/gtest.h"
+
+namespace grt {
+
+namespace {
+
+// The heap of the maze router before MazeHeap, kept as it was.
+int parent_index(int i)
+{
+  return (i - 1) / 2;
+}
+
+int left_index(int i)
+{
+  return 2 * i + 1;
+}
+
+int right_index(int i)
+{
+  return 2 * i + 2;
+}
+
+void heapify(std::vector<float*>& array)
+{
+  bool stop = false;
+  const int heapSize = array.size();
+  int i = 0;
+
+  float* tmp = array[i];
+  do {
+    const int l = left_index(i);
+    const int r = right_index(i);
+
+    int smallest;
+    if (l < heapSize && *(array[l]) < *tmp) {
+      smallest = l;
+      if (r < heapSize && *(array[r]) < *(array[l]))
+        smallest = r;
+    } else {
+      smallest = i;
+      if (r < heapSize && *(array[r]) < *tmp)
+        smallest = r;
+    }
+    if (smallest != i) {
+      array[i] = array[smallest];
+      i = smallest;
+    } else {
+      array[i] = tmp;
+      stop = true;
+    }
+  } while (!stop);
+}
+
+void updateHeap(std::vector<float*>& array, int i)
+{
+  float* tmpi = array[i];
+  while (i > 0 && *(array[parent_index(i)]) > *tmpi) {
+    const int parent = parent_index(i);
+    array[i] = array[parent];
+    i = parent;
+  }
+  array[i] = tmpi;
+}
+
+void removeMin(std::vector<float*>& array)
+{
+  array[0] = array.back();
+  heapify(array);
+  array.pop_back();
+}
+
+constexpr float BIG = 1e9;
+
+// A grid with random edge costs.  Few distinct costs give many ties.
+struct Grid
+{
+  int x_range;
+  int y_range;
+  std::vector<float> h_cost;  // edge from (x, y) to (x + 1, y)
+  std::vector<float> v_cost;  // edge from (x, y) to (x, y + 1)
+  std::vector<int> sources;   // may hold a grid more than once
+};
+
+Grid makeGrid(std::mt19937& rng)
+{
+  Grid grid;
+  grid.x_range = std::uniform_int_distribution<int>(2, 40)(rng);
+  grid.y_range = std::uniform_int_distribution<int>(2, 40)(rng);
+  const int num_cells = grid.x_range * grid.y_range;
+  std::uniform_int_distribution<int> cost(0, 6);
+  for (int i = 0; i < num_cells; i++) {
+    grid.h_cost.push_back(cost(rng) * 0.5f);
+    grid.v_cost.push_back(cost(rng) * 0.5f);
+  }
+  std::uniform_int_distribution<int> cell(0, num_cells - 1);
+  const int num_sources = std::uniform_int_distribution<int>(1, 12)(rng);
+  for (int i = 0; i < num_sources; i++) {
+    grid.sources.push_back(cell(rng));
+  }
+  // Grids on several subtree edges are pushed again
+  grid.sources.push_back(grid.sources.front());
+  return grid;
+}
+
+std::vector<int> neighbors(const Grid& grid,
+                           const int cell,
+                           std::vector<float>& costs)
+{
+  const int x = cell % grid.x_range;
+  const int y = cell / grid.x_range;
+  std::vector<int> cells;
+  costs.clear();
+  if (x > 0) {
+    cells.push_back(cell - 1);
+    costs.push_back(grid.h_cost[cell - 1]);
+  }
+  if (x < grid.x_range - 1) {
+    cells.push_back(cell + 1);
+    costs.push_back(grid.h_cost[cell]);
+  }
+  if (y > 0) {
+    cells.push_back(cell - grid.x_range);
+    costs.push_back(grid.v_cost[cell - grid.x_range]);
+  }
+  if (y < grid.y_range - 1) {
+    cells.push_back(cell + grid.x_range);
+    costs.push_back(grid.v_cost[cell]);
+  }
+  return cells;
+}
+
+// Pop order of a search from the sources with the old heap
+std::vector<int> searchPointerHeap(const Grid& grid)
+{
+  std::vector<float> d1(grid.x_range * grid.y_range, BIG);
+  std::vector<float*> heap;
+  for (const int cell : grid.sources) {
+    d1[cell] = 0;
+    heap.push_back(&d1[cell]);
+  }
+
+  std::vector<int> order;
+  std::vector<float> costs;
+  while (!heap.empty()) {
+    const int cur = heap[0] - d1.data();
+    order.push_back(cur);
+    removeMin(heap);
+    const std::vector<int> cells = neighbors(grid, cur, costs);
+    for (int i = 0; i < cells.size(); i++) {
+      const int nbr = cells[i];
+      const float tmp = d1[cur] + costs[i];
+      if (d1[nbr] >= BIG) {
+        d1[nbr] = tmp;
+        heap.push_back(&d1[nbr]);
+        updateHeap(heap, heap.size() - 1);
+      } else if (d1[nbr] > tmp) {
+        d1[nbr] = tmp;
+        float* dtmp = &d1[nbr];
+        int ind = 0;
+        while (heap[ind] != dtmp)
+          ind++;
+        updateHeap(heap, ind);
+      }
+    }
+  }
+  return order;
+}
+
+// Pop order of a search from the sources with MazeHeap
+std::vector<int> searchMazeHeap(const Grid& grid)
+{
+  std::vector<float> d1(grid.x_range * grid.y_range, BIG);
+  MazeHeap heap;
+  heap.init(d1.size(), d1.data());
+  for (const int cell : grid.sources) {
+    d1[cell] = 0;
+    heap.push(cell);
+  }
+
+  std::vector<int> order;
+  std::vector<float> costs;
+  while (!heap.empty()) {
+    const int cur = heap.top();
+    order.push_back(cur);
+    heap.pop();
+    const std::vector<int> cells = neighbors(grid, cur, costs);
+    for (int i = 0; i < cells.size(); i++) {
+      const int nbr = cells[i];
+      const float tmp = d1[cur] + costs[i];
+      if (d1[nbr] >= BIG) {
+        d1[nbr] = tmp;
+        heap.push(nbr);
+      } else if (d1[nbr] > tmp) {
+        d1[nbr] = tmp;
+        heap.decrease(nbr);
+      }
+    }
+  }
+  return order;
+}
+
+}  // namespace
+
+TEST(MazeHeapTest, PopsInPointerHeapOrder)
+{
+  std::mt19937 rng(42);
+  for (int i = 0; i < 500; i++) {
+    const Grid grid = makeGrid(rng);
+    ASSERT_EQ(searchMazeHeap(grid), searchPointerHeap(grid)) << "grid " << i;
+  }
+}
+
+}  // namespace grt
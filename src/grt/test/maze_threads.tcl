@@ -0,0 +1,31 @@
+# global_route with reduced layer capacities rips up and maze routes nets,
+# and gives the same guides with 1 and 4 threads.
+source "helpers.tcl"
+read_lef "Nangate45/Nangate45.lef"
+read_def "gcd.def"
+
+set_global_routing_layer_adjustment metal2 0.9
+set_global_routing_layer_adjustment metal3 0.9
+set_global_routing_layer_adjustment metal4-metal10 1
+
+set_routing_layers -signal metal2-metal10
+
+proc read_file { filename } {
+  set stream [open $filename r]
+  set data [read $stream]
+  close $stream
+  return $data
+}
+
+foreach threads { 1 4 } {
+  set_thread_count $threads
+  global_route -allow_congestion
+  set guide_file($threads) [make_result_file maze_threads_$threads.guide]
+  write_guides $guide_file($threads)
+}
+
+if { [read_file $guide_file(1)] eq [read_file $guide_file(4)] } {
+  puts "pass"
+} else {
+  puts "fail: guides differ between 1 and 4 threads"
+}
@@ -66,3 +66,8 @@ record_tests {
   #grt_man_tcl_check
   #grt_readme_msgs_check
 }
+record_pass_fail_tests {
+  incremental_groute
+  maze_threads
+  layer_assignment_threads
+}
@@ -203,6 +203,7 @@ void SACoreHardMacro::restore()
   height_ = pre_height_;
   outline_penalty_ = pre_outline_penalty_;
   wirelength_ = pre_wirelength_;
+  restoreWirelength();
   guidance_penalty_ = pre_guidance_penalty_;
   fence_penalty_ = pre_fence_penalty_;
 }
@@ -259,6 +259,7 @@ void SACoreSoftMacro::restore()
   height_ = pre_height_;
   outline_penalty_ = pre_outline_penalty_;
   wirelength_ = pre_wirelength_;
+  restoreWirelength();
   guidance_penalty_ = pre_guidance_penalty_;
   fence_penalty_ = pre_fence_penalty_;
   boundary_penalty_ = pre_boundary_penalty_;
@@ -35,6 +35,8 @@
 
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <numeric>
 
 #include "Mpl2Observer.h"
 #include "object.h"
@@ -122,6 +124,26 @@ template <class T>
 void SimulatedAnnealingCore<T>::setNets(const std::vector<BundledNet>& nets)
 {
   nets_ = nets;
+
+  tot_net_weight_ = 0.0;
+  macro_nets_.assign(macros_.size(), {});
+  for (int i = 0; i < nets_.size(); i++) {
+    const auto& [src, target] = nets_[i].terminals;
+    tot_net_weight_ += nets_[i].weight;
+    macro_nets_[src].push_back(i);
+    if (target != src) {
+      macro_nets_[target].push_back(i);
+    }
+  }
+
+  // force a full evaluation on the next calWirelength
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  pin_locs_.assign(macros_.size(), {nan, nan});
+  net_wirelength_.assign(nets_.size(), 0.0);
+  net_changed_.assign(nets_.size(), false);
+  net_wirelength_sum_ = 0.0;
+  pin_locs_undo_.clear();
+  net_wirelength_undo_.clear();
 }
 
 template <class T>
@@ -252,6 +274,18 @@ void SimulatedAnnealingCore<T>::calOutlinePenalty()
   }
 }
 
+template <class T>
+float SimulatedAnnealingCore<T>::calNetWirelength(const BundledNet& net) const
+{
+  const float x1 = macros_[net.terminals.first].getPinX();
+  const float y1 = macros_[net.terminals.first].getPinY();
+  const float x2 = macros_[net.terminals.second].getPinX();
+  const float y2 = macros_[net.terminals.second].getPinY();
+  return net.weight * (std::abs(x2 - x1) + std::abs(y2 - y1));
+}
+
+// Only the nets of the macros whose pins moved since the last evaluation
+// are recomputed.
 template <class T>
 void SimulatedAnnealingCore<T>::calWirelength()
 {
@@ -261,26 +295,43 @@ void SimulatedAnnealingCore<T>::calWirelength()
     return;
   }
 
-  // calculate the total net weight
-  float tot_net_weight = 0.0;
-  for (const auto& net : nets_) {
-    tot_net_weight += net.weight;
+  if (tot_net_weight_ <= 0.0) {
+    return;
   }
 
-  if (tot_net_weight <= 0.0) {
-    return;
+  pin_locs_undo_.clear();
+  net_wirelength_undo_.clear();
+  pre_net_wirelength_sum_ = net_wirelength_sum_;
+  for (int id = 0; id < macros_.size(); id++) {
+    const std::pair<float, float> pin_loc(macros_[id].getPinX(),
+                                          macros_[id].getPinY());
+    if (pin_loc == pin_locs_[id]) {
+      continue;
+    }
+    pin_locs_undo_.emplace_back(id, pin_locs_[id]);
+    pin_locs_[id] = pin_loc;
+    for (const int net_id : macro_nets_[id]) {
+      if (!net_changed_[net_id]) {
+        net_changed_[net_id] = true;
+        net_wirelength_undo_.emplace_back(net_id, net_wirelength_[net_id]);
+      }
+    }
+  }
+
+  for (const auto& [net_id, pre_wirelength] : net_wirelength_undo_) {
+    net_changed_[net_id] = false;
+    net_wirelength_[net_id] = calNetWirelength(nets_[net_id]);
+    net_wirelength_sum_ += net_wirelength_[net_id] - pre_wirelength;
   }
 
-  for (const auto& net : nets_) {
-    const float x1 = macros_[net.terminals.first].getPinX();
-    const float y1 = macros_[net.terminals.first].getPinY();
-    const float x2 = macros_[net.terminals.second].getPinX();
-    const float y2 = macros_[net.terminals.second].getPinY();
-    wirelength_ += net.weight * (std::abs(x2 - x1) + std::abs(y2 - y1));
+  // resum when most nets changed to keep the rounding error from drifting
+  if (net_wirelength_undo_.size() * 2 > nets_.size()) {
+    net_wirelength_sum_ = std::accumulate(
+        net_wirelength_.begin(), net_wirelength_.end(), 0.0);
   }
 
   // normalization
-  wirelength_ = wirelength_ / tot_net_weight
+  wirelength_ = net_wirelength_sum_ / tot_net_weight_
                 / (outline_.getHeight() + outline_.getWidth());
 
   if (graphics_) {
@@ -288,6 +339,21 @@ void SimulatedAnnealingCore<T>::calWirelength()
   }
 }
 
+// Revert the incremental wirelength state to before the last calWirelength
+template <class T>
+void SimulatedAnnealingCore<T>::restoreWirelength()
+{
+  for (const auto& [id, pin_loc] : pin_locs_undo_) {
+    pin_locs_[id] = pin_loc;
+  }
+  for (const auto& [net_id, wirelength] : net_wirelength_undo_) {
+    net_wirelength_[net_id] = wirelength;
+  }
+  net_wirelength_sum_ = pre_net_wirelength_sum_;
+  pin_locs_undo_.clear();
+  net_wirelength_undo_.clear();
+}
+
 template <class T>
 void SimulatedAnnealingCore<T>::calFencePenalty()
 {
@@ -374,91 +440,66 @@ void SimulatedAnnealingCore<T>::packFloorplan()
     macros_[macro_id].setY(0.0);
   }
 
-  // Each index corresponds to a macro id whose pair is:
-  // <Position in Positive Sequence , Position in Negative Sequence>
-  std::vector<std::pair<int, int>> sequence_pair_pos(pos_seq_.size());
-
-  // calculate X position
-  for (int i = 0; i < pos_seq_.size(); i++) {
-    sequence_pair_pos[pos_seq_[i]].first = i;
-    sequence_pair_pos[neg_seq_[i]].second = i;
+  neg_seq_pos_.resize(macros_.size());
+  for (int i = 0; i < neg_seq_.size(); i++) {
+    neg_seq_pos_[neg_seq_[i]] = i;
   }
 
-  std::vector<float> accumulated_length(pos_seq_.size(), 0.0);
-  for (int i = 0; i < pos_seq_.size(); i++) {
-    const int macro_id = pos_seq_[i];
-
-    // There may exist pin access macros with zero area in our sequence pair
-    // when bus planning is on. This check is a temporary approach.
-    if (macros_[macro_id].getWidth() <= 0
-        || macros_[macro_id].getHeight() <= 0) {
-      continue;
-    }
-
-    const int neg_seq_pos = sequence_pair_pos[macro_id].second;
-
-    macros_[macro_id].setX(accumulated_length[neg_seq_pos]);
-
-    const float current_length
-        = macros_[macro_id].getX() + macros_[macro_id].getWidth();
-
-    for (int j = neg_seq_pos; j < neg_seq_.size(); j++) {
-      if (current_length > accumulated_length[j]) {
-        accumulated_length[j] = current_length;
-      } else {
-        break;
-      }
-    }
-  }
-
-  width_ = accumulated_length[pos_seq_.size() - 1];
-
+  // calculate X position
+  width_ = packOneDimension(true);
   // calulate Y position
-  std::vector<int> reversed_pos_seq(pos_seq_.size());
-  for (int i = 0; i < reversed_pos_seq.size(); i++) {
-    reversed_pos_seq[i] = pos_seq_[reversed_pos_seq.size() - 1 - i];
-  }
+  height_ = packOneDimension(false);
 
-  for (int i = 0; i < pos_seq_.size(); i++) {
-    sequence_pair_pos[reversed_pos_seq[i]].first = i;
-    sequence_pair_pos[neg_seq_[i]].second = i;
-
-    // This is actually the accumulated height, but we use the same vector
-    // to avoid more allocation.
-    accumulated_length[i] = 0.0;
+  if (graphics_) {
+    graphics_->saStep(macros_);
   }
+}
 
-  for (int i = 0; i < pos_seq_.size(); i++) {
-    const int macro_id = reversed_pos_seq[i];
+// Longest path packing of the sequence pair in O(n log n) (FAST-SP).
+// Macros are visited in positive sequence order (reversed for Y) and each
+// one starts at the largest end of the placed macros that precede it in the
+// negative sequence, which is a prefix maximum over the negative sequence
+// positions kept in a Fenwick tree.  Returns the packed length.
+template <class T>
+float SimulatedAnnealingCore<T>::packOneDimension(const bool horizontal)
+{
+  const int num_macros = pos_seq_.size();
+  pack_tree_.assign(num_macros + 1, 0.0);
+
+  float length = 0.0;
+  for (int i = 0; i < num_macros; i++) {
+    const int macro_id
+        = horizontal ? pos_seq_[i] : pos_seq_[num_macros - 1 - i];
+    T& macro = macros_[macro_id];
 
     // There may exist pin access macros with zero area in our sequence pair
     // when bus planning is on. This check is a temporary approach.
-    if (macros_[macro_id].getWidth() <= 0
-        || macros_[macro_id].getHeight() <= 0) {
+    if (macro.getWidth() <= 0 || macro.getHeight() <= 0) {
       continue;
     }
 
-    const int neg_seq_pos = sequence_pair_pos[macro_id].second;
-
-    macros_[macro_id].setY(accumulated_length[neg_seq_pos]);
+    const int neg_seq_pos = neg_seq_pos_[macro_id];
+    float start = 0.0;
+    for (int j = neg_seq_pos; j > 0; j -= j & -j) {
+      start = std::max(start, pack_tree_[j]);
+    }
 
-    const float current_height
-        = macros_[macro_id].getY() + macros_[macro_id].getHeight();
+    float end;
+    if (horizontal) {
+      macro.setX(start);
+      end = macro.getX() + macro.getWidth();
+    } else {
+      macro.setY(start);
+      end = macro.getY() + macro.getHeight();
+    }
 
-    for (int j = neg_seq_pos; j < neg_seq_.size(); j++) {
-      if (current_height > accumulated_length[j]) {
-        accumulated_length[j] = current_height;
-      } else {
-        break;
-      }
+    for (int j = neg_seq_pos + 1; j <= num_macros; j += j & -j) {
+      pack_tree_[j] = std::max(pack_tree_[j], end);
     }
+    length = std::max(length, end);
   }
 
-  height_ = accumulated_length[pos_seq_.size() - 1];
-
-  if (graphics_) {
-    graphics_->saStep(macros_);
-  }
+  return length;
 }
 
 // SingleSeqSwap
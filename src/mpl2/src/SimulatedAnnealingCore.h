@@ -137,11 +137,14 @@ class SimulatedAnnealingCore
   virtual void calPenalty() = 0;
   void calOutlinePenalty();
   void calWirelength();
+  float calNetWirelength(const BundledNet& net) const;
+  void restoreWirelength();
   void calGuidancePenalty();
   void calFencePenalty();
 
   // operations
   void packFloorplan();
+  float packOneDimension(bool horizontal);
   virtual void perturb() = 0;
   virtual void restore() = 0;
   // actions used
@@ -166,6 +169,9 @@ class SimulatedAnnealingCore
 
   // nets, fences, guides, blockages
   std::vector<BundledNet> nets_;
+  float tot_net_weight_ = 0.0;
+  // ids of the nets connected to each macro
+  std::vector<std::vector<int>> macro_nets_;
   std::map<int, Rect> fences_;
   std::map<int, Rect> guides_;
 
@@ -205,6 +211,21 @@ class SimulatedAnnealingCore
   int macro_id_ = -1;          // the macro changed in the perturb
   int action_id_ = -1;         // the action_id of current step
 
+  // buffers reused by packFloorplan
+  std::vector<int> neg_seq_pos_;  // position of each macro in neg_seq_
+  std::vector<float> pack_tree_;  // Fenwick tree of prefix max lengths
+
+  // Incremental wirelength: the pin location of each macro and the weighted
+  // length of each net at the last evaluation.  The undo lists hold the
+  // values replaced by the last evaluation so that restore can revert them.
+  std::vector<std::pair<float, float>> pin_locs_;
+  std::vector<float> net_wirelength_;
+  std::vector<bool> net_changed_;
+  double net_wirelength_sum_ = 0.0;
+  double pre_net_wirelength_sum_ = 0.0;
+  std::vector<std::pair<int, std::pair<float, float>>> pin_locs_undo_;
+  std::vector<std::pair<int, float>> net_wirelength_undo_;
+
   // metrics
   float width_ = 0.0;
   float height_ = 0.0;
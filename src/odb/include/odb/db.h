@@ -383,17 +383,33 @@ class dbDatabase : public dbObject
   uint getNumberOfMasters();
 
   ///
-  /// Read a database from this stream.
+  /// Read a database from this stream.  Independent block tables are
+  /// decoded using up to num_threads threads.
   /// WARNING: This function destroys the data currently in the database.
   /// Throws ZIOError..
   ///
-  void read(std::istream& f);
+  void read(std::istream& f, int num_threads = 1);
 
   ///
-  /// Write a database to this stream.
+  /// Read a database from the named file.  The file is memory mapped and
+  /// decoded directly from the mapped buffer, avoiding the per-field
+  /// overhead of std::istream.  The whole file must be consumed.
+  /// If lazy is true, wires, special wires and parasitics (rsegs, cap nodes
+  /// and cc segs) are only decoded when first accessed, and the file stays
+  /// mapped until then.
+  /// WARNING: This function destroys the data currently in the database.
+  /// Throws std::ios_base::failure.
+  ///
+  void readMapped(const char* filename,
+                  int num_threads = 1,
+                  bool lazy = false);
+
+  ///
+  /// Write a database to this stream.  Independent block tables are
+  /// encoded using up to num_threads threads.
   /// Throws ZIOError..
   ///
-  void write(std::ostream& file);
+  void write(std::ostream& file, int num_threads = 1);
 
   ///
   /// ECO - The following methods implement a simple ECO mechanism for capturing
@@ -6077,6 +6093,14 @@ class dbTech : public dbObject
   ///
   void checkLayer(bool typeChk, bool widthChk, bool pitchChk, bool spacingChk);
 
+  ///
+  /// Write the technology, including all its layer rules, vias and
+  /// properties, in the database format. The output can't be read back on
+  /// its own. It identifies the technology, e.g. to key caches of results
+  /// that depend on it.
+  ///
+  void write(std::ostream& file);
+
   ///
   /// Create a new technology.
   /// Returns nullptr if a database technology already exists
@@ -134,6 +134,7 @@ class dbBlockCallBackObj
   // dbWire Start
   virtual void inDbWireCreate(dbWire*) {}
   virtual void inDbWireDestroy(dbWire*) {}
+  virtual void inDbWirePreModify(dbWire*) {}
   virtual void inDbWirePostModify(dbWire*) {}
   virtual void inDbWirePreAttach(dbWire*, dbNet*) {}
   virtual void inDbWirePostAttach(dbWire*) {}
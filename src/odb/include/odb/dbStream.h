@@ -36,10 +36,13 @@
 #include <cstdint>
 #include <cstring>
 #include <istream>
+#include <memory>
 #include <ostream>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <variant>
+#include <vector>
 
 #include "ZException.h"
 #include "dbObject.h"
@@ -68,6 +71,7 @@ class dbOStream
   double _lef_area_factor;
   double _lef_dist_factor;
   std::vector<Scope> _scopes;
+  int _num_threads;
 
   // By default values are written as their string ("255" vs 0xFF)
   // representations when using the << stream method. In dbOstream we are
@@ -270,8 +274,17 @@ class dbOStream
 
   Position pos() const { return _f.tellp(); }
 
+  // Write pre-encoded data (eg a section encoded by another dbOStream).
+  void writeBytes(const char* data, size_t size) { _f.write(data, size); }
+
+  // Threads available for encoding independent sections.
+  void setNumThreads(int num_threads) { _num_threads = num_threads; }
+  int getNumThreads() const { return _num_threads; }
+
   void pushScope(const std::string& name);
   void popScope();
+  // The open scopes, outermost first.
+  std::vector<std::string> getScopeNames() const;
 };
 
 // RAII class for scoping ostream operations
@@ -291,13 +304,53 @@ class dbOStreamScope
 
 class dbIStream
 {
-  std::istream& _f;
+  using Position = uint64_t;
+  struct Scope
+  {
+    std::string name;
+    Position start_pos;
+  };
+
+  // Exactly one of _f or _buf is used.  When reading from a memory buffer
+  // (eg a memory mapped file) values are decoded directly out of the buffer
+  // rather than going through std::istream::read for every field.
+  std::istream* _f;
+  const char* _buf;
+  const char* _buf_pos;
+  const char* _buf_end;
   _dbDatabase* _db;
   double _lef_area_factor;
   double _lef_dist_factor;
+  std::vector<Scope> _scopes;
+  int _num_threads;
+  bool _lazy;
+  std::shared_ptr<const void> _buf_owner;
+
+  void readBytes(void* data, size_t size)
+  {
+    if (_buf == nullptr) {
+      _f->read(reinterpret_cast<char*>(data), size);
+      return;
+    }
+    if (size > static_cast<size_t>(_buf_end - _buf_pos)) {
+      throw std::ios_base::failure("unexpected end of database buffer");
+    }
+    std::memcpy(data, _buf_pos, size);
+    _buf_pos += size;
+  }
+
+  // Counterpart of dbOStream::writeValueAsBytes
+  template <typename T>
+  void readValueAsBytes(T& type)
+  {
+    readBytes(&type, sizeof(T));
+  }
+
+  void init(_dbDatabase* db);
 
  public:
   dbIStream(_dbDatabase* db, std::istream& f);
+  dbIStream(_dbDatabase* db, const char* data, size_t size);
 
   _dbDatabase* getDatabase() { return _db; }
 
@@ -311,67 +364,67 @@ class dbIStream
 
   dbIStream& operator>>(char& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(unsigned char& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(int16_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(uint16_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(int& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(uint64_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(unsigned int& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(int8_t& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(float& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(double& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
   dbIStream& operator>>(long double& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
@@ -384,7 +437,7 @@ class dbIStream
       c = nullptr;
     } else {
       c = (char*) malloc(l);
-      _f.read(reinterpret_cast<char*>(c), l);
+      readBytes(c, l);
     }
 
     return *this;
@@ -392,7 +445,7 @@ class dbIStream
 
   dbIStream& operator>>(dbObjectType& c)
   {
-    _f.read(reinterpret_cast<char*>(&c), sizeof(c));
+    readValueAsBytes(c);
     return *this;
   }
 
@@ -437,11 +490,16 @@ class dbIStream
   {
     uint sz;
     *this >> sz;
-    m.reserve(sz);
-    for (uint i = 0; i < sz; i++) {
-      T1 val;
-      *this >> val;
-      m.push_back(val);
+    if constexpr (isBulkType<T1>()) {
+      m.resize(sz);
+      readArray(m.data(), sz);
+    } else {
+      m.reserve(sz);
+      for (uint i = 0; i < sz; i++) {
+        T1 val;
+        *this >> val;
+        m.push_back(val);
+      }
     }
     return *this;
   }
@@ -490,6 +548,71 @@ class dbIStream
 
   double lefdist(int value) { return ((double) value * _lef_dist_factor); }
 
+  // Types whose stream representation is exactly their in-memory bytes so
+  // that arrays of them can be decoded with a single copy.
+  template <typename T>
+  static constexpr bool isBulkType()
+  {
+    return std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+  }
+
+  // Decode cnt values written individually by dbOStream in one operation.
+  template <typename T>
+  void readArray(T* data, size_t cnt)
+  {
+    static_assert(isBulkType<T>(), "readArray requires an arithmetic type");
+    readBytes(data, cnt * sizeof(T));
+  }
+
+  // True when decoding from a memory buffer rather than a std::istream.
+  bool isBuffered() const { return _buf != nullptr; }
+
+  // Number of undecoded bytes left in the memory buffer.
+  size_t remaining() const { return _buf_end - _buf_pos; }
+
+  // Consume the next size bytes without decoding them.  A memory buffer is
+  // used in place, otherwise the bytes are read into storage.
+  const char* readBlock(size_t size, std::string& storage)
+  {
+    if (_buf == nullptr) {
+      storage.resize(size);
+      _f->read(storage.data(), size);
+      return storage.data();
+    }
+    if (size > remaining()) {
+      throw std::ios_base::failure("unexpected end of database buffer");
+    }
+    const char* data = _buf_pos;
+    _buf_pos += size;
+    return data;
+  }
+
+  // Threads available for decoding independent sections.
+  void setNumThreads(int num_threads) { _num_threads = num_threads; }
+  int getNumThreads() const { return _num_threads; }
+
+  // When lazy, sections that support it are decoded on first access
+  // rather than while the stream is read.
+  void setLazy(bool lazy) { _lazy = lazy; }
+  bool isLazy() const { return _lazy; }
+
+  // Keeps the memory buffer alive for sections whose decoding is deferred.
+  void setBufferOwner(std::shared_ptr<const void> owner)
+  {
+    _buf_owner = std::move(owner);
+  }
+  const std::shared_ptr<const void>& getBufferOwner() const
+  {
+    return _buf_owner;
+  }
+
+  Position pos() const;
+
+  void pushScope(const std::string& name);
+  void popScope();
+  // The open scopes, outermost first.
+  std::vector<std::string> getScopeNames() const;
+
  private:
   template <uint32_t I = 0, typename... Ts>
   dbIStream& variantHelper(uint32_t index, std::variant<Ts...>& v)
@@ -510,4 +633,19 @@ class dbIStream
   }
 };
 
+// RAII class for scoping istream operations
+class dbIStreamScope
+{
+ public:
+  dbIStreamScope(dbIStream& istream, const std::string& name)
+      : istream_(istream)
+  {
+    istream_.pushScope(name);
+  }
+
+  ~dbIStreamScope() { istream_.popScope(); }
+
+  dbIStream& istream_;
+};
+
 }  // namespace odb
@@ -73,6 +73,9 @@ class defin
   void namesAreDBIDs();
   void setAssemblyMode();
   void useBlockName(const char* name);
+  // With more than one thread NETS are committed on a separate thread
+  // while the parser reads ahead.
+  void setThreadCount(int threads);
 
   /// Create a new chip
   dbChip* createChip(std::vector<dbLib*>& search_libs,
@@ -65,6 +65,8 @@ class defout
   void setUseMasterIds(bool value);
   void selectNet(dbNet* net);
   void setVersion(Version v);  // default is 5.8
+  void setThreadCount(int threads);
+  void setChunkSize(int size);  // objects per parallel chunk, default 1024
 
   bool writeBlock(dbBlock* block, const char* def_file);
 };
@@ -114,6 +114,7 @@
 #include "dbSBoxItr.h"
 #include "dbSWire.h"
 #include "dbSWireItr.h"
+#include "dbStreamSection.h"
 #include "dbTable.h"
 #include "dbTable.hpp"
 #include "dbTech.h"
@@ -929,6 +930,54 @@ dbObjectTable* _dbBlock::getObjectTable(dbObjectType type)
   return getTable()->getObjectTable(type);
 }
 
+std::vector<dbStreamSection> _dbBlock::getStreamSections() const
+{
+  return {makeStreamSection("bterm_tbl", _bterm_tbl),
+          makeStreamSection("iterm_tbl", _iterm_tbl),
+          makeStreamSection("net_tbl", _net_tbl),
+          makeStreamSection("inst_hdr_tbl", _inst_hdr_tbl),
+          makeStreamSection("inst_tbl", _inst_tbl),
+          makeStreamSection("module_tbl", _module_tbl),
+          makeStreamSection("modinst_tbl", _modinst_tbl),
+          makeStreamSection("modbterm_tbl", _modbterm_tbl),
+          makeStreamSection("moditerm_tbl", _moditerm_tbl),
+          makeStreamSection("modnet_tbl", _modnet_tbl),
+          makeStreamSection("powerdomain_tbl", _powerdomain_tbl),
+          makeStreamSection("logicport_tbl", _logicport_tbl),
+          makeStreamSection("powerswitch_tbl", _powerswitch_tbl),
+          makeStreamSection("isolation_tbl", _isolation_tbl),
+          makeStreamSection("levelshifter_tbl", _levelshifter_tbl),
+          makeStreamSection("group_tbl", _group_tbl),
+          makeStreamSection("ap_tbl", ap_tbl_),
+          makeStreamSection("global_connect_tbl", global_connect_tbl_),
+          makeStreamSection("guide_tbl", _guide_tbl),
+          makeStreamSection("net_tracks_tbl", _net_tracks_tbl),
+          makeStreamSection("box_tbl", _box_tbl),
+          makeStreamSection("via_tbl", _via_tbl),
+          makeStreamSection("gcell_grid_tbl", _gcell_grid_tbl),
+          makeStreamSection("track_grid_tbl", _track_grid_tbl),
+          makeStreamSection("obstruction_tbl", _obstruction_tbl),
+          makeStreamSection("blockage_tbl", _blockage_tbl),
+          makeLazyStreamSection("wire_tbl", _wire_tbl),
+          makeLazyStreamSection("swire_tbl", _swire_tbl),
+          makeStreamSection("sbox_tbl", _sbox_tbl),
+          makeStreamSection("row_tbl", _row_tbl),
+          makeStreamSection("fill_tbl", _fill_tbl),
+          makeStreamSection("region_tbl", _region_tbl),
+          makeStreamSection("hier_tbl", _hier_tbl),
+          makeStreamSection("bpin_tbl", _bpin_tbl),
+          makeStreamSection("non_default_rule_tbl", _non_default_rule_tbl),
+          makeStreamSection("layer_rule_tbl", _layer_rule_tbl),
+          makeStreamSection("prop_tbl", _prop_tbl),
+          makeStreamSection("name_cache", _name_cache),
+          makeStreamSection("r_val_tbl", _r_val_tbl),
+          makeStreamSection("c_val_tbl", _c_val_tbl),
+          makeStreamSection("cc_val_tbl", _cc_val_tbl),
+          makeLazyStreamSection("cap_node_tbl", _cap_node_tbl),
+          makeLazyStreamSection("r_seg_tbl", _r_seg_tbl),
+          makeLazyStreamSection("cc_seg_tbl", _cc_seg_tbl)};
+}
+
 dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
 {
   std::list<dbBlockCallBackObj*>::const_iterator cbitr;
@@ -982,53 +1031,7 @@ dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
   stream << block._component_mask_shift;
   stream << block._currentCcAdjOrder;
 
-  stream << *block._bterm_tbl;
-  stream << *block._iterm_tbl;
-  stream << *block._net_tbl;
-  stream << *block._inst_hdr_tbl;
-  stream << *block._inst_tbl;
-  stream << *block._module_tbl;
-  stream << *block._modinst_tbl;
-  if (db->isSchema(db_schema_update_hierarchy)) {
-    stream << *block._modbterm_tbl;
-    stream << *block._moditerm_tbl;
-    stream << *block._modnet_tbl;
-  }
-  stream << *block._powerdomain_tbl;
-  stream << *block._logicport_tbl;
-  stream << *block._powerswitch_tbl;
-  stream << *block._isolation_tbl;
-  stream << *block._levelshifter_tbl;
-  stream << *block._group_tbl;
-  stream << *block.ap_tbl_;
-  stream << *block.global_connect_tbl_;
-  stream << *block._guide_tbl;
-  stream << *block._net_tracks_tbl;
-  stream << *block._box_tbl;
-  stream << *block._via_tbl;
-  stream << *block._gcell_grid_tbl;
-  stream << *block._track_grid_tbl;
-  stream << *block._obstruction_tbl;
-  stream << *block._blockage_tbl;
-  stream << *block._wire_tbl;
-  stream << *block._swire_tbl;
-  stream << *block._sbox_tbl;
-  stream << *block._row_tbl;
-  stream << *block._fill_tbl;
-  stream << *block._region_tbl;
-  stream << *block._hier_tbl;
-  stream << *block._bpin_tbl;
-  stream << *block._non_default_rule_tbl;
-  stream << *block._layer_rule_tbl;
-  stream << *block._prop_tbl;
-
-  stream << *block._name_cache;
-  stream << *block._r_val_tbl;
-  stream << *block._c_val_tbl;
-  stream << *block._cc_val_tbl;
-  stream << NamedTable("cap_node_tbl", block._cap_node_tbl);
-  stream << NamedTable("r_seg_tbl", block._r_seg_tbl);
-  stream << NamedTable("cc_seg_tbl", block._cc_seg_tbl);
+  writeSections(stream, block.getStreamSections());
   stream << *block._extControl;
   stream << block._dft;
   stream << *block._dft_tbl;
@@ -1053,6 +1056,7 @@ dbOStream& operator<<(dbOStream& stream, const _dbBlock& block)
 dbIStream& operator>>(dbIStream& stream, _dbBlock& block)
 {
   _dbDatabase* db = block.getImpl()->getDatabase();
+  dbIStreamScope scope(stream, "dbBlock");
 
   stream >> block._def_units;
   stream >> block._dbu_per_micron;
@@ -1110,58 +1114,62 @@ dbIStream& operator>>(dbIStream& stream, _dbBlock& block)
     stream >> block._component_mask_shift;
   }
   stream >> block._currentCcAdjOrder;
-  stream >> *block._bterm_tbl;
-  stream >> *block._iterm_tbl;
-  stream >> *block._net_tbl;
-  stream >> *block._inst_hdr_tbl;
-  stream >> *block._inst_tbl;
-  stream >> *block._module_tbl;
-  stream >> *block._modinst_tbl;
-  if (db->isSchema(db_schema_update_hierarchy)) {
-    stream >> *block._modbterm_tbl;
-    stream >> *block._moditerm_tbl;
-    stream >> *block._modnet_tbl;
-  }
-  stream >> *block._powerdomain_tbl;
-  stream >> *block._logicport_tbl;
-  stream >> *block._powerswitch_tbl;
-  stream >> *block._isolation_tbl;
-  if (db->isSchema(db_schema_level_shifter)) {
-    stream >> *block._levelshifter_tbl;
-  }
-  stream >> *block._group_tbl;
-  stream >> *block.ap_tbl_;
-  if (db->isSchema(db_schema_add_global_connect)) {
-    stream >> *block.global_connect_tbl_;
-  }
-  stream >> *block._guide_tbl;
-  if (db->isSchema(db_schema_net_tracks)) {
-    stream >> *block._net_tracks_tbl;
-  }
-  stream >> *block._box_tbl;
-  stream >> *block._via_tbl;
-  stream >> *block._gcell_grid_tbl;
-  stream >> *block._track_grid_tbl;
-  stream >> *block._obstruction_tbl;
-  stream >> *block._blockage_tbl;
-  stream >> *block._wire_tbl;
-  stream >> *block._swire_tbl;
-  stream >> *block._sbox_tbl;
-  stream >> *block._row_tbl;
-  stream >> *block._fill_tbl;
-  stream >> *block._region_tbl;
-  stream >> *block._hier_tbl;
-  stream >> *block._bpin_tbl;
-  stream >> *block._non_default_rule_tbl;
-  stream >> *block._layer_rule_tbl;
-  stream >> *block._prop_tbl;
-  stream >> *block._name_cache;
-  stream >> *block._r_val_tbl;
-  stream >> *block._c_val_tbl;
-  stream >> *block._cc_val_tbl;
-  stream >> *block._cap_node_tbl;  // DKF
-  stream >> *block._r_seg_tbl;     // DKF
-  stream >> *block._cc_seg_tbl;
+  if (db->isSchema(db_schema_block_sections)) {
+    readSections(stream, block.getStreamSections());
+  } else {
+    stream >> *block._bterm_tbl;
+    stream >> *block._iterm_tbl;
+    stream >> *block._net_tbl;
+    stream >> *block._inst_hdr_tbl;
+    stream >> *block._inst_tbl;
+    stream >> *block._module_tbl;
+    stream >> *block._modinst_tbl;
+    if (db->isSchema(db_schema_update_hierarchy)) {
+      stream >> *block._modbterm_tbl;
+      stream >> *block._moditerm_tbl;
+      stream >> *block._modnet_tbl;
+    }
+    stream >> *block._powerdomain_tbl;
+    stream >> *block._logicport_tbl;
+    stream >> *block._powerswitch_tbl;
+    stream >> *block._isolation_tbl;
+    if (db->isSchema(db_schema_level_shifter)) {
+      stream >> *block._levelshifter_tbl;
+    }
+    stream >> *block._group_tbl;
+    stream >> *block.ap_tbl_;
+    if (db->isSchema(db_schema_add_global_connect)) {
+      stream >> *block.global_connect_tbl_;
+    }
+    stream >> *block._guide_tbl;
+    if (db->isSchema(db_schema_net_tracks)) {
+      stream >> *block._net_tracks_tbl;
+    }
+    stream >> *block._box_tbl;
+    stream >> *block._via_tbl;
+    stream >> *block._gcell_grid_tbl;
+    stream >> *block._track_grid_tbl;
+    stream >> *block._obstruction_tbl;
+    stream >> *block._blockage_tbl;
+    stream >> *block._wire_tbl;
+    stream >> *block._swire_tbl;
+    stream >> *block._sbox_tbl;
+    stream >> *block._row_tbl;
+    stream >> *block._fill_tbl;
+    stream >> *block._region_tbl;
+    stream >> *block._hier_tbl;
+    stream >> *block._bpin_tbl;
+    stream >> *block._non_default_rule_tbl;
+    stream >> *block._layer_rule_tbl;
+    stream >> *block._prop_tbl;
+    stream >> *block._name_cache;
+    stream >> *block._r_val_tbl;
+    stream >> *block._c_val_tbl;
+    stream >> *block._cc_val_tbl;
+    stream >> *block._cap_node_tbl;  // DKF
+    stream >> *block._r_seg_tbl;     // DKF
+    stream >> *block._cc_seg_tbl;
+  }
   stream >> *block._extControl;
   if (db->isSchema(db_schema_add_scan)) {
     stream >> block._dft;
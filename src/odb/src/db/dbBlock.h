@@ -39,6 +39,7 @@
 #include "dbHashTable.h"
 #include "dbIntHashTable.h"
 #include "dbPagedVector.h"
+#include "dbStreamSection.h"
 #include "dbVector.h"
 #include "odb/dbTransform.h"
 #include "odb/dbTypes.h"
@@ -313,6 +314,9 @@ class _dbBlock : public _dbObject
   _dbTech* getTech();
 
   dbObjectTable* getObjectTable(dbObjectType type);
+
+  // The tables streamed as independently encoded sections
+  std::vector<dbStreamSection> getStreamSections() const;
 };
 
 dbOStream& operator<<(dbOStream& stream, const _dbBlock& block);
@@ -146,6 +146,7 @@ dbOStream& operator<<(dbOStream& stream, const _dbChip& chip)
 
 dbIStream& operator>>(dbIStream& stream, _dbChip& chip)
 {
+  dbIStreamScope scope(stream, "dbChip");
   stream >> chip._top;
   stream >> *chip._block_tbl;
   stream >> *chip._prop_tbl;
@@ -44,6 +44,9 @@
 ///  dbTablePage
 ///
 
+#include <atomic>
+#include <functional>
+
 #include "dbAttrTable.h"
 #include "odb/dbId.h"
 #include "odb/dbObject.h"
@@ -98,10 +101,15 @@ class dbObjectTable
   uint _obj_size;
   dbObjectTable* (dbObject::*_getObjectTable)(dbObjectType type);
 
+  // Deferred decoding of a lazily read table (see setLoader).  Only such
+  // tables allocate a Loader so the check on access is one pointer load.
+  struct Loader;
+  mutable std::atomic<Loader*> _loader{nullptr};
+
   // PERSISTANT DATA
   dbAttrTable<dbId<_dbProperty>> _prop_list;
 
-  virtual ~dbObjectTable() = default;
+  virtual ~dbObjectTable();
   dbObjectTable();
   dbObjectTable(_dbDatabase* db,
                 dbObject* owner,
@@ -109,19 +117,47 @@ class dbObjectTable
                 dbObjectType type,
                 uint size);
 
-  dbId<_dbProperty> getPropList(uint oid) { return _prop_list.getAttr(oid); }
+  dbId<_dbProperty> getPropList(uint oid)
+  {
+    load();
+    return _prop_list.getAttr(oid);
+  }
 
   void setPropList(uint oid, const dbId<_dbProperty>& propList)
   {
+    load();
     _prop_list.setAttr(oid, propList);
   }
 
+  // Defer decoding the table until it is first accessed.  The loader is
+  // expected to stream the table contents in.
+  void setLoader(std::function<void()> loader);
+
+  // Run the deferred loader, if any.  Safe to call from multiple threads.
+  void load() const
+  {
+    if (_loader.load(std::memory_order_acquire) != nullptr) {
+      loadDeferred();
+    }
+  }
+
+  bool isLoaded() const
+  {
+    return _loader.load(std::memory_order_acquire) == nullptr;
+  }
+
+  // Drop the deferred contents, unless called from the running loader.
+  void discardLoader();
+
   virtual dbObject* getObject(uint id, ...) = 0;
 
   dbObjectTable* getObjectTable(dbObjectType type)
   {
     return (_owner->*_getObjectTable)(type);
   }
+
+ private:
+  void loadDeferred() const;
 };
 
 ///////////////////////////////////////////////////////////////
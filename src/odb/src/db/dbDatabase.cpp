@@ -32,9 +32,16 @@
 
 #include "dbDatabase.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <map>
+#include <memory>
 #include <string>
 
 #include "dbArrayTable.h"
@@ -288,6 +295,7 @@ dbOStream& operator<<(dbOStream& stream, const _dbDatabase& db)
 
 dbIStream& operator>>(dbIStream& stream, _dbDatabase& db)
 {
+  dbIStreamScope scope(stream, "dbDatabase");
   stream >> db._magic1;
 
   if (db._magic1 != DB_MAGIC1) {
@@ -502,17 +510,79 @@ dbTech* dbDatabase::getTech()
       utl::ODB, 432, "getTech() is obsolete in a multi-tech db");
 }
 
-void dbDatabase::read(std::istream& file)
+void dbDatabase::read(std::istream& file, int num_threads)
 {
   _dbDatabase* db = (_dbDatabase*) this;
   dbIStream stream(db, file);
+  stream.setNumThreads(num_threads);
+  stream >> *db;
+}
+
+void dbDatabase::readMapped(const char* filename, int num_threads, bool lazy)
+{
+  const int fd = open(filename, O_RDONLY);
+  if (fd < 0) {
+    throw std::ios_base::failure(
+        fmt::format("can't open {}: {}", filename, strerror(errno)));
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    const int errnum = errno;
+    close(fd);
+    throw std::ios_base::failure(
+        fmt::format("can't stat {}: {}", filename, strerror(errnum)));
+  }
+
+  const size_t size = info.st_size;
+  if (size == 0) {
+    close(fd);
+    throw std::ios_base::failure(fmt::format("{} is empty", filename));
+  }
+
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  const int errnum = errno;
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw std::ios_base::failure(
+        fmt::format("can't map {}: {}", filename, strerror(errnum)));
+  }
+  // The advice values are not flags so each is given separately.  They
+  // are only hints, so failure is reported but not fatal.
+  _dbDatabase* db = (_dbDatabase*) this;
+  for (const int advice : {MADV_SEQUENTIAL, MADV_WILLNEED}) {
+    if (madvise(data, size, advice) != 0) {
+      db->getLogger()->warn(
+          utl::ODB, 442, "madvise on {} failed: {}", filename, strerror(errno));
+    }
+  }
+
+  // Lazily decoded tables keep the mapping alive until they are loaded.
+  auto unmap = [size](const void* addr) {
+    munmap(const_cast<void*>(addr), size);
+  };
+  std::shared_ptr<const void> mapping(data, unmap);
+
+  dbIStream stream(db, static_cast<const char*>(data), size);
+  stream.setNumThreads(num_threads);
+  stream.setLazy(lazy);
+  if (lazy) {
+    stream.setBufferOwner(mapping);
+  }
   stream >> *db;
+
+  // Every scope written by dbOStream must be consumed by the reader.
+  if (stream.remaining() != 0) {
+    throw std::ios_base::failure(fmt::format(
+        "{} has {} bytes of undecoded data", filename, stream.remaining()));
+  }
 }
 
-void dbDatabase::write(std::ostream& file)
+void dbDatabase::write(std::ostream& file, int num_threads)
 {
   _dbDatabase* db = (_dbDatabase*) this;
   dbOStream stream(db, file);
+  stream.setNumThreads(num_threads);
   stream << *db;
   file.flush();
 }
@@ -31,6 +31,7 @@
 // POSSIBILITY OF SUCH DAMAGE.
 
 #include <cstring>
+#include <mutex>
 
 #include "dbCore.h"
 #include "dbDatabase.h"
@@ -41,6 +42,67 @@
 
 namespace odb {
 
+struct dbObjectTable::Loader
+{
+  std::function<void()> load;
+  bool running = false;
+};
+
+// Guards all deferred table loads.  It is recursive as a loader may touch
+// its own or another lazy table, and is only taken for tables that still
+// have a loader.
+static std::recursive_mutex& loaderLock()
+{
+  static std::recursive_mutex lock;
+  return lock;
+}
+
+dbObjectTable::~dbObjectTable()
+{
+  delete _loader.load(std::memory_order_acquire);
+}
+
+void dbObjectTable::setLoader(std::function<void()> loader)
+{
+  std::lock_guard<std::recursive_mutex> lock(loaderLock());
+  Loader* deferred = new Loader{std::move(loader)};
+  delete _loader.exchange(deferred, std::memory_order_acq_rel);
+}
+
+void dbObjectTable::loadDeferred() const
+{
+  std::lock_guard<std::recursive_mutex> lock(loaderLock());
+  // Another thread may have finished loading while we waited, or the
+  // loader itself is touching the table.
+  Loader* loader = _loader.load(std::memory_order_acquire);
+  if (loader == nullptr || loader->running) {
+    return;
+  }
+  loader->running = true;
+  try {
+    loader->load();
+  } catch (...) {
+    loader->running = false;
+    throw;
+  }
+  _loader.store(nullptr, std::memory_order_release);
+  delete loader;
+}
+
+void dbObjectTable::discardLoader()
+{
+  if (_loader.load(std::memory_order_acquire) == nullptr) {
+    return;
+  }
+  std::lock_guard<std::recursive_mutex> lock(loaderLock());
+  Loader* loader = _loader.load(std::memory_order_acquire);
+  if (loader == nullptr || loader->running) {
+    return;
+  }
+  _loader.store(nullptr, std::memory_order_release);
+  delete loader;
+}
+
 uint dbObject::getId() const
 {
   return getImpl()->getOID();
@@ -32,6 +32,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "odb/ZException.h"
 #include "odb/dbDiff.h"
 #include "odb/dbStream.h"
@@ -72,6 +74,7 @@ class dbPagedVector
   ~dbPagedVector();
 
   void push_back(const T& item);
+  void readPages(dbIStream& stream, uint cnt);
 
   uint push_back(int cnt, const T& item)
   {
@@ -272,6 +275,26 @@ void dbPagedVector<T, P, S>::push_back(const T& item)
   objects[offset] = item;
 }
 
+// Appends cnt values decoding a whole page at a time.  Only valid for
+// types where dbIStream::isBulkType is true.
+template <class T, const uint P, const uint S>
+void dbPagedVector<T, P, S>::readPages(dbIStream& stream, uint cnt)
+{
+  while (cnt > 0) {
+    unsigned int page = (_next_idx & ~(P - 1)) >> S;
+
+    if (page == _page_cnt) {
+      newPage();
+    }
+
+    unsigned int offset = _next_idx & (P - 1);
+    unsigned int n = std::min(cnt, P - offset);
+    stream.readArray(&_pages[page][offset], n);
+    _next_idx += n;
+    cnt -= n;
+  }
+}
+
 template <class T, const uint P, const uint S>
 inline bool dbPagedVector<T, P, S>::operator==(
     const dbPagedVector<T, P, S>& rhs) const
@@ -376,12 +399,17 @@ inline dbIStream& operator>>(dbIStream& stream, dbPagedVector<T, P, S>& v)
 
   uint sz;
   stream >> sz;
-  T t;
-  uint i;
 
-  for (i = 0; i < sz; ++i) {
-    stream >> t;
-    v.push_back(t);
+  if constexpr (dbIStream::isBulkType<T>()) {
+    v.readPages(stream, sz);
+  } else {
+    T t;
+    uint i;
+
+    for (i = 0; i < sz; ++i) {
+      stream >> t;
+      v.push_back(t);
+    }
   }
 
   return stream;
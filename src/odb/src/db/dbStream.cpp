@@ -65,6 +65,15 @@ void dbOStream::popScope()
   _scopes.pop_back();
 }
 
+std::vector<std::string> dbOStream::getScopeNames() const
+{
+  std::vector<std::string> names;
+  for (const Scope& scope : _scopes) {
+    names.push_back(scope.name);
+  }
+  return names;
+}
+
 dbOStream& operator<<(dbOStream& stream, const Rect& r)
 {
   stream << r.xlo_;
@@ -116,6 +125,7 @@ dbIStream& operator>>(dbIStream& stream, Oct& o)
 dbOStream::dbOStream(_dbDatabase* db, std::ostream& f) : _f(f)
 {
   _db = db;
+  _num_threads = 1;
   _lef_dist_factor = 0.001;
   _lef_area_factor = 0.000001;
 
@@ -127,9 +137,23 @@ dbOStream::dbOStream(_dbDatabase* db, std::ostream& f) : _f(f)
   }
 }
 
-dbIStream::dbIStream(_dbDatabase* db, std::istream& f) : _f(f)
+dbIStream::dbIStream(_dbDatabase* db, std::istream& f)
+    : _f(&f), _buf(nullptr), _buf_pos(nullptr), _buf_end(nullptr)
+{
+  init(db);
+}
+
+dbIStream::dbIStream(_dbDatabase* db, const char* data, size_t size)
+    : _f(nullptr), _buf(data), _buf_pos(data), _buf_end(data + size)
+{
+  init(db);
+}
+
+void dbIStream::init(_dbDatabase* db)
 {
   _db = db;
+  _num_threads = 1;
+  _lazy = false;
 
   _lef_dist_factor = 0.001;
   _lef_area_factor = 0.000001;
@@ -142,6 +166,49 @@ dbIStream::dbIStream(_dbDatabase* db, std::istream& f) : _f(f)
   }
 }
 
+dbIStream::Position dbIStream::pos() const
+{
+  if (_buf) {
+    return _buf_pos - _buf;
+  }
+  return _f->tellg();
+}
+
+void dbIStream::pushScope(const std::string& name)
+{
+  _scopes.push_back({name, pos()});
+}
+
+void dbIStream::popScope()
+{
+  auto logger = _db->getLogger();
+  if (logger->debugCheck(utl::ODB, "io_size", 1)) {
+    auto size = pos() - _scopes.back().start_pos;
+    if (size >= 1024) {  // hide tiny contributors
+      std::ostringstream scope_name;
+
+      std::transform(_scopes.begin(),
+                     _scopes.end(),
+                     std::ostream_iterator<std::string>(scope_name, "/"),
+                     [](const Scope& scope) { return scope.name; });
+
+      logger->report(
+          "{:8.1f} MB read in {}", size / 1048576.0, scope_name.str());
+    }
+  }
+
+  _scopes.pop_back();
+}
+
+std::vector<std::string> dbIStream::getScopeNames() const
+{
+  std::vector<std::string> names;
+  for (const Scope& scope : _scopes) {
+    names.push_back(scope.name);
+  }
+  return names;
+}
+
 std::ostream& operator<<(std::ostream& os, const Rect& box)
 {
   os << "( " << box.xMin() << " " << box.yMin() << " ) ( " << box.xMax() << " "
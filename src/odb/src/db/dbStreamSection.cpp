@@ -0,0 +1,220 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "dbStreamSection.h"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "dbDatabase.h"
+#include "odb/ZException.h"
+
+namespace odb {
+
+static void decodeSection(_dbDatabase* db,
+                          const std::vector<std::string>& parent_scopes,
+                          const char* name,
+                          const std::function<void(dbIStream&)>& read,
+                          const char* data,
+                          size_t size)
+{
+  dbIStream section_stream(db, data, size);
+  // Nest the io_size reports under the enclosing stream's scopes.  These
+  // are never popped so they are not reported again.
+  for (const std::string& scope : parent_scopes) {
+    section_stream.pushScope(scope);
+  }
+  {
+    dbIStreamScope scope(section_stream, name);
+    read(section_stream);
+  }
+  if (section_stream.remaining() != 0) {
+    throw ZException("database section %s has %zu undecoded bytes",
+                     name,
+                     section_stream.remaining());
+  }
+}
+
+void writeSections(dbOStream& stream,
+                   const std::vector<dbStreamSection>& sections)
+{
+  _dbDatabase* db = stream.getDatabase();
+  const std::vector<std::string> parent_scopes = stream.getScopeNames();
+  const int cnt = sections.size();
+  std::vector<std::string> data(cnt);
+  std::vector<std::exception_ptr> errors(cnt);
+
+#pragma omp parallel for num_threads(stream.getNumThreads()) \
+    schedule(dynamic, 1)
+  for (int i = 0; i < cnt; ++i) {
+    try {
+      std::ostringstream buffer;
+      dbOStream section_stream(db, buffer);
+      // Nest the io_size reports under the enclosing stream's scopes.
+      for (const std::string& scope : parent_scopes) {
+        section_stream.pushScope(scope);
+      }
+      {
+        dbOStreamScope scope(section_stream, sections[i].name);
+        sections[i].write(section_stream);
+      }
+      data[i] = buffer.str();
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  }
+
+  for (const std::exception_ptr& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  uint64_t offset = 0;
+  stream << (uint) cnt;
+  for (int i = 0; i < cnt; ++i) {
+    stream << sections[i].name;
+    stream << offset;
+    stream << (uint64_t) data[i].size();
+    offset += data[i].size();
+  }
+
+  for (std::string& section_data : data) {
+    stream.writeBytes(section_data.data(), section_data.size());
+    std::string().swap(section_data);
+  }
+}
+
+void readSections(dbIStream& stream,
+                  const std::vector<dbStreamSection>& sections)
+{
+  _dbDatabase* db = stream.getDatabase();
+  const std::vector<std::string> parent_scopes = stream.getScopeNames();
+
+  uint cnt;
+  stream >> cnt;
+  if (cnt != sections.size()) {
+    throw ZException("database has %u sections, expected %zu",
+                     cnt,
+                     sections.size());
+  }
+
+  std::vector<uint64_t> offsets(cnt);
+  std::vector<uint64_t> sizes(cnt);
+  uint64_t total = 0;
+  for (uint i = 0; i < cnt; ++i) {
+    std::string name;
+    stream >> name;
+    stream >> offsets[i];
+    stream >> sizes[i];
+    if (name != sections[i].name) {
+      throw ZException("database section %s found where %s was expected",
+                       name.c_str(),
+                       sections[i].name);
+    }
+    if (offsets[i] != total) {
+      throw ZException("database section %s has a bad offset", name.c_str());
+    }
+    total += sizes[i];
+  }
+
+  // When decoding from a memory buffer the sections are used in place,
+  // otherwise they are first read into memory.
+  std::string storage;
+  const char* data = stream.readBlock(total, storage);
+
+  // Deferred sections are decoded after the database schema has been
+  // updated to the current revision, so only defer when they match.
+  const bool lazy = stream.isLazy() && db->_schema_minor == db_schema_minor;
+
+  std::vector<int> order;
+  std::shared_ptr<const void> owner;
+  for (uint i = 0; i < cnt; ++i) {
+    if (!lazy || !sections[i].defer) {
+      order.push_back(i);
+      continue;
+    }
+    if (!owner) {
+      owner = stream.getBufferOwner();
+      if (!owner) {
+        auto copy = std::make_shared<std::string>(std::move(storage));
+        data = copy->data();
+        owner = std::move(copy);
+      }
+    }
+    sections[i].defer([db,
+                       owner,
+                       parent_scopes,
+                       name = sections[i].name,
+                       read = sections[i].read,
+                       section_data = data + offsets[i],
+                       size = sizes[i]]() {
+      decodeSection(db, parent_scopes, name, read, section_data, size);
+    });
+  }
+
+  // Decode the largest sections first for better load balance.
+  std::stable_sort(order.begin(), order.end(), [&sizes](int a, int b) {
+    return sizes[a] > sizes[b];
+  });
+
+  std::vector<std::exception_ptr> errors(cnt);
+
+#pragma omp parallel for num_threads(stream.getNumThreads()) \
+    schedule(dynamic, 1)
+  for (int k = 0; k < (int) order.size(); ++k) {
+    const int i = order[k];
+    try {
+      decodeSection(db,
+                    parent_scopes,
+                    sections[i].name,
+                    sections[i].read,
+                    data + offsets[i],
+                    sizes[i]);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  }
+
+  for (const std::exception_ptr& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+}  // namespace odb
@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, The Regents of the University of California
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "odb/dbStream.h"
+
+namespace odb {
+
+//
+// A section is a piece of a stream that is encoded independently of its
+// neighbors.  A group of sections is written as a directory (name, offset
+// and size of each section) followed by the section data.  This allows the
+// sections to be encoded and decoded concurrently, using the thread count of
+// the enclosing stream.
+//
+// A section with a defer function may be decoded on first access when the
+// stream is lazy.  defer is handed a loader that decodes the section and is
+// expected to run it before the object is used.
+//
+struct dbStreamSection
+{
+  const char* name;
+  std::function<void(dbOStream&)> write;
+  std::function<void(dbIStream&)> read;
+  std::function<void(std::function<void()>)> defer;
+};
+
+template <class T>
+dbStreamSection makeStreamSection(const char* name, T* obj)
+{
+  return {name,
+          [obj](dbOStream& stream) { stream << *obj; },
+          [obj](dbIStream& stream) { stream >> *obj; },
+          nullptr};
+}
+
+// For objects providing setLoader(), eg dbTable.
+template <class T>
+dbStreamSection makeLazyStreamSection(const char* name, T* obj)
+{
+  dbStreamSection section = makeStreamSection(name, obj);
+  section.defer = [obj](std::function<void()> loader) {
+    obj->setLoader(std::move(loader));
+  };
+  return section;
+}
+
+void writeSections(dbOStream& stream,
+                   const std::vector<dbStreamSection>& sections);
+void readSections(dbIStream& stream,
+                  const std::vector<dbStreamSection>& sections);
+
+}  // namespace odb
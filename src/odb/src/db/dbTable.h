@@ -89,7 +89,11 @@ class dbTable : public dbObjectTable, public dbIterator
   ~dbTable() override;
 
   // returns the number of instances of "T" allocated
-  uint size() const { return _alloc_cnt; }
+  uint size() const
+  {
+    load();
+    return _alloc_cnt;
+  }
 
   // Create a "T", calls T( _dbDatabase * )
   T* create();
@@ -108,6 +112,7 @@ class dbTable : public dbObjectTable, public dbIterator
   // Get the object of this id
   T* getPtr(dbId<T> id) const
   {
+    load();
     uint page = (uint) id >> _page_shift;
     uint offset = (uint) id & _page_mask;
 
@@ -119,6 +124,7 @@ class dbTable : public dbObjectTable, public dbIterator
 
   bool validId(dbId<T> id) const
   {
+    load();
     uint page = (uint) id >> _page_shift;
     uint offset = (uint) id & _page_mask;
 
@@ -137,6 +143,7 @@ class dbTable : public dbObjectTable, public dbIterator
   //
   T* getFreeObj(dbId<T> id)
   {
+    load();
     uint page = (uint) id >> _page_shift;
     uint offset = (uint) id & _page_mask;
     assert(((uint) id != 0) && (page < _page_cnt));
@@ -101,6 +101,10 @@ inline void dbTable<T>::unlinkQ(uint& Q, _dbFreeObject* e)
 template <class T>
 void dbTable<T>::clear()
 {
+  // Clearing an unloaded table discards its deferred contents, unless the
+  // loader is the one clearing it before streaming in.
+  discardLoader();
+
   uint i;
   for (i = 0; i < _page_cnt; ++i) {
     dbTablePage* page = _pages[i];
@@ -149,17 +153,18 @@ dbTable<T>::dbTable(_dbDatabase* db,
 
 template <class T>
 dbTable<T>::dbTable(_dbDatabase* db, dbObject* owner, const dbTable<T>& t)
-    : dbObjectTable(db, owner, t._getObjectTable, t._type, sizeof(T)),
-      _page_mask(t._page_mask),
-      _page_shift(t._page_shift),
-      _top_idx(t._top_idx),
-      _bottom_idx(t._bottom_idx),
-      _page_cnt(t._page_cnt),
-      _page_tbl_size(t._page_tbl_size),
-      _alloc_cnt(t._alloc_cnt),
-      _free_list(t._free_list),
-      _pages(nullptr)
-{
+    : dbObjectTable(db, owner, t._getObjectTable, t._type, sizeof(T))
+{
+  t.load();
+  _page_mask = t._page_mask;
+  _page_shift = t._page_shift;
+  _top_idx = t._top_idx;
+  _bottom_idx = t._bottom_idx;
+  _page_cnt = t._page_cnt;
+  _page_tbl_size = t._page_tbl_size;
+  _alloc_cnt = t._alloc_cnt;
+  _free_list = t._free_list;
+  _pages = nullptr;
   copy_pages(t);
 }
 
@@ -242,6 +247,7 @@ void dbTable<T>::newPage()
 template <class T>
 T* dbTable<T>::create()
 {
+  load();
   ++_alloc_cnt;
 
   if (_free_list == 0) {
@@ -273,6 +279,7 @@ T* dbTable<T>::create()
 template <class T>
 T* dbTable<T>::duplicate(T* c)
 {
+  load();
   ++_alloc_cnt;
 
   if (_free_list == 0) {
@@ -414,6 +421,7 @@ inline void dbTable<T>::findTop()
 template <class T>
 void dbTable<T>::destroy(T* t)
 {
+  load();
   --_alloc_cnt;
 
   ZASSERT(t->getOID() != 0);
@@ -463,6 +471,7 @@ void dbTable<T>::reverse(dbObject* /* unused: parent */)
 template <class T>
 uint dbTable<T>::sequential()
 {
+  load();
   return _top_idx;
 }
 
@@ -475,6 +484,7 @@ uint dbTable<T>::size(dbObject* /* unused: parent */)
 template <class T>
 uint dbTable<T>::begin(dbObject* /* unused: parent */)
 {
+  load();
   return _bottom_idx;
 }
 
@@ -488,6 +498,7 @@ template <class T>
 uint dbTable<T>::next(uint id, ...)
 {
   ZASSERT(id != 0);
+  load();
   ++id;
 
   if (id > _top_idx) {
@@ -637,6 +648,7 @@ dbOStream& operator<<(dbOStream& stream, const NamedTable<T>& named_table)
 template <class T>
 dbOStream& operator<<(dbOStream& stream, const dbTable<T>& table)
 {
+  table.load();
   stream << table._page_mask;
   stream << table._page_shift;
   stream << table._top_idx;
@@ -707,6 +719,8 @@ template <class T>
 bool dbTable<T>::operator==(const dbTable<T>& rhs) const
 {
   const dbTable<T>& lhs = *this;
+  lhs.load();
+  rhs.load();
 
   // These basic parameters should be the same...
   assert(lhs._page_mask == rhs._page_mask);
@@ -762,6 +776,8 @@ template <class T>
 void dbTable<T>::differences(dbDiff& diff, const dbTable<T>& rhs) const
 {
   const dbTable<T>& lhs = *this;
+  lhs.load();
+  rhs.load();
 
   // These basic parameters should be the same...
   assert(lhs._page_mask == rhs._page_mask);
@@ -821,6 +837,7 @@ void dbTable<T>::differences(dbDiff& diff, const dbTable<T>& rhs) const
 template <class T>
 void dbTable<T>::out(dbDiff& diff, char side) const
 {
+  load();
   uint i;
 
   for (i = _bottom_idx; i <= _top_idx; ++i) {
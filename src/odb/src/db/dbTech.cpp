@@ -524,6 +524,7 @@ dbOStream& operator<<(dbOStream& stream, const _dbTech& tech)
 
 dbIStream& operator>>(dbIStream& stream, _dbTech& tech)
 {
+  dbIStreamScope scope(stream, "dbTech");
   _dbDatabase* db = tech.getImpl()->getDatabase();
   if (db->isSchema(db_schema_block_tech)) {
     stream >> tech._name;
@@ -1044,6 +1045,15 @@ void dbTech::checkLayer(bool typeChk,
     }
   }
 }
+
+void dbTech::write(std::ostream& file)
+{
+  _dbTech* tech = (_dbTech*) this;
+  dbOStream stream(tech->getDatabase(), file);
+  stream << *tech;
+  file.flush();
+}
+
 dbTech* dbTech::create(dbDatabase* db_, const char* name, int dbu_per_micron)
 {
   _dbDatabase* db = (_dbDatabase*) db_;
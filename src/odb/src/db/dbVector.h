@@ -148,13 +148,19 @@ inline dbIStream& operator>>(dbIStream& stream, dbVector<T>& v)
   v.clear();
   unsigned int sz;
   stream >> sz;
-  v.reserve(sz);
 
-  T t;
-  unsigned int i;
-  for (i = 0; i < sz; ++i) {
-    stream >> t;
-    v.push_back(t);
+  if constexpr (dbIStream::isBulkType<T>()) {
+    v.resize(sz);
+    stream.readArray(v.data(), sz);
+  } else {
+    v.reserve(sz);
+
+    T t;
+    unsigned int i;
+    for (i = 0; i < sz; ++i) {
+      stream >> t;
+      v.push_back(t);
+    }
   }
 
   return stream;
@@ -604,6 +604,10 @@ void dbWireEncoder::end()
     return;
   }
 
+  for (auto callback : ((_dbBlock*) _block)->_callbacks) {
+    callback->inDbWirePreModify((dbWire*) _wire);
+  }
+
   uint n = _opcodes.size();
 
   // Free the old memory
@@ -498,6 +498,8 @@ defrContext::defrContext(int ownConf)
 {
 }
 
-defrContext defContext;
+// Each thread has its own parser context so that separate reads can run
+// concurrently.
+thread_local defrContext defContext;
 
 END_LEFDEF_PARSER_NAMESPACE
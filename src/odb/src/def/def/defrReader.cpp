@@ -53,7 +53,7 @@ BEGIN_LEFDEF_PARSER_NAMESPACE
 
 extern int defyyparse(defrData* data);
 
-extern defrContext defContext;
+extern thread_local defrContext defContext;
 
 void def_init(const char* func)
 {
@@ -97,6 +97,11 @@ void defin::useBlockName(const char* name)
   _reader->useBlockName(name);
 }
 
+void defin::setThreadCount(int threads)
+{
+  _reader->setThreadCount(threads);
+}
+
 dbChip* defin::createChip(std::vector<dbLib*>& libs,
                           const char* def_file,
                           dbTech* tech)
@@ -32,6 +32,8 @@
 
 #include "definNet.h"
 
+#include <strings.h>
+
 #include <cctype>
 #include <cstdio>
 #include <cstdlib>
@@ -231,6 +233,20 @@ void definNet::connection(const char* iname, const char* tname)
   _net_iterm_cnt++;
 }
 
+void definNet::connection(dbITerm* iterm)
+{
+  if (_skip_signal_connections == true) {
+    return;
+  }
+
+  if ((_cur_net == nullptr) || (_replace_wires == true)) {
+    return;
+  }
+
+  iterm->connect(_cur_net);
+  _net_iterm_cnt++;
+}
+
 dbTechNonDefaultRule* definNet::findNonDefaultRule(const char* name)
 {
   dbTechNonDefaultRule* rule = _block->findNonDefaultRule(name);
@@ -735,4 +751,131 @@ void definNet::end()
   _cur_net = nullptr;
 }
 
+void definNet::resolveConnections(std::vector<definNetRecord>& nets,
+                                  int threads)
+{
+  if (_skip_signal_connections || _replace_wires) {
+    return;
+  }
+
+  const int net_count = nets.size();
+#pragma omp parallel for num_threads(threads) schedule(dynamic, 64)
+  for (int i = 0; i < net_count; i++) {
+    for (definNetConnection& conn : nets[i].connections) {
+      // Pins, must-joins and unknown names are left to connection(iname,
+      // pname) so they are created and reported as before.
+      const std::string& iname = conn.inst;
+      if (conn.must_join || strcasecmp(iname.c_str(), "PIN") == 0) {
+        continue;
+      }
+      dbInst* inst = _block->findInst(iname.c_str());
+      if (inst == nullptr) {
+        continue;
+      }
+      dbMTerm* mterm = inst->getMaster()->findMTerm(_block, conn.pin.c_str());
+      if (mterm != nullptr) {
+        conn.iterm = inst->getITerm(mterm);
+      }
+    }
+  }
+}
+
+void definNet::commit(const definNetRecord& net)
+{
+  begin(net.name.c_str());
+
+  if (net.has_use) {
+    use(net.use.c_str());
+  }
+
+  if (net.has_source) {
+    source(net.source.c_str());
+  }
+
+  if (net.has_fixed_bump) {
+    fixedbump();
+  }
+
+  if (net.has_weight) {
+    weight(net.weight);
+  }
+
+  if (net.has_non_default_rule) {
+    nonDefaultRule(net.non_default_rule.c_str());
+  }
+
+  for (const definNetConnection& conn : net.connections) {
+    if (conn.must_join) {
+      beginMustjoin(conn.inst.c_str(), conn.pin.c_str());
+    } else if (conn.iterm) {
+      connection(conn.iterm);
+    } else {
+      connection(conn.inst.c_str(), conn.pin.c_str());
+    }
+  }
+
+  for (const definNetPathOp& op : net.routing) {
+    switch (op.type) {
+      case definNetPathOp::WIRE:
+        wire(op.name.c_str());
+        break;
+      case definNetPathOp::LAYER:
+        path(op.name.c_str());
+        break;
+      case definNetPathOp::TAPER:
+        pathTaper(op.name.c_str());
+        break;
+      case definNetPathOp::TAPER_RULE:
+        pathTaperRule(op.name.c_str(), op.rule.c_str());
+        break;
+      case definNetPathOp::VIA:
+        pathVia(op.name.c_str());
+        break;
+      case definNetPathOp::ROTATED_VIA:
+        pathVia(op.name.c_str(),
+                dbOrientType((dbOrientType::Value) op.values[0]));
+        break;
+      case definNetPathOp::POINT:
+        pathPoint(op.values[0], op.values[1]);
+        break;
+      case definNetPathOp::FLUSH_POINT:
+        pathPoint(op.values[0], op.values[1], op.values[2]);
+        break;
+      case definNetPathOp::RECT:
+        pathRect(op.values[0], op.values[1], op.values[2], op.values[3]);
+        break;
+      case definNetPathOp::COLOR:
+        pathColor(op.values[0]);
+        break;
+      case definNetPathOp::VIA_COLOR:
+        pathViaColor(op.values[0], op.values[1], op.values[2]);
+        break;
+      case definNetPathOp::PATH_END:
+        pathEnd();
+        break;
+      case definNetPathOp::WIRE_END:
+        wireEnd();
+        break;
+    }
+  }
+
+  for (const definNetProperty& prop : net.properties) {
+    switch (prop.type) {
+      case 'R':
+        property(prop.name.c_str(), prop.number);
+        break;
+      case 'I':
+        property(prop.name.c_str(), (int) prop.number);
+        break;
+      case 'S': /* fallthru */
+      case 'N': /* fallthru */
+      case 'Q':
+        property(prop.name.c_str(), prop.value.c_str());
+        break;
+    }
+  }
+
+  end();
+}
+
 }  // namespace odb
@@ -34,6 +34,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "definBase.h"
 #include "odb/dbWireCodec.h"
@@ -44,11 +45,76 @@ namespace odb {
 class dbWire;
 class dbSWire;
 class dbNet;
+class dbITerm;
 class dbVia;
 class dbTechLayer;
 class dbTechLayerRule;
 class dbTechNonDefaultRule;
 
+// A NETS routing statement copied out of the DEF parser.
+struct definNetPathOp
+{
+  enum Type
+  {
+    WIRE,
+    LAYER,
+    TAPER,
+    TAPER_RULE,
+    VIA,
+    ROTATED_VIA,
+    POINT,
+    FLUSH_POINT,
+    RECT,
+    COLOR,
+    VIA_COLOR,
+    PATH_END,
+    WIRE_END
+  };
+
+  Type type;
+  std::string name;  // wire type, layer or via name
+  std::string rule;  // taper rule
+  int values[4];
+};
+
+struct definNetConnection
+{
+  std::string inst;
+  std::string pin;
+  bool must_join;
+  dbITerm* iterm;  // resolved by definNet::resolveConnections
+};
+
+struct definNetProperty
+{
+  std::string name;
+  char type;  // Si2 property type
+  std::string value;
+  double number;
+};
+
+// A net staged by the parser so it can be committed to the block later,
+// possibly on another thread than the one running the parser.
+struct definNetRecord
+{
+  std::string name;
+  std::string use;
+  std::string source;
+  std::string non_default_rule;
+  bool has_use = false;
+  bool has_source = false;
+  bool has_fixed_bump = false;
+  bool has_weight = false;
+  bool has_non_default_rule = false;
+  int weight = 0;
+  std::vector<definNetConnection> connections;
+  std::vector<definNetPathOp> routing;
+  std::vector<definNetProperty> properties;
+  // Unsupported constructs found when the net was parsed; they are reported
+  // in this order when the net is committed.
+  std::vector<const char*> unsupported;
+};
+
 class definNet : public definBase
 {
   bool _skip_signal_connections;
@@ -85,6 +151,7 @@ class definNet : public definBase
   void begin(const char* name);
   void beginMustjoin(const char* iname, const char* pname);
   void connection(const char* iname, const char* pname);
+  void connection(dbITerm* iterm);
   void nonDefaultRule(const char* rule);
   void use(dbSigType type);
   void wire(dbWireType type);
@@ -110,6 +177,12 @@ class definNet : public definBase
   void end();
 
   void pathBegin(const char* layer);
+
+  // Look up the instance terminals of staged connections.  Only reads the
+  // block so it may run in parallel.
+  void resolveConnections(std::vector<definNetRecord>& nets, int threads);
+  // Replay a staged net through the interface methods above.
+  void commit(const definNetRecord& net);
   // void netBeginCreate( const char * name );
   // void netBeginReplace( const char * name );
 
@@ -35,7 +35,12 @@
 #include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
+#include <algorithm>
 #include <string>
 
 #include "definBlockage.h"
@@ -82,6 +87,18 @@ definReader::definReader(dbDatabase* db, utl::Logger* logger, defin::MODE mode)
   hier_delimeter_ = 0;
   left_bus_delimeter_ = 0;
   right_bus_delimeter_ = 0;
+  _num_threads = 1;
+  _def_data = nullptr;
+  _def_size = 0;
+  _def_file = nullptr;
+  _nets_body_begin = 0;
+  _nets_body_end = 0;
+  _nets_body_lines = 0;
+  _read_pos = 0;
+  _read_newlines = 0;
+  _next_net_chunk = 0;
+  _committed_net_chunks = 0;
+  _stop_net_workers = false;
 
   definBase::setLogger(logger);
   definBase::setMode(mode);
@@ -124,6 +141,8 @@ definReader::definReader(dbDatabase* db, utl::Logger* logger, defin::MODE mode)
 
 definReader::~definReader()
 {
+  stopNetWorkers(false);
+  unmapDef();
   delete _blockageR;
   delete _componentR;
   delete _componentMaskShift;
@@ -714,85 +733,175 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
 {
   definReader* reader = (definReader*) data;
   CHECKBLOCK
-  definNet* netR = reader->_netR;
-  if (reader->_mode == defin::FLOORPLAN
-      && reader->_block->findNet(net->name()) == nullptr) {
-    reader->_logger->warn(
-        utl::ODB,
-        275,
-        "skipping undefined net {} encountered in FLOORPLAN DEF",
-        net->name());
+  if (reader->skipFloorplanNet(net->name())) {
     return PARSE_OK;
   }
+
+  definNetRecord netR;
+  copyNet(net, netR);
+  if (!reader->commitNet(netR)) {
+    return PARSE_ERROR;
+  }
+
+  return PARSE_OK;
+}
+
+int definReader::netChunkCallback(defrCallbackType_e /* unused: type */,
+                                  defiNet* net,
+                                  defiUserData data)
+{
+  auto chunk = (NetChunk*) data;
+  chunk->nets.emplace_back();
+  copyNet(net, chunk->nets.back());
+  return PARSE_OK;
+}
+
+void definReader::netChunkErrorLog(defiUserData data, const char* msg)
+{
+  auto chunk = (NetChunk*) data;
+  chunk->messages.emplace_back(true,
+                               fileLineMessage(msg, chunk->line_offset));
+}
+
+void definReader::netChunkWarningLog(defiUserData data, const char* msg)
+{
+  auto chunk = (NetChunk*) data;
+  chunk->messages.emplace_back(false,
+                               fileLineMessage(msg, chunk->line_offset));
+}
+
+// The parser's messages end in "at line <n>" with the line in the chunk's
+// text; replace it by the line in the file.
+std::string definReader::fileLineMessage(const char* msg,
+                                         long long line_offset)
+{
+  std::string text = msg;
+  const char* tag = "at line ";
+  const size_t pos = text.find(tag);
+  if (pos == std::string::npos) {
+    return text;
+  }
+  const size_t begin = pos + strlen(tag);
+  size_t end = begin;
+  while (end < text.size() && isdigit(text[end])) {
+    end++;
+  }
+  if (end == begin) {
+    return text;
+  }
+  const long long line = std::stoll(text.substr(begin, end - begin));
+  text.replace(begin, end - begin, std::to_string(line + line_offset));
+  return text;
+}
+
+// Errors go to stderr as from the main parser; warnings to its log file.
+void definReader::reportNetChunkMessages(const NetChunk& chunk)
+{
+  FILE* warning_log = nullptr;
+  for (const auto& [is_error, text] : chunk.messages) {
+    if (is_error) {
+      fprintf(stderr, "%s", text.c_str());
+      continue;
+    }
+    if (warning_log == nullptr) {
+      warning_log = fopen("defRWarning.log", "a");
+      if (warning_log == nullptr) {
+        continue;
+      }
+    }
+    fprintf(warning_log, "%s", text.c_str());
+  }
+  if (warning_log != nullptr) {
+    fclose(warning_log);
+  }
+}
+
+// Copy a net out of the parser; it is committed by definNet::commit.  This
+// does not touch the reader so it can run on the NETS worker threads.
+void definReader::copyNet(defiNet* net, definNetRecord& netR)
+{
   if (net->numShieldNets() > 0) {
-    UNSUPPORTED("SHIELDNET on net is unsupported");
+    netR.unsupported.push_back("SHIELDNET on net is unsupported");
   }
 
   if (net->numVpins() > 0) {
-    UNSUPPORTED("VPIN on net is unsupported");
+    netR.unsupported.push_back("VPIN on net is unsupported");
   }
 
   if (net->hasSubnets()) {
-    UNSUPPORTED("SUBNET on net is unsupported");
+    netR.unsupported.push_back("SUBNET on net is unsupported");
   }
 
   if (net->hasXTalk()) {
-    UNSUPPORTED("XTALK on net is unsupported");
+    netR.unsupported.push_back("XTALK on net is unsupported");
   }
 
   if (net->hasFrequency()) {
-    UNSUPPORTED("FREQUENCY on net is unsupported");
+    netR.unsupported.push_back("FREQUENCY on net is unsupported");
   }
 
   if (net->hasOriginal()) {
-    UNSUPPORTED("ORIGINAL on net is unsupported");
+    netR.unsupported.push_back("ORIGINAL on net is unsupported");
   }
 
   if (net->hasPattern()) {
-    UNSUPPORTED("PATTERN on net is unsupported");
+    netR.unsupported.push_back("PATTERN on net is unsupported");
   }
 
   if (net->hasCap()) {
-    UNSUPPORTED("ESTCAP on net is unsupported");
+    netR.unsupported.push_back("ESTCAP on net is unsupported");
   }
 
-  netR->begin(net->name());
+  netR.name = net->name();
 
   if (net->hasUse()) {
-    netR->use(net->use());
+    netR.has_use = true;
+    netR.use = net->use();
   }
 
   if (net->hasSource()) {
-    netR->source(net->source());
+    netR.has_source = true;
+    netR.source = net->source();
   }
 
   if (net->hasFixedbump()) {
-    netR->fixedbump();
+    netR.has_fixed_bump = true;
   }
 
   if (net->hasWeight()) {
-    netR->weight(net->weight());
+    netR.has_weight = true;
+    netR.weight = net->weight();
   }
 
   if (net->hasNonDefaultRule()) {
-    netR->nonDefaultRule(net->nonDefaultRule());
+    netR.has_non_default_rule = true;
+    netR.non_default_rule = net->nonDefaultRule();
   }
 
+  netR.connections.reserve(net->numConnections());
   for (int i = 0; i < net->numConnections(); ++i) {
     if (net->pinIsSynthesized(i)) {
-      UNSUPPORTED("SYNTHESIZED on net's connection is unsupported");
+      netR.unsupported.push_back(
+          "SYNTHESIZED on net's connection is unsupported");
     }
 
-    if (net->pinIsMustJoin(i)) {
-      netR->beginMustjoin(net->instance(i), net->pin(i));
-    } else {
-      netR->connection(net->instance(i), net->pin(i));
-    }
+    netR.connections.push_back(
+        {net->instance(i), net->pin(i), bool(net->pinIsMustJoin(i)), nullptr});
   }
 
+  auto addOp = [&netR](definNetPathOp::Type type,
+                       const char* name = "",
+                       int v0 = 0,
+                       int v1 = 0,
+                       int v2 = 0,
+                       int v3 = 0) -> definNetPathOp& {
+    netR.routing.push_back({type, name, "", {v0, v1, v2, v3}});
+    return netR.routing.back();
+  };
+
   for (int i = 0; i < net->numWires(); ++i) {
     defiWire* wire = net->wire(i);
-    netR->wire(wire->wireType());
+    addOp(definNetPathOp::WIRE, wire->wireType());
 
     for (int j = 0; j < wire->numPaths(); ++j) {
       defiPath* path = wire->path(j);
@@ -807,11 +916,12 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
             const char* layer = path->getLayer();
             int nextId = path->next();
             if (nextId == DEFIPATH_TAPER) {
-              netR->pathTaper(layer);
+              addOp(definNetPathOp::TAPER, layer);
             } else if (nextId == DEFIPATH_TAPERRULE) {
-              netR->pathTaperRule(layer, path->getTaperRule());
+              addOp(definNetPathOp::TAPER_RULE, layer).rule
+                  = path->getTaperRule();
             } else {
-              netR->path(layer);
+              addOp(definNetPathOp::LAYER, layer);
               path->prev();  // put back the token
             }
             break;
@@ -822,10 +932,11 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
             const char* viaName = path->getVia();
             int nextId = path->next();
             if (nextId == DEFIPATH_VIAROTATION) {
-              netR->pathVia(viaName,
-                            translate_orientation(path->getViaRotation()));
+              addOp(definNetPathOp::ROTATED_VIA,
+                    viaName,
+                    translate_orientation(path->getViaRotation()).getValue());
             } else {
-              netR->pathVia(viaName);
+              addOp(definNetPathOp::VIA, viaName);
               path->prev();  // put back the token
             }
             break;
@@ -835,7 +946,7 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
             int x;
             int y;
             path->getPoint(&x, &y);
-            netR->pathPoint(x, y);
+            addOp(definNetPathOp::POINT, "", x, y);
             break;
           }
 
@@ -844,12 +955,12 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
             int y;
             int ext;
             path->getFlushPoint(&x, &y, &ext);
-            netR->pathPoint(x, y, ext);
+            addOp(definNetPathOp::FLUSH_POINT, "", x, y, ext);
             break;
           }
 
           case DEFIPATH_STYLE:
-            UNSUPPORTED("styles are not supported on wires");
+            netR.unsupported.push_back("styles are not supported on wires");
             break;
 
           case DEFIPATH_RECT: {
@@ -858,42 +969,537 @@ int definReader::netCallback(defrCallbackType_e /* unused: type */,
             int deltaX2;
             int deltaY2;
             path->getViaRect(&deltaX1, &deltaY1, &deltaX2, &deltaY2);
-            netR->pathRect(deltaX1, deltaY1, deltaX2, deltaY2);
+            addOp(definNetPathOp::RECT, "", deltaX1, deltaY1, deltaX2, deltaY2);
             break;
           }
 
           case DEFIPATH_VIRTUALPOINT:
-            UNSUPPORTED("VIRTUAL in net's routing is unsupported");
+            netR.unsupported.push_back(
+                "VIRTUAL in net's routing is unsupported");
             break;
 
           case DEFIPATH_MASK:
-            netR->pathColor(path->getMask());
+            addOp(definNetPathOp::COLOR, "", path->getMask());
             break;
 
           case DEFIPATH_VIAMASK:
-            netR->pathViaColor(path->getViaBottomMask(),
-                               path->getViaCutMask(),
-                               path->getViaTopMask());
+            addOp(definNetPathOp::VIA_COLOR,
+                  "",
+                  path->getViaBottomMask(),
+                  path->getViaCutMask(),
+                  path->getViaTopMask());
             break;
 
           default:
-            UNSUPPORTED("Unknown construct in net's routing is unsupported");
+            netR.unsupported.push_back(
+                "Unknown construct in net's routing is unsupported");
             break;
         }
       }
-      netR->pathEnd();
+      addOp(definNetPathOp::PATH_END);
     }
 
-    netR->wireEnd();
+    addOp(definNetPathOp::WIRE_END);
   }
 
-  handle_props(net, netR);
+  for (int i = 0; i < net->numProps(); ++i) {
+    netR.properties.push_back({net->propName(i),
+                               net->propType(i),
+                               net->propValue(i),
+                               net->propNumber(i)});
+  }
+}
 
-  netR->end();
+bool definReader::skipFloorplanNet(const char* name)
+{
+  if (_mode != defin::FLOORPLAN || _block->findNet(name) != nullptr) {
+    return false;
+  }
+  _logger->warn(utl::ODB,
+                275,
+                "skipping undefined net {} encountered in FLOORPLAN DEF",
+                name);
+  return true;
+}
 
+bool definReader::commitNet(const definNetRecord& net)
+{
+  for (const char* msg : net.unsupported) {
+    error(msg);
+    if (!_continue_on_errors) {
+      return false;
+    }
+  }
+  _netR->commit(net);
+  return true;
+}
+
+int definReader::netsEndCallback(defrCallbackType_e /* unused: type */,
+                                 void* /* unused: v */,
+                                 defiUserData data)
+{
+  definReader* reader = (definReader*) data;
+  if (reader->_net_chunks.empty()) {
+    return PARSE_OK;
+  }
+  if (!reader->commitNetChunks()) {
+    return PARSE_ERROR;
+  }
   return PARSE_OK;
 }
 
+namespace {
+
+// Splits a DEF file into tokens by the Si2 lexer's rules for blanks, quoted
+// strings and comments.  It is only used to find statement boundaries.
+class DefTokenizer
+{
+ public:
+  DefTokenizer(const char* data, size_t size) : data_(data), size_(size) {}
+
+  // Advance to the next token.  Returns false at the end of the data or at
+  // an &alias, which only the real parser can expand.
+  bool next();
+  // Skip raw text up to and including the next occurrence of text.
+  bool skipPast(const char* text);
+  bool is(const char* keyword) const;
+  bool isNumber() const;
+  size_t begin() const { return begin_; }
+  size_t end() const { return end_; }
+
+ private:
+  static bool isBlank(char c)
+  {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+  }
+
+  const char* data_;
+  size_t size_;
+  size_t pos_ = 0;
+  size_t begin_ = 0;
+  size_t end_ = 0;
+};
+
+bool DefTokenizer::next()
+{
+  while (pos_ < size_) {
+    while (pos_ < size_ && isBlank(data_[pos_])) {
+      pos_++;
+    }
+    if (pos_ >= size_) {
+      return false;
+    }
+    begin_ = pos_;
+    if (data_[pos_] == '"') {
+      for (pos_++; pos_ < size_ && data_[pos_] != '"'; pos_++) {
+        if (data_[pos_] == '\\') {
+          pos_++;
+        }
+      }
+      pos_ = std::min(pos_ + 1, size_);
+      end_ = pos_;
+      return true;
+    }
+    while (pos_ < size_ && !isBlank(data_[pos_])) {
+      pos_++;
+    }
+    end_ = pos_;
+    if (data_[begin_] == '#') {
+      // A comment runs to the end of the line.
+      const void* eol = memchr(data_ + begin_, '\n', size_ - begin_);
+      pos_ = eol ? static_cast<const char*>(eol) - data_ + 1 : size_;
+      continue;
+    }
+    return data_[begin_] != '&';
+  }
+  return false;
+}
+
+bool DefTokenizer::skipPast(const char* text)
+{
+  const size_t length = strlen(text);
+  const void* found = memmem(data_ + pos_, size_ - pos_, text, length);
+  if (found == nullptr) {
+    return false;
+  }
+  pos_ = static_cast<const char*>(found) - data_ + length;
+  begin_ = end_ = pos_;
+  return true;
+}
+
+bool DefTokenizer::is(const char* keyword) const
+{
+  const size_t length = end_ - begin_;
+  return strlen(keyword) == length
+         && strncasecmp(data_ + begin_, keyword, length) == 0;
+}
+
+bool DefTokenizer::isNumber() const
+{
+  return std::all_of(
+      data_ + begin_, data_ + end_, [](char c) { return isdigit(c); });
+}
+
+// Where the NETS section of a DEF file is and where it can be cut.
+struct DefNetsLayout
+{
+  std::string header;        // VERSION, DIVIDERCHAR, ... statements
+  size_t body_begin = 0;     // just after "NETS n ;"
+  size_t body_end = 0;       // at the END of "END NETS"
+  std::vector<size_t> cuts;  // chunk starts, each at a net's "-"
+};
+
+// Returns false if the file has no NETS section or anything the tokenizer
+// can not be sure about, in which case the file is read serially.
+bool scanDefNets(const char* data,
+                 size_t size,
+                 size_t chunk_bytes,
+                 DefNetsLayout& layout)
+{
+  DefTokenizer token(data, size);
+  bool statement_start = true;
+  bool found_nets = false;
+  while (!found_nets && token.next()) {
+    if (!statement_start) {
+      statement_start = token.is(";");
+      continue;
+    }
+    if (token.is("VERSION") || token.is("NAMESCASESENSITIVE")
+        || token.is("DIVIDERCHAR") || token.is("BUSBITCHARS")) {
+      const size_t begin = token.begin();
+      while (token.next() && !token.is(";")) {
+      }
+      if (!token.is(";")) {
+        return false;
+      }
+      layout.header.append(data + begin, token.end() - begin);
+      layout.header += '\n';
+    } else if (token.is("HISTORY")) {
+      // History text is raw up to the ';'.
+      if (!token.skipPast(";")) {
+        return false;
+      }
+    } else if (token.is("BEGINEXT")) {
+      if (!token.skipPast("ENDEXT")) {
+        return false;
+      }
+    } else if (token.is("END")) {
+      // The section name follows; the next statement starts after it.
+      if (!token.next()) {
+        return false;
+      }
+    } else if (token.is("NETS")) {
+      if (!token.next() || !token.isNumber() || !token.next()
+          || !token.is(";")) {
+        return false;
+      }
+      found_nets = true;
+    } else if (!token.is(";")) {
+      statement_start = false;
+    }
+  }
+  if (!found_nets) {
+    return false;
+  }
+
+  layout.body_begin = token.end();
+  layout.cuts.push_back(layout.body_begin);
+  statement_start = true;
+  while (token.next()) {
+    if (statement_start) {
+      if (token.is("END")) {
+        layout.body_end = token.begin();
+        return token.next() && token.is("NETS");
+      }
+      if (token.is("-") && token.begin() - layout.cuts.back() >= chunk_bytes) {
+        layout.cuts.push_back(token.begin());
+      }
+    }
+    statement_start = token.is(";");
+  }
+  return false;
+}
+
+// NETS sections are cut into chunks of about this size.
+const size_t net_chunk_bytes = 64 << 10;
+
+// The reader whose file the main parser is reading with the NETS body
+// elided.
+thread_local definReader* eliding_reader = nullptr;
+
+}  // namespace
+
+int definReader::readDef(FILE* file, const char* file_name)
+{
+  _def_file = file_name;
+  if (_num_threads <= 1 || !startNetWorkers(file)) {
+    return defrRead(
+        file, file_name, (defiUserData) this, /* case sensitive */ 1);
+  }
+
+  eliding_reader = this;
+  defrSetReadFunction(readElidingNetsFunction);
+  int res;
+  try {
+    res = defrRead(
+        file, file_name, (defiUserData) this, /* case sensitive */ 1);
+  } catch (...) {
+    defrUnsetReadFunction();
+    eliding_reader = nullptr;
+    stopNetWorkers(false);
+    unmapDef();
+    throw;
+  }
+  defrUnsetReadFunction();
+  eliding_reader = nullptr;
+  // If the parser stopped before END NETS the parsed nets are dropped, as
+  // the serial parser would never have reached them.
+  try {
+    stopNetWorkers(true);
+  } catch (...) {
+    unmapDef();
+    throw;
+  }
+  unmapDef();
+  return res;
+}
+
+void definReader::unmapDef()
+{
+  if (_def_data != nullptr) {
+    munmap((void*) _def_data, _def_size);
+    _def_data = nullptr;
+    _def_size = 0;
+  }
+}
+
+bool definReader::startNetWorkers(FILE* file)
+{
+  struct stat file_stat;
+  const int fd = fileno(file);
+  if (fd < 0 || fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+    return false;
+  }
+  const size_t size = file_stat.st_size;
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (data == MAP_FAILED) {
+    return false;
+  }
+
+  DefNetsLayout layout;
+  if (!scanDefNets((const char*) data, size, net_chunk_bytes, layout)
+      || layout.cuts.size() < 2) {
+    munmap(data, size);
+    return false;
+  }
+
+  _def_data = (const char*) data;
+  _def_size = size;
+  _def_header = std::move(layout.header);
+  _nets_body_begin = layout.body_begin;
+  _nets_body_end = layout.body_end;
+  const size_t body_lines = std::count(
+      _def_data + _nets_body_begin, _def_data + _nets_body_end, '\n');
+  _nets_body_lines = std::max<size_t>(body_lines, 1);
+  _read_pos = 0;
+  _read_newlines = 0;
+
+  // The chunk parser reads the header and two more lines before the chunk.
+  const long long header_lines
+      = std::count(_def_header.begin(), _def_header.end(), '\n') + 2;
+  size_t line = 1 + std::count(_def_data, _def_data + layout.cuts[0], '\n');
+  _net_chunks.resize(layout.cuts.size());
+  for (size_t i = 0; i < layout.cuts.size(); i++) {
+    NetChunk& chunk = _net_chunks[i];
+    chunk.begin = layout.cuts[i];
+    chunk.end = i + 1 < layout.cuts.size() ? layout.cuts[i + 1]
+                                           : _nets_body_end;
+    chunk.line_offset = (long long) line - 1 - header_lines;
+    line += std::count(_def_data + chunk.begin, _def_data + chunk.end, '\n');
+  }
+  _next_net_chunk = 0;
+  _committed_net_chunks = 0;
+  _stop_net_workers = false;
+  _net_worker_exception = nullptr;
+
+  // The main thread keeps parsing the rest of the file.
+  const int workers = std::max(_num_threads - 1, 1);
+  for (int i = 0; i < workers; i++) {
+    _net_workers.emplace_back(&definReader::netWorker, this);
+  }
+  return true;
+}
+
+void definReader::netWorker()
+{
+  // Only a few chunks are parsed ahead of the commit to bound memory.
+  const size_t window = 2 * _num_threads;
+  for (;;) {
+    NetChunk* chunk;
+    {
+      std::unique_lock<std::mutex> lock(_net_chunks_lock);
+      _net_chunks_cond.wait(lock, [this, window] {
+        return _stop_net_workers || _next_net_chunk >= _net_chunks.size()
+               || _next_net_chunk < _committed_net_chunks + window;
+      });
+      if (_stop_net_workers || _next_net_chunk >= _net_chunks.size()) {
+        return;
+      }
+      chunk = &_net_chunks[_next_net_chunk++];
+    }
+
+    try {
+      parseNetChunk(*chunk);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(_net_chunks_lock);
+      if (!_net_worker_exception) {
+        _net_worker_exception = std::current_exception();
+      }
+      chunk->failed = true;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(_net_chunks_lock);
+      chunk->parsed = true;
+    }
+    _net_chunks_cond.notify_all();
+  }
+}
+
+// Parse one chunk of nets with this thread's own parser context.  The chunk
+// is wrapped in the file's header statements so names are read the same
+// way as by the main parser.
+void definReader::parseNetChunk(NetChunk& chunk)
+{
+  std::string text = _def_header;
+  text += "DESIGN nets ;\nNETS 0 ;\n";
+  text.append(_def_data + chunk.begin, chunk.end - chunk.begin);
+  text += "\nEND NETS\nEND DESIGN\n";
+
+  FILE* file = fmemopen(text.data(), text.size(), "r");
+  if (file == nullptr) {
+    chunk.failed = true;
+    return;
+  }
+
+  defrInit();
+  defrReset();
+  defrInitSession();
+  defrSetNetCbk(netChunkCallback);
+  defrSetAddPathToNet();
+  defrSetContextLogFunction(netChunkErrorLog);
+  defrSetContextWarningLogFunction(netChunkWarningLog);
+  const int res
+      = defrRead(file, _def_file, (defiUserData) &chunk, /* case */ 1);
+  defrClear();
+  fclose(file);
+
+  chunk.failed = res != 0;
+}
+
+// Commit the parsed chunks in file order.  Called on the main thread when
+// its parser reaches END NETS.
+bool definReader::commitNetChunks()
+{
+  if (_block == nullptr) {
+    _logger->warn(utl::ODB, 260, "DESIGN is not defined in DEF");
+    stopNetWorkers(true);
+    return false;
+  }
+
+  bool ok = true;
+  for (NetChunk& chunk : _net_chunks) {
+    {
+      std::unique_lock<std::mutex> lock(_net_chunks_lock);
+      _net_chunks_cond.wait(lock, [&chunk] { return chunk.parsed; });
+    }
+    reportNetChunkMessages(chunk);
+    if (chunk.failed) {
+      ok = false;
+      break;
+    }
+
+    _netR->resolveConnections(chunk.nets, _num_threads);
+    for (const definNetRecord& net : chunk.nets) {
+      if (skipFloorplanNet(net.name.c_str())) {
+        continue;
+      }
+      if (!commitNet(net)) {
+        ok = false;
+        break;
+      }
+    }
+    if (!ok) {
+      break;
+    }
+
+    std::vector<definNetRecord>().swap(chunk.nets);
+    {
+      std::lock_guard<std::mutex> lock(_net_chunks_lock);
+      _committed_net_chunks++;
+    }
+    _net_chunks_cond.notify_all();
+  }
+
+  stopNetWorkers(true);
+  return ok;
+}
+
+// Join the workers.  A worker's exception is
+// rethrown here on the main thread if rethrow is set.
+void definReader::stopNetWorkers(bool rethrow)
+{
+  {
+    std::lock_guard<std::mutex> lock(_net_chunks_lock);
+    _stop_net_workers = true;
+  }
+  _net_chunks_cond.notify_all();
+  for (std::thread& worker : _net_workers) {
+    worker.join();
+  }
+  _net_workers.clear();
+  _net_chunks.clear();
+
+  std::exception_ptr exception = _net_worker_exception;
+  _net_worker_exception = nullptr;
+  if (rethrow && exception) {
+    std::rethrow_exception(exception);
+  }
+}
+
+// Serve the main parser the file with the NETS body replaced by the same
+// number of newlines, so its line numbers still match the file.
+size_t definReader::readElidingNets(char* buffer, size_t size)
+{
+  size_t count = 0;
+  while (count < size) {
+    if (_read_pos < _nets_body_begin || _read_pos >= _nets_body_end) {
+      const size_t limit
+          = _read_pos < _nets_body_begin ? _nets_body_begin : _def_size;
+      const size_t n = std::min(size - count, limit - _read_pos);
+      if (n == 0) {
+        break;
+      }
+      memcpy(buffer + count, _def_data + _read_pos, n);
+      count += n;
+      _read_pos += n;
+    } else if (_read_newlines < _nets_body_lines) {
+      buffer[count++] = '\n';
+      _read_newlines++;
+    } else {
+      _read_pos = _nets_body_end;
+    }
+  }
+  return count;
+}
+
+size_t definReader::readElidingNetsFunction(FILE* /* unused: file */,
+                                            char* buffer,
+                                            size_t size)
+{
+  return eliding_reader->readElidingNets(buffer, size);
+}
+
 int definReader::nonDefaultRuleCallback(defrCallbackType_e /* unused: type */,
                                         defiNonDefault* rule,
                                         defiUserData data)
@@ -1874,6 +2480,7 @@ bool definReader::createBlock(const char* file)
     defrSetTrackCbk(trackCallback);
     defrSetRowCbk(rowCallback);
     defrSetNetCbk(netCallback);
+    defrSetNetEndCbk(netsEndCallback);
     defrSetSNetCbk(specialNetCallback);
     defrSetViaCbk(viaCallback);
     defrSetBlockageCbk(blockageCallback);
@@ -1914,7 +2521,7 @@ bool definReader::createBlock(const char* file)
       _logger->warn(utl::ODB, 148, "error: Cannot open DEF file {}", file);
       return false;
     }
-    res = defrRead(f, file, (defiUserData) this, /* case sensitive */ 1);
+    res = readDef(f, file);
     fclose(f);
   } else {
     defrSetGZipReadFunction();
@@ -1927,7 +2534,6 @@ bool definReader::createBlock(const char* file)
     res = defrReadGZip(f, file, (defiUserData) this);
     defGZipClose(f);
   }
-
   if (res != 0 || errors() != 0) {
     if (!_continue_on_errors) {
       _logger->error(utl::ODB, 421, "DEF parser returns an error!");
@@ -1959,11 +2565,13 @@ bool definReader::replaceWires(const char* file)
   defrInitSession();
 
   defrSetNetCbk(netCallback);
+  defrSetNetEndCbk(netsEndCallback);
   defrSetSNetCbk(specialNetCallback);
 
   defrSetAddPathToNet();
 
-  int res = defrRead(f, file, (defiUserData) this, /* case sensitive */ 1);
+  int res = readDef(f, file);
+
   if (res != 0) {
     if (!_continue_on_errors) {
       _logger->error(utl::ODB, 422, "DEF parser returns an error!");
@@ -32,7 +32,16 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include "definBase.h"
+#include "definNet.h"
 #include "defrReader.hpp"
 #include "odb/odb.h"
 
@@ -88,6 +97,55 @@ class definReader : public definBase
   char left_bus_delimeter_;
   char right_bus_delimeter_;
 
+  // Parallel NETS: the NETS section of an uncompressed DEF is cut into
+  // chunks at net boundaries.  Worker threads tokenize the chunks, each with
+  // its own parser context, while the main parser reads the rest of the file
+  // with the NETS body elided.  When the main parser reaches END NETS the
+  // nets are committed in file order.
+  struct NetChunk
+  {
+    size_t begin = 0;
+    size_t end = 0;
+    std::vector<definNetRecord> nets;
+    // Added to a line number of the chunk's parser to get the file's.
+    long long line_offset = 0;
+    // Parser messages with file line numbers, reported at the commit so
+    // they come out in file order.
+    std::vector<std::pair<bool, std::string>> messages;  // is error, text
+    bool parsed = false;
+    bool failed = false;
+  };
+  int _num_threads;
+  const char* _def_data;  // mapped DEF file
+  size_t _def_size;
+  const char* _def_file;
+  std::string _def_header;  // VERSION, DIVIDERCHAR, ... statements
+  size_t _nets_body_begin;
+  size_t _nets_body_end;
+  size_t _nets_body_lines;
+  size_t _read_pos;
+  size_t _read_newlines;
+  std::vector<NetChunk> _net_chunks;
+  size_t _next_net_chunk;
+  size_t _committed_net_chunks;
+  bool _stop_net_workers;
+  std::mutex _net_chunks_lock;
+  std::condition_variable _net_chunks_cond;
+  std::vector<std::thread> _net_workers;
+  std::exception_ptr _net_worker_exception;
+
+  int readDef(FILE* file, const char* file_name);
+  bool startNetWorkers(FILE* file);
+  void netWorker();
+  void parseNetChunk(NetChunk& chunk);
+  bool commitNetChunks();
+  void stopNetWorkers(bool rethrow);
+  void unmapDef();
+  size_t readElidingNets(char* buffer, size_t size);
+  bool skipFloorplanNet(const char* name);
+  bool commitNet(const definNetRecord& net);
+  static void copyNet(defiNet* net, definNetRecord& record);
+
   void init();
   void setLibs(std::vector<dbLib*>& lib_names);
 
@@ -156,6 +214,20 @@ class definReader : public definBase
                          defiNet* net,
                          defiUserData data);
 
+  static int netsEndCallback(defrCallbackType_e type,
+                             void* v,
+                             defiUserData data);
+
+  static int netChunkCallback(defrCallbackType_e type,
+                              defiNet* net,
+                              defiUserData data);
+  static void netChunkErrorLog(defiUserData data, const char* msg);
+  static void netChunkWarningLog(defiUserData data, const char* msg);
+  static std::string fileLineMessage(const char* msg, long long line_offset);
+  void reportNetChunkMessages(const NetChunk& chunk);
+
+  static size_t readElidingNetsFunction(FILE* file, char* buffer, size_t size);
+
   static int nonDefaultRuleCallback(defrCallbackType_e type,
                                     defiNonDefault* rule,
                                     defiUserData data);
@@ -258,6 +330,7 @@ class definReader : public definBase
   void useBlockName(const char* name);
   void namesAreDBIDs();
   void setAssemblyMode();
+  void setThreadCount(int threads) { _num_threads = threads; }
 
   dbChip* createChip(std::vector<dbLib*>& search_libs,
                      const char* def_file,
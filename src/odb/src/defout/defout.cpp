@@ -75,6 +75,16 @@ void defout::setVersion(Version v)
   _writer->setVersion(v);
 }
 
+void defout::setThreadCount(int threads)
+{
+  _writer->setThreadCount(threads);
+}
+
+void defout::setChunkSize(int size)
+{
+  _writer->setChunkSize(size);
+}
+
 bool defout::writeBlock(dbBlock* block, const char* def_file)
 {
   return _writer->writeBlock(block, def_file);
@@ -34,8 +34,12 @@
 
 #include <stdio.h>
 #include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
 #include <limits>
 #include <optional>
 #include <set>
@@ -91,6 +95,12 @@ static const char* defOrient(dbOrientType orient)
   return "N";
 }
 
+static bool hasSuffix(const std::string& str, const std::string& suffix)
+{
+  return str.size() >= suffix.size()
+         && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
 static const char* defSigType(dbSigType type)
 {
   return type.getString();
@@ -162,6 +172,20 @@ bool defout_impl::writeBlock(dbBlock* block, const char* def_file)
     return false;
   }
 
+  if (hasSuffix(def_file, ".gz")) {
+    // Compress through a stream over the file handler's descriptor so it
+    // still owns (and renames) the underlying file.
+    _out = openZipped(fileno(_out));
+    if (_out == nullptr) {
+      _logger->warn(utl::ODB,
+                    441,
+                    "Cannot open zipped DEF file ({}) for writing",
+                    def_file);
+      return false;
+    }
+    _zipped = true;
+  }
+
   // By default C File*'s are line buffered which means they get dumped on every
   // newline, which is nominally pretty expensive. This makes it so that the
   // writes are buffered according to the block size which on modern systems can
@@ -170,7 +194,7 @@ bool defout_impl::writeBlock(dbBlock* block, const char* def_file)
   //
   // The following lines enable IO buffering based on disk block size.
   struct stat stats;
-  fstat(fileno(_out), &stats);
+  fstat(fileno(fileHandler.getFile()), &stats);
   setvbuf(_out, nullptr, _IOFBF, stats.st_blksize);
 
   if (_version == defout::DEF_5_3) {
@@ -243,6 +267,11 @@ bool defout_impl::writeBlock(dbBlock* block, const char* def_file)
   writeGroups(block);
 
   fprintf(_out, "END DESIGN\n");
+  if (_zipped) {
+    fclose(_out);
+    _out = nullptr;
+    _zipped = false;
+  }
   {
     delete _select_net_map;
   }
@@ -252,6 +281,83 @@ bool defout_impl::writeBlock(dbBlock* block, const char* def_file)
   return true;
 }
 
+// The cookie stream functions for writing a gzip file through a FILE*, so
+// the printf formatting is shared with plain DEF files.
+static ssize_t gzCookieWrite(void* cookie, const char* data, size_t size)
+{
+  if (size == 0) {
+    return 0;
+  }
+  const int written = gzwrite((gzFile) cookie, data, size);
+  return written > 0 ? written : -1;
+}
+
+static int gzCookieClose(void* cookie)
+{
+  return gzclose((gzFile) cookie) == Z_OK ? 0 : EOF;
+}
+
+FILE* defout_impl::openZipped(int fd)
+{
+  const int gz_fd = dup(fd);
+  if (gz_fd < 0) {
+    return nullptr;
+  }
+  gzFile gz_out = gzdopen(gz_fd, "wb");
+  if (gz_out == nullptr) {
+    close(gz_fd);
+    return nullptr;
+  }
+  cookie_io_functions_t functions = {nullptr, gzCookieWrite, nullptr,
+                                     gzCookieClose};
+  FILE* out = fopencookie(gz_out, "w", functions);
+  if (out == nullptr) {
+    gzclose(gz_out);
+  }
+  return out;
+}
+
+// Format objects in parallel into one memory buffer per chunk and write the
+// buffers in order so the output matches the serial writer.  Chunks are
+// processed in batches to bound the memory held at once.
+template <typename T>
+void defout_impl::writeChunked(const std::vector<T*>& objects,
+                               void (defout_impl::*write)(T*))
+{
+  const int object_count = objects.size();
+  if (_num_threads <= 1 || object_count <= _chunk_size) {
+    for (T* object : objects) {
+      (this->*write)(object);
+    }
+    return;
+  }
+
+  const int chunk_count = (object_count + _chunk_size - 1) / _chunk_size;
+  const int batch_size = _num_threads * 4;
+  std::vector<char*> buffers(batch_size);
+  std::vector<size_t> sizes(batch_size);
+  for (int batch = 0; batch < chunk_count; batch += batch_size) {
+    const int batch_end = std::min(batch + batch_size, chunk_count);
+#pragma omp parallel for num_threads(_num_threads) schedule(dynamic, 1)
+    for (int chunk = batch; chunk < batch_end; chunk++) {
+      // Each chunk gets its own writer since writeNet/writeSNet keep the
+      // current non-default rule as state.
+      defout_impl writer(*this);
+      writer._out
+          = open_memstream(&buffers[chunk - batch], &sizes[chunk - batch]);
+      const int end = std::min((chunk + 1) * _chunk_size, object_count);
+      for (int i = chunk * _chunk_size; i < end; i++) {
+        (writer.*write)(objects[i]);
+      }
+      fclose(writer._out);
+    }
+    for (int i = 0; i < batch_end - batch; i++) {
+      fwrite(buffers[i], 1, sizes[i], _out);
+      free(buffers[i]);
+    }
+  }
+}
+
 void defout_impl::writeRows(dbBlock* block)
 {
   dbSet<dbRow> rows = block->getRows();
@@ -516,12 +622,14 @@ void defout_impl::writeInsts(dbBlock* block)
   fprintf(_out, "COMPONENTS %u ;\n", insts.size());
 
   // Sort the components for consistent output
+  std::vector<dbInst*> selected_insts;
   for (dbInst* inst : sortedSet(insts)) {
     if (_select_inst_map && !(*_select_inst_map)[inst]) {
       continue;
     }
-    writeInst(inst);
+    selected_insts.push_back(inst);
   }
+  writeChunked(selected_insts, &defout_impl::writeInst);
 
   fprintf(_out, "END COMPONENTS\n");
 }
@@ -1369,29 +1477,33 @@ void defout_impl::writeNets(dbBlock* block)
   if (snet_cnt > 0) {
     fprintf(_out, "SPECIALNETS %d ;\n", snet_cnt);
 
+    std::vector<dbNet*> snets;
     for (dbNet* net : sorted_nets) {
       if (_select_net_map && !(*_select_net_map)[net]) {
         continue;
       }
       if (net->isSpecial()) {
-        writeSNet(net);
+        snets.push_back(net);
       }
     }
+    writeChunked(snets, &defout_impl::writeSNet);
 
     fprintf(_out, "END SPECIALNETS\n");
   }
 
   fprintf(_out, "NETS %d ;\n", net_cnt);
 
+  std::vector<dbNet*> regular_nets;
   for (dbNet* net : sorted_nets) {
     if (_select_net_map && !(*_select_net_map)[net]) {
       continue;
     }
 
     if (regular_net[net] == 1) {
-      writeNet(net);
+      regular_nets.push_back(net);
     }
   }
+  writeChunked(regular_nets, &defout_impl::writeNet);
 
   fprintf(_out, "END NETS\n");
 }
@@ -35,6 +35,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "odb/db.h"
 #include "odb/dbMap.h"
@@ -69,6 +70,10 @@ class defout_impl
 
   double _dist_factor;
   FILE* _out;
+  bool _zipped;
+  int _num_threads;
+  // Number of objects formatted per buffer by writeChunked.
+  int _chunk_size;
   bool _use_net_inst_ids;
   bool _use_master_ids;
   bool _use_alias;
@@ -85,6 +90,11 @@ class defout_impl
 
   int defdist(uint value) { return (uint) (((double) value) * _dist_factor); }
 
+  static FILE* openZipped(int fd);
+  template <typename T>
+  void writeChunked(const std::vector<T*>& objects,
+                    void (defout_impl::*write)(T*));
+
   void writePropertyDefinitions(dbBlock* block);
   void writeRows(dbBlock* block);
   void writeTracks(dbBlock* block);
@@ -120,6 +130,9 @@ class defout_impl
   {
     _dist_factor = 0;
     _out = nullptr;
+    _zipped = false;
+    _num_threads = 1;
+    _chunk_size = 1024;
     _use_net_inst_ids = false;
     _use_master_ids = false;
     _use_alias = false;
@@ -142,6 +155,8 @@ class defout_impl
 
   void selectInst(dbInst* inst);
   void setVersion(int v) { _version = v; }
+  void setThreadCount(int threads) { _num_threads = threads; }
+  void setChunkSize(int size) { _chunk_size = size; }
 
   bool writeBlock(dbBlock* block, const char* def_file);
 };
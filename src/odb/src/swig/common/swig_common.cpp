@@ -165,13 +165,8 @@ odb::dbDatabase* read_db(odb::dbDatabase* db, const char* db_path)
     db = odb::dbDatabase::create();
   }
 
-  std::ifstream file;
-  file.exceptions(std::ifstream::failbit | std::ifstream::badbit
-                  | std::ios::eofbit);
-  file.open(db_path, std::ios::binary);
-
   try {
-    db->read(file);
+    db->readMapped(db_path);
   } catch (const std::ios_base::failure& f) {
     auto msg = fmt::format("odb file {} is invalid: {}", db_path, f.what());
     throw std::ios_base::failure(msg);
@@ -6,6 +6,7 @@
 
 #include <unistd.h>
 
+#include <fstream>
 #include <memory>
 
 #include "gtest/gtest.h"
@@ -130,4 +131,51 @@ TEST_F(OdbMultiPatternedTest, WireColorIsClearedOnNewPath)
   EXPECT_EQ(decoder.getColor().value(), /*mask_color=*/2);
 }
 
+TEST_F(OdbMultiPatternedTest, WireSurvivesMappedRead)
+{
+  // Arrange
+  dbNet* net = dbNet::create(block_.get(), "net0");
+  dbTech* tech = lib_->getTech();
+  dbTechLayer* met1 = tech->findLayer("met1");
+  dbWire* wire = dbWire::create(net);
+
+  dbWireEncoder encoder;
+  encoder.begin(wire);
+  encoder.newPath(met1, dbWireType::ROUTED);
+  encoder.addPoint(50, 50);
+  encoder.setColor(/*mask_color=*/1);
+  encoder.addPoint(100, 50);
+  encoder.end();
+
+  char path[] = "/tmp/TestDbWireXXXXXX";
+  close(mkstemp(path));
+  {
+    std::ofstream file(path, std::ios::binary);
+    db_->write(file);
+  }
+
+  // Act
+  OdbUniquePtr<odb::dbDatabase> db(odb::dbDatabase::create(),
+                                   &odb::dbDatabase::destroy);
+  db->readMapped(path);
+  unlink(path);
+
+  // Assert
+  dbNet* read_net = db->getChip()->getBlock()->findNet("net0");
+  ASSERT_NE(read_net, nullptr);
+  dbWire* read_wire = read_net->getWire();
+  ASSERT_NE(read_wire, nullptr);
+  EXPECT_EQ(read_wire->length(), wire->length());
+
+  dbWireDecoder decoder;
+  decoder.begin(read_wire);
+  EXPECT_EQ(decoder.next(), dbWireDecoder::OpCode::PATH);
+  EXPECT_EQ(decoder.getLayer()->getName(), "met1");
+  EXPECT_EQ(decoder.next(), dbWireDecoder::OpCode::POINT);
+  EXPECT_EQ(decoder.next(), dbWireDecoder::OpCode::POINT);
+  EXPECT_TRUE(decoder.getColor().has_value());
+  EXPECT_EQ(decoder.getColor().value(), /*mask_color=*/1);
+  EXPECT_EQ(decoder.next(), dbWireDecoder::OpCode::END_DECODE);
+}
+
 }  // namespace odb
@@ -0,0 +1,71 @@
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "odb/db.h"
+#include "odb/defin.h"
+#include "odb/defout.h"
+#include "odb/lefin.h"
+#include "utl/Logger.h"
+
+namespace odb {
+
+class DefoutThreadsFixture : public ::testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    db_ = dbDatabase::create();
+    lefin lef_reader(db_, &logger_, /*ignore_non_routing_layers=*/false);
+    dbLib* lib = lef_reader.createTechAndLib(
+        "Nangate45",
+        "Nangate45",
+        "data/Nangate45/NangateOpenCellLibrary.mod.lef");
+    std::vector<dbLib*> libs{lib};
+    defin def_reader(db_, &logger_);
+    dbChip* chip = def_reader.createChip(
+        libs, "data/gcd/gcd_nangate45_route.def", lib->getTech());
+    block_ = chip->getBlock();
+  }
+
+  void TearDown() override { dbDatabase::destroy(db_); }
+
+  std::string writeDef(int threads, int chunk_size, const std::string& name)
+  {
+    const std::string path = ::testing::TempDir() + name;
+    defout writer(&logger_);
+    writer.setThreadCount(threads);
+    writer.setChunkSize(chunk_size);
+    writer.writeBlock(block_, path.c_str());
+
+    std::ifstream stream(path);
+    std::stringstream contents;
+    contents << stream.rdbuf();
+    return contents.str();
+  }
+
+  utl::Logger logger_;
+  dbDatabase* db_ = nullptr;
+  dbBlock* block_ = nullptr;
+};
+
+// The gcd sections are smaller than the default chunk, so small chunks are
+// used to split COMPONENTS, SPECIALNETS and NETS over the threads.
+TEST_F(DefoutThreadsFixture, ChunkedWriterMatchesSerialWriter)
+{
+  const std::string serial = writeDef(1, 1024, "defout_serial.def");
+  ASSERT_FALSE(serial.empty());
+
+  for (int chunk_size : {1, 7, 64}) {
+    const std::string chunked
+        = writeDef(4,
+                   chunk_size,
+                   "defout_chunk_" + std::to_string(chunk_size) + ".def");
+    EXPECT_EQ(chunked, serial) << "chunk size " << chunk_size;
+  }
+}
+
+}  // namespace odb
@@ -0,0 +1,48 @@
+source "helpers.tcl"
+
+proc read_binary { filename } {
+  set stream [open $filename r]
+  fconfigure $stream -translation binary
+  set data [read $stream]
+  close $stream
+  return $data
+}
+
+# Read and write the block sections on several threads.  The databases
+# must match the serially read one and the files the serially written one.
+# The thread count is capped by the cores of the machine
+suppress_message ORD 30
+set_thread_count 4
+
+set src_db [odb::dbDatabase_create]
+odb::read_lef $src_db "data/Nangate45/NangateOpenCellLibrary.mod.lef"
+odb::read_def [$src_db getTech] "data/gcd/gcd_nangate45_route.def"
+set serial_file [make_result_file db_read_write_threads_serial.db]
+odb::write_db $src_db $serial_file
+
+read_db $serial_file
+
+if { [odb::db_diff $src_db [ord::get_db]] } {
+  puts "FAIL: Differences found between the serially and threaded read db"
+  exit 1
+}
+file delete diffs.rpt
+
+set db_file [make_result_file db_read_write_threads.db]
+write_db $db_file
+
+if { [read_binary $db_file] ne [read_binary $serial_file] } {
+  puts "FAIL: Threaded written db differs from the serially written one"
+  exit 1
+}
+
+set new_db [odb::read_db [odb::dbDatabase_create] $db_file]
+
+if { [odb::db_diff $src_db $new_db] } {
+  puts "FAIL: Differences found between exported and imported db"
+  exit 1
+}
+file delete diffs.rpt
+
+puts "pass"
+exit 0
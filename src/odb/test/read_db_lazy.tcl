@@ -0,0 +1,28 @@
+source "helpers.tcl"
+
+# A db read with -lazy decodes its wire and parasitic tables on first use.
+# It must look the same as one read eagerly.
+set src_db [odb::dbDatabase_create]
+odb::read_lef $src_db "data/Nangate45/NangateOpenCellLibrary.mod.lef"
+odb::read_def [$src_db getTech] "data/gcd/gcd_nangate45_route.def"
+set db_file [make_result_file read_db_lazy.db]
+odb::write_db $src_db $db_file
+
+read_db -lazy $db_file
+set eager_db [odb::dbDatabase_create]
+odb::read_db $eager_db $db_file
+
+set lazy_def [make_result_file read_db_lazy.def]
+write_def $lazy_def
+set eager_def [make_result_file read_db_eager.def]
+odb::write_def [[$eager_db getChip] getBlock] $eager_def
+diff_files $lazy_def $eager_def
+
+if { [odb::db_diff $eager_db [ord::get_db]] } {
+  puts "FAIL: Differences found between lazy and eager db"
+  exit 1
+}
+file delete diffs.rpt
+
+puts "pass"
+exit 0
@@ -0,0 +1,20 @@
+source "helpers.tcl"
+
+# Read a routed DEF with its NETS section split between threads and compare
+# it to a serial read.
+# The thread count is capped by the cores of the machine
+suppress_message ORD 30
+set_thread_count 4
+read_lef "data/Nangate45/NangateOpenCellLibrary.mod.lef"
+read_def "data/gcd/gcd_nangate45_route.def"
+
+set parallel_def [make_result_file read_def_threads_parallel.def]
+write_def $parallel_def
+
+set serial_db [odb::dbDatabase_create]
+odb::read_lef $serial_db "data/Nangate45/NangateOpenCellLibrary.mod.lef"
+odb::read_def [$serial_db getTech] "data/gcd/gcd_nangate45_route.def"
+set serial_def [make_result_file read_def_threads_serial.def]
+odb::write_def [[$serial_db getChip] getBlock] $serial_def
+
+diff_files $parallel_def $serial_def
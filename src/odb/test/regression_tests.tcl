@@ -8,13 +8,16 @@ record_tests {
   import_package
   read_lef
   read_db
+  read_db_lazy
   read_zipped
   create_sboxes
   dump_via_rules
   dump_vias
   read_def
   read_def58
+  read_def_threads
   write_def58
+  write_def_threads
   dump_nets
   lef_mask
   write_lef_and_def
@@ -26,6 +29,7 @@ record_tests {
   edit_via_params
   row_settings
   db_read_write
+  db_read_write_threads
   check_routing_tracks
   polygon
   def_parser
@@ -0,0 +1,26 @@
+source "helpers.tcl"
+
+# write_def with several threads, plain and zipped, must match the serial
+# writer.
+read_lef "data/Nangate45/NangateOpenCellLibrary.mod.lef"
+read_def "data/gcd/gcd_nangate45_route.def"
+
+set serial_def [make_result_file write_def_threads_serial.def]
+write_def $serial_def
+
+# The thread count is capped by the cores of the machine
+suppress_message ORD 30
+set_thread_count 4
+set parallel_def [make_result_file write_def_threads.def]
+write_def $parallel_def
+diff_files $parallel_def $serial_def
+
+set zipped_def [make_result_file write_def_threads.def.gz]
+write_def $zipped_def
+
+set zipped_db [odb::dbDatabase_create]
+odb::read_lef $zipped_db "data/Nangate45/NangateOpenCellLibrary.mod.lef"
+odb::read_def [$zipped_db getTech] $zipped_def
+set unzipped_def [make_result_file write_def_threads_unzipped.def]
+odb::write_def [[$zipped_db getChip] getBlock] $unzipped_def
+diff_files $unzipped_def $serial_def
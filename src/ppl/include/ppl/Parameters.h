@@ -112,6 +112,9 @@ class Parameters
   }
   std::string getPinPlacementFile() const { return pin_placement_file_; }
 
+  void setNumThreads(int threads) { num_threads_ = threads; }
+  int getNumThreads() const { return num_threads_; }
+
  private:
   bool report_hpwl_ = false;
   int num_slots_ = -1;
@@ -128,6 +131,7 @@ class Parameters
   int min_dist_ = 0;
   bool distance_in_tracks_ = false;
   std::string pin_placement_file_;
+  int num_threads_ = 1;
 };
 
 }  // namespace ppl
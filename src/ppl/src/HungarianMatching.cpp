@@ -261,13 +261,6 @@ void HungarianMatching::createMatrixForGroups()
       }
       slot_index++;
     }
-
-    if (hungarian_matrix_.empty()) {
-      logger_->error(utl::PPL,
-                     89,
-                     "Could not create matrix for groups. Not available slots "
-                     "inside section.");
-    }
   }
 }
 
@@ -276,6 +269,13 @@ void HungarianMatching::getAssignmentForGroups(std::vector<IOPin>& assignment,
                                                bool only_mirrored)
 {
   if (hungarian_matrix_.empty()) {
+    // Reported here as the matrices are built by parallel threads
+    if (!pin_groups_.empty()) {
+      logger_->error(utl::PPL,
+                     89,
+                     "Could not create matrix for groups. Not available slots "
+                     "inside section.");
+    }
     return;
   }
 
@@ -2003,8 +2003,12 @@ void IOPlacer::findPinAssignment(std::vector<Section>& sections,
     }
   }
 
-  for (auto& match : hg_vec) {
-    match.findAssignmentForGroups();
+  // The sections don't share slots, so their matchings are independent
+  const int num_threads = parms_->getNumThreads();
+  const int num_matches = hg_vec.size();
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic, 1)
+  for (int i = 0; i < num_matches; i++) {
+    hg_vec[i].findAssignmentForGroups();
   }
 
   for (auto& match : hg_vec) {
@@ -2018,8 +2022,9 @@ void IOPlacer::findPinAssignment(std::vector<Section>& sections,
     updateSection(sec, slots);
   }
 
-  for (auto& match : hg_vec) {
-    match.findAssignment();
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic, 1)
+  for (int i = 0; i < num_matches; i++) {
+    hg_vec[i].findAssignment();
   }
 
   if (!mirrored_pins_.empty()) {
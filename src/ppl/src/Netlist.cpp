@@ -55,6 +55,16 @@ void Netlist::addIONet(const IOPin& io_pin,
   io_pins_.push_back(io_pin);
   inst_pins_.insert(inst_pins_.end(), inst_pins.begin(), inst_pins.end());
   net_pointer_.push_back(inst_pins_.size());
+
+  // The instance pins don't move during pin placement, so the HPWL of an
+  // IO net only needs their bounding box and the IO pin position.
+  Rect sinks_bbox;
+  sinks_bbox.mergeInit();
+  for (const InstancePin& inst_pin : inst_pins) {
+    const Point pos = inst_pin.getPos();
+    sinks_bbox.merge(Rect(pos, pos));
+  }
+  sinks_bbox_.push_back(sinks_bbox);
 }
 
 int Netlist::createIOGroup(const std::vector<odb::dbBTerm*>& pin_list,
@@ -106,51 +116,15 @@ int Netlist::numIOPins()
 
 Rect Netlist::getBB(int idx, const Point& slot_pos)
 {
-  int net_start = net_pointer_[idx];
-  int net_end = net_pointer_[idx + 1];
-
-  int min_x = slot_pos.x();
-  int min_y = slot_pos.y();
-  int max_x = slot_pos.x();
-  int max_y = slot_pos.y();
-
-  for (int idx = net_start; idx < net_end; ++idx) {
-    Point pos = inst_pins_[idx].getPos();
-    min_x = std::min(min_x, pos.x());
-    max_x = std::max(max_x, pos.x());
-    min_y = std::min(min_y, pos.y());
-    max_y = std::max(max_y, pos.y());
-  }
-
-  Point upper_bounds = Point(max_x, max_y);
-  Point lower_bounds = Point(min_x, min_y);
-
-  Rect net_b_box(lower_bounds, upper_bounds);
+  Rect net_b_box = sinks_bbox_[idx];
+  net_b_box.merge(Rect(slot_pos, slot_pos));
   return net_b_box;
 }
 
 int Netlist::computeIONetHPWL(int idx, const Point& slot_pos)
 {
-  int net_start = net_pointer_[idx];
-  int net_end = net_pointer_[idx + 1];
-
-  int min_x = slot_pos.x();
-  int min_y = slot_pos.y();
-  int max_x = slot_pos.x();
-  int max_y = slot_pos.y();
-
-  for (int idx = net_start; idx < net_end; ++idx) {
-    Point pos = inst_pins_[idx].getPos();
-    min_x = std::min(min_x, pos.x());
-    max_x = std::max(max_x, pos.x());
-    min_y = std::min(min_y, pos.y());
-    max_y = std::max(max_y, pos.y());
-  }
-
-  int x = max_x - min_x;
-  int y = max_y - min_y;
-
-  return (x + y);
+  const Rect net_b_box = getBB(idx, slot_pos);
+  return net_b_box.dx() + net_b_box.dy();
 }
 
 int Netlist::computeDstIOtoPins(int idx, const Point& slot_pos)
@@ -182,6 +156,7 @@ void Netlist::reset()
 {
   inst_pins_.clear();
   net_pointer_.clear();
+  sinks_bbox_.clear();
   io_pins_.clear();
   io_groups_.clear();
   _db_pin_idx_map.clear();
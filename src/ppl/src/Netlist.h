@@ -209,6 +209,9 @@ class Netlist
  private:
   std::vector<InstancePin> inst_pins_;
   std::vector<int> net_pointer_;
+  // [io pin] -> bounding box of its net's instance pins.  Inverted when the
+  // net has no instance pins.
+  std::vector<odb::Rect> sinks_bbox_;
   std::vector<IOPin> io_pins_;
   std::vector<PinGroupByIndex> io_groups_;
   std::map<odb::dbBTerm*, int> _db_pin_idx_map;
@@ -0,0 +1,16 @@
+# gcd_nangate45 IO placement with several threads matches the serial placement
+source "helpers.tcl"
+read_lef Nangate45/Nangate45.lef
+read_def gcd.def
+
+# The thread count is capped by the cores of the machine
+suppress_message ORD 30
+set_thread_count 4
+
+place_pins -hor_layers metal3 -ver_layers metal2 -corner_avoidance 0 -min_distance 0.12
+
+set def_file [make_result_file gcd_threads.def]
+
+write_def $def_file
+
+diff_file gcd.defok $def_file
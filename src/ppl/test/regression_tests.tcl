@@ -48,6 +48,7 @@ record_tests {
   exclude2
   exclude3
   gcd
+  gcd_threads
   group_pins1
   group_pins2
   group_pins3
@@ -69,6 +69,13 @@ enum class GeneratedSourceType
   BUMPS
 };
 
+enum class SolverType
+{
+  LU,    // SparseLU
+  LDLT,  // SimplicialLDLT
+  CG     // ConjugateGradient with incomplete Cholesky preconditioner
+};
+
 class PDNSim : public odb::dbBlockCallBackObj
 {
  public:
@@ -84,6 +91,16 @@ class PDNSim : public odb::dbBlockCallBackObj
     int strap_track_pitch = 10;
   };
 
+  struct SolverSettings
+  {
+    SolverType type = SolverType::LU;
+
+    // CG stops once |GV - J| / |J| is below this
+    double tolerance = 1e-10;
+
+    int threads = 1;
+  };
+
   using IRDropByPoint = std::map<odb::Point, double>;
   using IRDropByLayer = std::map<odb::dbTechLayer*, IRDropByPoint>;
 
@@ -121,6 +138,9 @@ class PDNSim : public odb::dbBlockCallBackObj
   void clearSolvers();
 
   void setGeneratedSourceSettings(const GeneratedSourceSettings& settings);
+  void setSolverType(SolverType type);
+  void setSolverTolerance(double tolerance);
+  void setThreadCount(int threads);
 
   // from dbBlockCallBackObj
   void inDbPostMoveInst(odb::dbInst*) override;
@@ -145,6 +165,7 @@ class PDNSim : public odb::dbBlockCallBackObj
   bool debug_gui_enabled_ = false;
 
   GeneratedSourceSettings generated_source_settings_;
+  SolverSettings solver_settings_;
 
   std::map<odb::dbNet*, std::unique_ptr<IRSolver>> solvers_;
   std::map<odb::dbNet*, std::map<sta::Corner*, double>> user_voltages_;
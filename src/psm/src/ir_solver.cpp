@@ -33,6 +33,7 @@
 #include "ir_solver.h"
 
 #include <Eigen/SparseLU>
+#include <algorithm>
 #include <fstream>
 #include <list>
 #include <queue>
@@ -52,6 +53,21 @@
 
 namespace psm {
 
+// Eigen's thread count is process wide.  Use the solver's count for the
+// duration of a CG call and then restore the caller's.
+class EigenThreadScope
+{
+ public:
+  explicit EigenThreadScope(int threads) : saved_threads_(Eigen::nbThreads())
+  {
+    Eigen::setNbThreads(threads);
+  }
+  ~EigenThreadScope() { Eigen::setNbThreads(saved_threads_); }
+
+ private:
+  const int saved_threads_;
+};
+
 struct ODBCompare
 {
   bool operator()(odb::dbObject* lhs, odb::dbObject* rhs) const
@@ -67,7 +83,8 @@ IRSolver::IRSolver(
     rsz::Resizer* resizer,
     utl::Logger* logger,
     const std::map<odb::dbNet*, std::map<sta::Corner*, Voltage>>& user_voltages,
-    const PDNSim::GeneratedSourceSettings& generated_source_settings)
+    const PDNSim::GeneratedSourceSettings& generated_source_settings,
+    const PDNSim::SolverSettings& solver_settings)
     : net_(net),
       logger_(logger),
       resizer_(resizer),
@@ -75,7 +92,8 @@ IRSolver::IRSolver(
       network_(new IRNetwork(net_, logger_, floorplanning)),
       gui_(nullptr),
       user_voltages_(user_voltages),
-      generated_source_settings_(generated_source_settings)
+      generated_source_settings_(generated_source_settings),
+      solver_settings_(solver_settings)
 {
 }
 
@@ -865,6 +883,48 @@ void IRSolver::addSourcesToMatrixAndVoltages(
   }
 }
 
+void IRSolver::fixSourceVoltages(
+    Voltage src_voltage,
+    const std::vector<std::unique_ptr<psm::SourceNode>>& sources,
+    const std::map<Node*, std::size_t>& node_index,
+    Eigen::SparseMatrix<Connection::Conductance>& G,
+    Eigen::VectorXd& J) const
+{
+  // Pin the nodes under the sources to the source voltage instead of
+  // adding source rows, which keeps G symmetric positive definite:
+  // fixed columns move to J and fixed rows become the identity.
+  std::vector<bool> fixed(G.rows(), false);
+  for (const auto& src_node : sources) {
+    const std::size_t idx = node_index.at(src_node->getSource());
+    debugPrint(
+        logger_, utl::PSM, "solve", 2, "Fixing source voltage at {}", idx);
+    fixed[idx] = true;
+  }
+
+  for (Eigen::Index col = 0; col < G.outerSize(); col++) {
+    for (Matrix::InnerIterator it(G, col); it; ++it) {
+      const Eigen::Index row = it.row();
+      if (fixed[col]) {
+        if (!fixed[row]) {
+          J[row] -= it.value() * src_voltage;
+        }
+        it.valueRef() = (row == col) ? 1.0 : 0.0;
+      } else if (fixed[row]) {
+        it.valueRef() = 0.0;
+      }
+    }
+  }
+  G.prune([](const Eigen::Index&,
+             const Eigen::Index&,
+             const Connection::Conductance& value) { return value != 0.0; });
+
+  for (std::size_t idx = 0; idx < fixed.size(); idx++) {
+    if (fixed[idx]) {
+      J[idx] = src_voltage;
+    }
+  }
+}
+
 void IRSolver::solve(sta::Corner* corner,
                      GeneratedSourceType source_type,
                      const std::string& source_file)
@@ -916,7 +976,9 @@ void IRSolver::solve(sta::Corner* corner,
     node_index[node] = id;
   }
 
-  const std::size_t num_nodes = node_index.size();
+  const bool spd = solver_settings_.type != SolverType::LU;
+  const std::size_t num_nodes
+      = spd ? real_node_index.size() : node_index.size();
 
   debugPrint(logger_,
              utl::PSM,
@@ -931,59 +993,187 @@ void IRSolver::solve(sta::Corner* corner,
   Eigen::VectorXd J(num_nodes);
 
   // Build G and J
-  buildCondMatrixAndVoltages(src_voltage == 0.0,
-                             node_connections,
-                             currents,
-                             conductance,
-                             node_index,
-                             G,
-                             J);
-  addSourcesToMatrixAndVoltages(src_voltage, src_nodes, node_index, G, J);
+  if (spd) {
+    buildCondMatrixAndVoltages(src_voltage == 0.0,
+                               node_connections,
+                               currents,
+                               conductance,
+                               real_node_index,
+                               G,
+                               J);
+    fixSourceVoltages(src_voltage, src_nodes, real_node_index, G, J);
+  } else {
+    buildCondMatrixAndVoltages(src_voltage == 0.0,
+                               node_connections,
+                               currents,
+                               conductance,
+                               node_index,
+                               G,
+                               J);
+    addSourcesToMatrixAndVoltages(src_voltage, src_nodes, node_index, G, J);
+  }
+  G.makeCompressed();
+
+  factorizeMatrix(G, node_index);
+  const Eigen::VectorXd V = solveMatrix(J, node_index);
+  debugPrint(logger_,
+             utl::PSM,
+             "solve",
+             1,
+             "Solving system of equations GV=J complete");
 
-  Eigen::SparseLU<Eigen::SparseMatrix<Connection::Conductance>> eigen_solver;
+  if (logger_->debugCheck(utl::PSM, "dump", 2)) {
+    network_->dumpNodes(node_index);
+    dumpMatrix(G, "G");
+    dumpVector(J, "J");
+    dumpVector(V, "V");
+  }
+  for (const auto& [node, node_idx] : real_node_index) {
+    voltages[node] = V[node_idx];
+  }
+  solution_voltages_[corner] = src_voltage;
+}
+
+static bool isSameMatrix(const Eigen::SparseMatrix<Connection::Conductance>& a,
+                         const Eigen::SparseMatrix<Connection::Conductance>& b)
+{
+  if (a.rows() != b.rows() || a.cols() != b.cols()
+      || a.nonZeros() != b.nonZeros()) {
+    return false;
+  }
+  const auto outer = a.outerSize() + 1;
+  const auto nnz = a.nonZeros();
+  return std::equal(
+             a.outerIndexPtr(), a.outerIndexPtr() + outer, b.outerIndexPtr())
+         && std::equal(
+             a.innerIndexPtr(), a.innerIndexPtr() + nnz, b.innerIndexPtr())
+         && std::equal(a.valuePtr(), a.valuePtr() + nnz, b.valuePtr());
+}
+
+void IRSolver::factorizeMatrix(const Matrix& G,
+                               const std::map<Node*, std::size_t>& node_index)
+{
+  const SolverType type = solver_settings_.type;
+  if (factored_type_ == type && isSameMatrix(G, factored_G_)) {
+    debugPrint(
+        logger_, utl::PSM, "solve", 1, "Reusing factorization of the G matrix");
+    return;
+  }
+
+  const utl::DebugScopedTimer timer(
+      logger_, utl::PSM, "timer", 1, "Factorize G: {}");
+
+  lu_solver_.reset();
+  ldlt_solver_.reset();
+  cg_solver_.reset();
+  // The CG solver keeps a reference to the matrix it was computed on.
+  factored_G_ = G;
+  factored_type_ = type;
 
   debugPrint(logger_, utl::PSM, "solve", 1, "Factorizing the G matrix");
-  eigen_solver.compute(G);
-  if (eigen_solver.info() != Eigen::ComputationInfo::Success) {
+  Eigen::ComputationInfo info = Eigen::ComputationInfo::Success;
+  std::string message;
+  switch (type) {
+    case SolverType::LU:
+      lu_solver_ = std::make_unique<LUSolver>();
+      lu_solver_->compute(factored_G_);
+      info = lu_solver_->info();
+      message = lu_solver_->lastErrorMessage();
+      break;
+    case SolverType::LDLT:
+      ldlt_solver_ = std::make_unique<LDLTSolver>();
+      ldlt_solver_->compute(factored_G_);
+      info = ldlt_solver_->info();
+      break;
+    case SolverType::CG: {
+      const EigenThreadScope threads(solver_settings_.threads);
+      cg_solver_ = std::make_unique<CGSolver>();
+      cg_solver_->compute(factored_G_);
+      info = cg_solver_->info();
+      break;
+    }
+  }
+
+  if (info != Eigen::ComputationInfo::Success) {
     // decomposition failed
     if (logger_->debugCheck(utl::PSM, "dump", 1)) {
       network_->dumpNodes(node_index);
-      dumpMatrix(G, "G");
+      dumpMatrix(factored_G_, "G");
+    }
+    factored_G_.resize(0, 0);
+    switch (type) {
+      case SolverType::LU:
+        logger_->error(utl::PSM,
+                       10,
+                       "LU factorization of the G Matrix failed. SparseLU "
+                       "solver message: {}.",
+                       message);
+        break;
+      case SolverType::LDLT:
+        logger_->error(
+            utl::PSM, 93, "LDLT factorization of the G Matrix failed.");
+        break;
+      case SolverType::CG:
+        logger_->error(utl::PSM,
+                       94,
+                       "Incomplete Cholesky preconditioning of the G Matrix "
+                       "failed.");
+        break;
     }
-    logger_->error(
-        utl::PSM,
-        10,
-        "LU factorization of the G Matrix failed. SparseLU solver message: {}.",
-        eigen_solver.lastErrorMessage());
   }
+}
 
+Eigen::VectorXd IRSolver::solveMatrix(
+    const Eigen::VectorXd& J,
+    const std::map<Node*, std::size_t>& node_index)
+{
   debugPrint(logger_, utl::PSM, "solve", 1, "Solving system of equations GV=J");
-  const Eigen::VectorXd V = eigen_solver.solve(J);
-  if (eigen_solver.info() != Eigen::ComputationInfo::Success) {
+  Eigen::VectorXd V;
+  Eigen::ComputationInfo info = Eigen::ComputationInfo::Success;
+  switch (factored_type_) {
+    case SolverType::LU:
+      V = lu_solver_->solve(J);
+      info = lu_solver_->info();
+      break;
+    case SolverType::LDLT:
+      V = ldlt_solver_->solve(J);
+      info = ldlt_solver_->info();
+      break;
+    case SolverType::CG: {
+      const EigenThreadScope threads(solver_settings_.threads);
+      cg_solver_->setTolerance(solver_settings_.tolerance);
+      V = cg_solver_->solve(J);
+      info = cg_solver_->info();
+      debugPrint(logger_,
+                 utl::PSM,
+                 "solve",
+                 1,
+                 "CG finished after {} iterations with error {:.3e}",
+                 cg_solver_->iterations(),
+                 cg_solver_->error());
+      break;
+    }
+  }
+
+  if (info != Eigen::ComputationInfo::Success) {
     // solving failed
     if (logger_->debugCheck(utl::PSM, "dump", 1)) {
       network_->dumpNodes(node_index);
-      dumpMatrix(G, "G");
+      dumpMatrix(factored_G_, "G");
       dumpVector(J, "J");
     }
+    if (factored_type_ == SolverType::CG) {
+      logger_->error(utl::PSM,
+                     95,
+                     "CG did not converge to {:.3e} after {} iterations "
+                     "(error {:.3e}).",
+                     solver_settings_.tolerance,
+                     cg_solver_->iterations(),
+                     cg_solver_->error());
+    }
     logger_->error(utl::PSM, 12, "Solving V = inv(G)*J failed.");
   }
-  debugPrint(logger_,
-             utl::PSM,
-             "solve",
-             1,
-             "Solving system of equations GV=J complete");
-
-  if (logger_->debugCheck(utl::PSM, "dump", 2)) {
-    network_->dumpNodes(node_index);
-    dumpMatrix(G, "G");
-    dumpVector(J, "J");
-    dumpVector(V, "V");
-  }
-  for (const auto& [node, node_idx] : real_node_index) {
-    voltages[node] = V[node_idx];
-  }
-  solution_voltages_[corner] = src_voltage;
+  return V;
 }
 
 std::map<odb::dbInst*, IRSolver::Power> IRSolver::getInstancePower(
@@ -94,7 +94,8 @@ class IRSolver
            utl::Logger* logger,
            const std::map<odb::dbNet*, std::map<sta::Corner*, Voltage>>&
                user_voltages,
-           const PDNSim::GeneratedSourceSettings& generated_source_settings);
+           const PDNSim::GeneratedSourceSettings& generated_source_settings,
+           const PDNSim::SolverSettings& solver_settings);
 
   odb::dbNet* getNet() const { return net_; };
 
@@ -148,6 +149,12 @@ class IRSolver
  private:
   template <typename T>
   using ValueNodeMap = std::map<const Node*, T>;
+  using Matrix = Eigen::SparseMatrix<Connection::Conductance>;
+  using LUSolver = Eigen::SparseLU<Matrix>;
+  using LDLTSolver = Eigen::SimplicialLDLT<Matrix>;
+  using CGPreconditioner = Eigen::IncompleteCholesky<Connection::Conductance>;
+  using CGSolver = Eigen::
+      ConjugateGradient<Matrix, Eigen::Lower | Eigen::Upper, CGPreconditioner>;
 
   odb::dbBlock* getBlock() const;
   odb::dbTech* getTech() const;
@@ -211,6 +218,16 @@ class IRSolver
       const std::map<Node*, std::size_t>& node_index,
       Eigen::SparseMatrix<Connection::Conductance>& G,
       Eigen::VectorXd& J) const;
+  void fixSourceVoltages(
+      Voltage src_voltage,
+      const std::vector<std::unique_ptr<psm::SourceNode>>& sources,
+      const std::map<Node*, std::size_t>& node_index,
+      Eigen::SparseMatrix<Connection::Conductance>& G,
+      Eigen::VectorXd& J) const;
+  void factorizeMatrix(const Matrix& G,
+                       const std::map<Node*, std::size_t>& node_index);
+  Eigen::VectorXd solveMatrix(const Eigen::VectorXd& J,
+                              const std::map<Node*, std::size_t>& node_index);
 
   std::string getMetricKey(const std::string& key, sta::Corner* corner) const;
 
@@ -235,6 +252,16 @@ class IRSolver
   std::map<sta::Corner*, Voltage> solution_voltages_;
 
   const PDNSim::GeneratedSourceSettings& generated_source_settings_;
+  const PDNSim::SolverSettings& solver_settings_;
+
+  // Factorization of the last G matrix.  A solve with the same G and
+  // solver type (other corners with the same resistances, other current
+  // maps) only does the triangular solve.
+  Matrix factored_G_;
+  SolverType factored_type_ = SolverType::LU;
+  std::unique_ptr<LUSolver> lu_solver_;
+  std::unique_ptr<LDLTSolver> ldlt_solver_;
+  std::unique_ptr<CGSolver> cg_solver_;
 
   // Holds nodes that were visited during the open net check
   std::set<const Node*> visited_;
@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "psm/pdnsim.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -164,7 +165,8 @@ psm::IRSolver* PDNSim::getIRSolver(odb::dbNet* net, bool floorplanning)
                                         resizer_,
                                         logger_,
                                         user_voltages_,
-                                        generated_source_settings_);
+                                        generated_source_settings_,
+                                        solver_settings_);
     addOwner(net->getBlock());
   }
 
@@ -202,6 +204,21 @@ void PDNSim::setGeneratedSourceSettings(const GeneratedSourceSettings& settings)
   }
 }
 
+void PDNSim::setSolverType(SolverType type)
+{
+  solver_settings_.type = type;
+}
+
+void PDNSim::setSolverTolerance(double tolerance)
+{
+  solver_settings_.tolerance = tolerance;
+}
+
+void PDNSim::setThreadCount(int threads)
+{
+  solver_settings_.threads = std::max(threads, 1);
+}
+
 void PDNSim::clearSolvers()
 {
   solvers_.clear();
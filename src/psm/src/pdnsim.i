@@ -67,6 +67,19 @@ using sta::Corner;
   }
 }
 
+%typemap(in) psm::SolverType {
+  int length;
+  const char *arg = Tcl_GetStringFromObj($input, &length);
+
+  if (strcmp(arg, "LDLT") == 0) {
+    $1 = psm::SolverType::LDLT;
+  } else if (strcmp(arg, "CG") == 0) {
+    $1 = psm::SolverType::CG;
+  } else {
+    $1 = psm::SolverType::LU;
+  }
+}
+
 %inline %{
 
 
@@ -81,6 +94,7 @@ void
 analyze_power_grid_cmd(odb::dbNet* net, Corner* corner, psm::GeneratedSourceType type, const char* error_file, bool enable_em, const char* em_file, const char* voltage_file, const char* voltage_source_file)
 {
   PDNSim* pdnsim = getPDNSim();
+  pdnsim->setThreadCount(ord::OpenRoad::openRoad()->getThreadCount());
   pdnsim->analyzePowerGrid(net, corner, type, voltage_file, enable_em, em_file, error_file, voltage_source_file);
 }
 
@@ -123,5 +137,17 @@ void set_source_settings(int bump_dx, int bump_dy, int bump_size, int bump_inter
   pdnsim->setGeneratedSourceSettings(settings);
 }
 
+void set_solver_type(psm::SolverType type)
+{
+  PDNSim* pdnsim = getPDNSim();
+  pdnsim->setSolverType(type);
+}
+
+void set_solver_tolerance(double tolerance)
+{
+  PDNSim* pdnsim = getPDNSim();
+  pdnsim->setSolverTolerance(tolerance);
+}
+
 %} // inline
 
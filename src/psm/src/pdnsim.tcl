@@ -207,6 +207,29 @@ proc set_pdnsim_source_settings { args } {
   psm::set_source_settings $dx $dy $size $interval $track_pitch
 }
 
+sta::define_cmd_args "set_pdnsim_solver_settings" {
+  [-solver LU|LDLT|CG]
+  [-tolerance tolerance]}
+
+proc set_pdnsim_solver_settings { args } {
+  sta::parse_key_args "set_pdnsim_solver_settings" args \
+    keys {-solver -tolerance} flags {}
+
+  if { [info exists keys(-solver)] } {
+    set solver [string toupper $keys(-solver)]
+    if { [lsearch -exact {LU LDLT CG} $solver] == -1 } {
+      utl::error PSM 96 "-solver must be LU, LDLT or CG."
+    }
+    psm::set_solver_type $solver
+  }
+
+  if { [info exists keys(-tolerance)] } {
+    set tolerance $keys(-tolerance)
+    sta::check_positive_float "-tolerance" $tolerance
+    psm::set_solver_tolerance $tolerance
+  }
+}
+
 namespace eval psm {
 
 proc find_net {net_name} {
@@ -0,0 +1,12 @@
+# Solve the same grid with the LDLT and CG solvers
+source "helpers.tcl"
+read_lef Nangate45/Nangate45.lef
+read_def Nangate45_data/aes.def
+read_liberty Nangate45/Nangate45_typ.lib
+read_sdc Nangate45_data/aes.sdc
+
+set_pdnsim_solver_settings -solver LDLT
+analyze_power_grid -vsrc Vsrc_aes_vdd.loc -net VDD
+
+set_pdnsim_solver_settings -solver CG -tolerance 1e-12
+analyze_power_grid -vsrc Vsrc_aes_vdd.loc -net VDD
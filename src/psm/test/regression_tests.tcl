@@ -1,5 +1,6 @@
 record_tests {
   aes_test_vdd
+  aes_test_vdd_solvers
   aes_test_vss
   gcd_test_vdd
   gcd_no_vsrc
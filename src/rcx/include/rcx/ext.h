@@ -118,9 +118,13 @@ class Ext
     int context_depth = 5;
     int cc_model = 10;
     bool lef_res = false;
+    bool incremental = false;
+    int thread_count = 1;
   };
 
   void extract(ExtractOptions options);
+  // Width in tracks of the bands that coupling is extracted in.
+  void set_coupling_band_tracks(int tracks);
 
   void define_process_corner(int ext_model_index, const std::string& name);
   void define_derived_corner(const std::string& name,
@@ -160,6 +164,7 @@ class Ext
     const bool no_backslash = false;
     const char* cap_units = "PF";
     const char* res_units = "OHM";
+    bool incremental = false;
   };
   void write_spef(const SpefOptions& options);
 
@@ -33,10 +33,13 @@
 #pragma once
 
 #include <map>
+#include <set>
+#include <vector>
 
 #include "ext2dBox.h"
 #include "extprocess.h"
 #include "odb/db.h"
+#include "odb/dbBlockCallBackObj.h"
 #include "odb/dbExtControl.h"
 #include "odb/dbShape.h"
 #include "odb/odb.h"
@@ -672,6 +675,50 @@ class extLenOU  // assume cross-section on the z-direction
   bool _under;
 };
 
+// The db updates of one coupling band, recorded by a thread of a parallel
+// coupling sweep and applied in band order so that the rsegs and coupling
+// segments come out as in a serial sweep.
+class extRCUpdates
+{
+ public:
+  void updateTotalCap(odb::dbRSeg* rseg, double cap, uint modelIndex);
+  void updateTotalCap(odb::dbRSeg* rseg,
+                      double frCap,
+                      double ccCap,
+                      double deltaFr,
+                      uint modelIndex);
+  void updateRes(odb::dbRSeg* rseg, double res, uint model);
+  void updateCoupCap(odb::dbRSeg* rseg1, odb::dbRSeg* rseg2, int jj, double v);
+  void createCCSeg(odb::dbCapNode* node1, odb::dbCapNode* node2);
+  // Adds to the coupling segment of the last createCCSeg.
+  void addCCCap(double v, uint model);
+
+  void apply(extMain* extMain);
+
+ private:
+  enum Kind
+  {
+    TOTAL_CAP,
+    TOTAL_CAP_FRINGE,
+    RES,
+    COUP_CAP,
+    CC_SEG,
+    CC_CAP
+  };
+  struct Update
+  {
+    Kind _kind;
+    int _model;
+    odb::dbRSeg* _rseg1;
+    odb::dbRSeg* _rseg2;
+    odb::dbCapNode* _node1;
+    odb::dbCapNode* _node2;
+    double _v[3];
+  };
+
+  std::vector<Update> _updates;
+};
+
 class extMeasure
 {
  public:
@@ -863,8 +910,17 @@ class extMeasure
                    uint trackn,
                    Ath__array1D<SEQ*>* residueSeq);
 
-  odb::dbCCSeg* makeCcap(odb::dbRSeg* rseg1, odb::dbRSeg* rseg2, double ccCap);
-  void addCCcap(odb::dbCCSeg* ccap, double v, uint model);
+  bool makeCcap(odb::dbRSeg* rseg1, odb::dbRSeg* rseg2, double ccCap);
+  void createCCSeg(odb::dbCapNode* node1, odb::dbCapNode* node2);
+  void addCCcap(double v, uint model);
+  void updateTotalCap(odb::dbRSeg* rseg, double cap, uint modelIndex);
+  void updateTotalCap(odb::dbRSeg* rseg,
+                      double frCap,
+                      double ccCap,
+                      double deltaFr,
+                      uint modelIndex);
+  void updateRes(odb::dbRSeg* rseg, double res, uint model);
+  void updateCoupCap(odb::dbRSeg* rseg1, odb::dbRSeg* rseg2, int jj, double v);
   void addFringe(odb::dbRSeg* rseg1,
                  odb::dbRSeg* rseg2,
                  double frCap,
@@ -1140,6 +1196,10 @@ class extMeasure
 
   AthPool<SEQ>* _seqPool;
 
+  // Db updates are recorded here instead of applied when set.
+  extRCUpdates* _rcUpdates = nullptr;
+  odb::dbCCSeg* _ccSeg = nullptr;
+
   AthPool<extLenOU>* _lenOUPool;
   Ath__array1D<extLenOU*>* _lenOUtable;
 
@@ -1230,6 +1290,91 @@ class extCorner
   extCorner* _extCornerPtr;
 };
 
+// A wire shape collected once per coupling sweep direction and added to
+// the search grid when the band containing it is processed.
+struct extBandShape
+{
+  odb::Rect _rect;
+  uint _level;
+  uint _id;  // net id of signal wires, sbox id of power wires
+  uint _shapeId;
+  uint _wtype;
+  bool _signal;
+};
+
+// The bands of one coupling sweep direction.
+struct extBandSweep
+{
+  uint _dir;
+  int _ll[2];
+  int _ur[2];
+  uint _layerCnt;
+  uint* _dirTable;
+  uint* _pitchTable;
+  uint* _widthTable;
+  uint _maxPitch;
+  std::vector<int> _bandHi;
+  std::vector<std::vector<extBandShape>> _bandShapes;
+  std::vector<std::vector<odb::Rect>> _gsShapes;
+};
+
+// Search grid, context arrays and measure of one thread of a parallel
+// coupling sweep.
+struct extCouplingThread
+{
+  Ath__gridTable* _search = nullptr;
+  extMeasure* _m = nullptr;
+  Ath__array1D<SEQ*>*** _dgContextArray = nullptr;
+  uint _dgContextBaseLvl = 0;
+  int _dgContextLowLvl = 0;
+  int _dgContextHiLvl = 0;
+  uint* _dgContextBaseTrack = nullptr;
+  int* _dgContextLowTrack = nullptr;
+  int* _dgContextHiTrack = nullptr;
+  int** _dgContextTrackBase = nullptr;
+  Ath__array1D<int>** _ccContextArray = nullptr;
+  int** _limitArray = nullptr;
+};
+
+// Records the nets whose routing or connectivity changed since the last
+// extraction, together with the shapes of any wire that was removed, so
+// that extract_parasitics -incremental re-extracts only those nets.
+class extNetTracker : public odb::dbBlockCallBackObj
+{
+ public:
+  void attach(odb::dbBlock* block);
+  bool isAttached(odb::dbBlock* block) const;
+  void clear();
+
+  const std::set<uint>& getNets() const { return _nets; }
+  const std::vector<odb::Rect>& getRemovedShapes() const
+  {
+    return _removedShapes;
+  }
+
+  void inDbNetDestroy(odb::dbNet* net) override;
+  void inDbITermPostConnect(odb::dbITerm* iterm) override;
+  void inDbITermPreDisconnect(odb::dbITerm* iterm) override;
+  void inDbBTermPostConnect(odb::dbBTerm* bterm) override;
+  void inDbBTermPreDisconnect(odb::dbBTerm* bterm) override;
+  void inDbWireCreate(odb::dbWire* wire) override;
+  void inDbWireDestroy(odb::dbWire* wire) override;
+  void inDbWirePreModify(odb::dbWire* wire) override;
+  void inDbWirePostModify(odb::dbWire* wire) override;
+  void inDbWirePostAttach(odb::dbWire* wire) override;
+  void inDbWirePreDetach(odb::dbWire* wire) override;
+  void inDbWirePostAppend(odb::dbWire* src, odb::dbWire* dst) override;
+  void inDbWirePostCopy(odb::dbWire* src, odb::dbWire* dst) override;
+
+ private:
+  void addNet(odb::dbNet* net);
+  void addRemovedShapes(odb::dbWire* wire);
+
+  odb::dbBlock* _block = nullptr;
+  std::set<uint> _nets;
+  std::vector<odb::Rect> _removedShapes;
+};
+
 class extMain
 {
  public:
@@ -1350,7 +1495,30 @@ class extMain
                     uint ccFlag,
                     extMeasure* m,
                     CoupleAndCompute coupleAndCompute);
-  uint initPlanes(uint dir,
+  void sweepCouplingBands(extBandSweep& sweep,
+                          uint ccFlag,
+                          uint firstBand,
+                          uint lastBand,
+                          Ath__gridTable* search,
+                          extMeasure* m,
+                          int** limitArray,
+                          CoupleAndCompute coupleAndCompute,
+                          std::vector<extRCUpdates>* bandUpdates,
+                          FILE* bandinfo,
+                          uint totWireCnt,
+                          uint& totalWiresExtracted);
+  void reportCouplingProgress(uint wireCnt,
+                              uint totWireCnt,
+                              uint& totalWiresExtracted);
+  void setupCouplingMeasure(extMeasure* m);
+  void initCouplingThread(extCouplingThread& thread,
+                          uint layerCnt,
+                          uint* pitchTable,
+                          const int* baseX,
+                          const int* baseY);
+  void removeCouplingThread(extCouplingThread& thread, uint layerCnt);
+  uint initPlanes(gs* geomSeq,
+                  uint dir,
                   int* wLL,
                   int* wUR,
                   uint layerCnt,
@@ -1464,7 +1632,25 @@ class extMain
                        bool mergeViaRes,
                        double ccThres,
                        int contextDepth,
-                       const char* extRules);
+                       const char* extRules,
+                       std::vector<odb::dbNet*>* incrNets = nullptr);
+  void makeIncrementalRCsegs(uint cc_up,
+                             uint ccFlag,
+                             double resBound,
+                             bool mergeViaRes,
+                             double ccThres,
+                             int contextDepth,
+                             const char* extRules);
+  void trackNetChanges();
+  bool getIncrementalNets(std::vector<odb::dbNet*>& nets);
+  int getCouplingHalo(uint ccFlag);
+  void getCouplingNeighbors(const std::vector<odb::dbNet*>& nets,
+                            int halo,
+                            std::vector<odb::dbNet*>& neighbors);
+  bool isFrozen(odb::dbRSeg* rseg)
+  {
+    return _incrExtract && rseg != nullptr && !rseg->getNet()->isMarked();
+  }
 
   uint getShortSrcJid(uint jid);
   void make1stRSeg(odb::dbNet* net,
@@ -1567,7 +1753,8 @@ class extMain
                  int corner,
                  const char* corner_name,
                  const char* spef_version,
-                 bool parallel);
+                 bool parallel,
+                 bool incremental = false);
   uint writeNetSPEF(odb::dbNet* net, double resBound, uint debug);
   uint makeITermCapNode(uint id, odb::dbNet* net);
   uint makeBTermCapNode(uint id, odb::dbNet* net);
@@ -1602,7 +1789,7 @@ class extMain
   void cleanCornerTables();
   int getDbCornerIndex(const char* name);
   int getDbCornerModel(const char* name);
-  bool setCorners(const char* rulesFileName);
+  bool setCorners(const char* rulesFileName, bool initBlockCorners = true);
   int getProcessCornerDbIndex(int pcidx);
   void getScaledCornerDbIndex(int pcidx, int& scidx, int& scdbIdx);
   void getScaledRC(int sidx, double& res, double& cap);
@@ -1641,7 +1828,8 @@ class extMain
                     bool swap_coords,
                     int dir);
 
-  uint fill_gs4(int dir,
+  uint fill_gs4(gs* geomSeq,
+                int dir,
                 int* ll,
                 int* ur,
                 int* lo_gs,
@@ -1649,7 +1837,21 @@ class extMain
                 uint layerCnt,
                 uint* dirTable,
                 uint* pitchTable,
-                uint* widthTable);
+                uint* widthTable,
+                const std::vector<std::vector<odb::Rect>>& gsShapes);
+  void getGsShapes(int dir,
+                   bool gsRotated,
+                   const odb::Rect* clip,
+                   std::vector<std::vector<odb::Rect>>& gsShapes);
+  void getBandShapes(uint dir,
+                     int bandLo,
+                     const std::vector<int>& bandHi,
+                     uint pwrtype,
+                     uint sigtype,
+                     const odb::Rect* clip,
+                     std::vector<std::vector<extBandShape>>& bandShapes);
+  uint addBandShapes(Ath__gridTable* search,
+                     const std::vector<extBandShape>& shapes);
 
   uint addInsts(uint dir,
                 int* lo_gs,
@@ -2035,6 +2237,12 @@ class extMain
   bool _extracted;
   bool _allNet;
 
+  // Incremental extraction: the nets re-extracted by the last incremental
+  // run and the changes recorded since the last extraction.
+  bool _incrExtract = false;
+  std::vector<uint> _incrNetIds;
+  extNetTracker _netTracker;
+
   bool _getBandWire = false;
   bool _printBandInfo = false;
   uint _ccUp = 0;
@@ -2222,6 +2430,8 @@ class extMain
 
  public:
   bool _lef_res;
+  int _threadCnt = 1;
+  uint _couplingBandTracks = 1000;
   std::string _tmpLenStats;
   int _last_node_xy[2];
   bool _wireInfra;
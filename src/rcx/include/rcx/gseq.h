@@ -58,7 +58,7 @@ class gs
                       int x1,
                       int y1);
 
-  // render a rectangle
+  // render a rectangle; safe to call concurrently on different slices
   int box(int x0, int y0, int x1, int y1, int slice);
 
   // set the number of slices
@@ -119,8 +119,7 @@ class gs
 
   static constexpr int PIXMAPGRID = 64;
 
-  int nslices_;   // max number of slices
-  int maxslice_;  // maximum used slice
+  int nslices_;  // max number of slices
 
   int init_;
 
@@ -230,6 +230,11 @@ void Ext::get_ext_db_corner(int& index, const std::string& name)
   }
 }
 
+void Ext::set_coupling_band_tracks(int tracks)
+{
+  _ext->_couplingBandTracks = tracks;
+}
+
 void Ext::extract(ExtractOptions options)
 {
   _ext->setBlockFromChip();
@@ -241,15 +246,27 @@ void Ext::extract(ExtractOptions options)
 
   _ext->set_debug_nets(options.debug_net);
   _ext->_lef_res = options.lef_res;
-
-  _ext->makeBlockRCsegs(options.net,
-                        options.cc_up,
-                        options.cc_model,
-                        options.max_res,
-                        !options.no_merge_via_res,
-                        options.coupling_threshold,
-                        options.context_depth,
-                        options.ext_model_file);
+  _ext->_threadCnt = options.thread_count;
+
+  if (options.incremental) {
+    _ext->makeIncrementalRCsegs(options.cc_up,
+                                options.cc_model,
+                                options.max_res,
+                                !options.no_merge_via_res,
+                                options.coupling_threshold,
+                                options.context_depth,
+                                options.ext_model_file);
+  } else {
+    _ext->makeBlockRCsegs(options.net,
+                          options.cc_up,
+                          options.cc_model,
+                          options.max_res,
+                          !options.no_merge_via_res,
+                          options.coupling_threshold,
+                          options.context_depth,
+                          options.ext_model_file);
+  }
+  _ext->trackNetChanges();
 
   logger_->info(
       RCX, 15, "Finished extracting {}.", _ext->getBlock()->getName().c_str());
@@ -312,7 +329,8 @@ void Ext::write_spef(const SpefOptions& options)
                   options.corner,
                   name,
                   spef_version_,
-                  options.parallel);
+                  options.parallel,
+                  options.incremental);
 
   logger_->info(RCX, 17, "Finished writing SPEF ...");
 }
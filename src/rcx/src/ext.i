@@ -70,7 +70,8 @@ extract(const char* ext_model_file,
         int context_depth,
         const char* debug_net_id,
         bool lef_res,
-        bool no_merge_via_res)
+        bool no_merge_via_res,
+        bool incremental)
 {
   Ext* ext = getOpenRCX();
   Ext::ExtractOptions opts;
@@ -84,15 +85,25 @@ extract(const char* ext_model_file,
   opts.lef_res = lef_res;
   opts.debug_net = debug_net_id;
   opts.no_merge_via_res = no_merge_via_res;
+  opts.incremental = incremental;
+  opts.thread_count = ord::OpenRoad::openRoad()->getThreadCount();
   
   ext->extract(opts);
 }
 
+void
+set_coupling_band_tracks(int tracks)
+{
+  Ext* ext = getOpenRCX();
+  ext->set_coupling_band_tracks(tracks);
+}
+
 void
 write_spef(const char* file,
            const char* nets,
            int net_id,
-           bool write_coordinates)
+           bool write_coordinates,
+           bool incremental)
 {
   Ext* ext = getOpenRCX();
   Ext::SpefOptions opts;
@@ -102,6 +113,7 @@ write_spef(const char* file,
   if (write_coordinates) {
     opts.N = "Y";
   }
+  opts.incremental = incremental;
   
   ext->write_spef(opts);
 }
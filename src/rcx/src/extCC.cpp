@@ -41,7 +41,7 @@ CoupleOptions coupleOptionsNull{};
 
 namespace rcx {
 
-static uint ttttGetDgOverlap;
+static thread_local uint ttttGetDgOverlap;
 
 uint Ath__track::trackContextOn(int orig,
                                 int end,
@@ -694,9 +694,9 @@ void Ath__track::buildDgContext(Ath__array1D<SEQ*>* dgContext,
 
 void Ath__grid::buildDgContext(int gridn, int base)
 {
-  static Ath__wire** allCtxwire = nullptr;
-  static int awcnt;
-  static int awsize;
+  static thread_local Ath__wire** allCtxwire = nullptr;
+  static thread_local int awcnt;
+  static thread_local int awsize;
   if (allCtxwire == nullptr) {
     allCtxwire = (Ath__wire**) calloc(sizeof(Ath__wire*), 4096);
     awsize = 4096;
@@ -895,6 +895,30 @@ int Ath__grid::couplingCaps(int hiXY,
   return hiXY;
 }
 
+// Same track walk as couplingCaps without extracting, so that a search grid
+// can be brought to the state it has after the band.
+int Ath__grid::skipCouplingCaps(int hiXY, uint couplingDist)
+{
+  uint ccThreshold = couplingDist * _pitch;
+  uint TargetHighMarkedNet = _gridtable->targetHighMarkedNet();
+  bool allNet = _gridtable->allNet();
+
+  uint domainAdjust = allNet || !TargetHighMarkedNet ? 0 : couplingDist;
+
+  initContextGrids();
+  setSearchDomain(domainAdjust);
+
+  for (uint ii = _currentTrack; ii <= _searchHiTrack; ii++) {
+    int baseXY = _base + _pitch * ii;
+    int hiEnd = hiXY - (ccThreshold + _pitch);
+    if (baseXY >= hiEnd) {
+      _currentTrack = ii;
+      return baseXY;
+    }
+  }
+  return hiXY;
+}
+
 int Ath__grid::dealloc(int hiXY)
 {
   for (uint ii = _lastFreeTrack; ii <= _searchHiTrack; ii++) {
@@ -1068,6 +1092,25 @@ int Ath__gridTable::couplingCaps(int hiXY,
   return minExtracted;
 }
 
+int Ath__gridTable::skipCouplingCaps(int hiXY, uint couplingDist, uint dir)
+{
+  setCCFlag(couplingDist);
+
+  int minExtracted = hiXY;
+  for (uint jj = 1; jj < _colCnt; jj++) {
+    Ath__grid* netGrid = _gridTable[dir][jj];
+    if (netGrid == nullptr) {
+      continue;
+    }
+
+    const int lastExtracted1 = netGrid->skipCouplingCaps(hiXY, couplingDist);
+    if (minExtracted > lastExtracted1) {
+      minExtracted = lastExtracted1;
+    }
+  }
+  return minExtracted;
+}
+
 int Ath__grid::initCouplingCapLoops(uint couplingDist,
                                     rcx::CoupleAndCompute coupleAndCompute,
                                     void* compPtr,
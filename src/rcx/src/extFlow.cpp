@@ -30,6 +30,7 @@
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
 // POSSIBILITY OF SUCH DAMAGE.
 
+#include <algorithm>
 #include <map>
 #include <vector>
 
@@ -828,6 +829,130 @@ uint extMain::addSignalNets(uint dir,
   return cnt;
 }
 
+void extMain::getBandShapes(uint dir,
+                            int bandLo,
+                            const std::vector<int>& bandHi,
+                            uint pwrtype,
+                            uint sigtype,
+                            const Rect* clip,
+                            std::vector<std::vector<extBandShape>>& bandShapes)
+{
+  bandShapes.clear();
+  bandShapes.resize(bandHi.size());
+
+  // Band i holds the wires starting in [bandHi[i-1], bandHi[i]); this is
+  // the same test isIncludedInsearch applies to the band limits.
+  auto getBand = [&](Rect& r) {
+    if (!matchDir(dir, r)) {
+      return -1;
+    }
+    if (clip != nullptr) {
+      if (!clip->intersects(r)) {
+        return -1;
+      }
+      r = r.intersect(*clip);
+    }
+    const int xy = dir ? r.yMin() : r.xMin();
+    if (xy < bandLo) {
+      return -1;
+    }
+    const auto it = std::upper_bound(bandHi.begin(), bandHi.end(), xy);
+    if (it == bandHi.end()) {
+      return -1;
+    }
+    return (int) (it - bandHi.begin());
+  };
+
+  // Power wires go first so each band is added to the search grid in the
+  // same order as addPowerNets followed by addSignalNets.
+  for (dbNet* net : _block->getNets()) {
+    if (!net->getSigType().isSupply()) {
+      continue;
+    }
+    for (dbSWire* swire : net->getSWires()) {
+      for (dbSBox* s : swire->getWires()) {
+        if (s->isVia()) {
+          continue;
+        }
+        Rect r = s->getBox();
+        const int band = getBand(r);
+        if (band < 0) {
+          continue;
+        }
+        const uint level = s->getTechLayer()->getRoutingLevel();
+        bandShapes[band].push_back({r, level, s->getId(), 0, pwrtype, false});
+      }
+    }
+  }
+
+  for (dbNet* net : _block->getNets()) {
+    if (net->getSigType().isSupply()) {
+      continue;
+    }
+    dbWire* wire = net->getWire();
+    if (wire == nullptr) {
+      continue;
+    }
+    dbWireShapeItr shapes;
+    dbShape s;
+    for (shapes.begin(wire); shapes.next(s);) {
+      if (s.isVia()) {
+        continue;
+      }
+      Rect r = s.getBox();
+      const int band = getBand(r);
+      if (band < 0) {
+        continue;
+      }
+      const uint level = s.getTechLayer()->getRoutingLevel();
+      const uint shapeId = shapes.getShapeId();
+      bandShapes[band].push_back(
+          {r, level, net->getId(), shapeId, sigtype, true});
+    }
+  }
+}
+
+uint extMain::addBandShapes(Ath__gridTable* search,
+                            const std::vector<extBandShape>& shapes)
+{
+  for (const extBandShape& shape : shapes) {
+    const Rect& r = shape._rect;
+    const uint trackNum = search->addBox(r.xMin(),
+                                         r.yMin(),
+                                         r.xMax(),
+                                         r.yMax(),
+                                         shape._level,
+                                         shape._id,
+                                         shape._shapeId,
+                                         shape._wtype);
+    if (shape._signal && shape._id == _debug_net_id) {
+      debugPrint(logger_,
+                 RCX,
+                 "debug_net",
+                 1,
+                 "\t[Search:W]"
+                 "\tonSearch: tr={} L{}  DX={} DY={} {} {}  {} {} -- {:.3f} "
+                 "{:.3f}  {:.3f} {:.3f} net {}",
+                 trackNum,
+                 shape._level,
+                 r.dx(),
+                 r.dy(),
+                 r.xMin(),
+                 r.yMin(),
+                 r.xMax(),
+                 r.yMax(),
+                 GetDBcoords1(r.xMin()),
+                 GetDBcoords1(r.yMin()),
+                 GetDBcoords1(r.xMax()),
+                 GetDBcoords1(r.yMax()),
+                 shape._id);
+    }
+  }
+  search->adjustOverlapMakerEnd();
+
+  return shapes.size();
+}
+
 void extMain::resetNetSpefFlag(Ath__array1D<uint>* tmpNetIdTable)
 {
   for (uint ii = 0; ii < tmpNetIdTable->getCnt(); ii++) {
@@ -1044,7 +1169,8 @@ int extMain::getXY_gs(int base, int XY, uint minRes)
   return v;
 }
 
-uint extMain::initPlanes(uint dir,
+uint extMain::initPlanes(gs* geomSeq,
+                         uint dir,
                          int* wLL,
                          int* wUR,
                          uint layerCnt,
@@ -1055,12 +1181,7 @@ uint extMain::initPlanes(uint dir,
 {
   bool rotatedFlag = getRotatedFlag();
 
-  {
-    delete _geomSeq;
-  }
-  _geomSeq = new gs(_seqPool);
-
-  _geomSeq->set_slices(layerCnt);
+  geomSeq->set_slices(layerCnt);
 
   for (uint ii = 1; ii < layerCnt; ii++) {
     uint layerDir = dirTable[ii];
@@ -1082,18 +1203,18 @@ uint extMain::initPlanes(uint dir,
     ur[dir] = getXY_gs(bb_ll[dir], wUR[dir], res[dir]);
 
     if (!rotatedFlag) {
-      _geomSeq->configureSlice(ii, res[0], res[1], ll[0], ll[1], ur[0], ur[1]);
+      geomSeq->configureSlice(ii, res[0], res[1], ll[0], ll[1], ur[0], ur[1]);
     } else {
       if (dir > 0) {  // horizontal segment extraction
-        _geomSeq->configureSlice(
+        geomSeq->configureSlice(
             ii, res[0], res[1], ll[0], ll[1], ur[0], ur[1]);
       } else {
         if (layerDir > 0) {
-          _geomSeq->configureSlice(
+          geomSeq->configureSlice(
               ii, pitchTable[ii], widthTable[ii], ll[1], ll[0], ur[1], ur[0]);
 
         } else {
-          _geomSeq->configureSlice(
+          geomSeq->configureSlice(
               ii, widthTable[ii], pitchTable[ii], ll[1], ll[0], ur[1], ur[0]);
         }
       }
@@ -1114,49 +1235,104 @@ bool extMain::enableRotatedFlag()
   return _rotatedGs;
 }
 
-uint extMain::fill_gs4(int dir,
-                       int* ll,
-                       int* ur,
-                       int* lo_gs,
-                       int* hi_gs,
-                       uint layerCnt,
-                       uint* dirTable,
-                       uint* pitchTable,
-                       uint* widthTable)
+void extMain::getGsShapes(int dir,
+                          bool gsRotated,
+                          const Rect* clip,
+                          std::vector<std::vector<Rect>>& gsShapes)
 {
-  bool rotatedGs = getRotatedFlag();
-
-  initPlanes(dir, lo_gs, hi_gs, layerCnt, pitchTable, widthTable, dirTable, ll);
+  gsShapes.clear();
 
-  const int gs_dir = dir;
-
-  uint pcnt = 0;
-  dbSet<dbNet> nets = _block->getNets();
-  dbSet<dbNet>::iterator net_itr;
-
-  for (net_itr = nets.begin(); net_itr != nets.end(); ++net_itr) {
-    dbNet* net = *net_itr;
+  // Same filtering and coordinate swap as addShapeOnGS.
+  auto addShape = [&](Rect r, dbTechLayer* layer, bool plane) {
+    if (!plane && matchDir(dir, r)) {
+      return;
+    }
+    if (clip != nullptr) {
+      if (!clip->intersects(r)) {
+        return;
+      }
+      r = r.intersect(*clip);
+    }
+    if (gsRotated && dir == 0) {
+      r.init(r.yMin(), r.xMin(), r.yMax(), r.xMax());
+    }
+    const uint level = layer->getRoutingLevel();
+    if (level >= gsShapes.size()) {
+      gsShapes.resize(level + 1);
+    }
+    gsShapes[level].push_back(r);
+  };
 
-    if (!((net->getSigType().isSupply()))) {
+  for (dbNet* net : _block->getNets()) {
+    if (!net->getSigType().isSupply()) {
       continue;
     }
-
-    pcnt += addNetSboxesGs(net, rotatedGs, !dir, gs_dir);
+    for (dbSWire* swire : net->getSWires()) {
+      for (dbSBox* s : swire->getWires()) {
+        if (s->isVia()) {
+          continue;
+        }
+        addShape(s->getBox(), s->getTechLayer(), true);
+      }
+    }
   }
 
-  uint scnt = 0;
-
-  for (net_itr = nets.begin(); net_itr != nets.end(); ++net_itr) {
-    dbNet* net = *net_itr;
-
-    if ((net->getSigType().isSupply())) {
+  for (dbNet* net : _block->getNets()) {
+    if (net->getSigType().isSupply()) {
       continue;
     }
+    dbWire* wire = net->getWire();
+    if (wire == nullptr) {
+      continue;
+    }
+    const bool plane = net->getSigType() == dbSigType::ANALOG;
+    dbWireShapeItr shapes;
+    dbShape s;
+    for (shapes.begin(wire); shapes.next(s);) {
+      if (s.isVia()) {
+        continue;
+      }
+      addShape(s.getBox(), s.getTechLayer(), plane);
+    }
+  }
+}
 
-    scnt += addNetShapesGs(net, rotatedGs, !dir, gs_dir);
+uint extMain::fill_gs4(gs* geomSeq,
+                       int dir,
+                       int* ll,
+                       int* ur,
+                       int* lo_gs,
+                       int* hi_gs,
+                       uint layerCnt,
+                       uint* dirTable,
+                       uint* pitchTable,
+                       uint* widthTable,
+                       const std::vector<std::vector<Rect>>& gsShapes)
+{
+  initPlanes(geomSeq,
+             dir,
+             lo_gs,
+             hi_gs,
+             layerCnt,
+             pitchTable,
+             widthTable,
+             dirTable,
+             ll);
+
+  // Every level is rendered into its own slice and painting only sets
+  // pixels, so the slices can be filled in parallel in any order.
+  uint cnt = 0;
+#pragma omp parallel for num_threads(_threadCnt) schedule(dynamic, 1) \
+    reduction(+ : cnt)
+  for (int level = 0; level < (int) gsShapes.size(); level++) {
+    for (const Rect& r : gsShapes[level]) {
+      if (geomSeq->box(r.xMin(), r.yMin(), r.xMax(), r.yMax(), level) == 0) {
+        cnt++;
+      }
+    }
   }
 
-  return pcnt + scnt;
+  return cnt;
 }
 
 uint extMain::couplingFlow(Rect& extRect,
@@ -1193,11 +1369,6 @@ uint extMain::couplingFlow(Rect& extRect,
   ur[0] = extRect.xMax();
   ur[1] = extRect.yMax();
 
-  int lo_gs[2];
-  int hi_gs[2];
-  int lo_sdb[2];
-  int hi_sdb[2];
-
   Ath__overlapAdjust overlapAdj = Z_noAdjust;
   _useDbSdb = true;
   _search->setExtControl(_block,
@@ -1235,7 +1406,7 @@ uint extMain::couplingFlow(Rect& extRect,
   minRes[1] = pitchTable[1];
   minRes[0] = widthTable[1];
 
-  const uint trackStep = 1000;
+  const uint trackStep = _couplingBandTracks;
   uint step_nm[2];
   step_nm[1] = trackStep * minRes[1];
   step_nm[0] = trackStep * minRes[1];
@@ -1271,107 +1442,395 @@ uint extMain::couplingFlow(Rect& extRect,
       enableRotatedFlag();
     }
 
-    lo_gs[!dir] = ll[!dir];
-    hi_gs[!dir] = ur[!dir];
-    lo_sdb[!dir] = ll[!dir];
-    hi_sdb[!dir] = ur[!dir];
+    extBandSweep sweep;
+    sweep._dir = dir;
+    sweep._ll[0] = ll[0];
+    sweep._ll[1] = ll[1];
+    sweep._ur[0] = ur[0];
+    sweep._ur[1] = ur[1];
+    sweep._layerCnt = layerCnt;
+    sweep._dirTable = dirTable;
+    sweep._pitchTable = pitchTable;
+    sweep._widthTable = widthTable;
+    sweep._maxPitch = maxPitch;
 
-    int gs_limit = ll[dir];
-
-    _search->initCouplingCapLoops(dir, ccFlag, coupleAndCompute, m);
-
-    lo_sdb[dir] = ll[dir] - step_nm[dir];
     int hiXY = ll[dir] + step_nm[dir];
     if (hiXY > ur[dir]) {
       hiXY = ur[dir];
     }
-
-    uint stepNum = 0;
     for (; hiXY <= ur[dir]; hiXY += step_nm[dir]) {
       if (ur[dir] - hiXY <= (int) step_nm[dir]) {
         hiXY = ur[dir] + 5 * ccDist * maxPitch;
       }
+      sweep._bandHi.push_back(hiXY);
+    }
+
+    // Read the wires of this direction from the db once instead of
+    // rescanning every net for each band.
+    // An incremental run only sweeps a window of the die, so wires are
+    // clipped to it to keep the search grid from clamping them onto its
+    // edge tracks.
+    const Rect* clip = _incrExtract ? &extRect : nullptr;
+    getBandShapes(dir,
+                  ll[dir] - step_nm[dir],
+                  sweep._bandHi,
+                  pwrtype,
+                  sigtype,
+                  clip,
+                  sweep._bandShapes);
+    getGsShapes(dir, getRotatedFlag(), clip, sweep._gsShapes);
+
+    const int bandCnt = sweep._bandHi.size();
+    const int threadCnt = std::min(_threadCnt, bandCnt);
+    if (threadCnt < 2 || _getBandWire || _printBandInfo) {
+      sweepCouplingBands(sweep,
+                         ccFlag,
+                         0,
+                         bandCnt,
+                         _search,
+                         m,
+                         limitArray,
+                         coupleAndCompute,
+                         nullptr,
+                         bandinfo,
+                         totWireCnt,
+                         totalWiresExtracted);
+      continue;
+    }
+
+    // Every thread sweeps a strip of consecutive bands in a search grid of
+    // its own. The db updates of the bands are applied afterwards in band
+    // order, so the result does not depend on the thread count.
+    std::vector<extRCUpdates> bandUpdates(bandCnt);
+    std::vector<extCouplingThread> threads(threadCnt);
+#pragma omp parallel for num_threads(threadCnt) schedule(static, 1)
+    for (int ii = 0; ii < threadCnt; ii++) {
+      extCouplingThread& thread = threads[ii];
+      initCouplingThread(thread, layerCnt, pitchTable, baseX, baseY);
+      uint threadWiresExtracted = 0;
+      sweepCouplingBands(sweep,
+                         ccFlag,
+                         bandCnt * ii / threadCnt,
+                         bandCnt * (ii + 1) / threadCnt,
+                         thread._search,
+                         thread._m,
+                         thread._limitArray,
+                         coupleAndCompute,
+                         &bandUpdates,
+                         nullptr,
+                         totWireCnt,
+                         threadWiresExtracted);
+    }
+
+    for (int band = 0; band < bandCnt; band++) {
+      bandUpdates[band].apply(this);
+      reportCouplingProgress(
+          sweep._bandShapes[band].size(), totWireCnt, totalWiresExtracted);
+    }
+    for (extCouplingThread& thread : threads) {
+      m->_totCCcnt += thread._m->_totCCcnt;
+      m->_totSmallCCcnt += thread._m->_totSmallCCcnt;
+      m->_totBigCCcnt += thread._m->_totBigCCcnt;
+      m->_totSegCnt += thread._m->_totSegCnt;
+      m->_totSignalSegCnt += thread._m->_totSignalSegCnt;
+      removeCouplingThread(thread, layerCnt);
+    }
+  }
+  if (_printBandInfo) {
+    fclose(bandinfo);
+  }
+
+  for (uint jj = 0; jj < layerCnt; jj++) {
+    delete[] limitArray[jj];
+  }
+  delete[] limitArray;
+
+  return 0;
+}
+
+// Sweeps the bands [firstBand, lastBand) of one direction through search.
+// The wires of the bands before firstBand are only added and released
+// again, which leaves the search grid as a serial sweep has it at
+// firstBand. With bandUpdates the db updates of each band are recorded
+// there instead of applied.
+void extMain::sweepCouplingBands(extBandSweep& sweep,
+                                 uint ccFlag,
+                                 uint firstBand,
+                                 uint lastBand,
+                                 Ath__gridTable* search,
+                                 extMeasure* m,
+                                 int** limitArray,
+                                 CoupleAndCompute coupleAndCompute,
+                                 std::vector<extRCUpdates>* bandUpdates,
+                                 FILE* bandinfo,
+                                 uint totWireCnt,
+                                 uint& totalWiresExtracted)
+{
+  const uint dir = sweep._dir;
+  const uint ccDist = ccFlag;
+  const uint maxPitch = sweep._maxPitch;
+
+  int lo_gs[2];
+  int hi_gs[2];
+  lo_gs[!dir] = sweep._ll[!dir];
+  hi_gs[!dir] = sweep._ur[!dir];
 
+  int gs_limit = sweep._ll[dir];
+
+  search->initCouplingCapLoops(dir, ccFlag, coupleAndCompute, m);
+
+  gs* geomSeq = nullptr;
+  for (uint stepNum = 0; stepNum < lastBand; stepNum++) {
+    const int hiXY = sweep._bandHi[stepNum];
+    const int extractLimit = hiXY - ccDist * maxPitch;
+
+    int minExtracted;
+    uint processWireCnt;
+    if (stepNum < firstBand) {
+      processWireCnt = addBandShapes(search, sweep._bandShapes[stepNum]);
+      minExtracted = search->skipCouplingCaps(extractLimit, ccFlag, dir);
+    } else {
       lo_gs[dir] = gs_limit;
       hi_gs[dir] = hiXY;
 
-      fill_gs4(dir,
-               ll,
-               ur,
+      delete geomSeq;
+      geomSeq = new gs(m->_seqPool);
+      fill_gs4(geomSeq,
+               dir,
+               sweep._ll,
+               sweep._ur,
                lo_gs,
                hi_gs,
-               layerCnt,
-               dirTable,
-               pitchTable,
-               widthTable);
+               sweep._layerCnt,
+               sweep._dirTable,
+               sweep._pitchTable,
+               sweep._widthTable,
+               sweep._gsShapes);
 
       m->_rotatedGs = getRotatedFlag();
-      m->_pixelTable = _geomSeq;
-
-      // add wires onto search such that    loX<=loX<=hiX
-      hi_sdb[dir] = hiXY;
-
-      uint processWireCnt = 0;
-      processWireCnt += addPowerNets(dir, lo_sdb, hi_sdb, pwrtype);
-      processWireCnt += addSignalNets(dir, lo_sdb, hi_sdb, sigtype);
+      m->_pixelTable = geomSeq;
 
-      uint extractedWireCnt = 0;
-      int extractLimit = hiXY - ccDist * maxPitch;
-      const int minExtracted = _search->couplingCaps(extractLimit,
-                                                     ccFlag,
-                                                     dir,
-                                                     extractedWireCnt,
-                                                     coupleAndCompute,
-                                                     m,
-                                                     _getBandWire,
-                                                     limitArray);
-
-      int deallocLimit = minExtracted - (ccDist + 1) * maxPitch;
-      if (_printBandInfo) {
-        fprintf(bandinfo,
-                "    step %d  hiXY=%d extLimit=%d minExtracted=%d "
-                "deallocLimit=%d\n",
-                stepNum,
-                hiXY,
-                extractLimit,
-                minExtracted,
-                deallocLimit);
+      processWireCnt = addBandShapes(search, sweep._bandShapes[stepNum]);
+      if (bandUpdates != nullptr) {
+        m->_rcUpdates = &(*bandUpdates)[stepNum];
+      } else {
+        std::vector<extBandShape>().swap(sweep._bandShapes[stepNum]);
       }
-      _search->dealloc(dir, deallocLimit);
 
-      lo_sdb[dir] = hiXY;
-      gs_limit = minExtracted - (ccDist + 2) * maxPitch;
+      uint extractedWireCnt = 0;
+      minExtracted = search->couplingCaps(extractLimit,
+                                          ccFlag,
+                                          dir,
+                                          extractedWireCnt,
+                                          coupleAndCompute,
+                                          m,
+                                          _getBandWire,
+                                          limitArray);
+    }
 
-      stepNum++;
-      totalWiresExtracted += processWireCnt;
-      float percent_extracted
-          = lround(100.0 * (1.0 * totalWiresExtracted / totWireCnt));
+    int deallocLimit = minExtracted - (ccDist + 1) * maxPitch;
+    if (bandinfo != nullptr) {
+      fprintf(bandinfo,
+              "    step %d  hiXY=%d extLimit=%d minExtracted=%d "
+              "deallocLimit=%d\n",
+              stepNum,
+              hiXY,
+              extractLimit,
+              minExtracted,
+              deallocLimit);
+    }
+    search->dealloc(dir, deallocLimit);
 
-      if ((totWireCnt > 0) && (totalWiresExtracted > 0)
-          && (percent_extracted - _previous_percent_extracted >= 5.0)) {
-        logger_->info(RCX,
-                      442,
-                      "{:d}% completion -- {:d} wires have been extracted",
-                      (int) (100.0 * (1.0 * totalWiresExtracted / totWireCnt)),
-                      totalWiresExtracted);
+    gs_limit = minExtracted - (ccDist + 2) * maxPitch;
 
-        _previous_percent_extracted = percent_extracted;
-      }
+    if (bandUpdates == nullptr) {
+      reportCouplingProgress(processWireCnt, totWireCnt, totalWiresExtracted);
     }
   }
-  if (_printBandInfo) {
-    fclose(bandinfo);
+  m->_rcUpdates = nullptr;
+  m->_pixelTable = nullptr;
+  delete geomSeq;
+}
+
+void extMain::reportCouplingProgress(uint wireCnt,
+                                     uint totWireCnt,
+                                     uint& totalWiresExtracted)
+{
+  totalWiresExtracted += wireCnt;
+  float percent_extracted
+      = lround(100.0 * (1.0 * totalWiresExtracted / totWireCnt));
+
+  if ((totWireCnt > 0) && (totalWiresExtracted > 0)
+      && (percent_extracted - _previous_percent_extracted >= 5.0)) {
+    logger_->info(RCX,
+                  442,
+                  "{:d}% completion -- {:d} wires have been extracted",
+                  (int) (100.0 * (1.0 * totalWiresExtracted / totWireCnt)),
+                  totalWiresExtracted);
+
+    _previous_percent_extracted = percent_extracted;
+  }
+}
+
+void extMain::setupCouplingMeasure(extMeasure* m)
+{
+  m->_extMain = this;
+  m->_block = _block;
+  m->_diagFlow = _diagFlow;
+
+  m->_resFactor = _resFactor;
+  m->_resModify = _resModify;
+  m->_ccFactor = _ccFactor;
+  m->_ccModify = _ccModify;
+  m->_gndcFactor = _gndcFactor;
+  m->_gndcModify = _gndcModify;
+
+  m->_dgContextArray = _dgContextArray;
+  m->_dgContextDepth = &_dgContextDepth;
+  m->_dgContextPlanes = &_dgContextPlanes;
+  m->_dgContextTracks = &_dgContextTracks;
+  m->_dgContextBaseLvl = &_dgContextBaseLvl;
+  m->_dgContextLowLvl = &_dgContextLowLvl;
+  m->_dgContextHiLvl = &_dgContextHiLvl;
+  m->_dgContextBaseTrack = _dgContextBaseTrack;
+  m->_dgContextLowTrack = _dgContextLowTrack;
+  m->_dgContextHiTrack = _dgContextHiTrack;
+  m->_dgContextTrackBase = _dgContextTrackBase;
+  m->_dgContextCnt = 0;
+
+  m->_ccContextArray = _ccContextArray;
+
+  m->_pixelTable = _geomSeq;
+  m->_minModelIndex = 0;  // couplimg threshold will be appled to this cap
+  m->_maxModelIndex = 0;
+  m->_currentModel = _currentModel;
+  m->_diagModel = _currentModel[0].getDiagModel();
+  for (uint ii = 0; ii < _modelMap.getCnt(); ii++) {
+    uint jj = _modelMap.get(ii);
+    m->_metRCTable.add(_currentModel->getMetRCTable(jj));
   }
+  const uint techLayerCnt = getExtLayerCnt(_tech) + 1;
+  const uint modelLayerCnt = _currentModel->getLayerCnt();
+  m->_layerCnt = techLayerCnt < modelLayerCnt ? techLayerCnt : modelLayerCnt;
+  if (techLayerCnt == 5 && modelLayerCnt == 8) {
+    m->_layerCnt = modelLayerCnt;
+  }
+  m->getMinWidth(_tech);
+  m->allocOUpool();
 
-  delete _geomSeq;
-  _geomSeq = nullptr;
+  m->_debugFP = nullptr;
+  m->_netId = 0;
+}
 
+void extMain::initCouplingThread(extCouplingThread& thread,
+                                 uint layerCnt,
+                                 uint* pitchTable,
+                                 const int* baseX,
+                                 const int* baseY)
+{
+  Rect searchRect(
+      _search->xMin(), _search->yMin(), _search->xMax(), _search->yMax());
+  thread._search = new Ath__gridTable(&searchRect,
+                                      2,
+                                      _search->getColCnt(),
+                                      nullptr,
+                                      pitchTable,
+                                      nullptr,
+                                      baseX,
+                                      baseY);
+  thread._search->setBlock(_block);
+
+  thread._dgContextArray = new Ath__array1D<SEQ*>**[_dgContextPlanes];
+  thread._dgContextBaseTrack = new uint[_dgContextPlanes];
+  thread._dgContextLowTrack = new int[_dgContextPlanes];
+  thread._dgContextHiTrack = new int[_dgContextPlanes];
+  thread._dgContextTrackBase = new int*[_dgContextPlanes];
+  for (uint jj = 0; jj < _dgContextPlanes; jj++) {
+    thread._dgContextTrackBase[jj] = new int[1024];
+    thread._dgContextArray[jj] = new Ath__array1D<SEQ*>*[_dgContextTracks];
+    for (uint tt = 0; tt < _dgContextTracks; tt++) {
+      thread._dgContextArray[jj][tt] = new Ath__array1D<SEQ*>(1024);
+    }
+  }
+  if (_ccContextArray != nullptr) {
+    const uint extLayerCnt = getExtLayerCnt(_tech);
+    thread._ccContextArray = new Ath__array1D<int>*[extLayerCnt + 1];
+    thread._ccContextArray[0] = nullptr;
+    for (uint ii = 1; ii <= extLayerCnt; ii++) {
+      thread._ccContextArray[ii] = new Ath__array1D<int>(1024);
+    }
+  }
+  thread._limitArray = new int*[layerCnt];
   for (uint jj = 0; jj < layerCnt; jj++) {
-    delete[] limitArray[jj];
+    thread._limitArray[jj] = new int[10];
   }
-  delete[] limitArray;
 
-  return 0;
+  extMeasure* m = new extMeasure(logger_);
+  setupCouplingMeasure(m);
+  m->_dgContextArray = thread._dgContextArray;
+  m->_dgContextBaseLvl = &thread._dgContextBaseLvl;
+  m->_dgContextLowLvl = &thread._dgContextLowLvl;
+  m->_dgContextHiLvl = &thread._dgContextHiLvl;
+  m->_dgContextBaseTrack = thread._dgContextBaseTrack;
+  m->_dgContextLowTrack = thread._dgContextLowTrack;
+  m->_dgContextHiTrack = thread._dgContextHiTrack;
+  m->_dgContextTrackBase = thread._dgContextTrackBase;
+  m->_ccContextArray = thread._ccContextArray;
+  thread._m = m;
+
+  thread._search->setExtControl(_block,
+                                _useDbSdb,
+                                (uint) Z_noAdjust,
+                                _CCnoPowerSource,
+                                _CCnoPowerTarget,
+                                _ccUp,
+                                _allNet,
+                                _ccContextDepth,
+                                thread._ccContextArray,
+                                thread._dgContextArray,
+                                &_dgContextDepth,
+                                &_dgContextPlanes,
+                                &_dgContextTracks,
+                                &thread._dgContextBaseLvl,
+                                &thread._dgContextLowLvl,
+                                &thread._dgContextHiLvl,
+                                thread._dgContextBaseTrack,
+                                thread._dgContextLowTrack,
+                                thread._dgContextHiTrack,
+                                thread._dgContextTrackBase,
+                                m->_seqPool);
+}
+
+void extMain::removeCouplingThread(extCouplingThread& thread, uint layerCnt)
+{
+  delete thread._search;
+  delete thread._m;
+
+  for (uint jj = 0; jj < _dgContextPlanes; jj++) {
+    delete[] thread._dgContextTrackBase[jj];
+    for (uint tt = 0; tt < _dgContextTracks; tt++) {
+      delete thread._dgContextArray[jj][tt];
+    }
+    delete[] thread._dgContextArray[jj];
+  }
+  delete[] thread._dgContextTrackBase;
+  delete[] thread._dgContextArray;
+  delete[] thread._dgContextBaseTrack;
+  delete[] thread._dgContextLowTrack;
+  delete[] thread._dgContextHiTrack;
+
+  if (thread._ccContextArray != nullptr) {
+    const uint extLayerCnt = getExtLayerCnt(_tech);
+    for (uint ii = 1; ii <= extLayerCnt; ii++) {
+      delete thread._ccContextArray[ii];
+    }
+    delete[] thread._ccContextArray;
+  }
+
+  for (uint jj = 0; jj < layerCnt; jj++) {
+    delete[] thread._limitArray[jj];
+  }
+  delete[] thread._limitArray;
 }
 
 dbRSeg* extMain::getRseg(dbNet* net, uint shapeId, Logger* logger)
@@ -0,0 +1,371 @@
+///////////////////////////////////////////////////////////////////////////////
+// BSD 3-Clause License
+//
+// Copyright (c) 2019, Nefelus Inc
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice, this
+//   list of conditions and the following disclaimer.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+//
+// * Neither the name of the copyright holder nor the names of its
+//   contributors may be used to endorse or promote products derived from
+//   this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "rcx/extRCap.h"
+#include "utl/Logger.h"
+
+namespace rcx {
+
+using odb::dbBlock;
+using odb::dbBTerm;
+using odb::dbITerm;
+using odb::dbNet;
+using odb::dbSet;
+using odb::dbShape;
+using odb::dbTechLayer;
+using odb::dbWire;
+using odb::dbWireShapeItr;
+using odb::Rect;
+using utl::RCX;
+
+////////////////////////////////////////////////////////////////
+
+void extNetTracker::attach(dbBlock* block)
+{
+  if (_block != block) {
+    removeOwner();
+    addOwner(block);
+    _block = block;
+  }
+  clear();
+}
+
+bool extNetTracker::isAttached(dbBlock* block) const
+{
+  return hasOwner() && _block == block;
+}
+
+void extNetTracker::clear()
+{
+  _nets.clear();
+  _removedShapes.clear();
+}
+
+void extNetTracker::addNet(dbNet* net)
+{
+  if (net == nullptr || net->getSigType().isSupply()) {
+    return;
+  }
+  _nets.insert(net->getId());
+}
+
+void extNetTracker::addRemovedShapes(dbWire* wire)
+{
+  dbWireShapeItr shapes;
+  dbShape s;
+  for (shapes.begin(wire); shapes.next(s);) {
+    if (!s.isVia()) {
+      _removedShapes.push_back(s.getBox());
+    }
+  }
+}
+
+void extNetTracker::inDbNetDestroy(dbNet* net)
+{
+  _nets.erase(net->getId());
+}
+
+void extNetTracker::inDbITermPostConnect(dbITerm* iterm)
+{
+  addNet(iterm->getNet());
+}
+
+void extNetTracker::inDbITermPreDisconnect(dbITerm* iterm)
+{
+  addNet(iterm->getNet());
+}
+
+void extNetTracker::inDbBTermPostConnect(dbBTerm* bterm)
+{
+  addNet(bterm->getNet());
+}
+
+void extNetTracker::inDbBTermPreDisconnect(dbBTerm* bterm)
+{
+  addNet(bterm->getNet());
+}
+
+void extNetTracker::inDbWireCreate(dbWire* wire)
+{
+  addNet(wire->getNet());
+}
+
+void extNetTracker::inDbWireDestroy(dbWire* wire)
+{
+  addNet(wire->getNet());
+  addRemovedShapes(wire);
+}
+
+void extNetTracker::inDbWirePreModify(dbWire* wire)
+{
+  // The old shapes are gone once the wire is re-encoded; nets next to them
+  // may lose coupling below the threshold that has no cc segment to find.
+  addNet(wire->getNet());
+  addRemovedShapes(wire);
+}
+
+void extNetTracker::inDbWirePostModify(dbWire* wire)
+{
+  addNet(wire->getNet());
+}
+
+void extNetTracker::inDbWirePostAttach(dbWire* wire)
+{
+  addNet(wire->getNet());
+}
+
+void extNetTracker::inDbWirePreDetach(dbWire* wire)
+{
+  addNet(wire->getNet());
+  addRemovedShapes(wire);
+}
+
+void extNetTracker::inDbWirePostAppend(dbWire* /* unused: src */, dbWire* dst)
+{
+  addNet(dst->getNet());
+}
+
+void extNetTracker::inDbWirePostCopy(dbWire* /* unused: src */, dbWire* dst)
+{
+  addNet(dst->getNet());
+}
+
+////////////////////////////////////////////////////////////////
+
+void extMain::trackNetChanges()
+{
+  _netTracker.attach(_block);
+}
+
+int extMain::getCouplingHalo(uint ccFlag)
+{
+  int maxPitch = 0;
+  for (dbTechLayer* layer : _tech->getLayers()) {
+    if (layer->getRoutingLevel() > 0) {
+      maxPitch = std::max(maxPitch, layer->getPitch());
+    }
+  }
+  return ccFlag * maxPitch;
+}
+
+void extMain::getCouplingNeighbors(const std::vector<dbNet*>& nets,
+                                   int halo,
+                                   std::vector<dbNet*>& neighbors)
+{
+  // Bloated shapes of the changed nets, old and new, binned on a coarse
+  // grid so each candidate shape only checks the regions near it.
+  std::vector<Rect> regions;
+  std::set<dbNet*> changed(nets.begin(), nets.end());
+  for (dbNet* net : nets) {
+    dbWire* wire = net->getWire();
+    if (wire == nullptr) {
+      continue;
+    }
+    dbWireShapeItr shapes;
+    dbShape s;
+    for (shapes.begin(wire); shapes.next(s);) {
+      if (!s.isVia()) {
+        regions.push_back(s.getBox());
+      }
+    }
+  }
+  for (const Rect& r : _netTracker.getRemovedShapes()) {
+    regions.push_back(r);
+  }
+  if (regions.empty()) {
+    return;
+  }
+  for (Rect& r : regions) {
+    r.bloat(halo, r);
+  }
+
+  const Rect die = _block->getDieArea();
+  const int binSize = std::max({die.dx() / 1024, die.dy() / 1024, halo, 1});
+  auto getBin = [&](int x, int y) {
+    const int64_t bx = (x - die.xMin()) / binSize;
+    const int64_t by = (y - die.yMin()) / binSize;
+    return (bx << 32) | (by & 0xffffffff);
+  };
+  std::unordered_map<int64_t, std::vector<int>> bins;
+  for (int ii = 0; ii < (int) regions.size(); ii++) {
+    const Rect& r = regions[ii];
+    for (int x = r.xMin(); x <= r.xMax() + binSize - 1; x += binSize) {
+      for (int y = r.yMin(); y <= r.yMax() + binSize - 1; y += binSize) {
+        bins[getBin(std::min(x, r.xMax()), std::min(y, r.yMax()))].push_back(
+            ii);
+      }
+    }
+  }
+
+  auto isNear = [&](const Rect& s) {
+    for (int x = s.xMin(); x <= s.xMax() + binSize - 1; x += binSize) {
+      for (int y = s.yMin(); y <= s.yMax() + binSize - 1; y += binSize) {
+        auto it = bins.find(
+            getBin(std::min(x, s.xMax()), std::min(y, s.yMax())));
+        if (it == bins.end()) {
+          continue;
+        }
+        for (int ii : it->second) {
+          if (regions[ii].intersects(s)) {
+            return true;
+          }
+        }
+      }
+    }
+    return false;
+  };
+
+  for (dbNet* net : _block->getNets()) {
+    if (net->getSigType().isSupply() || changed.count(net) > 0) {
+      continue;
+    }
+    dbWire* wire = net->getWire();
+    if (wire == nullptr) {
+      continue;
+    }
+    dbWireShapeItr shapes;
+    dbShape s;
+    for (shapes.begin(wire); shapes.next(s);) {
+      if (!s.isVia() && isNear(s.getBox())) {
+        neighbors.push_back(net);
+        break;
+      }
+    }
+  }
+}
+
+void extMain::makeIncrementalRCsegs(uint cc_up,
+                                    uint ccFlag,
+                                    double resBound,
+                                    bool mergeViaRes,
+                                    double ccThres,
+                                    int contextDepth,
+                                    const char* extRules)
+{
+  _incrNetIds.clear();
+  if (!_extracted || !_netTracker.isAttached(_block)) {
+    logger_->warn(RCX,
+                  498,
+                  "No previous extraction of {} to update, extracting all "
+                  "nets.",
+                  _block->getConstName());
+    makeBlockRCsegs(nullptr,
+                    cc_up,
+                    ccFlag,
+                    resBound,
+                    mergeViaRes,
+                    ccThres,
+                    contextDepth,
+                    extRules);
+    return;
+  }
+
+  std::set<uint> changedIds = _netTracker.getNets();
+  for (dbNet* net : _block->getNets()) {
+    if (net->isWireAltered() && !net->getSigType().isSupply()) {
+      changedIds.insert(net->getId());
+    }
+  }
+  if (changedIds.empty()) {
+    logger_->info(RCX,
+                  499,
+                  "No nets of {} changed since the last extraction.",
+                  _block->getConstName());
+    return;
+  }
+
+  std::vector<dbNet*> changed;
+  changed.reserve(changedIds.size());
+  for (uint id : changedIds) {
+    changed.push_back(dbNet::getNet(_block, id));
+  }
+
+  // Nets coupled to the old routing are found through their cc segments,
+  // nets coupled to the new routing by proximity.
+  std::vector<dbNet*> neighbors;
+  _block->getCcHaloNets(changed, neighbors);
+  getCouplingNeighbors(changed, getCouplingHalo(ccFlag), neighbors);
+
+  std::set<uint> netIds = changedIds;
+  for (dbNet* net : neighbors) {
+    netIds.insert(net->getId());
+  }
+  std::vector<dbNet*> nets;
+  nets.reserve(netIds.size());
+  for (uint id : netIds) {
+    nets.push_back(dbNet::getNet(_block, id));
+  }
+
+  logger_->info(RCX,
+                500,
+                "Re-extracting {} changed nets and {} coupled nets.",
+                changed.size(),
+                nets.size() - changed.size());
+
+  removeExt(nets);
+
+  _incrExtract = true;
+  makeBlockRCsegs(nullptr,
+                  cc_up,
+                  ccFlag,
+                  resBound,
+                  mergeViaRes,
+                  ccThres,
+                  contextDepth,
+                  extRules,
+                  &nets);
+  _incrExtract = false;
+
+  _incrNetIds.assign(netIds.begin(), netIds.end());
+}
+
+bool extMain::getIncrementalNets(std::vector<dbNet*>& nets)
+{
+  if (_incrNetIds.empty()) {
+    return false;
+  }
+  for (uint id : _incrNetIds) {
+    dbNet* net = dbNet::getValidNet(_block, id);
+    if (net != nullptr) {
+      nets.push_back(net);
+    }
+  }
+  return true;
+}
+
+}  // namespace rcx
@@ -663,7 +663,11 @@ extDistRC* extDistRCTable::getComputeRC(uint dist)
       if (dist <= 2 * lastDist) {  // send Inf dist
 
         uint cnt = _measureTable->getCnt();
-        extDistRC* rc31 = _measureTable->geti(31);
+        // Interpolated into a per-thread copy of the entry so that the
+        // threads of a parallel coupling sweep can share the tables.
+        static thread_local std::map<extDistRCTable*, extDistRC> rc31Copies;
+        extDistRC* rc31 = &rc31Copies[this];
+        *rc31 = *_measureTable->geti(31);
         extDistRC* rc2 = _measureTable->get(cnt - 2);
         extDistRC* rc3 = _measureTable->get(cnt - 3);
 
@@ -442,6 +442,9 @@ void extMain::updateTotalCap(dbRSeg* rseg,
                              double deltaFr,
                              uint modelIndex)
 {
+  if (isFrozen(rseg)) {
+    return;
+  }
   double cap = frCap + ccCap - deltaFr;
 
   double tot = rseg->getCapacitance(modelIndex);
@@ -464,13 +467,13 @@ void extMain::updateTotalRes(dbRSeg* rseg1,
       res *= _resFactor;
     }
 
-    if (rseg1 != nullptr) {
+    if (rseg1 != nullptr && !isFrozen(rseg1)) {
       double tot = rseg1->getResistance(modelIndex);
       tot += res;
 
       rseg1->setResistance(tot, modelIndex);
     }
-    if (rseg2 != nullptr) {
+    if (rseg2 != nullptr && !isFrozen(rseg2)) {
       double tot = rseg2->getResistance(modelIndex);
       tot += res;
 
@@ -486,6 +489,9 @@ void extMain::updateTotalCap(dbRSeg* rseg,
                              bool includeCoupling,
                              bool includeDiag)
 {
+  if (isFrozen(rseg)) {
+    return;
+  }
   double tot, cap;
   int extDbIndex, sci, scDbIdx;
   for (uint modelIndex = 0; modelIndex < modelCnt; modelIndex++) {
@@ -526,6 +532,9 @@ void extMain::updateTotalCap(dbRSeg* rseg,
 
 void extMain::updateCCCap(dbRSeg* rseg1, dbRSeg* rseg2, double ccCap)
 {
+  if (isFrozen(rseg1) && isFrozen(rseg2)) {
+    return;
+  }
   dbCCSeg* ccap
       = dbCCSeg::create(dbCapNode::getCapNode(_block, rseg1->getTargetNode()),
                         dbCapNode::getCapNode(_block, rseg2->getTargetNode()),
@@ -698,6 +707,9 @@ void extMain::measureRC(CoupleOptions& options)
       }
       _totBigCCcnt++;
 
+      if (isFrozen(rseg1) && isFrozen(rseg2)) {
+        return;
+      }
       dbCCSeg* ccap = dbCCSeg::create(
           dbCapNode::getCapNode(_block, rseg1->getTargetNode()),
           dbCapNode::getCapNode(_block, rseg2->getTargetNode()),
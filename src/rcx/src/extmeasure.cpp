@@ -1878,6 +1878,9 @@ void extMeasure::printNet(dbRSeg* rseg, uint netId)
 bool extMain::updateCoupCap(dbRSeg* rseg1, dbRSeg* rseg2, int jj, double v)
 {
   if (rseg1 != nullptr && rseg2 != nullptr) {
+    if (isFrozen(rseg1) && isFrozen(rseg2)) {
+      return true;
+    }
     dbCCSeg* ccap
         = dbCCSeg::create(dbCapNode::getCapNode(_block, rseg1->getTargetNode()),
                           dbCapNode::getCapNode(_block, rseg2->getTargetNode()),
@@ -1913,7 +1916,7 @@ double extMain::calcFringe(extDistRC* rc, double deltaFr, bool includeCoupling)
 
 double extMain::updateTotalCap(dbRSeg* rseg, double cap, uint modelIndex)
 {
-  if (rseg == nullptr) {
+  if (rseg == nullptr || isFrozen(rseg)) {
     return 0;
   }
 
@@ -1950,7 +1953,7 @@ void extDistRC::addRC(extDistRC* rcUnit, uint len, bool addCC)
 
 double extMain::updateRes(dbRSeg* rseg, double res, uint model)
 {
-  if (rseg == nullptr) {
+  if (rseg == nullptr || isFrozen(rseg)) {
     return 0;
   }
 
@@ -1983,7 +1986,7 @@ bool extMeasure::isConnectedToBterm(dbRSeg* rseg1)
   return false;
 }
 
-dbCCSeg* extMeasure::makeCcap(dbRSeg* rseg1, dbRSeg* rseg2, double ccCap)
+bool extMeasure::makeCcap(dbRSeg* rseg1, dbRSeg* rseg2, double ccCap)
 {
   if ((rseg1 != nullptr) && (rseg2 != nullptr)
       && rseg1->getNet() != rseg2->getNet()) {  // signal nets
@@ -1993,21 +1996,157 @@ dbCCSeg* extMeasure::makeCcap(dbRSeg* rseg1, dbRSeg* rseg2, double ccCap)
     if (ccCap >= _extMain->_coupleThreshold) {
       _totBigCCcnt++;
 
+      if (_extMain->isFrozen(rseg1) && _extMain->isFrozen(rseg2)) {
+        return false;
+      }
       dbCapNode* node1 = rseg1->getTargetCapNode();
       dbCapNode* node2 = rseg2->getTargetCapNode();
 
-      return dbCCSeg::create(node1, node2, true);
+      createCCSeg(node1, node2);
+      return true;
     }
     _totSmallCCcnt++;
-    return nullptr;
+    return false;
+  }
+  return false;
+}
+
+void extMeasure::createCCSeg(dbCapNode* node1, dbCapNode* node2)
+{
+  if (_rcUpdates != nullptr) {
+    _rcUpdates->createCCSeg(node1, node2);
+    return;
   }
-  return nullptr;
+  _ccSeg = dbCCSeg::create(node1, node2, true);
 }
 
-void extMeasure::addCCcap(dbCCSeg* ccap, double v, uint model)
+void extMeasure::addCCcap(double v, uint model)
 {
   double coupling = _ccModify ? v * _ccFactor : v;
-  ccap->addCapacitance(coupling, model);
+  if (_rcUpdates != nullptr) {
+    _rcUpdates->addCCCap(coupling, model);
+    return;
+  }
+  _ccSeg->addCapacitance(coupling, model);
+}
+
+void extMeasure::updateTotalCap(dbRSeg* rseg, double cap, uint modelIndex)
+{
+  if (_rcUpdates != nullptr) {
+    _rcUpdates->updateTotalCap(rseg, cap, modelIndex);
+    return;
+  }
+  _extMain->updateTotalCap(rseg, cap, modelIndex);
+}
+
+void extMeasure::updateTotalCap(dbRSeg* rseg,
+                                double frCap,
+                                double ccCap,
+                                double deltaFr,
+                                uint modelIndex)
+{
+  if (_rcUpdates != nullptr) {
+    _rcUpdates->updateTotalCap(rseg, frCap, ccCap, deltaFr, modelIndex);
+    return;
+  }
+  _extMain->updateTotalCap(rseg, frCap, ccCap, deltaFr, modelIndex);
+}
+
+void extMeasure::updateRes(dbRSeg* rseg, double res, uint model)
+{
+  if (_rcUpdates != nullptr) {
+    _rcUpdates->updateRes(rseg, res, model);
+    return;
+  }
+  _extMain->updateRes(rseg, res, model);
+}
+
+void extMeasure::updateCoupCap(dbRSeg* rseg1,
+                               dbRSeg* rseg2,
+                               int jj,
+                               double v)
+{
+  if (_rcUpdates != nullptr) {
+    _rcUpdates->updateCoupCap(rseg1, rseg2, jj, v);
+    return;
+  }
+  _extMain->updateCoupCap(rseg1, rseg2, jj, v);
+}
+
+void extRCUpdates::updateTotalCap(dbRSeg* rseg, double cap, uint modelIndex)
+{
+  _updates.push_back(
+      {TOTAL_CAP, (int) modelIndex, rseg, nullptr, nullptr, nullptr, {cap}});
+}
+
+void extRCUpdates::updateTotalCap(dbRSeg* rseg,
+                                  double frCap,
+                                  double ccCap,
+                                  double deltaFr,
+                                  uint modelIndex)
+{
+  _updates.push_back({TOTAL_CAP_FRINGE,
+                      (int) modelIndex,
+                      rseg,
+                      nullptr,
+                      nullptr,
+                      nullptr,
+                      {frCap, ccCap, deltaFr}});
+}
+
+void extRCUpdates::updateRes(dbRSeg* rseg, double res, uint model)
+{
+  _updates.push_back(
+      {RES, (int) model, rseg, nullptr, nullptr, nullptr, {res}});
+}
+
+void extRCUpdates::updateCoupCap(dbRSeg* rseg1,
+                                 dbRSeg* rseg2,
+                                 int jj,
+                                 double v)
+{
+  _updates.push_back({COUP_CAP, jj, rseg1, rseg2, nullptr, nullptr, {v}});
+}
+
+void extRCUpdates::createCCSeg(dbCapNode* node1, dbCapNode* node2)
+{
+  _updates.push_back({CC_SEG, 0, nullptr, nullptr, node1, node2, {}});
+}
+
+void extRCUpdates::addCCCap(double v, uint model)
+{
+  _updates.push_back(
+      {CC_CAP, (int) model, nullptr, nullptr, nullptr, nullptr, {v}});
+}
+
+void extRCUpdates::apply(extMain* extMain)
+{
+  dbCCSeg* ccSeg = nullptr;
+  for (const Update& update : _updates) {
+    const double* v = update._v;
+    switch (update._kind) {
+      case TOTAL_CAP:
+        extMain->updateTotalCap(update._rseg1, v[0], update._model);
+        break;
+      case TOTAL_CAP_FRINGE:
+        extMain->updateTotalCap(update._rseg1, v[0], v[1], v[2], update._model);
+        break;
+      case RES:
+        extMain->updateRes(update._rseg1, v[0], update._model);
+        break;
+      case COUP_CAP:
+        extMain->updateCoupCap(
+            update._rseg1, update._rseg2, update._model, v[0]);
+        break;
+      case CC_SEG:
+        ccSeg = dbCCSeg::create(update._node1, update._node2, true);
+        break;
+      case CC_CAP:
+        ccSeg->addCapacitance(v[0], update._model);
+        break;
+    }
+  }
+  _updates.clear();
 }
 
 void extMeasure::addFringe(dbRSeg* rseg1,
@@ -2020,11 +2159,11 @@ void extMeasure::addFringe(dbRSeg* rseg1,
   }
 
   if (rseg1 != nullptr) {
-    _extMain->updateTotalCap(rseg1, frCap, model);
+    updateTotalCap(rseg1, frCap, model);
   }
 
   if (rseg2 != nullptr) {
-    _extMain->updateTotalCap(rseg2, frCap, model);
+    updateTotalCap(rseg2, frCap, model);
   }
 }
 
@@ -2065,11 +2204,11 @@ void extMeasure::calcDiagRC(int rsegId1,
     rseg2 = dbRSeg::getRSeg(_block, rsegId2);
   }
 
-  dbCCSeg* ccCap = makeCcap(rseg1, rseg2, capTable[_minModelIndex]);
+  const bool ccCap = makeCcap(rseg1, rseg2, capTable[_minModelIndex]);
 
   for (uint model = 0; model < modelCnt; model++) {
-    if (ccCap != nullptr) {
-      addCCcap(ccCap, capTable[model], model);
+    if (ccCap) {
+      addCCcap(capTable[model], model);
     } else {
       addFringe(nullptr, rseg2, capTable[model], model);
     }
@@ -2087,12 +2226,12 @@ void extMeasure::createCap(int rsegId1, uint rsegId2, double* capTable)
     rseg2 = dbRSeg::getRSeg(_block, rsegId2);
   }
 
-  dbCCSeg* ccCap = makeCcap(rseg1, rseg2, capTable[_minModelIndex]);
+  const bool ccCap = makeCcap(rseg1, rseg2, capTable[_minModelIndex]);
 
   uint modelCnt = _metRCTable.getCnt();
   for (uint model = 0; model < modelCnt; model++) {
-    if (ccCap != nullptr) {
-      addCCcap(ccCap, capTable[model], model);
+    if (ccCap) {
+      addCCcap(capTable[model], model);
     } else {
       _rc[model]->_diag += capTable[model];
       addFringe(nullptr, rseg2, capTable[model], model);
@@ -2122,7 +2261,7 @@ void extMeasure::areaCap(int rsegId1, uint rsegId2, uint len, uint tgtMet)
       extDistRC* area_rc = areaCapOverSub(ii, rcModel);
       _met = met;
       double areaCapOverSub = 2 * area * area_rc->_fringe;
-      _extMain->updateTotalCap(rseg2, 0.0, 0.0, areaCapOverSub, ii);
+      updateTotalCap(rseg2, 0.0, 0.0, areaCapOverSub, ii);
     }
   }
   createCap(rsegId1, rsegId2, capTable);
@@ -2187,10 +2326,10 @@ bool extMeasure::verticalCap(int rsegId1,
       frCap *= scale;
     }
     if (rseg2 != nullptr) {
-      _extMain->updateTotalCap(rseg2, 0.0, 0.0, frCap, ii);
+      updateTotalCap(rseg2, 0.0, 0.0, frCap, ii);
     }
     if (rseg1 != nullptr) {
-      _extMain->updateTotalCap(rseg1, 0.0, 0.0, 0.5 * frCap, ii);
+      updateTotalCap(rseg1, 0.0, 0.0, 0.5 * frCap, ii);
     }
   }
   createCap(rsegId1, rsegId2, capTable);
@@ -2277,24 +2416,24 @@ void extMeasure::calcRC(dbRSeg* rseg1, dbRSeg* rseg2, uint totLenCovered)
       }
 
       if (rseg1 != nullptr) {
-        _extMain->updateRes(rseg1, res, model);
+        updateRes(rseg1, res, model);
       }
 
       if (rseg2 != nullptr) {
-        _extMain->updateRes(rseg2, res, model);
+        updateRes(rseg2, res, model);
       }
 
-      dbCCSeg* ccap = nullptr;
+      bool ccap = false;
       bool includeCoupling = true;
       if ((rseg1 != nullptr) && (rseg2 != nullptr)) {  // signal nets
 
         _totCCcnt++;
 
-        if (_rc[_minModelIndex]->_coupling >= _extMain->_coupleThreshold) {
-          ccap = dbCCSeg::create(
-              dbCapNode::getCapNode(_block, rseg1->getTargetNode()),
-              dbCapNode::getCapNode(_block, rseg2->getTargetNode()),
-              true);
+        if (_rc[_minModelIndex]->_coupling >= _extMain->_coupleThreshold
+            && !(_extMain->isFrozen(rseg1) && _extMain->isFrozen(rseg2))) {
+          createCCSeg(dbCapNode::getCapNode(_block, rseg1->getTargetNode()),
+                      dbCapNode::getCapNode(_block, rseg2->getTargetNode()));
+          ccap = true;
 
           includeCoupling = false;
           _totBigCCcnt++;
@@ -2303,20 +2442,18 @@ void extMeasure::calcRC(dbRSeg* rseg1, dbRSeg* rseg2, uint totLenCovered)
         }
       }
       extDistRC* finalRC = _rc[model];
-      if (ccap != nullptr) {
-        double coupling
-            = _ccModify ? finalRC->_coupling * _ccFactor : finalRC->_coupling;
-        ccap->addCapacitance(coupling, model);
+      if (ccap) {
+        addCCcap(finalRC->_coupling, model);
       }
 
       double frCap = _extMain->calcFringe(finalRC, deltaFr, includeCoupling);
 
       if (rseg1 != nullptr) {
-        _extMain->updateTotalCap(rseg1, frCap, model);
+        updateTotalCap(rseg1, frCap, model);
       }
 
       if (rseg2 != nullptr) {
-        _extMain->updateTotalCap(rseg2, frCap, model);
+        updateTotalCap(rseg2, frCap, model);
       }
     }
   }
@@ -2355,13 +2492,13 @@ void extMeasure::OverSubRC(dbRSeg* rseg1,
     double cap = 0;
     if (lenOverSub > 0) {
       cap = rc->getFringe() * lenOverSub;
-      _extMain->updateTotalCap(rseg1, cap, jj);
+      updateTotalCap(rseg1, cap, jj);
     }
     double res = 0;
     if (!_extMain->_lef_res && !rvia1) {
       if (res_lenOverSub > 0) {
         res = rc->getRes() * res_lenOverSub;
-        _extMain->updateRes(rseg1, res, jj);
+        updateRes(rseg1, res, jj);
       }
     }
     const char* msg = "OverSubRC (No Neighbor)";
@@ -2439,10 +2576,10 @@ void extMeasure::OverSubRC_dist(dbRSeg* rseg1,
 
     if (!_extMain->_lef_res) {
       if (!rvia1) {
-        _extMain->updateRes(rseg1, res, jj);
+        updateRes(rseg1, res, jj);
       }
       if (!rvia2) {
-        _extMain->updateRes(rseg2, res, jj);
+        updateRes(rseg2, res, jj);
       }
     }
 
@@ -2451,15 +2588,15 @@ void extMeasure::OverSubRC_dist(dbRSeg* rseg1,
     if (lenOverSub > 0) {
       if (_sameNetFlag) {
         fr = SUB_MULT * rc->getFringe() * lenOverSub;
-        _extMain->updateTotalCap(rseg1, fr, jj);
+        updateTotalCap(rseg1, fr, jj);
       } else {
         double fr = SUB_MULT * rc->getFringe() * lenOverSub;
-        _extMain->updateTotalCap(rseg1, fr, jj);
-        _extMain->updateTotalCap(rseg2, fr, jj);
+        updateTotalCap(rseg1, fr, jj);
+        updateTotalCap(rseg2, fr, jj);
 
         if (_dist > 0) {  // dist based
           cc = SUB_MULT * rc->getCoupling() * lenOverSub;
-          _extMain->updateCoupCap(rseg1, rseg2, jj, cc);
+          updateCoupCap(rseg1, rseg2, jj, cc);
         }
       }
     }
@@ -2517,7 +2654,7 @@ int extMeasure::computeAndStoreRC(dbRSeg* rseg1, dbRSeg* rseg2, int srcCovered)
 
       if (_rc[jj]->_fringe > 0) {
         ou = true;
-        _extMain->updateTotalCap(rseg1, _rc[jj]->_fringe, jj);
+        updateTotalCap(rseg1, _rc[jj]->_fringe, jj);
       }
       if (ou && IsDebugNet()) {
         _rc[jj]->printDebugRC_values("OverUnder Total Open");
@@ -2544,12 +2681,12 @@ int extMeasure::computeAndStoreRC(dbRSeg* rseg1, dbRSeg* rseg2, int srcCovered)
     bool ou = false;
     if (_rc[jj]->_fringe > 0) {
       ou = true;
-      _extMain->updateTotalCap(rseg1, _rc[jj]->_fringe, jj);
-      _extMain->updateTotalCap(rseg2, _rc[jj]->_fringe, jj);
+      updateTotalCap(rseg1, _rc[jj]->_fringe, jj);
+      updateTotalCap(rseg2, _rc[jj]->_fringe, jj);
     }
     if (_rc[jj]->_coupling > 0) {
       ou = true;
-      _extMain->updateCoupCap(rseg1, rseg2, jj, _rc[jj]->_coupling);
+      updateCoupCap(rseg1, rseg2, jj, _rc[jj]->_coupling);
     }
     if (ou && IsDebugNet()) {
       _rc[jj]->printDebugRC_values("OverUnder Total Dist");
@@ -2671,7 +2808,7 @@ void extMeasure::measureRC(CoupleOptions& options)
       if (totR1 > 0) {
         totR1 -= deltaRes[jj];
         if (totR1 != 0.0) {
-          _extMain->updateRes(rseg1, totR1, jj);
+          updateRes(rseg1, totR1, jj);
         }
       }
     }
@@ -81,7 +81,6 @@ gs::gs(odb::AthPool<SEQ>* pool)
   }
 
   nslices_ = -1;
-  maxslice_ = -1;
 
   seqPool_ = pool;
 }
@@ -226,11 +225,9 @@ int gs::box(int px0, int py0, int px1, int py1, int sl)
     return -1;
   }
 
-  if (sl > maxslice_) {
-    maxslice_ = sl;
-  }
-
-  plc_ = pldata_[sl];
+  // Use a local plane pointer so that boxes on different slices can be
+  // rendered concurrently.
+  const plconfig* plc = pldata_[sl];
 
   // normalize bbox
   if (px0 > px1) {
@@ -240,30 +237,30 @@ int gs::box(int px0, int py0, int px1, int py1, int sl)
     std::swap(py0, py1);
   }
 
-  if (px1 < plc_->x0) {
+  if (px1 < plc->x0) {
     return -1;
   }
-  if (px0 > plc_->x1) {
+  if (px0 > plc->x1) {
     return -1;
   }
-  if (py1 < plc_->y0) {
+  if (py1 < plc->y0) {
     return -1;
   }
-  if (py0 > plc_->y1) {
+  if (py0 > plc->y1) {
     return -1;
   }
 
   // convert to pixel space
-  int cx0 = int((px0 - plc_->x0) / plc_->xres);
-  int cx1 = int((px1 - plc_->x0) / plc_->xres);
-  int cy0 = int((py0 - plc_->y0) / plc_->yres);
-  int cy1 = int((py1 - plc_->y0) / plc_->yres);
+  int cx0 = int((px0 - plc->x0) / plc->xres);
+  int cx1 = int((px1 - plc->x0) / plc->xres);
+  int cy0 = int((py0 - plc->y0) / plc->yres);
+  int cy1 = int((py1 - plc->y0) / plc->yres);
 
   // render a rectangle on the selected slice. Paint all pixels
-  cx0 = clip(cx0, 0, plc_->width);
-  cx1 = clip(cx1, 0, plc_->width);
-  cy0 = clip(cy0, 0, plc_->height);
-  cy1 = clip(cy1, 0, plc_->height);
+  cx0 = clip(cx0, 0, plc->width);
+  cx1 = clip(cx1, 0, plc->width);
+  cy0 = clip(cy0, 0, plc->height);
+  cy1 = clip(cy1, 0, plc->height);
   // now fill in planes object
 
   // xbs = x block start - block the box starts in
@@ -278,14 +275,14 @@ int gs::box(int px0, int py0, int px1, int py1, int sl)
     smask &= emask;
   }
 
-  pixmap* pm = plc_->plane + plc_->pixstride * cy0 + xbs;
+  pixmap* pm = plc->plane + plc->pixstride * cy0 + xbs;
 
   for (int yb = cy0; yb <= cy1; yb++) {
     // start block
     pixmap* pcb = pm;
 
     // for next time through loop - allow compiler time for out-of-order
-    pm += plc_->pixstride;
+    pm += plc->pixstride;
 
     // do "start" block
     pcb->lword = pcb->lword | smask;
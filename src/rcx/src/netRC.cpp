@@ -1571,7 +1571,7 @@ void extMain::makeCornerNameMap()
   updatePrevControl();
 }
 
-bool extMain::setCorners(const char* rulesFileName)
+bool extMain::setCorners(const char* rulesFileName, bool initBlockCorners)
 {
   _modelMap.resetCnt(0);
   uint ii;
@@ -1655,7 +1655,10 @@ bool extMain::setCorners(const char* rulesFileName)
   assert(_cornerCnt == _extDbCnt + scaleCornerCnt);
 #endif
 
-  _block->setCornerCount(_cornerCnt, _extDbCnt, nullptr);
+  // Re-initializing the block corners destroys all existing parasitics.
+  if (initBlockCorners) {
+    _block->setCornerCount(_cornerCnt, _extDbCnt, nullptr);
+  }
   return true;
 }
 
@@ -1715,10 +1718,14 @@ void extMain::makeBlockRCsegs(const char* netNames,
                               bool mergeViaRes,
                               double ccThres,
                               int contextDepth,
-                              const char* extRules)
+                              const char* extRules,
+                              std::vector<dbNet*>* incrNets)
 {
   uint debugNetId = 0;
 
+  // write_spef -incremental only covers the latest incremental extraction
+  _incrNetIds.clear();
+
   _diagFlow = true;
 
   std::vector<dbNet*> inets;
@@ -1745,7 +1752,7 @@ void extMain::makeBlockRCsegs(const char* netNames,
       || ((_processCornerTable == nullptr) && (extRules != nullptr))) {
     const char* rulesfile
         = extRules ? extRules : _prevControl->_ruleFileName.c_str();
-    if (!setCorners(rulesfile)) {
+    if (!setCorners(rulesfile, incrNets == nullptr)) {
       logger_->info(RCX, 128, "skipping Extraction ...");
       return;
     }
@@ -1755,7 +1762,12 @@ void extMain::makeBlockRCsegs(const char* netNames,
   }
   _foreign = false;  // extract after read_spef
 
-  _allNet = !((dbBlock*) _block)->findSomeNet(netNames, inets);
+  if (incrNets != nullptr) {
+    inets = *incrNets;
+    _allNet = false;
+  } else {
+    _allNet = !((dbBlock*) _block)->findSomeNet(netNames, inets);
+  }
 
   if (_ccContextDepth) {
     initContextArray();
@@ -1834,55 +1846,11 @@ void extMain::makeBlockRCsegs(const char* netNames,
                   _coupleThreshold,
                   _coupleThreshold);
 
-    m._extMain = this;
-    m._block = _block;
-    m._diagFlow = _diagFlow;
-
-    m._resFactor = _resFactor;
-    m._resModify = _resModify;
-    m._ccFactor = _ccFactor;
-    m._ccModify = _ccModify;
-    m._gndcFactor = _gndcFactor;
-    m._gndcModify = _gndcModify;
-
-    m._dgContextArray = _dgContextArray;
-    m._dgContextDepth = &_dgContextDepth;
-    m._dgContextPlanes = &_dgContextPlanes;
-    m._dgContextTracks = &_dgContextTracks;
-    m._dgContextBaseLvl = &_dgContextBaseLvl;
-    m._dgContextLowLvl = &_dgContextLowLvl;
-    m._dgContextHiLvl = &_dgContextHiLvl;
-    m._dgContextBaseTrack = _dgContextBaseTrack;
-    m._dgContextLowTrack = _dgContextLowTrack;
-    m._dgContextHiTrack = _dgContextHiTrack;
-    m._dgContextTrackBase = _dgContextTrackBase;
+    setupCouplingMeasure(&m);
     if (ttttPrintDgContext) {
       m._dgContextFile = fopen("dgCtxtFile", "w");
     }
-    m._dgContextCnt = 0;
-
-    m._ccContextArray = _ccContextArray;
-
-    m._pixelTable = _geomSeq;
-    m._minModelIndex = 0;  // couplimg threshold will be appled to this cap
-    m._maxModelIndex = 0;
-    m._currentModel = _currentModel;
-    m._diagModel = _currentModel[0].getDiagModel();
-    for (uint ii = 0; ii < _modelMap.getCnt(); ii++) {
-      uint jj = _modelMap.get(ii);
-      m._metRCTable.add(_currentModel->getMetRCTable(jj));
-    }
-    const uint techLayerCnt = getExtLayerCnt(_tech) + 1;
-    const uint modelLayerCnt = _currentModel->getLayerCnt();
-    m._layerCnt = techLayerCnt < modelLayerCnt ? techLayerCnt : modelLayerCnt;
-    if (techLayerCnt == 5 && modelLayerCnt == 8) {
-      m._layerCnt = modelLayerCnt;
-    }
-    m.getMinWidth(_tech);
-    m.allocOUpool();
 
-    m._debugFP = nullptr;
-    m._netId = 0;
     debugNetId = 0;
     if (debugNetId > 0) {
       m._netId = debugNetId;
@@ -1892,6 +1860,13 @@ void extMain::makeBlockRCsegs(const char* netNames,
     }
 
     Rect maxRect = _block->getDieArea();
+    if (incrNets != nullptr && _ccMinX <= _ccMaxX && _ccMinY <= _ccMaxY) {
+      // Only sweep the window around the re-extracted nets; shapes outside
+      // of it are clipped in couplingFlow.
+      Rect window(_ccMinX, _ccMinY, _ccMaxX, _ccMaxY);
+      window.bloat(2 * getCouplingHalo(ccFlag), window);
+      maxRect = maxRect.intersect(window);
+    }
 
     couplingFlow(maxRect, _couplingFlag, &m, extCompute1);
 
@@ -2135,13 +2110,23 @@ void extMain::writeSPEF(char* filename,
                         int corner,
                         const char* corner_name,
                         const char* spef_version,
-                        bool parallel)
+                        bool parallel,
+                        bool incremental)
 {
   if (_block == nullptr) {
     logger_->info(
         RCX, 475, "Can't execute write_spef command. There's no block in db");
     return;
   }
+  std::vector<dbNet*> inets;
+  if (incremental && !getIncrementalNets(inets)) {
+    logger_->warn(RCX,
+                  501,
+                  "Can't execute write_spef -incremental. There's no "
+                  "incremental extraction of {}.",
+                  _block->getConstName());
+    return;
+  }
   if (!_spef || _spef->getBlock() != _block) {
     delete _spef;
     _spef = new extSpef(_tech, _block, logger_, spef_version, this);
@@ -2182,8 +2167,9 @@ void extMain::writeSPEF(char* filename,
     }
     _spef->_db_ext_corner = n;
 
-    std::vector<dbNet*> inets;
-    ((dbBlock*) _block)->findSomeNet(netNames, inets);
+    if (!incremental) {
+      ((dbBlock*) _block)->findSomeNet(netNames, inets);
+    }
     _spef->writeBlock(nodeCoord,
                       capUnit,
                       resUnit,
@@ -516,6 +516,7 @@ class Ath__grid
                    CoupleAndCompute coupleAndCompute,
                    void* compPtr,
                    int* limitArray);
+  int skipCouplingCaps(int hiXY, uint couplingDist);
   int dealloc(int hiXY);
   void dealloc();
 };
@@ -762,6 +763,7 @@ class Ath__gridTable
                    void* compPtr,
                    bool getBandWire,
                    int** limitArray);
+  int skipCouplingCaps(int hiXY, uint couplingDist, uint dir);
   void initCouplingCapLoops(uint dir,
                             uint couplingDist,
                             CoupleAndCompute coupleAndCompute,
@@ -0,0 +1,65 @@
+# extract_parasitics -incremental after a reroute gives the same SPEF as a
+# full extraction.
+source helpers.tcl
+
+read_lef sky130hs/sky130hs.tlef
+read_lef sky130hs/sky130hs_std_cell.lef
+read_liberty sky130hs/sky130hs_tt.lib
+
+read_def gcd.def
+
+source sky130hs/sky130hs.rc
+
+define_process_corner -ext_model_index 0 X
+extract_parasitics -ext_model_file ext_pattern.rules \
+  -max_res 0 -coupling_threshold 0.1
+
+# Reroute _000_ with its met1 segment moved 3um north, away from the
+# neighbors of the old route.
+set tech [ord::get_db_tech]
+set l1m1 [$tech findVia L1M1_PR_MR]
+set m1m2 [$tech findVia M1M2_PR]
+set wire [[[ord::get_db_block] findNet _000_] getWire]
+set encoder [odb::dbWireEncoder]
+$encoder begin $wire
+$encoder newPath [$tech findLayer li1] "ROUTED"
+$encoder addPoint 202320 128205
+$encoder addTechVia $l1m1
+$encoder addTechVia $m1m2
+$encoder addPoint 202320 133425
+$encoder addTechVia $m1m2
+$encoder addPoint 208080 133425
+$encoder addTechVia $m1m2
+$encoder addPoint 208080 130425
+$encoder addTechVia $m1m2
+$encoder addTechVia $l1m1
+$encoder end
+
+extract_parasitics -ext_model_file ext_pattern.rules \
+  -max_res 0 -coupling_threshold 0.1 -incremental
+set incr_file [make_result_file gcd_incremental.spef]
+write_spef $incr_file
+
+extract_parasitics -ext_model_file ext_pattern.rules \
+  -max_res 0 -coupling_threshold 0.1
+set full_file [make_result_file gcd_incremental_full.spef]
+write_spef $full_file
+
+# SPEF contents without the header lines that change between writes
+proc read_spef_body { file_name } {
+  set stream [open $file_name r]
+  set body {}
+  while { [gets $stream line] >= 0 } {
+    if { ![regexp {^\*(DATE|VERSION)} $line] } {
+      lappend body $line
+    }
+  }
+  close $stream
+  return $body
+}
+
+if { [read_spef_body $incr_file] eq [read_spef_body $full_file] } {
+  puts "pass"
+} else {
+  puts "fail: incremental SPEF differs from the full extraction"
+}
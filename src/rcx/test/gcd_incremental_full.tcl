@@ -0,0 +1,63 @@
+# write_spef -incremental has nothing to write after a full extraction or
+# an incremental one that found no changes.
+source helpers.tcl
+
+read_lef sky130hs/sky130hs.tlef
+read_lef sky130hs/sky130hs_std_cell.lef
+read_liberty sky130hs/sky130hs_tt.lib
+
+read_def gcd.def
+
+source sky130hs/sky130hs.rc
+
+define_process_corner -ext_model_index 0 X
+extract_parasitics -ext_model_file ext_pattern.rules \
+  -max_res 0 -coupling_threshold 0.1
+
+# Move the met1 segment of _000_ 3um north.
+set tech [ord::get_db_tech]
+set l1m1 [$tech findVia L1M1_PR_MR]
+set m1m2 [$tech findVia M1M2_PR]
+set wire [[[ord::get_db_block] findNet _000_] getWire]
+set encoder [odb::dbWireEncoder]
+$encoder begin $wire
+$encoder newPath [$tech findLayer li1] "ROUTED"
+$encoder addPoint 202320 128205
+$encoder addTechVia $l1m1
+$encoder addTechVia $m1m2
+$encoder addPoint 202320 133425
+$encoder addTechVia $m1m2
+$encoder addPoint 208080 133425
+$encoder addTechVia $m1m2
+$encoder addPoint 208080 130425
+$encoder addTechVia $m1m2
+$encoder addTechVia $l1m1
+$encoder end
+
+extract_parasitics -ext_model_file ext_pattern.rules \
+  -max_res 0 -coupling_threshold 0.1 -incremental
+set incr_file [make_result_file gcd_incremental_full_incr.spef]
+file delete $incr_file
+write_spef -incremental $incr_file
+
+extract_parasitics -ext_model_file ext_pattern.rules \
+  -max_res 0 -coupling_threshold 0.1
+set full_file [make_result_file gcd_incremental_full_full.spef]
+file delete $full_file
+write_spef -incremental $full_file
+
+extract_parasitics -ext_model_file ext_pattern.rules \
+  -max_res 0 -coupling_threshold 0.1 -incremental
+set none_file [make_result_file gcd_incremental_full_none.spef]
+file delete $none_file
+write_spef -incremental $none_file
+
+if { ![file exists $incr_file] } {
+  puts "fail: no incremental SPEF after an incremental extraction"
+} elseif { [file exists $full_file] } {
+  puts "fail: incremental SPEF written after a full extraction"
+} elseif { [file exists $none_file] } {
+  puts "fail: incremental SPEF written when no nets changed"
+} else {
+  puts "pass"
+}
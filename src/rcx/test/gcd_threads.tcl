@@ -0,0 +1,43 @@
+# extract_parasitics gives the same SPEF with 1 and 4 threads.
+source helpers.tcl
+
+read_lef sky130hs/sky130hs.tlef
+read_lef sky130hs/sky130hs_std_cell.lef
+read_liberty sky130hs/sky130hs_tt.lib
+
+read_def gcd.def
+
+source sky130hs/sky130hs.rc
+
+define_process_corner -ext_model_index 0 X
+
+# SPEF contents without the header lines that change between writes
+proc read_spef_body { file_name } {
+  set stream [open $file_name r]
+  set body {}
+  while { [gets $stream line] >= 0 } {
+    if { ![regexp {^\*(DATE|VERSION)} $line] } {
+      lappend body $line
+    }
+  }
+  close $stream
+  return $body
+}
+
+# Narrow bands so that the coupling sweep of the small design is split over
+# the threads.
+rcx::set_coupling_band_tracks 50
+
+foreach threads { 1 4 } {
+  set_thread_count $threads
+  extract_parasitics -ext_model_file ext_pattern.rules \
+    -max_res 0 -coupling_threshold 0.1
+  set spef_file($threads) [make_result_file gcd_threads_$threads.spef]
+  write_spef $spef_file($threads)
+}
+
+if { [read_spef_body $spef_file(1)] eq [read_spef_body $spef_file(4)] } {
+  puts "pass"
+} else {
+  puts "fail: SPEF differs between 1 and 4 threads"
+}
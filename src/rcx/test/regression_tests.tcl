@@ -10,4 +10,7 @@ record_tests {
 }
 record_pass_fail_tests {
   rcx_unit_test
+  gcd_incremental
+  gcd_incremental_full
+  gcd_threads
 }
@@ -37,11 +37,13 @@
 
 #include <functional>
 #include <string>
+#include <vector>
 
 #include "db_sta/dbSta.hh"
 #include "rsz/Resizer.hh"
 
 namespace abc {
+typedef struct Abc_Ntk_t_ Abc_Ntk_t;
 }  // namespace abc
 
 namespace utl {
@@ -62,6 +64,9 @@ class dbSta;
 
 namespace rmp {
 
+class Blif;
+struct Gate;
+
 using utl::Logger;
 
 enum class Mode
@@ -95,14 +100,25 @@ class Restructure
   void setMode(const char* mode_name);
   void setTieLoPort(sta::LibertyPort* loport);
   void setTieHiPort(sta::LibertyPort* hiport);
+  void setThreadCount(int threads) { num_threads_ = threads; }
 
  private:
   void deleteComponents();
   void getBlob(unsigned max_depth);
   void runABC();
   void postABC(float worst_slack);
-  bool writeAbcScript(std::string file_name);
-  void writeOptCommands(std::ofstream& script);
+  std::vector<std::string> getAbcCommands(Mode mode,
+                                          const std::string& output_name);
+  void addOptCommands(Mode mode, std::vector<std::string>& commands);
+  int runAbcMode(Blif& blif,
+                 abc::Abc_Ntk_t* network,
+                 Mode mode,
+                 int mode_idx,
+                 std::vector<Gate>& gates);
+  std::vector<int> runAbcModes(Blif& blif,
+                               abc::Abc_Ntk_t* network,
+                               const std::vector<Mode>& modes,
+                               std::vector<std::vector<Gate>>& mode_gates);
   void initDB();
   void getEndPoints(sta::PinSet& ends, bool area_mode, unsigned max_depth);
   int countConsts(odb::dbBlock* top_block);
@@ -124,13 +140,12 @@ class Restructure
   rsz::Resizer* resizer_;
   odb::dbBlock* block_ = nullptr;
 
-  std::string input_blif_file_name_;
-  std::string output_blif_file_name_;
   std::vector<std::string> lib_file_names_;
   std::set<odb::dbInst*> path_insts_;
 
   Mode opt_mode_;
   bool is_area_mode_;
+  int num_threads_ = 1;
 };
 
 }  // namespace rmp
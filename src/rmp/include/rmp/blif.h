@@ -41,6 +41,14 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
+
+#include "rmp/blifParser.h"
+
+namespace abc {
+typedef struct Abc_Ntk_t_ Abc_Ntk_t;
+typedef struct Mio_LibraryStruct_t_ Mio_Library_t;
+}  // namespace abc
 
 namespace ord {
 class OpenRoad;
@@ -78,12 +86,34 @@ class Blif
   bool writeBlif(const char* file_name, bool write_arrival_requireds = false);
   bool readBlif(const char* file_name, odb::dbBlock* block);
   bool inspectBlif(const char* file_name, int& num_instances);
+  // Builds the logic network of the replaceable instances mapped to the
+  // gates of library. Instances whose master is not a gate of library are
+  // left out and become the boundary of the network. The caller owns the
+  // returned network.
+  abc::Abc_Ntk_t* buildAbcNetwork(abc::Mio_Library_t* library,
+                                  bool add_arrival_requireds = false);
+  // Reads the gates of a mapped ABC network.
+  bool readAbcNetwork(abc::Abc_Ntk_t* network, std::vector<Gate>& gates);
+  // Replaces the replaceable instances by gates.
+  bool insertGates(const std::vector<Gate>& gates, odb::dbBlock* block);
   float getRequiredTime(sta::Pin* term, bool is_rise);
   float getArrivalTime(sta::Pin* term, bool is_rise);
   void addArrival(sta::Pin* pin, std::string netName);
   void addRequired(sta::Pin* pin, std::string netName);
 
  private:
+  struct Cut
+  {
+    std::vector<Gate> gates;
+    std::set<std::string> inputs;
+    std::set<std::string> outputs;
+    std::set<std::string> const0;
+    std::set<std::string> const1;
+    std::set<std::string> clocks;
+  };
+
+  void extractCut(Cut& cut);
+
   std::set<odb::dbInst*> instances_to_optimize;
   Logger* logger_;
   sta::dbSta* open_sta_ = nullptr;
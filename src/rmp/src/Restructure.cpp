@@ -35,15 +35,22 @@
 
 #include "rmp/Restructure.h"
 
+#include <poll.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <time.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 
+#include "abc_library_factory.h"
 #include "base/abc/abc.h"
 #include "base/main/abcapis.h"
 #include "db_sta/dbNetwork.hh"
@@ -64,11 +71,27 @@
 #include "sta/Sta.hh"
 #include "utl/Logger.h"
 
+// Headers have duplicate declarations so we include
+// a forward one to get at these functions without angering
+// gcc.
+namespace abc {
+Abc_Ntk_t* Abc_FrameReadNtk(Abc_Frame_t* p);
+void Abc_FrameReplaceCurrentNetwork(Abc_Frame_t* p, Abc_Ntk_t* pNet);
+}  // namespace abc
+
 using utl::RMP;
 using namespace abc;
 
 namespace rmp {
 
+// Status of an ABC mode, also the exit code of its child process.
+enum AbcModeStatus
+{
+  abc_success = 0,
+  abc_command_failed = 1,
+  abc_no_netlist = 2
+};
+
 void Restructure::init(utl::Logger* logger,
                        sta::dbSta* open_sta,
                        odb::dbDatabase* db,
@@ -157,10 +180,6 @@ void Restructure::getBlob(unsigned max_depth)
 
 void Restructure::runABC()
 {
-  input_blif_file_name_ = work_dir_name_ + std::string(block_->getConstName())
-                          + "_crit_path.blif";
-  std::vector<std::string> files_to_remove;
-
   debugPrint(logger_,
              utl::RMP,
              "remap",
@@ -170,14 +189,9 @@ void Restructure::runABC()
 
   Blif blif_(logger_, open_sta_, locell_, loport_, hicell_, hiport_);
   blif_.setReplaceableInstances(path_insts_);
-  blif_.writeBlif(input_blif_file_name_.c_str(), !is_area_mode_);
-  debugPrint(
-      logger_, RMP, "remap", 1, "Writing blif file {}", input_blif_file_name_);
-  files_to_remove.emplace_back(input_blif_file_name_);
 
   // abc optimization
   std::vector<Mode> modes;
-  std::vector<pid_t> child_proc;
 
   if (is_area_mode_) {
     // Area Mode
@@ -187,71 +201,69 @@ void Restructure::runABC()
     modes = {Mode::DELAY_1, Mode::DELAY_2, Mode::DELAY_3, Mode::DELAY_4};
   }
 
-  child_proc.resize(modes.size(), 0);
-
-  std::string best_blif;
+  int best_mode_idx = -1;
   int best_inst_count = std::numeric_limits<int>::max();
   float best_delay_gain = std::numeric_limits<float>::max();
 
   debugPrint(
       logger_, RMP, "remap", 1, "Running ABC with {} modes.", modes.size());
 
-  for (size_t curr_mode_idx = 0; curr_mode_idx < modes.size();
-       curr_mode_idx++) {
-    output_blif_file_name_
-        = work_dir_name_ + std::string(block_->getConstName())
-          + std::to_string(curr_mode_idx) + "_crit_path_out.blif";
+  if (logfile_ == "")
+    logfile_ = work_dir_name_ + "abc.log";
 
-    opt_mode_ = modes[curr_mode_idx];
+  Abc_Start();
 
-    const std::string abc_script_file
-        = work_dir_name_ + std::to_string(curr_mode_idx) + "ord_abc_script.tcl";
-    if (logfile_ == "")
-      logfile_ = work_dir_name_ + "abc.log";
+  AbcLibraryFactory factory(logger_);
+  factory.AddDbSta(open_sta_);
+  for (const auto& lib_name : lib_file_names_) {
+    factory.AddLibertyFile(lib_name);
+  }
+  Mio_Library_t* library = factory.BuildAndInstall();
 
-    debugPrint(logger_,
-               RMP,
-               "remap",
-               1,
-               "Writing ABC script file {}.",
-               abc_script_file);
-
-    if (writeAbcScript(abc_script_file)) {
-      // call linked abc
-      Abc_Start();
-      Abc_Frame_t* abc_frame = Abc_FrameGetGlobalFrame();
-      const std::string command = "source " + abc_script_file;
-      child_proc[curr_mode_idx]
-          = Cmd_CommandExecute(abc_frame, command.c_str());
-      if (child_proc[curr_mode_idx]) {
-        logger_->error(RMP, 26, "Error executing ABC command {}.", command);
-        return;
-      }
-      Abc_Stop();
-      // exit linked abc
-      files_to_remove.emplace_back(abc_script_file);
-    }
-  }  // end modes
+  Abc_Ntk_t* network = blif_.buildAbcNetwork(library, !is_area_mode_);
+  if (network == nullptr) {
+    Abc_Stop();
+    logger_->info(
+        RMP, 21, "All re-synthesis runs discarded, keeping original netlist.");
+    return;
+  }
 
-  // Inspect ABC results to choose blif with least instance count
-  for (int curr_mode_idx = 0; curr_mode_idx < modes.size(); curr_mode_idx++) {
-    // Skip failed ABC runs
-    if (child_proc[curr_mode_idx] != 0) {
-      continue;
+  if (logger_->debugCheck(RMP, "remap", 1)) {
+    Abc_Frame_t* abc_frame = Abc_FrameGetGlobalFrame();
+    Abc_FrameReplaceCurrentNetwork(abc_frame, Abc_NtkDup(network));
+    const std::string crit_path_name
+        = work_dir_name_ + std::string(block_->getConstName()) + "_crit_path";
+    Cmd_CommandExecute(abc_frame,
+                       ("write_verilog " + crit_path_name + ".v").c_str());
+  }
+
+  std::vector<std::vector<Gate>> mode_gates(modes.size());
+  const std::vector<int> mode_status
+      = runAbcModes(blif_, network, modes, mode_gates);
+
+  Abc_NtkDelete(network);
+  Abc_Stop();
+
+  for (size_t curr_mode_idx = 0; curr_mode_idx < modes.size();
+       curr_mode_idx++) {
+    if (mode_status[curr_mode_idx] == abc_command_failed) {
+      logger_->error(
+          RMP, 26, "Error executing ABC commands of mode {}.", curr_mode_idx);
+      return;
     }
+  }
 
-    output_blif_file_name_
-        = work_dir_name_ + std::string(block_->getConstName())
-          + std::to_string(curr_mode_idx) + "_crit_path_out.blif";
+  // Inspect ABC results to choose the network with least instance count
+  for (size_t curr_mode_idx = 0; curr_mode_idx < modes.size();
+       curr_mode_idx++) {
     const std::string abc_log_name = logfile_ + std::to_string(curr_mode_idx);
 
     int level_gain = 0;
     float delay = std::numeric_limits<float>::max();
-    int num_instances = 0;
     bool success = readAbcLog(abc_log_name, level_gain, delay);
     if (success) {
-      success
-          = blif_.inspectBlif(output_blif_file_name_.c_str(), num_instances);
+      success = mode_status[curr_mode_idx] == abc_success;
+      const int num_instances = mode_gates[curr_mode_idx].size();
       logger_->report(
           "Optimized to {} instances in iteration {} with max path depth "
           "decrease of {}, delay of {}.",
@@ -264,26 +276,25 @@ void Restructure::runABC()
         if (is_area_mode_) {
           if (num_instances < best_inst_count) {
             best_inst_count = num_instances;
-            best_blif = output_blif_file_name_;
+            best_mode_idx = curr_mode_idx;
           }
         } else {
           // Using only DELAY_4 for delay based gain since other modes not
           // showing good gains
           if (modes[curr_mode_idx] == Mode::DELAY_4) {
             best_delay_gain = delay;
-            best_blif = output_blif_file_name_;
+            best_mode_idx = curr_mode_idx;
           }
         }
       }
     }
-    files_to_remove.emplace_back(output_blif_file_name_);
   }
 
   if (best_inst_count < std::numeric_limits<int>::max()
       || best_delay_gain < std::numeric_limits<float>::max()) {
     // read back netlist
-    debugPrint(logger_, RMP, "remap", 1, "Reading blif file {}.", best_blif);
-    blif_.readBlif(best_blif.c_str(), block_);
+    logger_->info(RMP, 43, "Using the netlist of iteration {}.", best_mode_idx);
+    blif_.insertGates(mode_gates[best_mode_idx], block_);
     debugPrint(logger_,
                utl::RMP,
                "remap",
@@ -294,13 +305,6 @@ void Restructure::runABC()
     logger_->info(
         RMP, 21, "All re-synthesis runs discarded, keeping original netlist.");
   }
-
-  for (const auto& file_to_remove : files_to_remove) {
-    if (!logger_->debugCheck(RMP, "remap", 1))
-      if (std::remove(file_to_remove.c_str()) != 0) {
-        logger_->error(RMP, 37, "Fail to remove file {}", file_to_remove);
-      }
-  }
 }
 
 void Restructure::postABC(float worst_slack)
@@ -479,42 +483,300 @@ void Restructure::removeConstCell(odb::dbInst* inst)
   odb::dbInst::destroy(inst);
 }
 
-bool Restructure::writeAbcScript(std::string file_name)
+// Runs the commands of a mode on a copy of network in the global ABC frame
+// and reads the mapped result into gates.
+int Restructure::runAbcMode(Blif& blif,
+                            Abc_Ntk_t* network,
+                            Mode mode,
+                            int mode_idx,
+                            std::vector<Gate>& gates)
+{
+  Abc_Frame_t* abc_frame = Abc_FrameGetGlobalFrame();
+  Abc_FrameReplaceCurrentNetwork(abc_frame, Abc_NtkDup(network));
+
+  const std::string output_name = work_dir_name_
+                                  + std::string(block_->getConstName())
+                                  + std::to_string(mode_idx) + "_crit_path_out";
+  for (const std::string& command : getAbcCommands(mode, output_name)) {
+    if (Cmd_CommandExecute(abc_frame, command.c_str())) {
+      return abc_command_failed;
+    }
+  }
+
+  if (!blif.readAbcNetwork(Abc_FrameReadNtk(abc_frame), gates)) {
+    return abc_no_netlist;
+  }
+  return abc_success;
+}
+
+static bool writeAll(int fd, const void* data, size_t size)
+{
+  const char* bytes = static_cast<const char*>(data);
+  while (size > 0) {
+    const ssize_t count = write(fd, bytes, size);
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count <= 0) {
+      return false;
+    }
+    bytes += count;
+    size -= count;
+  }
+  return true;
+}
+
+static bool writeString(int fd, const std::string& str)
 {
-  std::ofstream script(file_name.c_str());
+  const uint32_t size = str.size();
+  return writeAll(fd, &size, sizeof(size)) && writeAll(fd, str.data(), size);
+}
 
-  if (!script.is_open()) {
-    logger_->error(RMP, 20, "Cannot open file {} for writing.", file_name);
+// Sends the gates of a mode from a child process to the parent.
+static bool writeGates(int fd, const std::vector<Gate>& gates)
+{
+  const uint32_t num_gates = gates.size();
+  if (!writeAll(fd, &num_gates, sizeof(num_gates))) {
     return false;
   }
+  for (const Gate& gate : gates) {
+    const uint32_t num_connections = gate.connections_.size();
+    if (!writeString(fd, gate.master_)
+        || !writeAll(fd, &num_connections, sizeof(num_connections))) {
+      return false;
+    }
+    for (const std::string& connection : gate.connections_) {
+      if (!writeString(fd, connection)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
 
-  for (const auto& lib_name : lib_file_names_) {
-    // abc read_lib prints verbose by default, -v toggles to off to avoid read
-    // time being printed
-    std::string read_lib_str = "read_lib -v " + lib_name + "\n";
-    script << read_lib_str;
+// Reads the data written by writeGates.
+class GateReader
+{
+ public:
+  explicit GateReader(const std::string& data) : data_(data) {}
+
+  bool readGates(std::vector<Gate>& gates)
+  {
+    uint32_t num_gates;
+    if (!readValue(num_gates)) {
+      return false;
+    }
+    for (uint32_t i = 0; i < num_gates; i++) {
+      std::string master;
+      uint32_t num_connections;
+      if (!readString(master) || !readValue(num_connections)) {
+        return false;
+      }
+      std::vector<std::string> connections(num_connections);
+      for (std::string& connection : connections) {
+        if (!readString(connection)) {
+          return false;
+        }
+      }
+      gates.emplace_back(GateType::Gate, master, connections);
+    }
+    return pos_ == data_.size();
   }
 
-  script << "read_blif -n " << input_blif_file_name_ << std::endl;
+ private:
+  bool readValue(uint32_t& value)
+  {
+    if (data_.size() - pos_ < sizeof(value)) {
+      return false;
+    }
+    std::memcpy(&value, data_.data() + pos_, sizeof(value));
+    pos_ += sizeof(value);
+    return true;
+  }
 
-  if (logger_->debugCheck(RMP, "remap", 1))
-    script << "write_verilog " << input_blif_file_name_ + std::string(".v")
-           << std::endl;
+  bool readString(std::string& str)
+  {
+    uint32_t size;
+    if (!readValue(size) || data_.size() - pos_ < size) {
+      return false;
+    }
+    str = data_.substr(pos_, size);
+    pos_ += size;
+    return true;
+  }
 
-  writeOptCommands(script);
+  const std::string& data_;
+  size_t pos_ = 0;
+};
 
-  script << "write_blif " << output_blif_file_name_ << std::endl;
+// Reads the output and gates pipes of a child until both are closed.
+// Both are read together so the child never blocks on a full pipe.
+static void drainChild(int output_fd,
+                       int gates_fd,
+                       std::string& output,
+                       std::string& gates)
+{
+  struct pollfd fds[2] = {{output_fd, POLLIN, 0}, {gates_fd, POLLIN, 0}};
+  std::string* buffers[2] = {&output, &gates};
+  int open_fds = 2;
+  char buffer[4096];
+  while (open_fds > 0) {
+    if (poll(fds, 2, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+    for (int i = 0; i < 2; i++) {
+      if (fds[i].fd < 0 || fds[i].revents == 0) {
+        continue;
+      }
+      const ssize_t count = read(fds[i].fd, buffer, sizeof(buffer));
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        // A negative fd is ignored by poll
+        fds[i].fd = -1;
+        open_fds--;
+      } else {
+        buffers[i]->append(buffer, count);
+      }
+    }
+  }
+}
 
-  if (logger_->debugCheck(RMP, "remap", 1))
-    script << "write_verilog " << output_blif_file_name_ + std::string(".v")
-           << std::endl;
+// ABC keeps its library and current network in one global frame, so modes
+// can only run concurrently in separate processes. Each mode runs in a
+// forked child, at most num_threads_ at a time, that inherits the frame
+// with the library and network already set up. The child sends its console
+// output and its gates back through two pipes before calling _exit, so no
+// files are exchanged. The children are collected in mode order and their
+// output is printed in that order, so the log and the result do not depend
+// on the thread count. Returns the status of each mode.
+std::vector<int> Restructure::runAbcModes(
+    Blif& blif,
+    Abc_Ntk_t* network,
+    const std::vector<Mode>& modes,
+    std::vector<std::vector<Gate>>& mode_gates)
+{
+  const int num_modes = modes.size();
+  std::vector<int> status(num_modes, abc_success);
 
-  script.close();
+  const int max_jobs = std::min(num_threads_, num_modes);
+  if (max_jobs <= 1) {
+    for (int i = 0; i < num_modes; i++) {
+      status[i] = runAbcMode(blif, network, modes[i], i, mode_gates[i]);
+    }
+    return status;
+  }
 
-  return true;
+  debugPrint(
+      logger_, RMP, "remap", 1, "Running ABC modes in {} processes.", max_jobs);
+
+  // Don't let the children flush the parent's buffered output
+  std::fflush(nullptr);
+
+  std::vector<pid_t> child_pids(num_modes, -1);
+  std::vector<int> output_fds(num_modes, -1);
+  std::vector<int> gates_fds(num_modes, -1);
+  int next_wait = 0;
+  auto waitForChild = [&]() {
+    const int i = next_wait++;
+    if (child_pids[i] < 0) {
+      // Ran in this process
+      return;
+    }
+    std::string output;
+    std::string gates;
+    drainChild(output_fds[i], gates_fds[i], output, gates);
+    close(output_fds[i]);
+    close(gates_fds[i]);
+    std::fwrite(output.data(), 1, output.size(), stdout);
+    std::fflush(stdout);
+
+    int child_status = 0;
+    pid_t pid;
+    do {
+      pid = waitpid(child_pids[i], &child_status, 0);
+    } while (pid < 0 && errno == EINTR);
+    if (pid < 0 || !WIFEXITED(child_status)) {
+      status[i] = abc_command_failed;
+    } else {
+      status[i] = WEXITSTATUS(child_status);
+      if (status[i] == abc_success
+          && !GateReader(gates).readGates(mode_gates[i])) {
+        status[i] = abc_no_netlist;
+      }
+    }
+    if (status[i] != abc_success) {
+      mode_gates[i].clear();
+    }
+  };
+
+  for (int i = 0; i < num_modes; i++) {
+    if (i - next_wait >= max_jobs) {
+      waitForChild();
+    }
+    int output_pipe[2] = {-1, -1};
+    int gates_pipe[2] = {-1, -1};
+    pid_t pid = -1;
+    if (pipe(output_pipe) == 0 && pipe(gates_pipe) == 0) {
+      pid = fork();
+    }
+    if (pid == 0) {
+      close(output_pipe[0]);
+      close(gates_pipe[0]);
+      dup2(output_pipe[1], STDOUT_FILENO);
+      close(output_pipe[1]);
+      std::vector<Gate> gates;
+      int child_status = runAbcMode(blif, network, modes[i], i, gates);
+      if (child_status == abc_success && !writeGates(gates_pipe[1], gates)) {
+        child_status = abc_no_netlist;
+      }
+      close(gates_pipe[1]);
+      std::fflush(nullptr);
+      _exit(child_status);
+    }
+    if (pid < 0) {
+      for (int fd :
+           {output_pipe[0], output_pipe[1], gates_pipe[0], gates_pipe[1]}) {
+        if (fd >= 0) {
+          close(fd);
+        }
+      }
+      logger_->warn(RMP, 38, "Could not start ABC process for mode {}.", i);
+      status[i] = runAbcMode(blif, network, modes[i], i, mode_gates[i]);
+      continue;
+    }
+    close(output_pipe[1]);
+    close(gates_pipe[1]);
+    child_pids[i] = pid;
+    output_fds[i] = output_pipe[0];
+    gates_fds[i] = gates_pipe[0];
+  }
+  while (next_wait < num_modes) {
+    waitForChild();
+  }
+
+  return status;
+}
+
+std::vector<std::string> Restructure::getAbcCommands(
+    Mode mode,
+    const std::string& output_name)
+{
+  std::vector<std::string> commands;
+
+  addOptCommands(mode, commands);
+
+  if (logger_->debugCheck(RMP, "remap", 1))
+    commands.push_back("write_verilog " + output_name + ".v");
+
+  return commands;
 }
 
-void Restructure::writeOptCommands(std::ofstream& script)
+void Restructure::addOptCommands(Mode mode, std::vector<std::string>& commands)
 {
   std::string choice
       = "alias choice \"fraig_store; resyn2; fraig_store; resyn2; fraig_store; "
@@ -523,61 +785,63 @@ void Restructure::writeOptCommands(std::ofstream& script)
       = "alias choice2 \"fraig_store; balance; fraig_store; resyn2; "
         "fraig_store; resyn2; fraig_store; resyn2; fraig_store; "
         "fraig_restore\"";
-  script << "bdd; sop" << std::endl;
+  commands.emplace_back("bdd; sop");
 
-  script << "alias resyn2 \"balance; rewrite; refactor; balance; rewrite; "
-            "rewrite -z; balance; refactor -z; rewrite -z; balance\""
-         << std::endl;
-  script << choice << std::endl;
-  script << choice2 << std::endl;
+  commands.emplace_back(
+      "alias resyn2 \"balance; rewrite; refactor; balance; rewrite; "
+      "rewrite -z; balance; refactor -z; rewrite -z; balance\"");
+  commands.push_back(choice);
+  commands.push_back(choice2);
 
-  if (opt_mode_ == Mode::AREA_3)
-    script << "choice2" << std::endl;  // << "scleanup" << std::endl;
+  if (mode == Mode::AREA_3)
+    commands.emplace_back("choice2");  // "scleanup"
   else
-    script << "resyn2" << std::endl;  // << "scleanup" << std::endl;
+    commands.emplace_back("resyn2");  // "scleanup"
 
-  switch (opt_mode_) {
+  switch (mode) {
     case Mode::DELAY_1: {
-      script << "map -D 0.01 -A 0.9 -B 0.2 -M 0 -p" << std::endl;
-      script << "buffer -p -c" << std::endl;
+      commands.emplace_back("map -D 0.01 -A 0.9 -B 0.2 -M 0 -p");
+      commands.emplace_back("buffer -p -c");
       break;
     }
     case Mode::DELAY_2: {
-      script << "choice" << std::endl;
-      script << "map -D 0.01 -A 0.9 -B 0.2 -M 0 -p" << std::endl;
-      script << "choice" << std::endl;
-      script << "map -D 0.01" << std::endl;
-      script << "buffer -p -c" << std::endl << "topo" << std::endl;
+      commands.emplace_back("choice");
+      commands.emplace_back("map -D 0.01 -A 0.9 -B 0.2 -M 0 -p");
+      commands.emplace_back("choice");
+      commands.emplace_back("map -D 0.01");
+      commands.emplace_back("buffer -p -c");
+      commands.emplace_back("topo");
       break;
     }
     case Mode::DELAY_3: {
-      script << "choice2" << std::endl;
-      script << "map -D 0.01 -A 0.9 -B 0.2 -M 0 -p" << std::endl;
-      script << "choice2" << std::endl;
-      script << "map -D 0.01" << std::endl;
-      script << "buffer -p -c" << std::endl << "topo" << std::endl;
+      commands.emplace_back("choice2");
+      commands.emplace_back("map -D 0.01 -A 0.9 -B 0.2 -M 0 -p");
+      commands.emplace_back("choice2");
+      commands.emplace_back("map -D 0.01");
+      commands.emplace_back("buffer -p -c");
+      commands.emplace_back("topo");
       break;
     }
     case Mode::DELAY_4: {
-      script << "choice2" << std::endl;
-      script << "amap -F 20 -A 20 -C 5000 -Q 0.1 -m" << std::endl;
-      script << "choice2" << std::endl;
-      script << "map -D 0.01 -A 0.9 -B 0.2 -M 0 -p" << std::endl;
-      script << "buffer -p -c" << std::endl;
+      commands.emplace_back("choice2");
+      commands.emplace_back("amap -F 20 -A 20 -C 5000 -Q 0.1 -m");
+      commands.emplace_back("choice2");
+      commands.emplace_back("map -D 0.01 -A 0.9 -B 0.2 -M 0 -p");
+      commands.emplace_back("buffer -p -c");
       break;
     }
     case Mode::AREA_2:
     case Mode::AREA_3: {
-      script << "choice2" << std::endl;
-      script << "amap -m -Q 0.1 -F 20 -A 20 -C 5000" << std::endl;
-      script << "choice2" << std::endl;
-      script << "amap -m -Q 0.1 -F 20 -A 20 -C 5000" << std::endl;
+      commands.emplace_back("choice2");
+      commands.emplace_back("amap -m -Q 0.1 -F 20 -A 20 -C 5000");
+      commands.emplace_back("choice2");
+      commands.emplace_back("amap -m -Q 0.1 -F 20 -A 20 -C 5000");
       break;
     }
     case Mode::AREA_1:
     default: {
-      script << "choice2" << std::endl;
-      script << "amap -m -Q 0.1 -F 20 -A 20 -C 5000" << std::endl;
+      commands.emplace_back("choice2");
+      commands.emplace_back("amap -m -Q 0.1 -F 20 -A 20 -C 5000");
       break;
     }
   }
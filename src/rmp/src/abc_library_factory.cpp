@@ -6,7 +6,10 @@
 
 #include "abc_library_factory.h"
 
+#include <algorithm>
 #include <cmath>
+#include <filesystem>
+#include <system_error>
 #include <unordered_set>
 #include <vector>
 
@@ -28,6 +31,14 @@
 #include "sta/Units.hh"
 #include "utl/deleter.h"
 
+// Headers have duplicate declarations so we include
+// a forward one to get at these functions without angering
+// gcc.
+namespace abc {
+void* Abc_FrameReadLibGen();
+void Abc_FrameSetLibScl(void* pLib);
+}  // namespace abc
+
 namespace rmp {
 
 static bool IsCombinational(sta::LibertyCell* cell)
@@ -300,25 +311,82 @@ AbcLibraryFactory& AbcLibraryFactory::AddDbSta(sta::dbSta* db_sta)
   return *this;
 }
 
+AbcLibraryFactory& AbcLibraryFactory::AddLibertyFile(
+    const std::string& file_name)
+{
+  liberty_files_.push_back(file_name);
+  return *this;
+}
+
+static bool IsSameFile(const std::string& file_name1,
+                       const std::string& file_name2)
+{
+  std::error_code error;
+  return file_name1 == file_name2
+         || std::filesystem::equivalent(file_name1, file_name2, error);
+}
+
+std::vector<sta::LibertyLibrary*> AbcLibraryFactory::GetLibraries()
+{
+  std::vector<sta::LibertyLibrary*> libraries;
+  std::unique_ptr<sta::LibertyLibraryIterator> library_iter(
+      db_sta_->network()->libertyLibraryIterator());
+  while (library_iter->hasNext()) {
+    libraries.push_back(library_iter->next());
+  }
+  if (liberty_files_.empty()) {
+    return libraries;
+  }
+
+  std::vector<sta::LibertyLibrary*> selected;
+  for (const std::string& file_name : liberty_files_) {
+    auto library = std::find_if(
+        libraries.begin(), libraries.end(), [&](sta::LibertyLibrary* lib) {
+          return IsSameFile(lib->filename(), file_name);
+        });
+    if (library == libraries.end()) {
+      logger_->error(utl::RMP,
+                     39,
+                     "Liberty file {} has not been read with read_liberty.",
+                     file_name);
+    }
+    selected.push_back(*library);
+  }
+  return selected;
+}
+
 utl::deleted_unique_ptr<abc::SC_Lib> AbcLibraryFactory::Build()
 {
   if (!db_sta_) {
     logger_->error(utl::RMP, 15, "Build called with null sta library");
   }
 
+  const std::vector<sta::LibertyLibrary*> libraries = GetLibraries();
   abc::SC_Lib* abc_library = abc::Abc_SclLibAlloc();
-  std::unique_ptr<sta::LibertyLibraryIterator> library_iter(
-      db_sta_->network()->libertyLibraryIterator());
-  while (library_iter->hasNext()) {
-    sta::LibertyLibrary* library = library_iter->next();
+  for (sta::LibertyLibrary* library : libraries) {
     PopulateAbcSclLibFromSta(abc_library, library);
   }
   abc::Abc_SclLibNormalize(abc_library);
+  abc::Abc_SclHashCells(abc_library);
+  abc::Abc_SclLinkCells(abc_library);
 
   return utl::deleted_unique_ptr<abc::SC_Lib>(
       abc_library, [](abc::SC_Lib* lib) { abc::Abc_SclLibFree(lib); });
 }
 
+abc::Mio_Library_t* AbcLibraryFactory::BuildAndInstall()
+{
+  abc::SC_Lib* abc_library = Build().release();
+  // The frame frees its library when it is stopped
+  abc::Abc_FrameSetLibScl(abc_library);
+
+  // When you set these params to zero they essentially turned off.
+  abc::Abc_SclInstallGenlib(
+      abc_library, /*Slew=*/0, /*Gain=*/0, /*nGatesMin=*/0);
+  abc::Mio_LibraryTransferCellIds();
+  return static_cast<abc::Mio_Library_t*>(abc::Abc_FrameReadLibGen());
+}
+
 void AbcLibraryFactory::PopulateAbcSclLibFromSta(abc::SC_Lib* sc_library,
                                                  sta::LibertyLibrary* library)
 {
@@ -16,6 +16,10 @@
 #include "utl/Logger.h"
 #include "utl/deleter.h"
 
+namespace abc {
+typedef struct Mio_LibraryStruct_t_ Mio_Library_t;
+}  // namespace abc
+
 namespace rmp {
 
 // A Factory to construct an abc::SC_Lib* from an OpenSTA library.
@@ -26,7 +30,14 @@ class AbcLibraryFactory
  public:
   explicit AbcLibraryFactory(utl::Logger* logger) : logger_(logger) {}
   AbcLibraryFactory& AddDbSta(sta::dbSta* db_sta);
+  // Only use the libraries read from the given Liberty files. All the
+  // libraries of the dbSta are used if none are added.
+  AbcLibraryFactory& AddLibertyFile(const std::string& file_name);
   utl::deleted_unique_ptr<abc::SC_Lib> Build();
+  // Builds the library and makes it the current library of the global ABC
+  // frame, which owns it from then on. Returns the gate library ABC
+  // derives from it for mapping.
+  abc::Mio_Library_t* BuildAndInstall();
 
  private:
   void PopulateAbcSclLibFromSta(abc::SC_Lib* sc_library,
@@ -42,8 +53,11 @@ class AbcLibraryFactory
                                     sta::Units* units);
   std::vector<abc::SC_Pin*> CreateAbcInputPins(sta::LibertyCell* cell);
 
+  std::vector<sta::LibertyLibrary*> GetLibraries();
+
   utl::Logger* logger_;
   sta::dbSta* db_sta_ = nullptr;
+  std::vector<std::string> liberty_files_;
 };
 
 }  // namespace rmp
\ No newline at end of file
@@ -36,6 +36,7 @@
 #include "rmp/blif.h"
 
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iterator>
 #include <map>
@@ -44,8 +45,11 @@
 #include <tuple>
 #include <vector>
 
+#include "base/abc/abc.h"
+#include "base/io/ioAbc.h"
 #include "db_sta/dbNetwork.hh"
 #include "db_sta/dbSta.hh"
+#include "map/mio/mio.h"
 #include "odb/db.h"
 #include "ord/OpenRoad.hh"
 #include "rmp/blifParser.h"
@@ -57,6 +61,7 @@
 #include "sta/PortDirection.hh"
 #include "sta/Sta.hh"
 #include "utl/Logger.h"
+#include "utl/deleter.h"
 
 using utl::RMP;
 
@@ -90,29 +95,22 @@ void Blif::addReplaceableInstance(odb::dbInst* inst)
   instances_to_optimize.insert(inst);
 }
 
-bool Blif::writeBlif(const char* file_name, bool write_arrival_requireds)
+void Blif::extractCut(Cut& cut)
 {
   int dummy_nets = 0;
 
-  std::ofstream f(file_name);
-
-  // These always need to be done before writing blif
+  // These always need to be done before extracting the cut
   open_sta_->ensureGraph();
   open_sta_->ensureLevelized();
   open_sta_->searchPreamble();
 
-  if (f.bad()) {
-    logger_->error(RMP, 1, "Cannot open file {}.", file_name);
-    return false;
-  }
-
   std::set<odb::dbInst*>& insts = this->instances_to_optimize;
   std::map<odb::uint, odb::dbInst*> instMap;
-  std::vector<std::string> subckts;
-  std::set<std::string> inputs, outputs, const0, const1, clocks;
-
-  subckts.resize(insts.size());
-  int instIndex = 0;
+  std::set<std::string>& inputs = cut.inputs;
+  std::set<std::string>& outputs = cut.outputs;
+  std::set<std::string>& const0 = cut.const0;
+  std::set<std::string>& const1 = cut.const1;
+  std::set<std::string>& clocks = cut.clocks;
 
   for (auto&& inst : insts) {
     instMap.insert(std::pair<odb::uint, odb::dbInst*>(inst->getId(), inst));
@@ -124,9 +122,8 @@ bool Blif::writeBlif(const char* file_name, bool write_arrival_requireds)
         open_sta_->getDbNetwork()->dbToSta(master));
     auto masterName = master->getName();
 
-    std::string currentGate
-        = ((cell->hasSequentials()) ? ".mlatch " : ".gate ") + masterName;
-    std::string currentConnections = "", currentClock = "";
+    std::vector<std::string> currentConnections;
+    std::string currentClock = "";
     std::set<std::string> currentClocks;
 
     auto iterms = inst->getITerms();
@@ -160,7 +157,7 @@ bool Blif::writeBlif(const char* file_name, bool write_arrival_requireds)
                                 ? ("dummy_" + std::to_string(dummy_nets++))
                                 : net->getName();
 
-      currentConnections += " " + mtermName + "=" + netName;
+      currentConnections.push_back(mtermName + "=" + netName);
 
       if (net == nullptr) {
         continue;
@@ -276,14 +273,15 @@ bool Blif::writeBlif(const char* file_name, bool write_arrival_requireds)
       }
     }
 
-    currentGate += currentConnections;
-
     if (cell->hasSequentials() && currentClocks.size() != 1)
       continue;
     else if (cell->hasSequentials())
-      currentGate += " " + currentClock;
+      currentConnections.push_back(currentClock);
 
-    subckts[instIndex++] = std::move(currentGate);
+    cut.gates.emplace_back(
+        cell->hasSequentials() ? GateType::Mlatch : GateType::Gate,
+        masterName,
+        currentConnections);
   }
 
   // remove drivers from input list
@@ -298,13 +296,26 @@ bool Blif::writeBlif(const char* file_name, bool write_arrival_requireds)
     inputs.erase(port);
     arrivals_.erase(port);
   }
+}
+
+bool Blif::writeBlif(const char* file_name, bool write_arrival_requireds)
+{
+  std::ofstream f(file_name);
+
+  if (f.bad()) {
+    logger_->error(RMP, 1, "Cannot open file {}.", file_name);
+    return false;
+  }
+
+  Cut cut;
+  extractCut(cut);
 
   f << ".model tmp_circuit\n";
   f << ".inputs";
 
-  for (auto& input : inputs) {
-    if (const0.find(input) != const0.end()
-        || const1.find(input) != const1.end())
+  for (auto& input : cut.inputs) {
+    if (cut.const0.find(input) != cut.const0.end()
+        || cut.const1.find(input) != cut.const1.end())
       continue;
 
     f << " " << input;
@@ -313,14 +324,14 @@ bool Blif::writeBlif(const char* file_name, bool write_arrival_requireds)
 
   f << ".outputs";
 
-  for (auto& output : outputs) {
+  for (auto& output : cut.outputs) {
     f << " " << output;
   }
   f << "\n";
 
-  if (clocks.size() > 0) {
+  if (cut.clocks.size() > 0) {
     f << ".clock";
-    for (auto& clock : clocks) {
+    for (auto& clock : cut.clocks) {
       f << " " << clock;
     }
   }
@@ -339,18 +350,27 @@ bool Blif::writeBlif(const char* file_name, bool write_arrival_requireds)
 
   f << "\n\n";
 
-  for (auto& zero : const0) {
+  for (auto& zero : cut.const0) {
     std::string const_subctk = ".gate _const0_ z=" + zero;
     f << const_subctk << "\n";
   }
 
-  for (auto& one : const1) {
+  for (auto& one : cut.const1) {
     std::string const_subctk = ".gate _const1_ z=" + one;
     f << const_subctk << "\n";
   }
 
-  for (auto& subckt : subckts) {
-    f << subckt << "\n";
+  for (auto& gate : cut.gates) {
+    f << ((gate.type_ == GateType::Mlatch) ? ".mlatch " : ".gate ")
+      << gate.master_;
+    for (auto& connection : gate.connections_) {
+      f << " " << connection;
+    }
+    f << "\n";
+  }
+  // Skipped instances leave empty lines
+  for (size_t i = cut.gates.size(); i < instances_to_optimize.size(); i++) {
+    f << "\n";
   }
 
   f << ".end\n";
@@ -360,7 +380,7 @@ bool Blif::writeBlif(const char* file_name, bool write_arrival_requireds)
   logger_->info(RMP,
                 2,
                 "Blif writer successfully dumped file with {} instances.",
-                instIndex);
+                cut.gates.size());
 
   return true;
 }
@@ -440,6 +460,170 @@ bool Blif::readBlif(const char* file_name, odb::dbBlock* block)
                 blif.getCombGateCount(),
                 blif.getFlopCount());
 
+  return insertGates(blif.getGates(), block);
+}
+
+abc::Abc_Ntk_t* Blif::buildAbcNetwork(abc::Mio_Library_t* library,
+                                      bool add_arrival_requireds)
+{
+  std::map<std::string, abc::Mio_Gate_t*> lib_gates;
+  for (abc::Mio_Gate_t* gate = abc::Mio_LibraryReadGates(library); gate;
+       gate = abc::Mio_GateReadNext(gate)) {
+    lib_gates[abc::Mio_GateReadName(gate)] = gate;
+  }
+
+  // Sequential cells are not gates, they stay in place and their pins
+  // become inputs and outputs of the cut.
+  for (auto it = instances_to_optimize.begin();
+       it != instances_to_optimize.end();) {
+    if (lib_gates.find((*it)->getMaster()->getName()) == lib_gates.end()) {
+      it = instances_to_optimize.erase(it);
+    } else {
+      it++;
+    }
+  }
+
+  Cut cut;
+  extractCut(cut);
+
+  utl::deleted_unique_ptr<abc::Abc_Ntk_t> netlist(
+      abc::Abc_NtkAlloc(abc::ABC_NTK_NETLIST, abc::ABC_FUNC_MAP, 1),
+      &abc::Abc_NtkDelete);
+  abc::Abc_NtkSetName(netlist.get(), strdup("tmp_circuit"));
+
+  for (auto& input : cut.inputs) {
+    if (cut.const0.find(input) != cut.const0.end()
+        || cut.const1.find(input) != cut.const1.end())
+      continue;
+    abc::Io_ReadCreatePi(netlist.get(), const_cast<char*>(input.c_str()));
+  }
+  for (auto& output : cut.outputs) {
+    abc::Io_ReadCreatePo(netlist.get(), const_cast<char*>(output.c_str()));
+  }
+
+  auto createNode = [&](abc::Mio_Gate_t* gate,
+                        const std::string& out,
+                        std::vector<char*>& ins) {
+    abc::Abc_Obj_t* node = abc::Io_ReadCreateNode(
+        netlist.get(), const_cast<char*>(out.c_str()), ins.data(), ins.size());
+    abc::Abc_ObjSetData(node, gate);
+  };
+
+  std::vector<char*> no_ins;
+  for (auto& zero : cut.const0) {
+    createNode(lib_gates["_const0_"], zero, no_ins);
+  }
+  for (auto& one : cut.const1) {
+    createNode(lib_gates["_const1_"], one, no_ins);
+  }
+
+  for (auto& gate : cut.gates) {
+    std::map<std::string, std::string> pin_nets;
+    for (auto& connection : gate.connections_) {
+      auto equalSignPos = connection.find("=");
+      if (equalSignPos != std::string::npos) {
+        pin_nets[connection.substr(0, equalSignPos)]
+            = connection.substr(equalSignPos + 1);
+      }
+    }
+
+    // Fanins are in the pin order of the gate
+    abc::Mio_Gate_t* lib_gate = lib_gates[gate.master_];
+    std::vector<char*> ins;
+    for (abc::Mio_Pin_t* pin = abc::Mio_GateReadPins(lib_gate); pin;
+         pin = abc::Mio_PinReadNext(pin)) {
+      auto pin_net = pin_nets.find(abc::Mio_PinReadName(pin));
+      if (pin_net == pin_nets.end()) {
+        logger_->warn(RMP,
+                      40,
+                      "Pin {} of {} is not connected, keeping original "
+                      "netlist.",
+                      abc::Mio_PinReadName(pin),
+                      gate.master_);
+        return nullptr;
+      }
+      ins.push_back(const_cast<char*>(pin_net->second.c_str()));
+    }
+    createNode(lib_gate, pin_nets[abc::Mio_GateReadOutName(lib_gate)], ins);
+  }
+
+  abc::Abc_NtkFinalizeRead(netlist.get());
+  if (!abc::Abc_NtkCheckRead(netlist.get())) {
+    logger_->warn(RMP, 41, "ABC network check failed.");
+    return nullptr;
+  }
+
+  if (add_arrival_requireds) {
+    for (auto& arrival : arrivals_) {
+      abc::Abc_Obj_t* net = abc::Abc_NtkFindNet(
+          netlist.get(), const_cast<char*>(arrival.first.c_str()));
+      if (net && abc::Abc_ObjFaninNum(net) > 0
+          && abc::Abc_ObjIsPi(abc::Abc_ObjFanin0(net))) {
+        abc::Abc_NtkTimeSetArrival(netlist.get(),
+                                   abc::Abc_ObjId(abc::Abc_ObjFanin0(net)),
+                                   arrival.second.first,
+                                   arrival.second.second);
+      }
+    }
+
+    for (auto& required : requireds_) {
+      abc::Abc_Obj_t* net = abc::Abc_NtkFindNet(
+          netlist.get(), const_cast<char*>(required.first.c_str()));
+      if (net == nullptr) {
+        continue;
+      }
+      for (int i = 0; i < abc::Abc_ObjFanoutNum(net); i++) {
+        abc::Abc_Obj_t* fanout = abc::Abc_ObjFanout(net, i);
+        if (abc::Abc_ObjIsPo(fanout)) {
+          abc::Abc_NtkTimeSetRequired(netlist.get(),
+                                      abc::Abc_ObjId(fanout),
+                                      required.second.first,
+                                      required.second.second);
+        }
+      }
+    }
+  }
+
+  logger_->info(
+      RMP, 42, "Built ABC network with {} instances.", cut.gates.size());
+
+  return abc::Abc_NtkToLogic(netlist.get());
+}
+
+bool Blif::readAbcNetwork(abc::Abc_Ntk_t* network, std::vector<Gate>& gates)
+{
+  if (network == nullptr || !abc::Abc_NtkHasMapping(network)) {
+    return false;
+  }
+
+  utl::deleted_unique_ptr<abc::Abc_Ntk_t> netlist(
+      abc::Abc_NtkToNetlist(network), &abc::Abc_NtkDelete);
+  for (int i = 0; i < abc::Abc_NtkObjNumMax(netlist.get()); i++) {
+    abc::Abc_Obj_t* node = abc::Abc_NtkObj(netlist.get(), i);
+    if (node == nullptr || !abc::Abc_ObjIsNode(node)) {
+      continue;
+    }
+
+    auto gate = static_cast<abc::Mio_Gate_t*>(abc::Abc_ObjData(node));
+    std::vector<std::string> connections;
+    int fanin = 0;
+    for (abc::Mio_Pin_t* pin = abc::Mio_GateReadPins(gate); pin;
+         pin = abc::Mio_PinReadNext(pin)) {
+      connections.push_back(
+          std::string(abc::Mio_PinReadName(pin)) + "="
+          + abc::Abc_ObjName(abc::Abc_ObjFanin(node, fanin++)));
+    }
+    connections.push_back(std::string(abc::Mio_GateReadOutName(gate)) + "="
+                          + abc::Abc_ObjName(abc::Abc_ObjFanout0(node)));
+    gates.emplace_back(
+        GateType::Gate, abc::Mio_GateReadName(gate), connections);
+  }
+
+  return true;
+}
+
+bool Blif::insertGates(const std::vector<Gate>& gates, odb::dbBlock* block)
+{
   for (auto& inst : instances_to_optimize) {
     std::set<odb::dbNet*> connectedNets;
     auto iterms = inst->getITerms();
@@ -454,7 +638,6 @@ bool Blif::readBlif(const char* file_name, odb::dbBlock* block)
   }
 
   // Create and connect new instances
-  auto gates = blif.getGates();
   logger_->info(RMP, 7, "Inserting {} new instances.", gates.size());
   std::map<std::string, int> instIds;
 
@@ -77,6 +77,7 @@ restructure_cmd(char* liberty_file_name, char* target, float slack_threshold,
                 int depth_threshold, char* workdir_name, char* abc_logfile)
 {
   getRestructure()->setMode(target);
+  getRestructure()->setThreadCount(getOpenRoad()->getThreadCount());
   getRestructure()->run(liberty_file_name, slack_threshold, depth_threshold,
                         workdir_name, abc_logfile);
 }
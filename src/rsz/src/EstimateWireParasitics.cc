@@ -373,8 +373,7 @@ void Resizer::ensureWireParasitic(const Pin* drvr_pin, const Net* net)
         parasitics_invalid_.erase(net);
         break;
       case ParasiticsSrc::global_routing: {
-        incr_groute_->updateRoutes();
-        global_router_->estimateRC(db_network_->staToDb(net));
+        incr_groute_->estimateRC(db_network_->staToDb(net));
         parasitics_invalid_.erase(net);
         break;
       }
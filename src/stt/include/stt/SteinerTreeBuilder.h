@@ -75,6 +75,14 @@ struct Tree
   int branchCount() const { return branch.size(); }
 };
 
+// Pin locations of one net for SteinerTreeBuilder::makeSteinerTrees
+struct NetPins
+{
+  std::vector<int> x;
+  std::vector<int> y;
+  int drvr_index = 0;
+};
+
 class SteinerTreeBuilder
 {
  public:
@@ -94,6 +102,12 @@ class SteinerTreeBuilder
                        const std::vector<int>& x,
                        const std::vector<int>& y,
                        int drvr_index);
+  // Builds the trees of many nets on num_threads threads using the
+  // builder's alpha.  The trees are returned in the order of nets.
+  // makeSteinerTree is reentrant, so callers may also build trees from
+  // their own threads.
+  std::vector<Tree> makeSteinerTrees(const std::vector<NetPins>& nets,
+                                     int num_threads);
   // API only for FastRoute, that requires the use of flutes in its
   // internal flute implementation
   Tree makeSteinerTree(const std::vector<int>& x,
@@ -35,6 +35,8 @@
 
 #include "stt/SteinerTreeBuilder.h"
 
+#include <omp.h>
+
 #include <map>
 #include <vector>
 
@@ -79,8 +81,9 @@ Tree SteinerTreeBuilder::makeSteinerTree(odb::dbNet* net,
   int min_fanout = min_fanout_alpha_.first;
   int min_hpwl = min_hpwl_alpha_.first;
 
-  if (net_alpha_map_.find(net) != net_alpha_map_.end()) {
-    net_alpha = net_alpha_map_[net];
+  auto alpha_itr = net_alpha_map_.find(net);
+  if (alpha_itr != net_alpha_map_.end()) {
+    net_alpha = alpha_itr->second;
   } else if (min_hpwl > 0) {
     if (computeHPWL(net) >= min_hpwl) {
       net_alpha = min_hpwl_alpha_.second;
@@ -109,6 +112,19 @@ Tree SteinerTreeBuilder::makeSteinerTree(const std::vector<int>& x,
   return flt::flute(x, y, flute_accuracy);
 }
 
+std::vector<Tree> SteinerTreeBuilder::makeSteinerTrees(
+    const std::vector<NetPins>& nets,
+    const int num_threads)
+{
+  std::vector<Tree> trees(nets.size());
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic, 64)
+  for (int i = 0; i < nets.size(); i++) {  // NOLINT
+    const NetPins& net = nets[i];
+    trees[i] = makeSteinerTree(net.x, net.y, net.drvr_index, alpha_);
+  }
+  return trees;
+}
+
 Tree SteinerTreeBuilder::makeSteinerTree(const std::vector<int>& x,
                                          const std::vector<int>& y,
                                          const std::vector<int>& s,
@@ -39,7 +39,9 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
 #include <string>
+#include <vector>
 
 // Use flute LUT file reader.
 #define LUT_FILE 1
@@ -68,7 +70,7 @@ namespace flt {
 #define MGROUP 362880 / 4  // Max. # of groups, 9! = 362880
 #define MPOWV 79           // Max. # of POWVs per group
 #endif
-int numgrp[10] = {0, 0, 0, 0, 6, 30, 180, 1260, 10080, 90720};
+const int numgrp[10] = {0, 0, 0, 0, 6, 30, 180, 1260, 10080, 90720};
 
 struct csoln
 {
@@ -84,7 +86,8 @@ struct csoln
 using LUT_TYPE = struct csoln***;
 using NUMSOLN_TYPE = int**;
 
-// Dynamically allocate LUTs.
+// Dynamically allocate LUTs.  They are only written while being built
+// under ensureLUT and are read-only afterwards, so flute is reentrant.
 LUT_TYPE LUT = nullptr;
 NUMSOLN_TYPE numsoln;
 
@@ -203,7 +206,7 @@ static void readLUTfiles(LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
 static void readLUT();
 static void makeLUT(LUT_TYPE& LUT, NUMSOLN_TYPE& numsoln);
 static void deleteLUT(LUT_TYPE& LUT, NUMSOLN_TYPE& numsoln);
-static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln);
+static void initLUT(int from_d, int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln);
 static void ensureLUT(int d);
 static std::string base64_decode(std::string const& encoded_string);
 #if LUT_SOURCE == LUT_VAR_CHECK
@@ -213,9 +216,12 @@ static void checkLUT(LUT_TYPE LUT1,
                      NUMSOLN_TYPE numsoln2);
 #endif
 
-// LUTs are initialized to this order at startup.
+// LUTs are initialized to this order on first use.
 static constexpr int lut_initial_d = 8;
-static int lut_valid_d = 0;
+static std::once_flag lut_initial_once;
+#if LUT_SOURCE == LUT_VAR
+static std::once_flag lut_full_once;
+#endif
 
 extern std::string post9;
 extern std::string powv9;
@@ -226,11 +232,10 @@ static void readLUT()
 
 #if LUT_SOURCE == LUT_FILE
   readLUTfiles(LUT, numsoln);
-  lut_valid_d = FLUTE_D;
 
 #elif LUT_SOURCE == LUT_VAR
   // Only init to d=8 on startup because d=9 is big and slow.
-  initLUT(lut_initial_d, LUT, numsoln);
+  initLUT(4, lut_initial_d, LUT, numsoln);
 
 #elif LUT_SOURCE == LUT_VAR_CHECK
   readLUTfiles(LUT, numsoln);
@@ -238,7 +243,7 @@ static void readLUT()
   LUT_TYPE LUT_;
   NUMSOLN_TYPE numsoln_;
   makeLUT(LUT_, numsoln_);
-  initLUT(FLUTE_D, LUT_, numsoln_);
+  initLUT(4, FLUTE_D, LUT_, numsoln_);
   checkLUT(LUT, numsoln, LUT_, numsoln_);
 #endif
 }
@@ -299,9 +304,13 @@ inline const char* readDecimalInt(const char* s, int& value)
   return s;
 }
 
-// Init LUTs from base64 encoded string variables.
-static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
+// Init LUTs for degrees from_d..to_d from base64 encoded string variables.
+// The lower degrees are parsed but not stored so existing entries are never
+// rewritten while other threads read them.
+static void initLUT(int from_d, int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
 {
+  std::vector<struct csoln> skipped;
+
   std::string pwv_string = base64_decode(powv9);
   const char* pwv = pwv_string.c_str();
 
@@ -322,17 +331,26 @@ static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
     ++prt;
 #endif
     for (int k = 0; k < numgrp[d]; k++) {
+      const bool store = d >= from_d;
       int ns = charNum(*pwv++);
       if (ns == 0) {  // same as some previous group
         int kk;
         pwv = readDecimalInt(pwv, kk) + 1;
-        numsoln[d][k] = numsoln[d][kk];
-        LUT[d][k] = LUT[d][kk];
+        if (store) {
+          numsoln[d][k] = numsoln[d][kk];
+          LUT[d][k] = LUT[d][kk];
+        }
       } else {
         pwv++;  // '\n'
-        numsoln[d][k] = ns;
-        struct csoln* p = new struct csoln[ns];
-        LUT[d][k] = p;
+        struct csoln* p;
+        if (store) {
+          numsoln[d][k] = ns;
+          p = new struct csoln[ns];
+          LUT[d][k] = p;
+        } else {
+          skipped.resize(ns);
+          p = skipped.data();
+        }
         for (int i = 1; i <= ns; i++) {
           p->parent = charNum(*pwv++);
 
@@ -373,17 +391,20 @@ static void initLUT(int to_d, LUT_TYPE LUT, NUMSOLN_TYPE numsoln)
       }
     }
   }
-  lut_valid_d = to_d;
 }
 
+// std::call_once makes the LUTs visible to every thread that returns from
+// here, so callers may read LUT[d] and numsoln[d] without locking.
 static void ensureLUT(int d)
 {
-  if (LUT == nullptr) {
-    readLUT();
-  }
-  if (d > lut_valid_d && d <= FLUTE_D) {
-    initLUT(FLUTE_D, LUT, numsoln);
+  std::call_once(lut_initial_once, readLUT);
+#if LUT_SOURCE == LUT_VAR
+  if (d > lut_initial_d && d <= FLUTE_D) {
+    std::call_once(lut_full_once, [] {
+      initLUT(lut_initial_d + 1, FLUTE_D, LUT, numsoln);
+    });
   }
+#endif
 }
 
 #if LUT_SOURCE == LUT_VAR_CHECK
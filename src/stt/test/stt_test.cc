@@ -0,0 +1,63 @@
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "stt/SteinerTreeBuilder.h"
+#include "utl/Logger.h"
+
+namespace stt {
+
+static std::vector<NetPins> makeNets(std::mt19937& rng)
+{
+  std::vector<NetPins> nets;
+  std::uniform_int_distribution<int> coord(0, 100000);
+  // Degrees past 9 take FLUTE's net splitting path.
+  for (int i = 0; i < 2000; i++) {
+    NetPins net;
+    const int degree = 2 + i % 39;
+    for (int j = 0; j < degree; j++) {
+      net.x.push_back(coord(rng));
+      net.y.push_back(coord(rng));
+    }
+    net.drvr_index = i % degree;
+    nets.push_back(net);
+  }
+  return nets;
+}
+
+static void expectSameTree(const Tree& tree, const Tree& expected, int net)
+{
+  ASSERT_EQ(tree.deg, expected.deg) << "net " << net;
+  EXPECT_EQ(tree.length, expected.length) << "net " << net;
+  ASSERT_EQ(tree.branchCount(), expected.branchCount()) << "net " << net;
+  for (int i = 0; i < tree.branchCount(); i++) {
+    EXPECT_EQ(tree.branch[i].x, expected.branch[i].x) << "net " << net;
+    EXPECT_EQ(tree.branch[i].y, expected.branch[i].y) << "net " << net;
+    EXPECT_EQ(tree.branch[i].n, expected.branch[i].n) << "net " << net;
+  }
+}
+
+// The batch API on several threads builds the same trees as building them
+// one net at a time, with PD (alpha > 0) and with FLUTE (alpha 0).
+TEST(SteinerTreeBuilderTest, BatchMatchesSingleNets)
+{
+  utl::Logger logger;
+  std::mt19937 rng(7);
+  const std::vector<NetPins> nets = makeNets(rng);
+  for (const float alpha : {0.3f, 0.0f}) {
+    SteinerTreeBuilder builder;
+    builder.init(nullptr, &logger);
+    builder.setAlpha(alpha);
+
+    const std::vector<Tree> trees = builder.makeSteinerTrees(nets, 4);
+    ASSERT_EQ(trees.size(), nets.size());
+    for (int i = 0; i < nets.size(); i++) {
+      const NetPins& net = nets[i];
+      const Tree expected
+          = builder.makeSteinerTree(net.x, net.y, net.drvr_index, alpha);
+      expectSameTree(trees[i], expected, i);
+    }
+  }
+}
+
+}  // namespace stt